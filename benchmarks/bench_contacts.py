@@ -0,0 +1,142 @@
+"""
+Benchmarks for contact sync matching.
+Compares all-pairs fuzzy scoring with blocked matching (ID/phone joins,
+then trigram candidates) for a 5k x 5k Contacts.app -> contacts.json sync.
+"""
+import sys
+from pathlib import Path
+import random
+import time
+from collections import Counter
+
+# Add project root to path
+PROJECT_ROOT = Path(__file__).parent.parent
+sys.path.insert(0, str(PROJECT_ROOT))
+
+from src.contacts_sync import FUZZY_AVAILABLE, FuzzyNameMatcher, match_contacts
+from benchmarks.benchmark_runner import benchmark, save_benchmark_results, print_results
+from benchmarks.config import RESULTS_DIR
+
+GIVEN = ["James", "Mary", "John", "Patricia", "Robert", "Jennifer", "Michael", "Linda",
+         "David", "Elizabeth", "William", "Barbara", "Sarah", "Daniel", "Lisa", "Wei",
+         "Priya", "Carlos", "Fatima", "Yuki", "Olga", "Kwame", "Sofia", "Liam"]
+FAMILY = ["Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis",
+          "Rodriguez", "Martinez", "Chen", "Patel", "Kim", "Nguyen", "Okafor", "Ivanova",
+          "Tanaka", "Silva", "Muller", "Rossi", "Haddad", "Kowalski", "Larsen", "Murphy"]
+
+# Queries timed for the all-pairs baseline; the full run is extrapolated
+BASELINE_SAMPLE = 100
+
+
+def typo(name: str, rng: random.Random) -> str:
+    """Drop or swap one character, as hand-typed contacts tend to."""
+    i = rng.randrange(1, len(name) - 1)
+    if rng.random() < 0.5:
+        return name[:i] + name[i + 1:]
+    return name[:i] + name[i + 1] + name[i] + name[i + 2:]
+
+
+def make_contacts(count: int, seed: int = 42):
+    """
+    contacts.json entries plus a Contacts.app export of the same people.
+
+    About half of the incoming contacts carry the stored macOS ID and a
+    quarter share a phone number; the rest only match (or not) by name,
+    sometimes with a typo, and one in ten is genuinely new.
+    """
+    rng = random.Random(seed)
+    existing, incoming = [], []
+    for i in range(count):
+        name = f"{rng.choice(GIVEN)} {rng.choice(FAMILY)} {i}"
+        phone = f"1415{i:07d}"
+        existing.append({
+            "name": name,
+            "phone": phone,
+            "macos_contact_id": f"ID-{i}" if i % 2 == 0 else None,
+        })
+
+        roll = rng.random()
+        if roll < 0.1:
+            # Fresh ID too, so nothing joins it and the new-contact path is measured
+            name, phone = f"{rng.choice(GIVEN)} {rng.choice(FAMILY)} new{i}", f"1650{i:07d}"
+            incoming.append({"name": name, "phone": phone, "macos_contact_id": f"NEW-{i}"})
+            continue
+        if i % 4 == 1:
+            name = typo(name, rng)  # Phone still matches
+        elif i % 4 == 3:
+            name, phone = typo(name, rng), ""
+        incoming.append({"name": name, "phone": phone, "macos_contact_id": f"ID-{i}"})
+    return existing, incoming
+
+
+def bench_all_pairs(existing, incoming, matcher):
+    """Score every existing name for a sample of queries, then extrapolate."""
+    names = [c["name"] for c in existing]
+    sample = incoming[:BASELINE_SAMPLE]
+
+    with benchmark(f"contacts_all_pairs_{len(existing)}") as result:
+        start = time.perf_counter()
+        for contact in sample:
+            max(names, key=lambda n: matcher.calculate_similarity(contact["name"], n))
+        per_query = (time.perf_counter() - start) / len(sample)
+
+        result.add_metric("sampled_queries", len(sample))
+        result.add_metric("pairs_scored", len(sample) * len(names))
+        result.add_metric("ms_per_query", round(per_query * 1000, 2))
+        result.add_metric("extrapolated_seconds", round(per_query * len(incoming), 1))
+
+    return result
+
+
+def bench_blocked(existing, incoming, matcher):
+    """Full sync through match_contacts(), counting the pairs it scores."""
+    scored = 0
+    original = matcher.calculate_similarity
+
+    def counting(name1, name2, stop_at=None):
+        nonlocal scored
+        scored += 1
+        return original(name1, name2, stop_at=stop_at)
+
+    matcher.calculate_similarity = counting
+    with benchmark(f"contacts_blocked_{len(existing)}") as result:
+        pairs = match_contacts(incoming, existing, matcher=matcher)
+
+        kinds = Counter(kind for _, kind in pairs.values())
+        result.add_metric("incoming", len(incoming))
+        result.add_metric("matched", len(pairs) - kinds["fuzzy"])
+        result.add_metric("fuzzy_suggestions", kinds["fuzzy"])
+        result.add_metric("new", len(incoming) - len(pairs))
+        result.add_metric("pairs_scored", scored)
+    matcher.calculate_similarity = original
+
+    return result
+
+
+def run_all_contacts_benchmarks(count: int = 5000):
+    """Run the 5k x 5k contact sync benchmark."""
+    if not FUZZY_AVAILABLE:
+        print("fuzzywuzzy not installed - skipping contact matching benchmarks")
+        return []
+
+    existing, incoming = make_contacts(count)
+    matcher = FuzzyNameMatcher(threshold=0.85)
+    print(f"Running contact matching benchmarks ({count} x {count})...")
+
+    baseline = bench_all_pairs(existing, incoming, matcher)
+    blocked = bench_blocked(existing, incoming, matcher)
+    blocked.add_metric(
+        "speedup_vs_all_pairs",
+        round(baseline.metrics["extrapolated_seconds"] / max(blocked.elapsed_seconds, 1e-9), 1),
+    )
+
+    results = [baseline, blocked]
+    output_file = RESULTS_DIR / "contacts_benchmarks.json"
+    save_benchmark_results(results, output_file)
+    print_results(results)
+
+    return results
+
+
+if __name__ == "__main__":
+    run_all_contacts_benchmarks()
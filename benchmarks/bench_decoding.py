@@ -0,0 +1,79 @@
+"""
+Benchmarks for attributedBody decoding.
+Compares the legacy multi-pass heuristic with the length-prefixed
+streamtyped parser, per blob and through the batch API.
+"""
+import sys
+from pathlib import Path
+import random
+import time
+
+# Add project root to path
+PROJECT_ROOT = Path(__file__).parent.parent
+sys.path.insert(0, str(PROJECT_ROOT))
+
+from src.messages_interface import (
+    _extract_text_legacy,
+    decode_attributed_bodies,
+    extract_text_from_blob,
+)
+from benchmarks.benchmark_runner import benchmark, save_benchmark_results, print_results
+from benchmarks.config import BENCHMARK_SIZES, RESULTS_DIR
+from benchmarks.synthetic_data import make_blob, random_text
+
+
+def make_corpus(count: int, seed: int = 42):
+    """Realistic length mix: mostly short texts, some long (0x81 length form)."""
+    rng = random.Random(seed)
+    return [make_blob(random_text(rng)) for _ in range(count)]
+
+
+def bench_decoder(name: str, decode_all, blobs):
+    """Time one decoding strategy over the corpus."""
+    with benchmark(name) as result:
+        start = time.perf_counter()
+        texts = decode_all(blobs)
+        elapsed = time.perf_counter() - start
+
+        result.add_metric("blobs", len(blobs))
+        result.add_metric("decoded", sum(1 for t in texts if t))
+        result.add_metric("us_per_blob", round(elapsed / max(1, len(blobs)) * 1e6, 2))
+
+    return result, texts
+
+
+def run_all_decoding_benchmarks(size: str = "medium"):
+    """Run decoder microbenchmarks and verify outputs agree."""
+    blobs = make_corpus(BENCHMARK_SIZES[size])
+    print(f"Running decoding benchmarks ({len(blobs)} blobs)...")
+
+    legacy_result, legacy_texts = bench_decoder(
+        f"decode_legacy_{size}", lambda bs: [_extract_text_legacy(b) for b in bs], blobs
+    )
+    single_result, single_texts = bench_decoder(
+        f"decode_streamtyped_{size}", lambda bs: [extract_text_from_blob(b) for b in bs], blobs
+    )
+    batch_result, batch_texts = bench_decoder(
+        f"decode_streamtyped_batch_{size}", decode_attributed_bodies, blobs
+    )
+
+    # The legacy path can't read 0x81-length strings, so compare short messages only
+    short = [i for i, b in enumerate(blobs) if b"+\x81" not in b]
+    mismatches = sum(1 for i in short if legacy_texts[i] != single_texts[i])
+    batch_result.add_metric("matches_single_decode", batch_texts == single_texts)
+    single_result.add_metric("legacy_mismatches_short_messages", mismatches)
+    single_result.add_metric(
+        "speedup_vs_legacy",
+        round(legacy_result.elapsed_seconds / max(single_result.elapsed_seconds, 1e-9), 1),
+    )
+
+    results = [legacy_result, single_result, batch_result]
+    output_file = RESULTS_DIR / "decoding_benchmarks.json"
+    save_benchmark_results(results, output_file)
+    print_results(results)
+
+    return results
+
+
+if __name__ == "__main__":
+    run_all_decoding_benchmarks()
@@ -3,6 +3,10 @@ Benchmarks for indexing operations.
 Measures throughput, latency, and memory usage.
 """
 import sys
+import random
+import shutil
+import tempfile
+import time
 from pathlib import Path
 
 # Add project root to path
@@ -11,6 +15,7 @@ sys.path.insert(0, str(PROJECT_ROOT / "Texting"))
 
 from src.messages_interface import MessagesInterface
 from src.rag.chunker import ConversationChunker
+from src.rag.store import find_existing_ids
 from src.rag.unified.imessage_indexer import ImessageIndexer
 from benchmarks.benchmark_runner import benchmark, save_benchmark_results, print_results
 from benchmarks.config import BENCHMARK_SIZES, MESSAGES_DB_PATH, RESULTS_DIR
@@ -70,16 +75,79 @@ def bench_full_index(size: str):
     return result
 
 
+def bench_dedupe_check(size: str, candidates: int = 200):
+    """
+    Benchmark add_chunks' "already indexed?" check vs. collection size.
+
+    Compares loading every ID (the old set(collection.get()["ids"])) with
+    the targeted find_existing_ids() lookup for a small incremental batch.
+    Uses a throwaway Chroma collection with tiny random embeddings, so no
+    embedding API or chat.db is needed.
+    """
+    import chromadb
+
+    collection_size = BENCHMARK_SIZES[size]
+    temp_dir = tempfile.mkdtemp()
+    try:
+        client = chromadb.PersistentClient(path=temp_dir)
+        collection = client.create_collection("dedupe_bench")
+        rng = random.Random(42)
+        for start in range(0, collection_size, 5000):
+            ids = [f"chunk_{i}" for i in range(start, min(start + 5000, collection_size))]
+            collection.add(
+                ids=ids,
+                embeddings=[[rng.random() for _ in range(16)] for _ in ids],
+                documents=["x"] * len(ids),
+                metadatas=[{"source": "imessage"}] * len(ids),
+            )
+
+        # Half the candidates already exist, as in a typical incremental run
+        candidate_ids = [f"chunk_{i}" for i in rng.sample(range(collection_size), candidates // 2)]
+        candidate_ids += [f"new_{i}" for i in range(candidates - len(candidate_ids))]
+
+        with benchmark(f"dedupe_check_{size}") as result:
+            start = time.perf_counter()
+            full_scan = set(collection.get()["ids"]) & set(candidate_ids)
+            full_scan_ms = (time.perf_counter() - start) * 1000
+
+            start = time.perf_counter()
+            targeted = find_existing_ids(collection, candidate_ids)
+            targeted_ms = (time.perf_counter() - start) * 1000
+
+            result.add_metric("collection_size", collection_size)
+            result.add_metric("candidates", candidates)
+            result.add_metric("full_scan_ms", round(full_scan_ms, 2))
+            result.add_metric("targeted_ms", round(targeted_ms, 2))
+            result.add_metric("same_result", full_scan == targeted)
+            if targeted_ms > 0:
+                result.add_metric("speedup", round(full_scan_ms / targeted_ms, 1))
+    finally:
+        shutil.rmtree(temp_dir, ignore_errors=True)
+
+    return result
+
+
 def run_all_indexing_benchmarks():
     """Run complete indexing benchmark suite."""
     results = []
 
     print("Running indexing benchmarks...")
+
+    # Dedupe check cost vs. collection size (synthetic, no chat.db needed)
+    for size in ["small", "medium", "large"]:
+        try:
+            results.append(bench_dedupe_check(size))
+        except Exception as e:
+            print(f"  Error in dedupe_check_{size}: {e}")
+
     print(f"Using Messages database: {MESSAGES_DB_PATH}")
 
     if not MESSAGES_DB_PATH.exists():
         print(f"ERROR: Messages database not found at {MESSAGES_DB_PATH}")
-        print("Skipping indexing benchmarks")
+        print("Skipping chat.db indexing benchmarks")
+        output_file = RESULTS_DIR / "indexing_benchmarks.json"
+        save_benchmark_results(results, output_file)
+        print_results(results)
         return results
 
     # Run each benchmark size
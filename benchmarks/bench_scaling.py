@@ -0,0 +1,419 @@
+"""
+Scaling benchmarks on synthetic datasets.
+
+Runs every read-only gateway command and each indexing stage against the
+synthetic chat.db / Notes / SuperWhisper corpora from synthetic_data.py at
+several sizes, so results are comparable across machines and runs and show
+how cost grows with history.
+
+Each measurement runs in its own worker process (this module with
+--worker), which gives it a clean peak RSS and a true cold first call
+(imports, connections, sidecar open) instead of inheriting a warm parent.
+Per measurement:
+
+- commands: cold_ms (first call), p50/p95/p99 of the warm calls, ops/s
+- stages: elapsed time and items/s for one pass
+- both: peak RSS of the worker (getrusage; psutil isn't required)
+
+Sidecar indexes (keyword index, rollups, link index) are built once per
+scale by the "sidecar" stages and then shared by the command workers, so
+command timings are steady-state query costs. Embedding is not measured:
+it depends on the network (OpenAI) or a local model, not on this code.
+
+CS Concept: **Tail latency** - p95/p99 over repeated calls expose
+stalls (cache misses, GC, lazy syncs) that a single mean hides.
+
+Usage:
+    python3 -m benchmarks.bench_scaling --scales 10k,100k
+    python3 -m benchmarks.bench_scaling --save-baseline
+    python3 -m benchmarks.bench_scaling --compare   # exit 1 on regression
+"""
+import argparse
+import contextlib
+import json
+import logging
+import math
+import os
+import resource
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+from datetime import datetime
+from pathlib import Path
+from typing import Any, Dict, List, Optional
+
+PROJECT_ROOT = Path(__file__).parent.parent
+sys.path.insert(0, str(PROJECT_ROOT))
+
+from benchmarks.config import RESULTS_DIR
+
+RESULTS_FILE = RESULTS_DIR / "scaling_benchmarks.json"
+BASELINE_FILE = RESULTS_DIR / "scaling_baseline.json"
+
+DEFAULT_SCALES = ["10k", "100k"]
+
+# Warm calls per command after the cold one
+DEFAULT_ITERATIONS = 20
+
+# A metric more than this fraction slower than baseline is a regression
+REGRESSION_THRESHOLD = 0.10
+
+# Compared against baseline (higher is worse)
+COMPARED_METRICS = ("cold_ms", "p50_ms", "p95_ms", "elapsed_seconds", "peak_rss_mb")
+
+# Gateway commands measured, by name. "{contact}" is the busiest synthetic
+# contact; "{group}" its busiest group chat.
+COMMANDS = {
+    "recent": ["recent", "--json"],
+    "unread": ["unread", "--json"],
+    "messages": ["messages", "{contact}", "--limit", "100", "--json"],
+    "find": ["find", "{contact}", "--query", "dinner", "--json"],
+    "find_all": ["find", "{contact}", "--query", "flight booked", "--sort", "relevance", "--json"],
+    "groups": ["groups", "--json"],
+    "group_messages": ["group-messages", "--group-id", "{group}", "--json"],
+    "attachments": ["attachments", "--json"],
+    "links": ["links", "--all-time", "--json"],
+    "voice": ["voice", "--json"],
+    "reactions": ["reactions", "--days", "365", "--json"],
+    "handles": ["handles", "--days", "365", "--json"],
+    "unknown": ["unknown", "--days", "365", "--json"],
+    "analytics": ["analytics", "--days", "365", "--json"],
+    "summary": ["summary", "{contact}", "--limit", "500", "--json"],
+}
+
+# Indexing stages, each measured in a fresh worker
+STAGES = ["sidecar", "fetch", "imessage_chunk", "notes", "superwhisper"]
+
+
+# ----- measurement helpers (worker side) -----
+
+def peak_rss_mb() -> float:
+    """Peak resident set size of this process (ru_maxrss: KB on Linux, bytes on macOS)."""
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return peak / (1024 * 1024) if sys.platform == "darwin" else peak / 1024
+
+
+def percentile(samples: List[float], pct: float) -> float:
+    """Nearest-rank percentile (samples need not be sorted)."""
+    if not samples:
+        return 0.0
+    ordered = sorted(samples)
+    rank = max(1, math.ceil(pct / 100 * len(ordered)))
+    return ordered[min(rank, len(ordered)) - 1]
+
+
+def use_dataset(spec: Dict[str, Any]):
+    """Point the gateway's process-wide interfaces at the synthetic dataset."""
+    from gateway import imessage_client
+    from src.contacts_manager import ContactsManager
+    from src.messages_interface import MessagesInterface
+
+    imessage_client.CONTACTS_CONFIG = Path(spec["contacts"])
+    imessage_client._interfaces = (
+        MessagesInterface(spec["chat_db"], sidecar_path=spec["sidecar"]),
+        ContactsManager(spec["contacts"]),
+    )
+    imessage_client._contacts_mtime = imessage_client._contacts_config_mtime()
+    return imessage_client
+
+
+def run_command_worker(spec: Dict[str, Any]) -> List[Dict[str, Any]]:
+    """Time one gateway command: a cold call, then `iterations` warm ones."""
+    started = time.perf_counter()
+    imessage_client = use_dataset(spec)
+    samples = []
+    with open(os.devnull, "w") as devnull, contextlib.redirect_stdout(devnull):
+        for _ in range(spec["iterations"] + 1):
+            t0 = time.perf_counter()
+            exit_code = imessage_client.run_command(spec["argv"])
+            samples.append(time.perf_counter() - t0)
+            if exit_code not in (0, None):
+                raise RuntimeError(f"{' '.join(spec['argv'])} exited {exit_code}")
+    # Cold includes interface setup: what a one-shot CLI call pays after import
+    cold, warm = samples[0] + (time.perf_counter() - started - sum(samples)), samples[1:]
+
+    return [{
+        "name": spec["name"],
+        "elapsed_seconds": sum(samples),
+        "metrics": {
+            "cold_ms": round(cold * 1000, 3),
+            "p50_ms": round(percentile(warm, 50) * 1000, 3),
+            "p95_ms": round(percentile(warm, 95) * 1000, 3),
+            "p99_ms": round(percentile(warm, 99) * 1000, 3),
+            "ops_per_sec": round(len(warm) / sum(warm), 1) if sum(warm) else 0.0,
+            "iterations": len(warm),
+            "peak_rss_mb": round(peak_rss_mb(), 1),
+        },
+    }]
+
+
+def stage_result(name: str, elapsed: float, items: int, **metrics) -> Dict[str, Any]:
+    return {
+        "name": name,
+        "elapsed_seconds": elapsed,
+        "metrics": {
+            "items": items,
+            "items_per_sec": round(items / elapsed, 1) if elapsed else 0.0,
+            "peak_rss_mb": round(peak_rss_mb(), 1),
+            **metrics,
+        },
+    }
+
+
+def run_stage_worker(spec: Dict[str, Any]) -> List[Dict[str, Any]]:
+    """Time one indexing stage from an empty sidecar/state directory."""
+    from src.messages_interface import MessagesInterface
+    from src.rag.unified.store import UnifiedVectorStore
+
+    stage, scale = spec["stage"], spec["scale"]
+    work = Path(spec["work_dir"])
+    store = UnifiedVectorStore(persist_directory=str(work / "chroma"))
+    results = []
+
+    if stage == "sidecar":
+        # Builds the shared sidecar; the keyword index pays the cold decode
+        mi = MessagesInterface(spec["chat_db"], sidecar_path=spec["sidecar"])
+        conn = mi._get_connection()
+        count = conn.execute("SELECT COUNT(*) FROM message").fetchone()[0]
+
+        t0 = time.perf_counter()
+        mi._get_search_index().sync(conn, decode_many=mi._decode_bodies)
+        results.append(stage_result(f"sidecar_search_index_{scale}", time.perf_counter() - t0, count))
+        t0 = time.perf_counter()
+        mi._synced_rollups(conn)
+        results.append(stage_result(f"sidecar_rollups_{scale}", time.perf_counter() - t0, count))
+        t0 = time.perf_counter()
+        links = mi._synced_media_index(conn).stats()["links"]
+        results.append(stage_result(f"sidecar_link_index_{scale}", time.perf_counter() - t0, count,
+                                    links=links))
+        return results
+
+    if stage in ("fetch", "imessage_chunk"):
+        from src.contacts_manager import ContactsManager
+        from src.rag.unified.imessage_indexer import ImessageIndexer
+
+        mi = MessagesInterface(spec["chat_db"], sidecar_path=str(work / "sidecar.db"))
+        indexer = ImessageIndexer(
+            messages_interface=mi, contacts_manager=ContactsManager(spec["contacts"]),
+            state_file=work / "state.json", store=store,
+        )
+        if stage == "fetch":
+            # First pass decodes every blob; the second hits the decoded-text cache
+            for label in ("cold", "warm"):
+                t0 = time.perf_counter()
+                count = sum(1 for _ in indexer.iter_data(incremental=False))
+                results.append(stage_result(f"imessage_fetch_{label}_{scale}", time.perf_counter() - t0, count))
+            return results
+
+        messages = list(indexer.iter_data(incremental=False))
+        t0 = time.perf_counter()
+        chunks = sum(len(batch) for batch in indexer.iter_chunks(messages))
+        return [stage_result(f"imessage_chunk_{scale}", time.perf_counter() - t0, len(messages),
+                             chunks=chunks)]
+
+    if stage == "notes":
+        from src.rag.unified.notes_indexer import NotesIndexer
+
+        indexer = NotesIndexer(notes_path=Path(spec["notes_dir"]), state_file=work / "state.json", store=store)
+        t0 = time.perf_counter()
+        documents = indexer.fetch_data(incremental=False)
+        chunks = indexer.chunk_data(documents)
+        return [stage_result(f"notes_load_chunk_{scale}", time.perf_counter() - t0, len(documents),
+                             chunks=len(chunks))]
+
+    if stage == "superwhisper":
+        from src.rag.unified.superwhisper_indexer import SuperWhisperIndexer
+
+        indexer = SuperWhisperIndexer(recordings_path=Path(spec["superwhisper_dir"]),
+                                      state_file=work / "state.json", store=store)
+        t0 = time.perf_counter()
+        recordings = indexer.fetch_data(incremental=False)
+        chunks = indexer.chunk_data(recordings)
+        return [stage_result(f"superwhisper_load_chunk_{scale}", time.perf_counter() - t0, len(recordings),
+                             chunks=len(chunks))]
+
+    raise ValueError(f"Unknown stage: {stage}")
+
+
+def worker_main(spec_json: str) -> int:
+    logging.basicConfig(level=logging.WARNING)
+    spec = json.loads(spec_json)
+    results = run_command_worker(spec) if spec["kind"] == "command" else run_stage_worker(spec)
+    # Last line of stdout is the result; commands' own output went to devnull
+    print(json.dumps(results))
+    return 0
+
+
+# ----- orchestration (parent side) -----
+
+def run_worker(spec: Dict[str, Any], timeout: float = 1800) -> List[Dict[str, Any]]:
+    """Run one measurement in a fresh interpreter and parse its results."""
+    proc = subprocess.run(
+        [sys.executable, "-m", "benchmarks.bench_scaling", "--worker", json.dumps(spec)],
+        capture_output=True, text=True, cwd=str(PROJECT_ROOT), timeout=timeout,
+    )
+    if proc.returncode != 0:
+        raise RuntimeError(f"Worker {spec.get('name') or spec.get('stage')} failed:\n{proc.stderr[-2000:]}")
+    return json.loads(proc.stdout.strip().splitlines()[-1])
+
+
+def command_targets(dataset) -> Dict[str, str]:
+    """Busiest synthetic contact and group chat, used as command arguments."""
+    import sqlite3
+
+    contacts = json.loads(dataset.contacts.read_text())["contacts"]
+    conn = sqlite3.connect(dataset.chat_db)
+    group = conn.execute("""
+        SELECT cache_roomnames FROM message WHERE cache_roomnames IS NOT NULL
+        GROUP BY cache_roomnames ORDER BY COUNT(*) DESC LIMIT 1
+    """).fetchone()
+    conn.close()
+    return {"contact": contacts[0]["name"], "group": group[0] if group else ""}
+
+
+def run_scale(scale: str, seed: int = 42, iterations: int = DEFAULT_ITERATIONS,
+              commands: Optional[List[str]] = None, stages: Optional[List[str]] = None,
+              data_root: Optional[Path] = None) -> List[Dict[str, Any]]:
+    """Generate (or reuse) the dataset for a scale and run every measurement on it."""
+    from benchmarks.synthetic_data import synthetic_dataset
+
+    print(f"\n=== scale {scale} ===")
+    t0 = time.perf_counter()
+    dataset = synthetic_dataset(scale, seed=seed, root=data_root)
+    print(f"dataset ready in {time.perf_counter() - t0:.1f}s: {dataset.counts['messages']} messages")
+
+    base = {"scale": scale, "chat_db": str(dataset.chat_db), "contacts": str(dataset.contacts),
+            "notes_dir": str(dataset.notes_dir), "superwhisper_dir": str(dataset.superwhisper_dir)}
+    results: List[Dict[str, Any]] = []
+
+    with tempfile.TemporaryDirectory(prefix=f"bench-{scale}-") as tmp:
+        sidecar = str(Path(tmp) / "sidecar.db")
+        # The sidecar stage always runs first: the command workers share its output
+        for stage in ["sidecar"] + [s for s in (stages or STAGES) if s != "sidecar"]:
+            work = Path(tmp) / stage
+            work.mkdir()
+            for result in run_worker({**base, "kind": "stage", "stage": stage,
+                                      "sidecar": sidecar, "work_dir": str(work)}):
+                if stage == "sidecar" and stages is not None and "sidecar" not in stages:
+                    continue
+                results.append(result)
+                print(f"  {result['name']}: {result['elapsed_seconds']:.3f}s "
+                      f"({result['metrics']['items_per_sec']}/s, {result['metrics']['peak_rss_mb']} MB)")
+
+        targets = command_targets(dataset)
+        for name in commands or COMMANDS:
+            argv = [arg.format(**targets) for arg in COMMANDS[name]]
+            result, = run_worker({**base, "kind": "command", "name": f"cmd_{name}_{scale}",
+                                  "argv": argv, "sidecar": sidecar, "iterations": iterations})
+            results.append(result)
+            m = result["metrics"]
+            print(f"  {result['name']}: cold {m['cold_ms']}ms, p50 {m['p50_ms']}ms, "
+                  f"p95 {m['p95_ms']}ms, p99 {m['p99_ms']}ms ({m['peak_rss_mb']} MB)")
+
+    for result in results:
+        result["metrics"].update(scale=scale, messages=dataset.counts["messages"], seed=seed)
+        result["memory_used_mb"] = result["metrics"]["peak_rss_mb"]
+        result["timestamp"] = datetime.now().isoformat()
+    return results
+
+
+def compare_scaling(baseline: List[Dict[str, Any]], current: List[Dict[str, Any]],
+                    threshold: float = REGRESSION_THRESHOLD) -> List[Dict[str, Any]]:
+    """
+    Compare results by name on COMPARED_METRICS.
+
+    Returns:
+        Changes beyond the threshold: dicts with name, metric, baseline,
+        current, change (fraction) and regressed (True when slower/larger)
+    """
+    base = {r["name"]: r for r in baseline}
+    changes = []
+    for result in current:
+        before = base.get(result["name"])
+        if before is None:
+            continue
+        for metric in COMPARED_METRICS:
+            old = before.get(metric, before.get("metrics", {}).get(metric))
+            new = result.get(metric, result.get("metrics", {}).get(metric))
+            if not old or new is None:
+                continue
+            change = (new - old) / old
+            if abs(change) > threshold:
+                changes.append({"name": result["name"], "metric": metric, "baseline": old,
+                                "current": new, "change": change, "regressed": change > 0})
+    return changes
+
+
+def print_comparison(changes: List[Dict[str, Any]], threshold: float = REGRESSION_THRESHOLD):
+    print("\n" + "=" * 80)
+    print("SCALING COMPARISON")
+    print("=" * 80)
+    if not changes:
+        print(f"\n⚪ All metrics within {threshold:.0%} of baseline")
+    for c in changes:
+        symbol = "🔴" if c["regressed"] else "🟢"
+        print(f"{symbol} {c['name']} {c['metric']}: {c['baseline']:.3f} -> {c['current']:.3f} "
+              f"({c['change']:+.1%})")
+    print()
+
+
+def run_all_scaling_benchmarks(scales: Optional[List[str]] = None, seed: int = 42,
+                               iterations: int = DEFAULT_ITERATIONS,
+                               commands: Optional[List[str]] = None,
+                               stages: Optional[List[str]] = None) -> List[Dict[str, Any]]:
+    """Run and save the suite; RESULTS_FILE holds the latest run only."""
+    results = []
+    for scale in scales or DEFAULT_SCALES:
+        results.extend(run_scale(scale, seed=seed, iterations=iterations, commands=commands, stages=stages))
+    RESULTS_FILE.write_text(json.dumps(results, indent=2))
+    print(f"\nSaved benchmark results to {RESULTS_FILE}")
+    return results
+
+
+def main(argv=None) -> int:
+    parser = argparse.ArgumentParser(description="Scaling benchmarks on synthetic datasets")
+    parser.add_argument("--worker", help=argparse.SUPPRESS)
+    parser.add_argument("--scales", default=",".join(DEFAULT_SCALES),
+                        help="Comma-separated scales: 10k, 100k, 1m or a message count (default: 10k,100k)")
+    parser.add_argument("--seed", type=int, default=42)
+    parser.add_argument("--iterations", type=int, default=DEFAULT_ITERATIONS, help="Warm calls per command")
+    parser.add_argument("--commands", help=f"Comma-separated subset of: {', '.join(COMMANDS)}")
+    parser.add_argument("--stages", help=f"Comma-separated subset of: {', '.join(STAGES)}")
+    parser.add_argument("--compare", nargs="?", const=BASELINE_FILE, type=Path, metavar="BASELINE",
+                        help="Compare against a baseline file (default: results/scaling_baseline.json); "
+                             "exits 1 on regression")
+    parser.add_argument("--threshold", type=float, default=REGRESSION_THRESHOLD,
+                        help="Regression threshold as a fraction (default: 0.10)")
+    parser.add_argument("--save-baseline", action="store_true", help="Save this run as the baseline")
+    args = parser.parse_args(argv)
+
+    if args.worker:
+        return worker_main(args.worker)
+
+    results = run_all_scaling_benchmarks(
+        scales=args.scales.split(","), seed=args.seed, iterations=args.iterations,
+        commands=args.commands.split(",") if args.commands else None,
+        stages=args.stages.split(",") if args.stages else None,
+    )
+
+    if args.save_baseline:
+        shutil.copy(RESULTS_FILE, BASELINE_FILE)
+        print(f"✅ Saved baseline to {BASELINE_FILE}")
+
+    if args.compare:
+        try:
+            baseline = json.loads(Path(args.compare).read_text())
+        except (OSError, ValueError) as e:
+            print(f"ERROR: Cannot read baseline {args.compare}: {e}")
+            return 1
+        changes = compare_scaling(baseline, results, args.threshold)
+        print_comparison(changes, args.threshold)
+        if any(c["regressed"] for c in changes):
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
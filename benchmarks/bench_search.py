@@ -1,7 +1,10 @@
 """
 Benchmarks for search and retrieval operations.
-Measures query latency and breakdown (embedding vs retrieval).
+Measures query latency and breakdown (embedding vs retrieval), and
+recall/memory/latency of reduced vector layouts (see quantized_vectors).
 """
+import heapq
+import random
 import sys
 from pathlib import Path
 import time
@@ -12,6 +15,7 @@ sys.path.insert(0, str(PROJECT_ROOT / "Texting"))
 
 from src.rag.unified.retriever import UnifiedRetriever
 from src.rag.store import EmbeddingProvider
+from src.rag.unified.quantized_vectors import RERANK_FACTOR, dequantize, quantize, truncate
 from benchmarks.benchmark_runner import benchmark, save_benchmark_results, print_results
 from benchmarks.config import RESULTS_DIR
 
@@ -117,6 +121,79 @@ def bench_search_k_scaling():
     return results
 
 
+def _synthetic_embeddings(count: int, dims: int, seed: int = 0):
+    """
+    Unit vectors whose variance decays across dimensions, like Matryoshka
+    embeddings (leading dimensions carry most of the signal).
+    """
+    rng = random.Random(seed)
+    scales = [1 / (1 + i / 64) ** 0.5 for i in range(dims)]
+    return [truncate([rng.gauss(0, s) for s in scales], dims) for _ in range(count)]
+
+
+def _top_k(query, vectors, k):
+    scores = ((sum(a * b for a, b in zip(query, v)), i) for i, v in enumerate(vectors))
+    return [i for _, i in heapq.nlargest(k, scores)]
+
+
+def bench_vector_layouts(n_chunks: int = 2000, dims: int = 1536, n_queries: int = 20, k: int = 10):
+    """
+    Compare reduced layouts against full float32 vectors on synthetic data.
+
+    For each layout: recall@k against exact full-precision search, bytes
+    per chunk in Chroma and in the re-rank sidecar, and query latency.
+    Stage one is brute force here (not HNSW), so latencies compare layouts
+    with each other rather than predicting Chroma's absolute numbers.
+    """
+    vectors = _synthetic_embeddings(n_chunks, dims)
+    rng = random.Random(1)
+    queries = [
+        truncate([x + rng.gauss(0, 0.02) for x in vectors[rng.randrange(n_chunks)]], dims)
+        for _ in range(n_queries)
+    ]
+    truth = [set(_top_k(q, vectors, k)) for q in queries]
+
+    layouts = [("full", None, None)]
+    for reduced in (128, 256, 512):
+        layouts.append((f"dim{reduced}_no_rerank", reduced, None))
+        for storage in ("float16", "int8"):
+            layouts.append((f"dim{reduced}_{storage}", reduced, storage))
+
+    results = []
+    for name, reduced, storage in layouts:
+        with benchmark(f"vector_layout_{name}") as result:
+            first_stage = [truncate(v, reduced) for v in vectors] if reduced else vectors
+            full = [dequantize(quantize(v, storage), storage) for v in vectors] if storage else None
+
+            hits = 0
+            start = time.perf_counter()
+            for query, expected in zip(queries, truth):
+                if reduced is None:
+                    found = _top_k(query, vectors, k)
+                elif storage is None:
+                    found = _top_k(truncate(query, reduced), first_stage, k)
+                else:
+                    candidates = _top_k(truncate(query, reduced), first_stage, k * RERANK_FACTOR)
+                    found = heapq.nlargest(
+                        k, candidates, key=lambda i: sum(a * b for a, b in zip(query, full[i]))
+                    )
+                hits += len(expected.intersection(found))
+            elapsed = time.perf_counter() - start
+
+            chroma_bytes = (reduced or dims) * 4
+            rerank_bytes = len(quantize(vectors[0], storage)) if storage else 0
+            result.add_metric("dimensions", reduced or dims)
+            result.add_metric("rerank_storage", storage or "none")
+            result.add_metric(f"recall_at_{k}", round(hits / (k * n_queries), 3))
+            result.add_metric("chroma_bytes_per_chunk", chroma_bytes)
+            result.add_metric("rerank_bytes_per_chunk", rerank_bytes)
+            result.add_metric("chroma_mb_per_100k_chunks", round(chroma_bytes * 100_000 / 2**20, 1))
+            result.add_metric("latency_ms", elapsed * 1000 / n_queries)
+        results.append(result)
+
+    return results
+
+
 def run_all_search_benchmarks():
     """Run complete search benchmark suite."""
     results = []
@@ -168,6 +245,13 @@ def run_all_search_benchmarks():
     except Exception as e:
         print(f"  Skipped k_scaling: {e}")
 
+    # Reduced vector layouts (synthetic, needs no index or API key)
+    print("\nBenchmarking vector layouts...")
+    try:
+        results.extend(bench_vector_layouts())
+    except Exception as e:
+        print(f"  Skipped vector_layouts: {e}")
+
     # Save and display
     output_file = RESULTS_DIR / "search_benchmarks.json"
     save_benchmark_results(results, output_file)
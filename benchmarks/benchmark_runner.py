@@ -2,7 +2,6 @@
 Core benchmark runner with timing and profiling utilities.
 """
 import time
-import psutil
 import json
 from typing import Dict, Any, List
 from pathlib import Path
@@ -29,7 +28,7 @@ class BenchmarkResult:
     @property
     def memory_used_mb(self) -> float:
         """Peak memory increase in MB."""
-        if self.memory_peak and self.memory_start:
+        if self.memory_peak is not None and self.memory_start is not None:
             return (self.memory_peak - self.memory_start) / 1024 / 1024
         return 0.0
 
@@ -37,6 +36,17 @@ class BenchmarkResult:
         """Add custom metric to results."""
         self.metrics[key] = value
 
+    @classmethod
+    def from_dict(cls, data: Dict[str, Any]) -> "BenchmarkResult":
+        """Rebuild a result from to_dict() output (or a --metrics-file line)."""
+        result = cls(data["name"])
+        result.start_time = 0.0
+        result.end_time = data.get("elapsed_seconds", 0.0)
+        result.memory_start = 0
+        result.memory_peak = data.get("memory_used_mb", 0.0) * 1024 * 1024
+        result.metrics = dict(data.get("metrics") or {})
+        return result
+
     def to_dict(self) -> Dict[str, Any]:
         """Convert to dictionary for serialization."""
         return {
@@ -58,6 +68,8 @@ def benchmark(name: str):
             # code to benchmark
             result.add_metric("items_processed", 1000)
     """
+    import psutil
+
     result = BenchmarkResult(name)
     process = psutil.Process()
 
@@ -89,6 +101,21 @@ def save_benchmark_results(results: List[BenchmarkResult], output_file: Path):
     print(f"Saved benchmark results to {output_file}")
 
 
+def load_benchmark_results(path: Path) -> List[BenchmarkResult]:
+    """
+    Load results from a JSON array (save_benchmark_results) or JSON Lines.
+
+    JSON Lines is what the gateway's --metrics-file appends: one record per
+    command run, with per-stage timings as <stage>_seconds metrics.
+    """
+    text = Path(path).read_text()
+    if text.lstrip().startswith("["):
+        records = json.loads(text)
+    else:
+        records = [json.loads(line) for line in text.splitlines() if line.strip()]
+    return [BenchmarkResult.from_dict(record) for record in records]
+
+
 def print_results(results: List[BenchmarkResult]):
     """Print formatted benchmark results to console."""
     print("\n" + "="*80)
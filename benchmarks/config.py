@@ -13,5 +13,8 @@ BENCHMARK_SIZES = {
 RESULTS_DIR = Path(__file__).parent / "results"
 RESULTS_DIR.mkdir(exist_ok=True)
 
+# Generated synthetic datasets (see synthetic_data.py); not committed
+BENCH_DATA_DIR = Path(__file__).parent / "data"
+
 # Test data
 MESSAGES_DB_PATH = Path.home() / "Library" / "Messages" / "chat.db"
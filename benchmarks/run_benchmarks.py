@@ -10,16 +10,24 @@ import json
 PROJECT_ROOT = Path(__file__).parent.parent.parent
 sys.path.insert(0, str(PROJECT_ROOT / "Texting"))
 
+from benchmarks.bench_contacts import run_all_contacts_benchmarks
+from benchmarks.bench_decoding import run_all_decoding_benchmarks
 from benchmarks.bench_indexing import run_all_indexing_benchmarks
 from benchmarks.bench_search import run_all_search_benchmarks
+from benchmarks.bench_scaling import run_all_scaling_benchmarks
+from benchmarks.benchmark_runner import load_benchmark_results
 from benchmarks.config import RESULTS_DIR
 
 
 def compare_results(baseline_file: Path, current_file: Path):
-    """Compare two benchmark result files and show regression/improvement."""
+    """
+    Compare two benchmark result files and show regression/improvement.
+
+    Either file may be a JSON array or JSON Lines (gateway --metrics-file);
+    when a name repeats, its last record is used.
+    """
     try:
-        with open(baseline_file) as f:
-            baseline = {r["name"]: r for r in json.load(f)}
+        baseline = {r.name: r.to_dict() for r in load_benchmark_results(baseline_file)}
     except FileNotFoundError:
         print(f"ERROR: Baseline file not found: {baseline_file}")
         return
@@ -28,8 +36,7 @@ def compare_results(baseline_file: Path, current_file: Path):
         return
 
     try:
-        with open(current_file) as f:
-            current = {r["name"]: r for r in json.load(f)}
+        current = {r.name: r.to_dict() for r in load_benchmark_results(current_file)}
     except FileNotFoundError:
         print(f"ERROR: Current file not found: {current_file}")
         return
@@ -77,14 +84,20 @@ def main():
     parser = argparse.ArgumentParser(description="Run RAG performance benchmarks")
     parser.add_argument(
         "--suite",
-        choices=["indexing", "search", "all"],
+        choices=["indexing", "search", "decoding", "contacts", "scaling", "all"],
         default="all",
-        help="Which benchmark suite to run"
+        help="Which benchmark suite to run ('scaling' generates synthetic datasets "
+             "and is not part of 'all')"
+    )
+    parser.add_argument(
+        "--scales",
+        default="10k,100k",
+        help="Comma-separated synthetic dataset sizes for the scaling suite (10k, 100k, 1m)"
     )
     parser.add_argument(
         "--compare",
         type=Path,
-        help="Compare against baseline results file"
+        help="Compare against baseline results file (JSON or JSON Lines)"
     )
     parser.add_argument(
         "--save-baseline",
@@ -111,6 +124,24 @@ def main():
         print("="*80)
         run_all_search_benchmarks()
 
+    if args.suite in ["decoding", "all"]:
+        print("\n" + "="*80)
+        print("DECODING BENCHMARKS")
+        print("="*80)
+        run_all_decoding_benchmarks()
+
+    if args.suite in ["contacts", "all"]:
+        print("\n" + "="*80)
+        print("CONTACT MATCHING BENCHMARKS")
+        print("="*80)
+        run_all_contacts_benchmarks()
+
+    if args.suite == "scaling":
+        print("\n" + "="*80)
+        print("SCALING BENCHMARKS")
+        print("="*80)
+        run_all_scaling_benchmarks(scales=args.scales.split(","))
+
     # Save baseline if requested
     if args.save_baseline:
         if args.suite == "indexing":
@@ -119,8 +150,17 @@ def main():
         elif args.suite == "search":
             baseline_file = RESULTS_DIR / "search_baseline.json"
             current_file = RESULTS_DIR / "search_benchmarks.json"
+        elif args.suite == "decoding":
+            baseline_file = RESULTS_DIR / "decoding_baseline.json"
+            current_file = RESULTS_DIR / "decoding_benchmarks.json"
+        elif args.suite == "contacts":
+            baseline_file = RESULTS_DIR / "contacts_baseline.json"
+            current_file = RESULTS_DIR / "contacts_benchmarks.json"
+        elif args.suite == "scaling":
+            baseline_file = RESULTS_DIR / "scaling_baseline.json"
+            current_file = RESULTS_DIR / "scaling_benchmarks.json"
         else:
-            print("\n--save-baseline requires --suite to be 'indexing' or 'search'")
+            print("\n--save-baseline requires --suite to be 'indexing', 'search', 'decoding', 'contacts' or 'scaling'")
             return
 
         if current_file.exists():
@@ -134,8 +174,12 @@ def main():
             current = RESULTS_DIR / "indexing_benchmarks.json"
         elif args.suite == "search":
             current = RESULTS_DIR / "search_benchmarks.json"
+        elif args.suite == "decoding":
+            current = RESULTS_DIR / "decoding_benchmarks.json"
+        elif args.suite == "scaling":
+            current = RESULTS_DIR / "scaling_benchmarks.json"
         else:
-            print("\n--compare requires --suite to be 'indexing' or 'search'")
+            print("\n--compare requires --suite to be 'indexing', 'search', 'decoding' or 'scaling'")
             return
 
         if current.exists():
@@ -0,0 +1,592 @@
+"""
+Reproducible synthetic datasets for benchmarks.
+
+Benchmarks against the live ~/Library/Messages/chat.db measure whatever
+history the machine happens to have, so numbers can't be compared across
+machines or over time and don't show how cost grows with history. This
+module builds the same inputs from a seed instead:
+
+- chat.db with the tables and columns the gateway reads (message, handle,
+  chat, the join tables, attachment), Ventura-style attributedBody blobs
+  for most messages, 1:1 and group chats, tapback reactions, attachments
+  (images, files, voice memos), shared links, replies and unread messages
+- contacts.json naming the busiest handles
+- a Notes markdown tree and SuperWhisper recordings (meta.json per folder)
+
+Same seed, scale, GENERATOR_VERSION and end date -> byte-identical message
+rows. The end date defaults to today at midnight (the gateway's "days ago"
+filters are relative to now), so default output changes from one day to the
+next; pass a fixed end to reproduce a dataset exactly. Datasets are cached
+under BENCH_DATA_DIR and regenerated when any of those change, including the
+day.
+
+CS Concept: **Synthetic workload generation** - a seeded generator that
+matches the shape of real data (session bursts, skewed contact activity,
+text length mix) gives stable, scalable inputs; the distributions matter
+more than the content.
+
+Usage:
+    python3 -m benchmarks.synthetic_data --scale 100k
+    dataset = synthetic_dataset("10k")   # -> SyntheticDataset with paths
+"""
+import argparse
+import json
+import random
+import shutil
+import sqlite3
+import sys
+from dataclasses import asdict, dataclass
+from datetime import datetime, timedelta
+from pathlib import Path
+from typing import Dict, List, Optional
+
+PROJECT_ROOT = Path(__file__).parent.parent
+sys.path.insert(0, str(PROJECT_ROOT))
+
+from benchmarks.config import BENCH_DATA_DIR
+
+# Bump when generated data changes shape, so cached datasets are rebuilt
+GENERATOR_VERSION = 1
+
+SCALES = {
+    "10k": 10_000,
+    "100k": 100_000,
+    "1m": 1_000_000,
+}
+
+COCOA_EPOCH = datetime(2001, 1, 1)
+
+# Length of the generated history; it ends at `end` (today at midnight unless
+# pinned) because "days ago" filters in the gateway are relative to now
+HISTORY_DAYS = 730
+
+WORDS = [
+    "dinner", "tonight", "running", "late", "see", "you", "at", "7", "ok", "sounds",
+    "good", "can't", "wait", "👍", "😂", "lol", "where", "are", "we", "meeting",
+    "tomorrow", "work", "weekend", "plans", "coffee", "call", "later", "thanks", "home",
+    "trip", "flight", "booked", "climbing", "gym", "movie", "restaurant", "reservation",
+    "birthday", "party", "bring", "anything", "just", "landed", "traffic", "sorry",
+    "yes", "no", "maybe", "love", "that", "haha", "omg", "what", "time", "works",
+]
+
+LINK_HOSTS = ["example.com", "news.example.org", "maps.example.net", "video.example.com"]
+
+TAPBACKS = {2000: "Loved", 2001: "Liked", 2002: "Disliked", 2003: "Laughed at",
+            2004: "Emphasized", 2005: "Questioned"}
+
+ATTACHMENT_KINDS = [
+    # (weight, mime_type, uti, extension, typical bytes)
+    (60, "image/jpeg", "public.jpeg", "jpeg", 2_500_000),
+    (15, "image/heic", "public.heic", "heic", 1_800_000),
+    (8, "video/quicktime", "com.apple.quicktime-movie", "mov", 25_000_000),
+    (5, "application/pdf", "com.adobe.pdf", "pdf", 400_000),
+    (12, None, "com.apple.coreaudio-format", "caf", 150_000),   # Voice memo
+]
+
+SCHEMA = """
+    CREATE TABLE handle (
+        ROWID INTEGER PRIMARY KEY AUTOINCREMENT,
+        id TEXT NOT NULL,
+        country TEXT,
+        service TEXT NOT NULL DEFAULT 'iMessage',
+        uncanonicalized_id TEXT,
+        person_centric_id TEXT
+    );
+    CREATE TABLE chat (
+        ROWID INTEGER PRIMARY KEY AUTOINCREMENT,
+        guid TEXT UNIQUE NOT NULL,
+        style INTEGER,
+        state INTEGER,
+        chat_identifier TEXT,
+        service_name TEXT,
+        display_name TEXT,
+        is_archived INTEGER DEFAULT 0
+    );
+    CREATE TABLE message (
+        ROWID INTEGER PRIMARY KEY AUTOINCREMENT,
+        guid TEXT UNIQUE NOT NULL,
+        text TEXT,
+        attributedBody BLOB,
+        handle_id INTEGER DEFAULT 0,
+        service TEXT,
+        date INTEGER,
+        date_read INTEGER,
+        date_delivered INTEGER,
+        is_from_me INTEGER DEFAULT 0,
+        is_read INTEGER DEFAULT 0,
+        is_delivered INTEGER DEFAULT 0,
+        is_finished INTEGER DEFAULT 0,
+        is_system_message INTEGER DEFAULT 0,
+        is_audio_message INTEGER DEFAULT 0,
+        is_played INTEGER DEFAULT 0,
+        item_type INTEGER DEFAULT 0,
+        cache_roomnames TEXT,
+        cache_has_attachments INTEGER DEFAULT 0,
+        was_data_detected INTEGER DEFAULT 0,
+        associated_message_guid TEXT,
+        associated_message_type INTEGER DEFAULT 0,
+        associated_message_emoji TEXT,
+        thread_originator_guid TEXT,
+        reply_to_guid TEXT,
+        schedule_type INTEGER DEFAULT 0,
+        schedule_state INTEGER DEFAULT 0,
+        date_edited INTEGER DEFAULT 0
+    );
+    CREATE TABLE attachment (
+        ROWID INTEGER PRIMARY KEY AUTOINCREMENT,
+        guid TEXT UNIQUE NOT NULL,
+        created_date INTEGER DEFAULT 0,
+        filename TEXT,
+        uti TEXT,
+        mime_type TEXT,
+        transfer_name TEXT,
+        total_bytes INTEGER DEFAULT 0,
+        is_outgoing INTEGER DEFAULT 0,
+        is_sticker INTEGER DEFAULT 0
+    );
+    CREATE TABLE chat_handle_join (
+        chat_id INTEGER REFERENCES chat (ROWID) ON DELETE CASCADE,
+        handle_id INTEGER REFERENCES handle (ROWID) ON DELETE CASCADE,
+        UNIQUE(chat_id, handle_id)
+    );
+    CREATE TABLE chat_message_join (
+        chat_id INTEGER REFERENCES chat (ROWID) ON DELETE CASCADE,
+        message_id INTEGER REFERENCES message (ROWID) ON DELETE CASCADE,
+        message_date INTEGER DEFAULT 0,
+        PRIMARY KEY (chat_id, message_id)
+    );
+    CREATE TABLE message_attachment_join (
+        message_id INTEGER REFERENCES message (ROWID) ON DELETE CASCADE,
+        attachment_id INTEGER REFERENCES attachment (ROWID) ON DELETE CASCADE,
+        UNIQUE(message_id, attachment_id)
+    );
+"""
+
+# Created after the bulk insert (faster load); mirrors chat.db's own indexes
+INDEXES = """
+    CREATE INDEX message_idx_handle ON message(handle_id, date);
+    CREATE INDEX message_idx_date ON message(date);
+    CREATE INDEX message_idx_is_read ON message(is_read, is_from_me, is_finished);
+    CREATE INDEX message_idx_associated_message ON message(associated_message_guid);
+    CREATE INDEX message_idx_thread_originator_guid ON message(thread_originator_guid);
+    CREATE INDEX chat_message_join_idx_message_id_only ON chat_message_join(message_id);
+    CREATE INDEX message_attachment_join_idx_message_id ON message_attachment_join(message_id);
+"""
+
+
+def make_blob(text: str, link: bool = False) -> bytes:
+    """Streamtyped attributedBody blob, as written by Messages."""
+    encoded = text.encode("utf-8")
+    n = len(encoded)
+    if n < 0x80:
+        length = bytes([n])
+    elif n < 0x10000:
+        length = b"\x81" + n.to_bytes(2, "little")
+    else:
+        length = b"\x82" + n.to_bytes(4, "little")
+    attributes = b"\x92\x84\x96\x96\x1d__kIMMessagePartAttributeName\x86\x86"
+    if link:
+        attributes += b"\x92\x84\x96\x96\x16__kIMLinkAttributeName\x86\x86"
+    return (
+        b"\x04\x0bstreamtyped\x81\xe8\x03\x84\x01@\x84\x84\x84\x12NSAttributedString\x00"
+        b"\x84\x84\x08NSObject\x00\x85\x92\x84\x84\x84\x08NSString\x01\x94\x84\x01+"
+        + length + encoded
+        + b"\x86\x84\x02iI\x01\x05\x92\x84\x84\x84\x0cNSDictionary\x00\x94\x84\x01i\x01"
+        + attributes
+    )
+
+
+def random_text(rng: random.Random) -> str:
+    """Realistic length mix: mostly short texts, some long."""
+    n_words = rng.choice([2, 4, 8, 12, 20]) if rng.random() < 0.9 else rng.randint(40, 120)
+    return " ".join(rng.choice(WORDS) for _ in range(n_words))
+
+
+def to_cocoa(dt: datetime) -> int:
+    return int((dt - COCOA_EPOCH).total_seconds()) * 1_000_000_000
+
+
+@dataclass
+class SyntheticProfile:
+    """
+    Shape of a generated chat.db. Ratios are per generated message.
+
+    Contact activity is Zipf-like (a few handles carry most traffic), and
+    messages arrive in sessions: bursts about a minute apart, separated by
+    gaps sized so the history spans HISTORY_DAYS.
+    """
+    handles: int = 300
+    group_chats: int = 25
+    group_ratio: float = 0.25          # Messages sent to group chats
+    blob_only_ratio: float = 0.7       # text NULL, body only in attributedBody
+    reaction_ratio: float = 0.06
+    attachment_ratio: float = 0.05
+    link_ratio: float = 0.03
+    reply_ratio: float = 0.02
+    session_length: int = 12           # Mean messages per session
+    unread_received: int = 40          # Newest received messages left unread
+
+
+@dataclass
+class SyntheticDataset:
+    """Paths and counts of one generated dataset."""
+    scale: str
+    seed: int
+    root: Path
+    chat_db: Path
+    contacts: Path
+    notes_dir: Path
+    superwhisper_dir: Path
+    counts: Dict[str, int]
+
+    @property
+    def manifest(self) -> Path:
+        return self.root / "manifest.json"
+
+
+def generate_chat_db(
+    path: Path,
+    messages: int,
+    seed: int = 42,
+    profile: Optional[SyntheticProfile] = None,
+    end: Optional[datetime] = None,
+) -> Dict[str, int]:
+    """
+    Build a synthetic chat.db at path (replacing any existing file).
+
+    Args:
+        path: Output database file
+        messages: Number of message rows (reactions included)
+        seed: RNG seed; the same seed and a fixed end give identical rows
+        profile: Data shape (default SyntheticProfile())
+        end: Timestamp of the newest message (default: today at midnight, so
+            day-relative filters work; rows then match only within one day)
+
+    Returns:
+        Row counts per kind (messages, reactions, attachments, links, ...)
+    """
+    profile = profile or SyntheticProfile()
+    rng = random.Random(seed)
+    end = end or datetime.now().replace(hour=0, minute=0, second=0, microsecond=0)
+    start = end - timedelta(days=HISTORY_DAYS)
+
+    path = Path(path)
+    path.parent.mkdir(parents=True, exist_ok=True)
+    if path.exists():
+        path.unlink()
+    conn = sqlite3.connect(path)
+    conn.execute("PRAGMA journal_mode = OFF")
+    conn.execute("PRAGMA synchronous = OFF")
+    conn.executescript(SCHEMA)
+
+    # Handles: mostly phones, some emails
+    handles = []
+    for i in range(profile.handles):
+        if i % 7 == 6:
+            handles.append(f"friend{i:04d}@example.com")
+        else:
+            handles.append(f"+1415{rng.randint(2000000, 9999999):07d}")
+    handles = list(dict.fromkeys(handles))
+    conn.executemany("INSERT INTO handle (id, country) VALUES (?, 'us')", [(h,) for h in handles])
+    handle_ids = list(range(1, len(handles) + 1))
+
+    # Chats: one per handle, then groups of 3-8 participants
+    chats = []   # (chat_id, identifier, participants(handle ids), is_group)
+    for handle_id, handle in zip(handle_ids, handles):
+        chats.append((handle_id, handle, [handle_id], False))
+    for g in range(profile.group_chats):
+        participants = rng.sample(handle_ids[: max(8, len(handle_ids) // 3)], rng.randint(3, 8))
+        chats.append((len(chats) + 1, f"chat{rng.randint(10**17, 10**18 - 1)}", participants, True))
+    conn.executemany(
+        "INSERT INTO chat (ROWID, guid, style, chat_identifier, service_name, display_name) "
+        "VALUES (?, ?, ?, ?, 'iMessage', ?)",
+        [
+            (chat_id, f"iMessage;{'+' if group else '-'};{identifier}", 43 if group else 45, identifier,
+             f"Group {chat_id}" if group and chat_id % 3 else "")
+            for chat_id, identifier, _, group in chats
+        ],
+    )
+    conn.executemany(
+        "INSERT INTO chat_handle_join VALUES (?, ?)",
+        [(chat_id, h) for chat_id, _, participants, _ in chats for h in participants],
+    )
+
+    # Zipf-like activity weights
+    direct_weights = [1.0 / (rank + 1) ** 1.1 for rank in range(len(handles))]
+    group_weights = [1.0 / (rank + 1) for rank in range(profile.group_chats)]
+
+    sessions = max(1, messages // profile.session_length)
+    mean_gap = (end - start).total_seconds() / sessions
+
+    counts = {"messages": 0, "reactions": 0, "attachments": 0, "voice": 0, "links": 0,
+              "blob_only": 0, "group_messages": 0, "replies": 0}
+    message_rows, chat_rows, attachment_rows, join_rows = [], [], [], []
+    recent = []        # (guid, text) of recent messages, targets for reactions/replies
+    t = start.timestamp()
+    rowid = 0
+    attachment_id = 0
+
+    def flush():
+        conn.executemany(
+            "INSERT INTO message (ROWID, guid, text, attributedBody, handle_id, service, date, date_read, "
+            "date_delivered, is_from_me, is_read, is_delivered, is_finished, is_audio_message, is_played, "
+            "cache_roomnames, cache_has_attachments, was_data_detected, associated_message_guid, "
+            "associated_message_type, thread_originator_guid, reply_to_guid) "
+            "VALUES (?, ?, ?, ?, ?, 'iMessage', ?, ?, ?, ?, ?, 1, 1, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+            message_rows,
+        )
+        conn.executemany("INSERT INTO chat_message_join VALUES (?, ?, ?)", chat_rows)
+        conn.executemany(
+            "INSERT INTO attachment (ROWID, guid, created_date, filename, uti, mime_type, transfer_name, "
+            "total_bytes, is_outgoing) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)",
+            attachment_rows,
+        )
+        conn.executemany("INSERT INTO message_attachment_join VALUES (?, ?)", join_rows)
+        for rows in (message_rows, chat_rows, attachment_rows, join_rows):
+            rows.clear()
+
+    kind_weights = [k[0] for k in ATTACHMENT_KINDS]
+    while rowid < messages:
+        # One session in one chat
+        t += rng.expovariate(1.0 / mean_gap)
+        if rng.random() < profile.group_ratio and profile.group_chats:
+            chat_id, identifier, participants, is_group = chats[
+                len(handles) + rng.choices(range(profile.group_chats), group_weights)[0]
+            ]
+        else:
+            chat_id, identifier, participants, is_group = chats[
+                rng.choices(range(len(handles)), direct_weights)[0]
+            ]
+
+        for _ in range(min(messages - rowid, max(1, int(rng.expovariate(1.0 / profile.session_length))))):
+            rowid += 1
+            t += rng.expovariate(1.0 / 45)
+            date = to_cocoa(datetime.fromtimestamp(t))
+            is_from_me = rng.random() < 0.45
+            handle_id = 0 if is_from_me and is_group else rng.choice(participants)
+            guid = f"{rng.getrandbits(128):032X}"
+            text, body = None, None
+            associated_guid, associated_type = None, 0
+            thread_guid = reply_guid = None
+            has_attachments = is_audio = data_detected = 0
+
+            roll = rng.random()
+            if roll < profile.reaction_ratio and recent:
+                target_guid, target_text = rng.choice(recent)
+                associated_type = rng.choice(list(TAPBACKS))
+                associated_guid = target_guid   # get_reactions joins on the plain GUID
+                text = f"{TAPBACKS[associated_type]} “{(target_text or 'an image')[:60]}”"
+                body = make_blob(text)
+                counts["reactions"] += 1
+            elif roll < profile.reaction_ratio + profile.attachment_ratio:
+                kind = rng.choices(ATTACHMENT_KINDS, kind_weights)[0]
+                attachment_id += 1
+                is_audio = 1 if kind[2] == "com.apple.coreaudio-format" else 0
+                name = f"Audio Message.{kind[3]}" if is_audio else f"IMG_{attachment_id:05d}.{kind[3]}"
+                attachment_rows.append((
+                    attachment_id, f"at_{guid}", date // 1_000_000_000,
+                    f"~/Library/Messages/Attachments/{attachment_id % 256:02x}/{attachment_id:05d}/{name}",
+                    kind[2], kind[1], name, int(kind[4] * rng.uniform(0.3, 1.7)), 1 if is_from_me else 0,
+                ))
+                join_rows.append((rowid, attachment_id))
+                text = "￼"
+                body = make_blob(text)
+                has_attachments = 1
+                counts["attachments"] += 1
+                counts["voice"] += is_audio
+            else:
+                text = random_text(rng)
+                if rng.random() < profile.link_ratio / (1 - profile.reaction_ratio - profile.attachment_ratio):
+                    text += f" https://{rng.choice(LINK_HOSTS)}/{rng.getrandbits(40):x}"
+                    data_detected = 1
+                    counts["links"] += 1
+                body = make_blob(text, link=bool(data_detected))
+                if recent and rng.random() < profile.reply_ratio:
+                    reply_guid = rng.choice(recent)[0]
+                    thread_guid = reply_guid
+                    counts["replies"] += 1
+                recent.append((guid, text))
+                if len(recent) > 50:
+                    recent.pop(0)
+
+            if rng.random() < profile.blob_only_ratio:
+                text = None
+                counts["blob_only"] += 1
+
+            message_rows.append((
+                rowid, guid, text, body, handle_id, date,
+                date + 60_000_000_000 if not is_from_me else 0, date + 1_000_000_000,
+                1 if is_from_me else 0, 1, is_audio, 1 if is_audio and rng.random() < 0.8 else 0,
+                identifier if is_group else None, has_attachments, data_detected,
+                associated_guid, associated_type, thread_guid, reply_guid,
+            ))
+            chat_rows.append((chat_id, rowid, date))
+            counts["messages"] += 1
+            counts["group_messages"] += 1 if is_group else 0
+
+            if len(message_rows) >= 20_000:
+                flush()
+
+    flush()
+
+    # Shift the whole history so the newest message lands at `end`
+    latest = conn.execute("SELECT MAX(date) FROM message").fetchone()[0] or 0
+    shift = to_cocoa(end) - latest
+    conn.execute("UPDATE message SET date = date + ?, date_read = CASE WHEN date_read > 0 "
+                 "THEN date_read + ? ELSE 0 END, date_delivered = date_delivered + ?", (shift, shift, shift))
+    conn.execute("UPDATE chat_message_join SET message_date = message_date + ?", (shift,))
+
+    # Newest received messages stay unread
+    conn.execute("""
+        UPDATE message SET is_read = 0, date_read = 0 WHERE ROWID IN (
+            SELECT ROWID FROM message WHERE is_from_me = 0 AND associated_message_type = 0
+            ORDER BY ROWID DESC LIMIT ?
+        )
+    """, (profile.unread_received,))
+
+    conn.executescript(INDEXES)
+    conn.commit()
+    conn.execute("ANALYZE")
+    conn.close()
+    counts["handles"] = len(handles)
+    counts["chats"] = len(chats)
+    return counts
+
+
+def generate_contacts(path: Path, chat_db: Path, count: int = 50) -> List[str]:
+    """
+    Write contacts.json naming the `count` busiest handles in chat_db.
+
+    Returns:
+        Contact names, busiest first ("Contact 001", ...)
+    """
+    conn = sqlite3.connect(chat_db)
+    rows = conn.execute("""
+        SELECT h.id FROM message m JOIN handle h ON h.ROWID = m.handle_id
+        GROUP BY h.id ORDER BY COUNT(*) DESC, h.id LIMIT ?
+    """, (count,)).fetchall()
+    conn.close()
+
+    contacts = []
+    for i, (handle,) in enumerate(rows, start=1):
+        is_email = "@" in handle
+        contacts.append({
+            "name": f"Contact {i:03d}",
+            "phone": "" if is_email else handle.lstrip("+"),
+            "relationship_type": "friend",
+            "notes": "",
+            "emails": [handle] if is_email else [],
+        })
+    Path(path).write_text(json.dumps({"contacts": contacts}, indent=2))
+    return [c["name"] for c in contacts]
+
+
+def generate_notes(directory: Path, count: int, seed: int = 42) -> int:
+    """Markdown notes in a few folders, with headings and paragraphs."""
+    rng = random.Random(seed)
+    directory = Path(directory)
+    folders = ["notes", "work", "travel", "recipes", "journal"]
+    for i in range(count):
+        folder = rng.choice(folders)
+        sections = []
+        for s in range(rng.randint(1, 5)):
+            paragraphs = [random_text(rng) + "." for _ in range(rng.randint(1, 4))]
+            sections.append(f"## Section {s + 1}\n\n" + "\n\n".join(paragraphs))
+        note = directory / ("" if folder == "notes" else folder) / f"note-{i:05d}.md"
+        note.parent.mkdir(parents=True, exist_ok=True)
+        note.write_text(f"# Note {i}\n\n" + "\n\n".join(sections) + "\n")
+    return count
+
+
+def generate_superwhisper(directory: Path, count: int, seed: int = 42,
+                          end: Optional[datetime] = None) -> int:
+    """SuperWhisper recordings: one folder per recording with meta.json."""
+    rng = random.Random(seed)
+    directory = Path(directory)
+    end = end or datetime.now().replace(hour=0, minute=0, second=0, microsecond=0)
+    for i in range(count):
+        recorded = end - timedelta(minutes=rng.randint(0, HISTORY_DAYS * 24 * 60))
+        words = rng.randint(5, 200)
+        text = " ".join(rng.choice(WORDS) for _ in range(words))
+        recording = directory / f"{int(recorded.timestamp())}{i:04d}"
+        recording.mkdir(parents=True, exist_ok=True)
+        (recording / "meta.json").write_text(json.dumps({
+            "result": text,
+            "datetime": recorded.isoformat(),
+            "duration": words * 400,
+            "modeName": rng.choice(["Default", "Email", "Note"]),
+            "modelName": "Synthetic",
+            "modelKey": "synthetic-v1",
+            "processingTime": words * 5,
+            "segments": [{"start": 0, "end": words * 0.4, "text": text}],
+            "appVersion": "1.0",
+        }))
+    return count
+
+
+def synthetic_dataset(scale: str, seed: int = 42, root: Optional[Path] = None,
+                      refresh: bool = False) -> SyntheticDataset:
+    """
+    Return the dataset for a scale, generating it if missing or stale.
+
+    A manifest records scale, seed, generator version and generation day;
+    any mismatch (or refresh=True) rebuilds the dataset from scratch.
+
+    Args:
+        scale: Key of SCALES, or a message count as a string ("2500")
+        seed: RNG seed
+        root: Parent directory (default: BENCH_DATA_DIR)
+    """
+    messages = SCALES.get(scale) or int(scale)
+    base = Path(root) if root else BENCH_DATA_DIR
+    directory = base / f"{scale}-seed{seed}"
+    dataset = SyntheticDataset(
+        scale=scale, seed=seed, root=directory,
+        chat_db=directory / "chat.db",
+        contacts=directory / "contacts.json",
+        notes_dir=directory / "notes",
+        superwhisper_dir=directory / "superwhisper",
+        counts={},
+    )
+
+    key = {"scale": scale, "messages": messages, "seed": seed, "version": GENERATOR_VERSION,
+           "day": datetime.now().strftime("%Y-%m-%d")}
+    if not refresh and dataset.manifest.exists():
+        try:
+            stored = json.loads(dataset.manifest.read_text())
+            if stored.get("key") == key:
+                dataset.counts = stored["counts"]
+                return dataset
+        except (ValueError, KeyError):
+            pass
+
+    if directory.exists():
+        shutil.rmtree(directory)
+    directory.mkdir(parents=True)
+    counts = generate_chat_db(dataset.chat_db, messages, seed=seed)
+    counts["contacts"] = len(generate_contacts(dataset.contacts, dataset.chat_db))
+    counts["notes"] = generate_notes(dataset.notes_dir, max(10, messages // 100), seed=seed)
+    counts["recordings"] = generate_superwhisper(dataset.superwhisper_dir, max(10, messages // 200), seed=seed)
+    dataset.counts = counts
+    dataset.manifest.write_text(json.dumps({"key": key, "counts": counts}, indent=2))
+    return dataset
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate synthetic benchmark datasets")
+    parser.add_argument("--scale", action="append", default=None,
+                        help=f"Scale to generate ({', '.join(SCALES)} or a message count); repeatable")
+    parser.add_argument("--seed", type=int, default=42)
+    parser.add_argument("--refresh", action="store_true", help="Regenerate even if cached")
+    args = parser.parse_args()
+
+    for scale in args.scale or ["10k"]:
+        started = datetime.now()
+        dataset = synthetic_dataset(scale, seed=args.seed, refresh=args.refresh)
+        elapsed = (datetime.now() - started).total_seconds()
+        print(f"{scale}: {dataset.root} ({elapsed:.1f}s)")
+        print("  " + json.dumps(dataset.counts))
+
+
+if __name__ == "__main__":
+    main()
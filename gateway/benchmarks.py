@@ -8,21 +8,25 @@ Tests:
 3. Contact resolution speed
 4. JSON output overhead
 5. Comparison with MCP server startup
+6. Per-subcommand cold start and import time (lazy-import regressions)
 
 Usage:
     python3 gateway/benchmarks.py                    # Run all benchmarks
     python3 gateway/benchmarks.py --quick           # Run quick benchmarks only
     python3 gateway/benchmarks.py --json            # Output results as JSON
     python3 gateway/benchmarks.py --compare-mcp     # Include MCP server comparison
+    python3 gateway/benchmarks.py --daemon          # In-process vs resident daemon
+    python3 gateway/benchmarks.py --cold-start      # Per-subcommand startup/imports
 """
 
+import os
 import sys
 import time
 import json
 import subprocess
 import statistics
 from pathlib import Path
-from typing import Dict, List, Any
+from typing import Dict, List, Any, Optional
 from dataclasses import dataclass, asdict
 import argparse
 
@@ -57,10 +61,16 @@ class BenchmarkSuite:
     metadata: Dict[str, Any]
 
 
-def run_cli_command(cmd: List[str], timeout: int = 30) -> tuple[float, bool, str]:
+def run_cli_command(cmd: List[str], timeout: int = 30,
+                    env: Optional[Dict[str, str]] = None) -> tuple[float, bool, str]:
     """
     Run a CLI command and measure execution time.
 
+    Args:
+        cmd: Command arguments
+        timeout: Seconds before the run is counted as failed
+        env: Extra environment variables (e.g. daemon socket overrides)
+
     Returns:
         (execution_time_ms, success, output)
     """
@@ -71,7 +81,8 @@ def run_cli_command(cmd: List[str], timeout: int = 30) -> tuple[float, bool, str
             capture_output=True,
             text=True,
             timeout=timeout,
-            cwd=str(REPO_ROOT)
+            cwd=str(REPO_ROOT),
+            env={**os.environ, **env} if env else None,
         )
         elapsed = (time.perf_counter() - start) * 1000  # Convert to ms
         success = result.returncode == 0
@@ -89,7 +100,8 @@ def benchmark_command(
     name: str,
     description: str,
     cmd: List[str],
-    iterations: int = 10
+    iterations: int = 10,
+    env: Optional[Dict[str, str]] = None,
 ) -> BenchmarkResult:
     """
     Benchmark a CLI command over multiple iterations.
@@ -99,6 +111,7 @@ def benchmark_command(
         description: What's being tested
         cmd: Command arguments (without python3 gateway/imessage_client.py)
         iterations: Number of times to run the command
+        env: Extra environment variables passed to the CLI
 
     Returns:
         BenchmarkResult with timing statistics
@@ -109,7 +122,7 @@ def benchmark_command(
     successes = 0
 
     for i in range(iterations):
-        elapsed, success, _ = run_cli_command(cmd)
+        elapsed, success, _ = run_cli_command(cmd, env=env)
         timings.append(elapsed)
         if success:
             successes += 1
@@ -383,6 +396,97 @@ def benchmark_mcp_server_startup(iterations: int = 10) -> BenchmarkResult:
     return result
 
 
+# Subcommands whose startup must stay cheap: none of them embeds anything,
+# so none should import an embedding backend (or chromadb on an empty store)
+COLD_START_COMMANDS = [
+    ("help", "CLI --help", ["--help"]),
+    ("contacts", "List contacts", ["contacts", "--json"]),
+    ("stats", "Knowledge base stats", ["stats", "--json"]),
+    ("sources", "List RAG sources", ["sources", "--json"]),
+    ("clear", "Clear preview (exits 1 when there is data)", ["clear", "--json"]),
+]
+
+
+def profile_imports(cmd: List[str], env: Optional[Dict[str, str]] = None,
+                    timeout: int = 60) -> tuple[float, Dict[str, float]]:
+    """
+    Run a CLI command under `python3 -X importtime`.
+
+    Returns:
+        (total import time in ms, top-level module -> cumulative ms)
+    """
+    result = subprocess.run(
+        ["python3", "-X", "importtime", str(CLI_PATH)] + cmd,
+        capture_output=True,
+        text=True,
+        timeout=timeout,
+        cwd=str(REPO_ROOT),
+        env={**os.environ, **(env or {})},
+    )
+
+    by_module: Dict[str, float] = {}
+    for line in result.stderr.splitlines():
+        if not line.startswith("import time:"):
+            continue
+        fields = line[len("import time:"):].split("|")
+        if len(fields) != 3 or not fields[1].strip().isdigit():
+            continue  # Header row
+        name = fields[2]
+        if name.startswith(" ") and not name.startswith("  "):
+            # Depth 0 (one space after the bar): a module imported by the program itself
+            root = name.strip().split(".")[0]
+            by_module[root] = by_module.get(root, 0.0) + int(fields[1]) / 1000
+    return sum(by_module.values()), by_module
+
+
+def benchmark_cold_start(iterations: int = 5) -> List[BenchmarkResult]:
+    """
+    Wall time and import time of each cheap subcommand, in-process (no daemon).
+
+    Prints the heaviest imports per command, so a regression (e.g. a
+    top-level import of chromadb or sentence-transformers) names its cause.
+    """
+    env = {"IMESSAGE_GATEWAY_NO_DAEMON": "1"}
+    results = []
+    for name, description, cmd in COLD_START_COMMANDS:
+        results.append(benchmark_command(
+            name=f"cold_start_{name}",
+            description=f"{description} (wall time)",
+            cmd=cmd,
+            iterations=iterations,
+            env=env,
+        ))
+
+        timings = []
+        heaviest: Dict[str, float] = {}
+        for _ in range(iterations):
+            total, by_module = profile_imports(cmd, env=env)
+            timings.append(total)
+            heaviest = by_module
+        results.append(BenchmarkResult(
+            name=f"imports_{name}",
+            description=f"{description} (import time)",
+            iterations=iterations,
+            mean_ms=statistics.mean(timings),
+            median_ms=statistics.median(timings),
+            min_ms=min(timings),
+            max_ms=max(timings),
+            std_dev_ms=statistics.stdev(timings) if len(timings) > 1 else 0,
+            success_rate=100.0,
+        ))
+        top = sorted(heaviest.items(), key=lambda kv: -kv[1])[:5]
+        print(f"  imports_{name}: {statistics.mean(timings):.1f}ms; heaviest: "
+              + ", ".join(f"{module} {ms:.1f}ms" for module, ms in top))
+
+    return results
+
+
+def run_cold_start_benchmarks() -> List[BenchmarkResult]:
+    """Run the per-subcommand cold start suite."""
+    print("\n=== Cold Start / Import Time ===\n")
+    return benchmark_cold_start(iterations=5)
+
+
 def run_quick_benchmarks() -> List[BenchmarkResult]:
     """Run a quick subset of benchmarks (fast execution)."""
     print("\n=== Quick Benchmark Suite ===\n")
@@ -450,6 +554,58 @@ def run_comparison_benchmarks() -> List[BenchmarkResult]:
     return cli_results + [mcp_result]
 
 
+def run_daemon_benchmarks() -> List[BenchmarkResult]:
+    """
+    Compare in-process execution against the resident daemon.
+
+    Starts a private daemon on a temporary socket so a user's running daemon
+    is neither used nor disturbed.
+    """
+    import tempfile
+
+    print("\n=== In-Process vs Daemon Comparison ===\n")
+
+    commands = [
+        ("contacts", "List all contacts", ["contacts", "--json"]),
+        ("recent", "Recent conversations (limit 10)", ["recent", "--limit", "10", "--json"]),
+        ("unread", "Fetch unread messages", ["unread", "--json"]),
+    ]
+
+    results = []
+    in_process_env = {"IMESSAGE_GATEWAY_NO_DAEMON": "1"}
+    for name, description, cmd in commands:
+        results.append(benchmark_command(
+            name=f"{name}_in_process",
+            description=f"{description} (in-process)",
+            cmd=cmd,
+            iterations=10,
+            env=in_process_env,
+        ))
+
+    with tempfile.TemporaryDirectory(prefix="imsg-bench-") as tmp:
+        daemon_env = {"IMESSAGE_GATEWAY_SOCKET": str(Path(tmp) / "gateway.sock")}
+        _, started, output = run_cli_command(
+            ["daemon", "start", "--detach", "--no-rag"], timeout=60, env=daemon_env
+        )
+        if not started:
+            print(f"Could not start daemon, skipping daemon runs: {output.strip()}")
+            return results
+
+        try:
+            for name, description, cmd in commands:
+                results.append(benchmark_command(
+                    name=f"{name}_daemon",
+                    description=f"{description} (via daemon)",
+                    cmd=cmd,
+                    iterations=10,
+                    env=daemon_env,
+                ))
+        finally:
+            run_cli_command(["daemon", "stop"], env=daemon_env)
+
+    return results
+
+
 def print_summary(results: List[BenchmarkResult]):
     """Print a human-readable summary of benchmark results."""
     print("\n" + "=" * 80)
@@ -509,6 +665,16 @@ def main():
         action="store_true",
         help="Include MCP server comparison benchmarks"
     )
+    parser.add_argument(
+        "--daemon",
+        action="store_true",
+        help="Compare in-process execution with the resident daemon"
+    )
+    parser.add_argument(
+        "--cold-start",
+        action="store_true",
+        help="Per-subcommand cold start and import time"
+    )
     parser.add_argument(
         "--json",
         action="store_true",
@@ -527,12 +693,21 @@ def main():
         results = run_quick_benchmarks()
     elif args.compare_mcp:
         results = run_comparison_benchmarks()
+    elif args.daemon:
+        results = run_daemon_benchmarks()
+    elif args.cold_start:
+        results = run_cold_start_benchmarks()
     else:
         results = run_full_benchmarks()
 
     # Create suite
     suite = BenchmarkSuite(
-        suite_name="quick" if args.quick else "full",
+        suite_name=(
+            "quick" if args.quick
+            else "daemon" if args.daemon
+            else "cold_start" if args.cold_start
+            else "full"
+        ),
         timestamp=time.strftime("%Y-%m-%d %H:%M:%S"),
         results=results,
         metadata={
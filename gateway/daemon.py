@@ -0,0 +1,381 @@
+#!/usr/bin/env python3
+"""
+iMessage Gateway Daemon - keeps the gateway resident behind a Unix socket.
+
+Every CLI invocation normally pays interpreter startup, the src.* imports,
+a fresh contacts.json parse and (for RAG commands) ChromaDB/embedder setup.
+The daemon loads all of that once and executes subcommands in-process; the
+CLI becomes a thin client that forwards argv and replays stdout/stderr.
+
+Protocol (one request per connection, newline-delimited JSON):
+    -> {"op": "run", "argv": ["recent", "--limit", "5"]}
+    <- {"exit_code": 0, "stdout": "...", "stderr": "..."}
+
+    With "stream": true, stdout is relayed as the command flushes it, in
+    {"chunk": "..."} frames before the final reply (whose "stdout" then
+    holds only the unflushed tail), so NDJSON output reaches the caller
+    while the command is still fetching. Daemons that predate streaming
+    ignore the flag and send the single final reply.
+
+    -> {"op": "ping"}       <- {"ok": true, "pid": 1234, "started": "...", "commands": 17}
+    -> {"op": "shutdown"}   <- {"ok": true}
+
+Usage:
+    python3 gateway/imessage_client.py daemon start            # foreground
+    python3 gateway/imessage_client.py daemon start --detach   # background
+    python3 gateway/imessage_client.py daemon status
+    python3 gateway/imessage_client.py daemon stop
+
+Environment:
+    IMESSAGE_GATEWAY_SOCKET     Override socket path (default: ~/.imessage_rag/gateway.sock)
+    IMESSAGE_GATEWAY_NO_DAEMON  Set to 1 to always execute in-process
+"""
+
+import contextlib
+import io
+import json
+import logging
+import os
+import socket
+import socketserver
+import sys
+import threading
+from datetime import datetime
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional
+
+logger = logging.getLogger(__name__)
+
+DEFAULT_SOCKET_PATH = Path.home() / ".imessage_rag" / "gateway.sock"
+
+# Short connect timeout: a missing daemon must not slow down the fallback path
+CONNECT_TIMEOUT_SECONDS = 0.25
+
+# Max size of a single request line (argv only, so this is generous)
+MAX_REQUEST_BYTES = 1024 * 1024
+
+# Buffered stdout relayed as one frame once it reaches this size (streaming)
+STREAM_CHUNK_CHARS = 16 * 1024
+
+
+def get_socket_path() -> Path:
+    """Return the daemon socket path, honouring IMESSAGE_GATEWAY_SOCKET."""
+    override = os.environ.get("IMESSAGE_GATEWAY_SOCKET")
+    return Path(override).expanduser() if override else DEFAULT_SOCKET_PATH
+
+
+def daemon_disabled() -> bool:
+    """True when the user has opted out of daemon dispatch."""
+    return os.environ.get("IMESSAGE_GATEWAY_NO_DAEMON", "").lower() in ("1", "true", "yes")
+
+
+# =============================================================================
+# CLIENT
+# =============================================================================
+
+
+class DaemonRequestError(Exception):
+    """The daemon accepted a request but never sent back a valid reply."""
+
+
+def _request(payload: Dict[str, Any], socket_path: Optional[Path] = None,
+             timeout: Optional[float] = None,
+             on_chunk: Optional[Callable[[str], None]] = None) -> Optional[Dict[str, Any]]:
+    """
+    Send one request to the daemon and return the decoded response.
+
+    Args:
+        on_chunk: Called with each streamed {"chunk": ...} frame's text
+            before the final response arrives
+
+    Returns None if no daemon is listening (missing/stale socket), so callers
+    can fall back to in-process execution.
+
+    Raises:
+        DaemonRequestError: The request was sent but the connection failed
+            or closed before a reply. The daemon may have run the command,
+            so callers must not fall back and run it again.
+    """
+    path = Path(socket_path) if socket_path else get_socket_path()
+    if not path.exists():
+        return None
+
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        try:
+            sock.settimeout(CONNECT_TIMEOUT_SECONDS)
+            sock.connect(str(path))
+        except OSError as e:  # Refused, missing or timed out: no daemon
+            logger.debug(f"Daemon not reachable: {e}")
+            return None
+
+        try:
+            # Commands like `index` can run for minutes - no read timeout by default
+            sock.settimeout(timeout)
+            sock.sendall(json.dumps(payload).encode("utf-8") + b"\n")
+
+            with sock.makefile("rb") as reader:
+                while True:
+                    line = reader.readline()
+                    if not line:
+                        raise DaemonRequestError("daemon closed the connection without replying")
+                    response = json.loads(line.decode("utf-8"))
+                    if set(response) != {"chunk"}:
+                        return response
+                    if on_chunk is not None:
+                        on_chunk(response["chunk"])
+        except (OSError, ValueError) as e:
+            raise DaemonRequestError(str(e)) from e
+    finally:
+        sock.close()
+
+
+def run_via_daemon(argv: List[str], socket_path: Optional[Path] = None) -> Optional[int]:
+    """
+    Execute a CLI command through the daemon, replaying its output locally.
+
+    Returns:
+        The command's exit code, or None if no daemon is listening. Once the
+        request is sent, failures are reported on stderr with exit code 1
+        rather than None: the daemon may already have run the command (sent
+        a message, say), and running it again in-process would repeat it.
+    """
+    def relay(chunk: str):
+        sys.stdout.write(chunk)
+        sys.stdout.flush()
+
+    try:
+        response = _request({"op": "run", "argv": list(argv), "stream": True},
+                            socket_path=socket_path, on_chunk=relay)
+    except DaemonRequestError as e:
+        print(f"Gateway daemon failed mid-command: {e}", file=sys.stderr)
+        return 1
+    if response is None:
+        return None
+    if "exit_code" not in response:
+        print("Gateway daemon sent an invalid reply", file=sys.stderr)
+        return 1
+
+    if response.get("stdout"):
+        sys.stdout.write(response["stdout"])
+        sys.stdout.flush()
+    if response.get("stderr"):
+        sys.stderr.write(response["stderr"])
+        sys.stderr.flush()
+    return int(response["exit_code"])
+
+
+def ping(socket_path: Optional[Path] = None) -> Optional[Dict[str, Any]]:
+    """Return daemon status info, or None if it isn't running."""
+    try:
+        return _request({"op": "ping"}, socket_path=socket_path, timeout=2.0)
+    except DaemonRequestError as e:
+        logger.debug(f"Daemon ping failed: {e}")
+        return None
+
+
+def shutdown(socket_path: Optional[Path] = None) -> bool:
+    """Ask a running daemon to exit. Returns True if it acknowledged."""
+    try:
+        response = _request({"op": "shutdown"}, socket_path=socket_path, timeout=2.0)
+    except DaemonRequestError as e:
+        logger.debug(f"Daemon shutdown failed: {e}")
+        return False
+    return bool(response and response.get("ok"))
+
+
+# =============================================================================
+# SERVER
+# =============================================================================
+
+
+class _GatewayRequestHandler(socketserver.StreamRequestHandler):
+    """Handles one newline-delimited JSON request per connection."""
+
+    def handle(self):
+        line = self.rfile.readline(MAX_REQUEST_BYTES)
+        if not line:
+            return
+
+        try:
+            request = json.loads(line.decode("utf-8"))
+        except ValueError:
+            self._reply({"exit_code": 2, "stdout": "", "stderr": "Invalid daemon request\n"})
+            return
+
+        op = request.get("op", "run")
+        if op == "ping":
+            self._reply(self.server.status())
+        elif op == "shutdown":
+            self._reply({"ok": True})
+            # shutdown() blocks until serve_forever exits - must not run on this thread
+            threading.Thread(target=self.server.shutdown, daemon=True).start()
+        elif op == "run":
+            on_stdout = self._send_chunk if request.get("stream") else None
+            self._reply(self.server.execute(request.get("argv") or [], on_stdout=on_stdout))
+        else:
+            self._reply({"exit_code": 2, "stdout": "", "stderr": f"Unknown op: {op}\n"})
+
+    def _reply(self, payload: Dict[str, Any]):
+        try:
+            self.wfile.write(json.dumps(payload, default=str).encode("utf-8") + b"\n")
+        except BrokenPipeError:
+            logger.debug("Client disconnected before reply")
+
+    def _send_chunk(self, text: str):
+        """Relay streamed stdout; raises BrokenPipeError if the client went away."""
+        self.wfile.write(json.dumps({"chunk": text}).encode("utf-8") + b"\n")
+        self.wfile.flush()
+
+
+class _StreamingStdout(io.TextIOBase):
+    """
+    stdout replacement that relays output in chunks while a command runs.
+
+    Text is sent on flush() or once STREAM_CHUNK_CHARS accumulate. If the
+    client disconnects, later output is dropped rather than failing the
+    command (which may be mid-way through sending messages).
+    """
+
+    def __init__(self, send: Callable[[str], None]):
+        self._send = send
+        self._buffer: List[str] = []
+        self._size = 0
+        self._closed_by_peer = False
+
+    def writable(self) -> bool:
+        return True
+
+    def write(self, text: str) -> int:
+        if not self._closed_by_peer:
+            self._buffer.append(text)
+            self._size += len(text)
+            if self._size >= STREAM_CHUNK_CHARS:
+                self.flush()
+        return len(text)
+
+    def flush(self):
+        if not self._buffer or self._closed_by_peer:
+            return
+        text = "".join(self._buffer)
+        self._buffer, self._size = [], 0
+        try:
+            self._send(text)
+        except (BrokenPipeError, ConnectionResetError):
+            logger.debug("Client disconnected mid-stream; discarding further output")
+            self._closed_by_peer = True
+
+    def getvalue(self) -> str:
+        """Unflushed tail, sent with the final reply."""
+        text = "".join(self._buffer)
+        self._buffer, self._size = [], 0
+        return text
+
+
+class GatewayDaemon(socketserver.UnixStreamServer):
+    """
+    Unix socket server that runs gateway commands in-process.
+
+    Requests are handled one at a time on purpose: commands write to the
+    process-wide stdout/stderr (which we redirect per request) and share the
+    cached MessagesInterface/ContactsManager/retriever, so serialising them
+    keeps output isolated without making every command thread-safe.
+    """
+
+    def __init__(self, socket_path: Path, runner: Callable[[List[str]], int],
+                 warmup: Optional[Callable[[], None]] = None):
+        """
+        Args:
+            socket_path: Path to bind the Unix socket at
+            runner: Callable executing a CLI argv in-process, returning exit code
+            warmup: Optional callable run once before serving (preloads state)
+        """
+        self.socket_path = Path(socket_path)
+        self.runner = runner
+        self.started = datetime.now()
+        self.commands_served = 0
+        self._lock = threading.Lock()
+
+        self.socket_path.parent.mkdir(parents=True, exist_ok=True)
+        self._remove_stale_socket()
+
+        super().__init__(str(self.socket_path), _GatewayRequestHandler)
+        # The socket can send messages on the user's behalf - owner only
+        os.chmod(self.socket_path, 0o600)
+
+        if warmup:
+            try:
+                warmup()
+            except Exception as e:
+                logger.warning(f"Daemon warm-up failed (continuing): {e}")
+
+    def _remove_stale_socket(self):
+        """Remove a leftover socket file, refusing if a daemon is still alive."""
+        if not self.socket_path.exists():
+            return
+        if ping(self.socket_path) is not None:
+            raise RuntimeError(f"Gateway daemon already running at {self.socket_path}")
+        self.socket_path.unlink()
+
+    def status(self) -> Dict[str, Any]:
+        return {
+            "ok": True,
+            "pid": os.getpid(),
+            "socket": str(self.socket_path),
+            "started": self.started.isoformat(),
+            "commands": self.commands_served,
+        }
+
+    def execute(self, argv: List[str],
+                on_stdout: Optional[Callable[[str], None]] = None) -> Dict[str, Any]:
+        """
+        Run argv through the runner, capturing its output.
+
+        Args:
+            on_stdout: Receives stdout as the command flushes it (streaming
+                requests); the returned "stdout" is then only the tail
+        """
+        stdout = _StreamingStdout(on_stdout) if on_stdout else io.StringIO()
+        stderr = io.StringIO()
+
+        with self._lock, contextlib.redirect_stdout(stdout), contextlib.redirect_stderr(stderr):
+            try:
+                exit_code = self.runner(argv)
+            except SystemExit as e:
+                # argparse errors and --help exit via SystemExit
+                code = e.code
+                exit_code = code if isinstance(code, int) else (0 if code is None else 1)
+                if isinstance(code, str):
+                    print(code, file=sys.stderr)
+            except Exception as e:
+                logger.exception("Command failed inside daemon")
+                print(f"Error: {e}", file=sys.stderr)
+                exit_code = 1
+            self.commands_served += 1
+
+        return {
+            "exit_code": exit_code if exit_code is not None else 0,
+            "stdout": stdout.getvalue(),
+            "stderr": stderr.getvalue(),
+        }
+
+    def server_close(self):
+        super().server_close()
+        try:
+            self.socket_path.unlink()
+        except FileNotFoundError:
+            pass
+
+
+def serve(runner: Callable[[List[str]], int], socket_path: Optional[Path] = None,
+          warmup: Optional[Callable[[], None]] = None):
+    """Run the daemon in the foreground until shutdown is requested."""
+    path = Path(socket_path) if socket_path else get_socket_path()
+    server = GatewayDaemon(path, runner, warmup=warmup)
+    logger.info(f"Gateway daemon listening on {path} (pid {os.getpid()})")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
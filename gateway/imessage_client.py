@@ -15,46 +15,90 @@ Usage:
     python3 gateway/imessage_client.py unread
     python3 gateway/imessage_client.py send "John" "Running late!"
     python3 gateway/imessage_client.py send-by-phone +14155551234 "Hi"
+    python3 gateway/imessage_client.py send-batch batch.jsonl
     python3 gateway/imessage_client.py contacts
     python3 gateway/imessage_client.py analytics "Sarah" --days 30
     python3 gateway/imessage_client.py search "dinner plans"    # Semantic search (RAG)
     python3 gateway/imessage_client.py index --source=imessage  # Index for RAG
+    python3 gateway/imessage_client.py watch                    # Index new messages live
+    python3 gateway/imessage_client.py daemon start --detach    # Keep gateway resident
 """
 
 import sys
 import argparse
 import json
+import os
 from pathlib import Path
+from typing import TYPE_CHECKING, Optional
 
 # Add parent directory to path for imports
 SCRIPT_DIR = Path(__file__).parent
 REPO_ROOT = SCRIPT_DIR.parent
 sys.path.insert(0, str(REPO_ROOT))
 
-try:
-    from src.messages_interface import MessagesInterface
+# Only stdlib modules are imported eagerly so the thin-client path (forwarding
+# to a running daemon) never pays for src.* imports.
+from gateway.daemon import daemon_disabled, run_via_daemon
+
+if TYPE_CHECKING:
     from src.contacts_manager import ContactsManager
-except ImportError as e:
-    print(f"Error: Could not import modules: {e}")
-    print(f"Make sure you're running from the imessage-mcp repository root")
-    print(f"Expected path: {REPO_ROOT}")
-    sys.exit(1)
 
 # Default config path (relative to repo root)
 CONTACTS_CONFIG = REPO_ROOT / "config" / "contacts.json"
 
+# Commands never forwarded to the daemon
+LOCAL_COMMANDS = ('daemon', 'send-batch', 'watch')
+
 # Valid RAG sources (single source of truth)
 VALID_RAG_SOURCES = ['imessage', 'superwhisper', 'notes', 'local', 'gmail', 'slack', 'calendar']
 
+# Process-wide instances. A one-shot CLI run builds them once; the daemon
+# keeps them resident across commands.
+_interfaces = None
+_contacts_mtime = None
+_retriever = None
+
+
+def _contacts_config_mtime():
+    try:
+        return CONTACTS_CONFIG.stat().st_mtime_ns
+    except OSError:
+        return None
+
 
 def get_interfaces():
-    """Initialize MessagesInterface and ContactsManager."""
-    mi = MessagesInterface()
-    cm = ContactsManager(str(CONTACTS_CONFIG))
-    return mi, cm
+    """
+    Initialize MessagesInterface and ContactsManager (cached per process).
 
+    ContactsManager is reloaded when contacts.json changes on disk, so a
+    long-running daemon picks up `add-contact` or sync_contacts.py edits.
+    """
+    global _interfaces, _contacts_mtime
 
-def resolve_contact(cm: ContactsManager, name: str):
+    try:
+        from src.messages_interface import MessagesInterface
+        from src.contacts_manager import ContactsManager
+        from src.tracing import span, traced
+    except ImportError as e:
+        print(f"Error: Could not import modules: {e}")
+        print(f"Make sure you're running from the imessage-mcp repository root")
+        print(f"Expected path: {REPO_ROOT}")
+        sys.exit(1)
+
+    with span("init"):
+        mtime = _contacts_config_mtime()
+        if _interfaces is None:
+            _interfaces = (MessagesInterface(), ContactsManager(str(CONTACTS_CONFIG)))
+        elif mtime != _contacts_mtime:
+            _interfaces = (_interfaces[0], ContactsManager(str(CONTACTS_CONFIG)))
+        _contacts_mtime = mtime
+
+    # Under --profile, calls are timed as query/contacts (unchanged otherwise)
+    mi, cm = _interfaces
+    return traced(mi, "query"), traced(cm, "contacts")
+
+
+def resolve_contact(cm: "ContactsManager", name: str):
     """Resolve contact name to Contact object using fuzzy matching."""
     contact = cm.get_contact_by_name(name)
     # get_contact_by_name already does partial matching
@@ -63,6 +107,34 @@ def resolve_contact(cm: ContactsManager, name: str):
     return contact
 
 
+def print_json(data, args):
+    """Print data for --json (indented document) or --ndjson (one compact line per item)."""
+    if getattr(args, 'ndjson', False):
+        write_ndjson(data if isinstance(data, list) else [data])
+    else:
+        print(json.dumps(data, indent=2, default=str))
+
+
+def write_ndjson(records, flush_interval=0.1):
+    """
+    Write records as newline-delimited compact JSON while they are produced.
+
+    Output is flushed after the first record and then at most every
+    flush_interval seconds, so a caller (or the daemon relaying stdout)
+    sees the first bytes as soon as they exist without a syscall per line.
+    """
+    import time
+
+    last_flush = None
+    for record in records:
+        sys.stdout.write(json.dumps(record, separators=(',', ':'), default=str) + "\n")
+        now = time.monotonic()
+        if last_flush is None or now - last_flush >= flush_interval:
+            sys.stdout.flush()
+            last_flush = now
+    sys.stdout.flush()
+
+
 def cmd_find(args):
     """Find messages with a contact (keyword search)."""
     mi, cm = get_interfaces()
@@ -75,20 +147,22 @@ def cmd_find(args):
 
     # Use efficient database-level search when query provided
     if args.query:
-        messages = mi.search_messages(query=args.query, phone=contact.phone, limit=args.limit)
+        messages = mi.search_messages(query=args.query, phone=contact.phone, limit=args.limit,
+                                      sort=args.sort)
     else:
         messages = mi.get_messages_by_phone(contact.phone, limit=args.limit)
 
-    if args.json:
-        print(json.dumps(messages, indent=2, default=str))
+    if args.json or args.ndjson:
+        print_json(messages, args)
     else:
         print(f"Messages with {contact.name} ({contact.phone}):")
         print("-" * 60)
 
         for m in messages:
             sender = "Me" if m.get('is_from_me') else contact.name
-            text = m.get('text', '[media/attachment]') or '[media/attachment]'
-            timestamp = m.get('timestamp', '')
+            # Keyword matches show the text around the hit instead of the start
+            text = m.get('match_snippet') or m.get('text') or '[media/attachment]'
+            timestamp = m.get('date') or ''
             print(f"{timestamp} | {sender}: {text[:200]}")
 
     return 0
@@ -105,8 +179,8 @@ def cmd_messages(args):
 
     messages = mi.get_messages_by_phone(contact.phone, limit=args.limit)
 
-    if args.json:
-        print(json.dumps(messages, indent=2, default=str))
+    if args.json or args.ndjson:
+        print_json(messages, args)
     else:
         if not messages:
             print("No messages found.")
@@ -124,10 +198,11 @@ def cmd_recent(args):
     """Get recent conversations across all contacts."""
     mi, _ = get_interfaces()
 
-    conversations = mi.get_all_recent_conversations(limit=args.limit)
+    # One entry per chat, served from the sidecar rollups
+    conversations = mi.list_conversations(limit=args.limit)
 
-    if args.json:
-        print(json.dumps(conversations, indent=2, default=str))
+    if args.json or args.ndjson:
+        print_json(conversations, args)
     else:
         if not conversations:
             print("No recent conversations found.")
@@ -136,10 +211,12 @@ def cmd_recent(args):
         print("Recent Conversations:")
         print("-" * 60)
         for conv in conversations:
-            handle = conv.get('handle_id', 'Unknown')
+            handle = conv.get('display_name') or conv.get('handle_id', 'Unknown')
             last_msg = conv.get('last_message', '')[:80]
             timestamp = conv.get('last_message_date', '')
-            print(f"{handle}: {last_msg} ({timestamp})")
+            unread = conv.get('unread_count', 0)
+            unread_note = f" [{unread} unread]" if unread else ""
+            print(f"{handle}: {last_msg} ({timestamp}){unread_note}")
 
     return 0
 
@@ -150,8 +227,8 @@ def cmd_unread(args):
 
     messages = mi.get_unread_messages(limit=args.limit)
 
-    if args.json:
-        print(json.dumps(messages, indent=2, default=str))
+    if args.json or args.ndjson:
+        print_json(messages, args)
     else:
         if not messages:
             print("No unread messages.")
@@ -217,6 +294,110 @@ def cmd_send_by_phone(args):
         return 1
 
 
+def _read_send_batch(source: str):
+    """Parse a JSON array or JSON Lines of {"to": ..., "text": ...} objects."""
+    raw = sys.stdin.read() if source == '-' else Path(source).read_text()
+    stripped = raw.strip()
+    if stripped.startswith('['):
+        items = json.loads(stripped)
+    else:
+        items = [json.loads(line) for line in stripped.splitlines() if line.strip()]
+    for number, item in enumerate(items, 1):
+        if not isinstance(item, dict):
+            raise ValueError(f'entry {number} is {type(item).__name__}, expected an object like {{"to": ..., "text": ...}}')
+    return items
+
+
+def _looks_like_handle(value: str) -> bool:
+    return '@' in value or sum(c.isdigit() for c in value) >= 5
+
+
+def cmd_send_batch(args):
+    """Send many messages through the batched send queue."""
+    try:
+        items = _read_send_batch(args.file)
+    except (OSError, ValueError) as e:
+        print(f"Could not read batch: {e}", file=sys.stderr)
+        return 1
+
+    mi, cm = get_interfaces()
+
+    # Resolve recipients up front; unresolved entries are reported, not sent.
+    # Names must match a contact exactly: nobody is watching to catch a
+    # partial match ("Jo") that picked someone else.
+    results = [None] * len(items)
+    pending = []  # (item index, handle, text)
+    names = {}  # item index -> resolved contact name
+    for i, item in enumerate(items):
+        to, text = str(item.get('to', '')).strip(), item.get('text')
+        if not to or not text:
+            results[i] = {"to": to, "success": False, "error": "Entry needs 'to' and 'text'"}
+            continue
+        if _looks_like_handle(to):
+            handle = to if '@' in to else to.translate(str.maketrans('', '', ' ()-.'))
+            contact = cm.resolve_handles([handle])[handle]
+        else:
+            contact = cm.get_contact_by_exact_name(to)
+            if not contact:
+                closest = cm.get_contact_by_name(to)
+                error = "Contact not found"
+                if closest:
+                    error = (f"No contact named exactly '{to}' (closest: {closest.name}); "
+                             f"use the full name or a number")
+                results[i] = {"to": to, "success": False, "error": error}
+                continue
+            handle = contact.phone
+        if contact:
+            names[i] = contact.name
+        pending.append((i, handle, text))
+
+    def recipient(index, handle):
+        return f"{names[index]} ({handle})" if index in names else handle
+
+    if args.dry_run:
+        for i, handle, text in pending:
+            results[i] = {"to": items[i]['to'], "contact": names.get(i), "handle": handle,
+                          "success": None, "error": None, "dry_run": True}
+    else:
+        def report(position, result):
+            if not args.json:
+                index, handle, _ = pending[position]
+                if result['success']:
+                    status = "sent"
+                elif result.get('possibly_sent'):
+                    status = f"UNKNOWN, may have been sent: {result['error']}"
+                else:
+                    status = f"FAILED: {result['error']}"
+                print(f"  [{index + 1}/{len(items)}] {recipient(index, handle)}: {status}", file=sys.stderr)
+
+        sent = mi.send_messages(
+            [(handle, text) for _, handle, text in pending],
+            concurrency=args.concurrency,
+            on_result=report,
+        )
+        for (i, _, _), result in zip(pending, sent):
+            results[i] = {"to": items[i]['to'], "contact": names.get(i), **result}
+
+    failed = sum(1 for r in results if r['success'] is False)
+    unknown = sum(1 for r in results if r.get('possibly_sent'))
+    if args.json:
+        print(json.dumps({"results": results, "total": len(results), "failed": failed,
+                          "possibly_sent": unknown}, indent=2))
+    else:
+        for r in results:
+            if r.get('dry_run'):
+                print(f"  {r['to']} -> {r['contact'] or 'unknown contact'} ({r['handle']})", file=sys.stderr)
+            elif 'handle' not in r:  # Never reached the send queue
+                print(f"  {r['to']}: {r['error']}", file=sys.stderr)
+        verb = "Would send" if args.dry_run else "Sent"
+        sent = len(pending) if args.dry_run else sum(1 for r in results if r['success'])
+        print(f"{verb} {sent} of {len(items)} messages ({failed} failed)", file=sys.stderr)
+        if unknown:
+            print(f"{unknown} of the failed may have been sent - check Messages before retrying them",
+                  file=sys.stderr)
+    return 1 if failed else 0
+
+
 def cmd_contacts(args):
     """List all contacts."""
     _, cm = get_interfaces()
@@ -282,6 +463,12 @@ def cmd_followup(args):
         print("Follow-ups Needed:")
         print("-" * 60)
 
+        names = cm.resolve_handles(
+            item['phone']
+            for items in followups.values() if isinstance(items, list)
+            for item in items if item.get('phone')
+        )
+
         # Iterate through categories (skip metadata keys)
         for category, items in followups.items():
             if category in ("summary", "analysis_period_days"):
@@ -292,7 +479,7 @@ def cmd_followup(args):
             print(f"\n--- {category.replace('_', ' ').title()} ---")
             for item in items:
                 phone = item.get('phone')
-                contact = cm.get_contact_by_phone(phone) if phone else None
+                contact = names.get(phone) if phone else None
                 name = contact.name if contact else phone or "Unknown"
                 text = item.get('text') or item.get('last_message', '')
                 date = item.get('date', '')
@@ -345,8 +532,8 @@ def cmd_group_messages(args):
         limit=args.limit
     )
 
-    if args.json:
-        print(json.dumps(messages, indent=2, default=str))
+    if args.json or args.ndjson:
+        print_json(messages, args)
     else:
         if not messages:
             print("No group messages found.")
@@ -363,6 +550,13 @@ def cmd_group_messages(args):
     return 0
 
 
+def print_next_page_hint(items, limit, rowid_key):
+    """After a full page, show the --before-rowid value that fetches the next one."""
+    if len(items) >= limit:
+        cursor = min(item[rowid_key] for item in items)
+        print(f"\nMore available: --before-rowid {cursor}")
+
+
 def cmd_attachments(args):
     """Get attachments (photos, videos, files) from messages."""
     mi, cm = get_interfaces()
@@ -378,11 +572,12 @@ def cmd_attachments(args):
     attachments = mi.get_attachments(
         phone=phone,
         mime_type_filter=args.type,
-        limit=args.limit
+        limit=args.limit,
+        before_rowid=args.before_rowid
     )
 
-    if args.json:
-        print(json.dumps(attachments, indent=2, default=str))
+    if args.json or args.ndjson:
+        print_json(attachments, args)
     else:
         if not attachments:
             print("No attachments found.")
@@ -397,6 +592,7 @@ def cmd_attachments(args):
             size_str = f"{size / 1024:.1f}KB" if size else "N/A"
             date = a.get('message_date', '')
             print(f"{filename} ({mime}, {size_str}) - {date}")
+        print_next_page_hint(attachments, args.limit, 'message_rowid')
 
     return 0
 
@@ -436,6 +632,24 @@ def cmd_reactions(args):
             return 1
         phone = contact.phone
 
+    if args.summary:
+        summary = mi.get_reaction_summary(phone=phone, days=args.days)
+        if args.json:
+            print(json.dumps(summary, indent=2, default=str))
+            return 0
+        print(f"Reactions (last {args.days} days): {summary.get('total_reactions', 0)} "
+              f"({summary.get('given', 0)} given, {summary.get('received', 0)} received)")
+        print("-" * 60)
+        for name, count in summary.get('by_type', {}).items():
+            print(f"  {name}: {count}")
+        reactors = summary.get('top_reactors', [])
+        names = cm.resolve_handles(r['handle'] for r in reactors)
+        for reactor in reactors:
+            contact = names.get(reactor['handle'])
+            name = contact.name if contact else reactor['handle']
+            print(f"  from {name}: {reactor['reaction_count']}")
+        return 0
+
     reactions = mi.get_reactions(phone=phone, limit=args.limit)
 
     if args.json:
@@ -470,10 +684,10 @@ def cmd_links(args):
         phone = contact.phone
 
     days = None if getattr(args, "all_time", False) else (args.days if args.days is not None else 30)
-    links = mi.extract_links(phone=phone, days=days, limit=args.limit)
+    links = mi.extract_links(phone=phone, days=days, limit=args.limit, before_rowid=args.before_rowid)
 
-    if args.json:
-        print(json.dumps(links, indent=2, default=str))
+    if args.json or args.ndjson:
+        print_json(links, args)
     else:
         if not links:
             print("No links found.")
@@ -487,6 +701,7 @@ def cmd_links(args):
             date = link.get('date', '')
             print(f"{url}")
             print(f"  From: {sender} ({date})")
+        print_next_page_hint(links, args.limit, 'rowid')
 
     return 0
 
@@ -503,10 +718,10 @@ def cmd_voice(args):
             return 1
         phone = contact.phone
 
-    voice_msgs = mi.get_voice_messages(phone=phone, limit=args.limit)
+    voice_msgs = mi.get_voice_messages(phone=phone, limit=args.limit, before_rowid=args.before_rowid)
 
-    if args.json:
-        print(json.dumps(voice_msgs, indent=2, default=str))
+    if args.json or args.ndjson:
+        print_json(voice_msgs, args)
     else:
         if not voice_msgs:
             print("No voice messages found.")
@@ -522,6 +737,7 @@ def cmd_voice(args):
             date = v.get('date', '')
             print(f"{path}")
             print(f"  From: {sender}, Size: {size_str}, Date: {date}")
+        print_next_page_hint(voice_msgs, args.limit, 'message_rowid')
 
     return 0
 
@@ -588,11 +804,12 @@ def cmd_unknown(args):
     """Find messages from senders not in contacts."""
     mi, cm = get_interfaces()
 
-    known_phones = [c.phone for c in cm.contacts]
+    # Handles are resolved through cm's indexes, so no phone list is needed
     unknown = mi.search_unknown_senders(
-        known_phones=known_phones,
+        known_phones=[],
         days=args.days,
-        limit=args.limit
+        limit=args.limit,
+        contacts=cm
     )
 
     if args.json:
@@ -653,10 +870,21 @@ def cmd_summary(args):
         print(f"Contact '{args.contact}' not found.", file=sys.stderr)
         return 1
 
+    if args.ndjson:
+        # Lines go out as rows are decoded; the stats record comes last
+        write_ndjson(mi.iter_conversation_for_summary(
+            phone=contact.phone,
+            days=args.days,
+            limit=args.limit,
+            max_tokens=args.max_tokens
+        ))
+        return 0
+
     summary = mi.get_conversation_for_summary(
         phone=contact.phone,
         days=args.days,
-        limit=args.limit
+        limit=args.limit,
+        max_tokens=args.max_tokens
     )
 
     if args.json:
@@ -677,6 +905,8 @@ def cmd_summary(args):
         print(summary.get('conversation_text', '')[:2000])
         if len(summary.get('conversation_text', '')) > 2000:
             print("... (truncated, use --json for full output)")
+        elif summary.get('truncated'):
+            print(f"... (older messages omitted to fit --max-tokens {args.max_tokens})")
 
     return 0
 
@@ -687,9 +917,15 @@ def cmd_summary(args):
 
 
 def get_unified_retriever():
-    """Get UnifiedRetriever instance (lazy import for faster startup)."""
-    from src.rag.unified import UnifiedRetriever
-    return UnifiedRetriever()
+    """Get UnifiedRetriever instance (lazy import, cached per process)."""
+    global _retriever
+    if _retriever is None:
+        from src.tracing import span
+
+        with span("init"):
+            from src.rag.unified import UnifiedRetriever
+            _retriever = UnifiedRetriever()
+    return _retriever
 
 
 def cmd_index(args):
@@ -708,10 +944,9 @@ def cmd_index(args):
         if source == 'imessage':
             # iMessage needs MessagesInterface and ContactsManager
             mi, cm = get_interfaces()
-            from src.rag.unified import UnifiedRetriever
             from src.rag.unified.imessage_indexer import ImessageIndexer
 
-            retriever = UnifiedRetriever()
+            retriever = get_unified_retriever()
             indexer = ImessageIndexer(
                 messages_interface=mi,
                 contacts_manager=cm,
@@ -725,10 +960,14 @@ def cmd_index(args):
             )
         elif source == 'superwhisper':
             retriever = get_unified_retriever()
-            result = retriever.index_superwhisper(days=args.days, limit=args.limit)
+            result = retriever.index_superwhisper(
+                days=args.days, limit=args.limit, incremental=not args.full
+            )
         elif source == 'notes':
             retriever = get_unified_retriever()
-            result = retriever.index_notes(days=args.days, limit=args.limit)
+            result = retriever.index_notes(
+                days=args.days, limit=args.limit, incremental=not args.full
+            )
         elif source == 'local':
             retriever = get_unified_retriever()
             result = retriever.index_local_sources(days=args.days)
@@ -763,6 +1002,61 @@ def cmd_index(args):
         return 1
 
 
+def cmd_watch(args):
+    """Keep sidecars and the iMessage RAG index current as messages arrive."""
+    import time
+    from src.chat_watcher import ChatDBWatcher
+
+    mi, cm = get_interfaces()
+    indexer = None
+    if not args.no_rag:
+        try:
+            from src.rag.unified.imessage_indexer import ImessageIndexer
+
+            indexer = ImessageIndexer(
+                messages_interface=mi,
+                contacts_manager=cm,
+                store=get_unified_retriever().store,
+            )
+        except Exception as e:
+            print(f"RAG indexing disabled: {e}", file=sys.stderr)
+
+    def on_change():
+        start = time.time()
+        sidecars = mi.sync_sidecars()
+        event = {"sidecars": sidecars}
+        if indexer is not None:
+            # Resumes from the ROWID cursor, so only new rows are read and chunked
+            result = indexer.index(incremental=True)
+            event["messages_processed"] = result.get("messages_processed", 0)
+            event["chunks_indexed"] = result.get("chunks_indexed", 0)
+            if not result.get("success"):
+                event["error"] = result.get("error")
+        event["elapsed_seconds"] = round(time.time() - start, 3)
+
+        if args.json:
+            print(json.dumps(event), flush=True)
+        elif "messages_processed" in event:
+            print(f"Synced: {event['messages_processed']} new messages, "
+                  f"{event['chunks_indexed']} chunks ({event['elapsed_seconds']:.1f}s)", flush=True)
+        else:
+            print(f"Synced sidecars ({event['elapsed_seconds']:.1f}s)", flush=True)
+
+    watcher = ChatDBWatcher(
+        mi.messages_db_path,
+        on_change,
+        poll_interval=args.interval,
+        debounce=args.debounce,
+    )
+    if not args.json:
+        print(f"Watching {mi.messages_db_path} (Ctrl-C to stop)", file=sys.stderr)
+    try:
+        watcher.run()
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
 def cmd_search(args):
     """Semantic search across indexed knowledge base."""
     try:
@@ -778,6 +1072,7 @@ def cmd_search(args):
             sources=sources,
             limit=args.limit,
             days=args.days,
+            mode=args.mode,
         )
 
         if args.json:
@@ -822,6 +1117,7 @@ def cmd_ask(args):
             sources=sources,
             limit=args.limit,
             days=args.days,
+            mode=args.mode,
         )
 
         if args.json:
@@ -836,11 +1132,27 @@ def cmd_ask(args):
         return 1
 
 
+def get_embedding_cache_stats(retriever=None) -> Optional[dict]:
+    """Embedding cache stats, preferring the retriever's live cache instance."""
+    # loaded_embedder never creates one: stats must not load a backend
+    embedder = getattr(getattr(retriever, 'store', None), 'loaded_embedder', None)
+    if embedder is not None:
+        return embedder.cache_stats()
+
+    from src.rag.embedding_cache import DEFAULT_CACHE_PATH, EmbeddingCache
+    if not DEFAULT_CACHE_PATH.exists():
+        return None
+    return EmbeddingCache().stats()
+
+
 def cmd_stats(args):
     """Show statistics about the indexed knowledge base."""
     try:
         retriever = get_unified_retriever()
         stats = retriever.get_stats(source=args.source)
+        cache_stats = get_embedding_cache_stats(retriever)
+        if cache_stats:
+            stats['embedding_cache'] = cache_stats
 
         if args.json:
             print(json.dumps(stats, indent=2, default=str))
@@ -871,6 +1183,15 @@ def cmd_stats(args):
                         newest = info.get('newest', 'N/A')[:10] if info.get('newest') else 'N/A'
                         print(f"  {src}: {count} chunks ({oldest} to {newest})")
 
+            if cache_stats:
+                rate = cache_stats.get('lifetime_hit_rate')
+                rate_str = f"{rate:.0%}" if rate is not None else "n/a"
+                print("\nEmbedding Cache:")
+                print(f"  {cache_stats['entries']} vectors "
+                      f"({cache_stats['vector_bytes'] / 1_000_000:.1f} MB)")
+                print(f"  Hit rate: {rate_str} "
+                      f"({cache_stats['lifetime_hits']} hits / {cache_stats['lifetime_misses']} misses)")
+
         return 0
 
     except Exception as e:
@@ -917,9 +1238,9 @@ def cmd_sources(args):
         retriever = get_unified_retriever()
 
         available = retriever.list_sources()
-        indexed = retriever.get_indexed_sources()
         stats = retriever.get_stats()
         by_source = stats.get('by_source', {})
+        indexed = [src for src, info in by_source.items() if info.get('chunk_count', 0) > 0]
 
         if args.json:
             result = {
@@ -950,7 +1271,93 @@ def cmd_sources(args):
         return 1
 
 
-def main():
+# =============================================================================
+# DAEMON COMMANDS - Resident Gateway
+# =============================================================================
+
+
+def _warm_daemon(include_rag: bool):
+    """Preload state the daemon keeps resident between commands."""
+    mi, cm = get_interfaces()
+    print(f"Loaded {len(cm.contacts)} contacts", file=sys.stderr)
+
+    if include_rag:
+        try:
+            retriever = get_unified_retriever()
+            retriever.store.warm_up()
+            print("Loaded vector store and embedder", file=sys.stderr)
+        except Exception as e:
+            # RAG deps are optional - core commands still benefit from the daemon
+            print(f"RAG not preloaded: {e}", file=sys.stderr)
+
+
+def cmd_daemon(args):
+    """Start, stop, or query the resident gateway daemon."""
+    from gateway import daemon
+
+    socket_path = daemon.get_socket_path()
+
+    if args.action == 'status':
+        info = daemon.ping(socket_path)
+        if args.json:
+            print(json.dumps(info or {"ok": False, "socket": str(socket_path)}, indent=2))
+        elif info:
+            print(f"Daemon running (pid {info['pid']}) at {info['socket']}")
+            print(f"  Started: {info['started']}")
+            print(f"  Commands served: {info['commands']}")
+        else:
+            print(f"Daemon not running ({socket_path})")
+        return 0 if info else 1
+
+    if args.action == 'stop':
+        if daemon.shutdown(socket_path):
+            print("Daemon stopped")
+            return 0
+        print("Daemon not running", file=sys.stderr)
+        return 1
+
+    # start
+    if daemon.ping(socket_path):
+        print(f"Daemon already running at {socket_path}", file=sys.stderr)
+        return 1
+
+    if args.detach:
+        import subprocess
+        import time
+
+        cmd = [sys.executable, str(Path(__file__).resolve()), 'daemon', 'start']
+        if args.no_rag:
+            cmd.append('--no-rag')
+        subprocess.Popen(
+            cmd,
+            stdin=subprocess.DEVNULL,
+            stdout=subprocess.DEVNULL,
+            stderr=subprocess.DEVNULL,
+            start_new_session=True,
+        )
+        # Wait for the socket so the next command is guaranteed to hit the daemon
+        deadline = time.time() + 30
+        while time.time() < deadline:
+            info = daemon.ping(socket_path)
+            if info:
+                print(f"Daemon started (pid {info['pid']}) at {socket_path}")
+                return 0
+            time.sleep(0.1)
+        print("Daemon did not come up within 30s", file=sys.stderr)
+        return 1
+
+    import logging
+    logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(levelname)s - %(message)s')
+    print(f"Starting gateway daemon on {socket_path} (Ctrl-C to stop)", file=sys.stderr)
+    daemon.serve(
+        runner=run_command,
+        socket_path=socket_path,
+        warmup=lambda: _warm_daemon(include_rag=not args.no_rag),
+    )
+    return 0
+
+
+def build_parser():
     parser = argparse.ArgumentParser(
         description="iMessage Gateway - Standalone CLI for iMessage operations",
         formatter_class=argparse.RawDescriptionHelpFormatter,
@@ -962,10 +1369,12 @@ Examples:
   %(prog)s unread                          Show unread messages
   %(prog)s send "John" "Running late!"     Send message to John
   %(prog)s send-by-phone +14155551234 "Hi" Send directly to phone number
+  %(prog)s send-batch batch.jsonl          Send many messages ({"to", "text"} per line)
   %(prog)s contacts                        List all contacts
   %(prog)s followup --days 7               Find messages needing follow-up
   %(prog)s search "dinner plans"           Semantic search across indexed messages
   %(prog)s index --source=imessage         Index iMessages for semantic search
+  %(prog)s daemon start --detach           Keep the gateway resident (faster calls)
         """
     )
 
@@ -977,7 +1386,11 @@ Examples:
     p_find.add_argument('--query', '-q', help='Text to search for in messages')
     p_find.add_argument('--limit', '-l', type=int, default=30, choices=range(1, 501), metavar='N',
                         help='Max messages to return (1-500, default: 30)')
+    p_find.add_argument('--sort', choices=['recent', 'relevance'], default='recent',
+                        help='With --query: order by date or by match relevance (default: recent)')
     p_find.add_argument('--json', action='store_true', help='Output as JSON')
+    p_find.add_argument('--ndjson', action='store_true',
+                        help='Stream one compact JSON object per line')
     p_find.set_defaults(func=cmd_find)
 
     # messages command
@@ -986,6 +1399,8 @@ Examples:
     p_messages.add_argument('--limit', '-l', type=int, default=20, choices=range(1, 501), metavar='N',
                             help='Max messages (1-500, default: 20)')
     p_messages.add_argument('--json', action='store_true', help='Output as JSON')
+    p_messages.add_argument('--ndjson', action='store_true',
+                            help='Stream one compact JSON object per line')
     p_messages.set_defaults(func=cmd_messages)
 
     # recent command
@@ -993,6 +1408,8 @@ Examples:
     p_recent.add_argument('--limit', '-l', type=int, default=10, choices=range(1, 501), metavar='N',
                           help='Max conversations (1-500, default: 10)')
     p_recent.add_argument('--json', action='store_true', help='Output as JSON')
+    p_recent.add_argument('--ndjson', action='store_true',
+                          help='Stream one compact JSON object per line')
     p_recent.set_defaults(func=cmd_recent)
 
     # unread command
@@ -1000,6 +1417,8 @@ Examples:
     p_unread.add_argument('--limit', '-l', type=int, default=20, choices=range(1, 501), metavar='N',
                           help='Max messages (1-500, default: 20)')
     p_unread.add_argument('--json', action='store_true', help='Output as JSON')
+    p_unread.add_argument('--ndjson', action='store_true',
+                          help='Stream one compact JSON object per line')
     p_unread.set_defaults(func=cmd_unread)
 
     # send command
@@ -1015,6 +1434,14 @@ Examples:
     p_send_phone.add_argument('--json', action='store_true', help='Output as JSON')
     p_send_phone.set_defaults(func=cmd_send_by_phone)
 
+    # send-batch command
+    p_send_batch = subparsers.add_parser('send-batch', help='Send many messages from a JSON/JSONL file')
+    p_send_batch.add_argument('file', help='JSON array or JSON Lines of {"to": ..., "text": ...}; "-" for stdin')
+    p_send_batch.add_argument('--concurrency', type=int, default=2, help='osascript processes in flight (default: 2)')
+    p_send_batch.add_argument('--dry-run', action='store_true', help='Resolve recipients without sending')
+    p_send_batch.add_argument('--json', action='store_true', help='Output as JSON')
+    p_send_batch.set_defaults(func=cmd_send_batch)
+
     # contacts command
     p_contacts = subparsers.add_parser('contacts', help='List all contacts')
     p_contacts.add_argument('--json', action='store_true', help='Output as JSON')
@@ -1055,6 +1482,8 @@ Examples:
     p_group_msg.add_argument('--limit', '-l', type=int, default=50, choices=range(1, 501), metavar='N',
                              help='Max messages (1-500, default: 50)')
     p_group_msg.add_argument('--json', action='store_true', help='Output as JSON')
+    p_group_msg.add_argument('--ndjson', action='store_true',
+                             help='Stream one compact JSON object per line')
     p_group_msg.set_defaults(func=cmd_group_messages)
 
     # attachments command
@@ -1063,7 +1492,11 @@ Examples:
     p_attach.add_argument('--type', '-t', help='MIME type filter (e.g., "image/", "video/")')
     p_attach.add_argument('--limit', '-l', type=int, default=50, choices=range(1, 501), metavar='N',
                           help='Max attachments (1-500, default: 50)')
+    p_attach.add_argument('--before-rowid', type=int, metavar='ROWID',
+                          help='Next page: only messages older than this ROWID')
     p_attach.add_argument('--json', action='store_true', help='Output as JSON')
+    p_attach.add_argument('--ndjson', action='store_true',
+                          help='Stream one compact JSON object per line')
     p_attach.set_defaults(func=cmd_attachments)
 
     # add-contact command
@@ -1085,6 +1518,10 @@ Examples:
     p_react.add_argument('contact', nargs='?', help='Contact name (optional)')
     p_react.add_argument('--limit', '-l', type=int, default=100, choices=range(1, 501), metavar='N',
                          help='Max reactions (1-500, default: 100)')
+    p_react.add_argument('--summary', action='store_true',
+                         help='Show counts by type and reactor instead of individual reactions')
+    p_react.add_argument('--days', '-d', type=int, default=30, choices=range(1, 366), metavar='N',
+                         help='Days to summarize with --summary (1-365, default: 30)')
     p_react.add_argument('--json', action='store_true', help='Output as JSON')
     p_react.set_defaults(func=cmd_reactions)
 
@@ -1097,7 +1534,11 @@ Examples:
                          help='Search without date cutoff (can be slow)')
     p_links.add_argument('--limit', '-l', type=int, default=100, choices=range(1, 501), metavar='N',
                          help='Max links (1-500, default: 100)')
+    p_links.add_argument('--before-rowid', type=int, metavar='ROWID',
+                         help='Next page: only messages older than this ROWID')
     p_links.add_argument('--json', action='store_true', help='Output as JSON')
+    p_links.add_argument('--ndjson', action='store_true',
+                         help='Stream one compact JSON object per line')
     p_links.set_defaults(func=cmd_links)
 
     # voice command
@@ -1105,7 +1546,11 @@ Examples:
     p_voice.add_argument('contact', nargs='?', help='Contact name (optional)')
     p_voice.add_argument('--limit', '-l', type=int, default=50, choices=range(1, 501), metavar='N',
                          help='Max voice messages (1-500, default: 50)')
+    p_voice.add_argument('--before-rowid', type=int, metavar='ROWID',
+                         help='Next page: only messages older than this ROWID')
     p_voice.add_argument('--json', action='store_true', help='Output as JSON')
+    p_voice.add_argument('--ndjson', action='store_true',
+                         help='Stream one compact JSON object per line')
     p_voice.set_defaults(func=cmd_voice)
 
     # thread command
@@ -1150,7 +1595,11 @@ Examples:
                            help='Days to include (1-365)')
     p_summary.add_argument('--limit', '-l', type=int, default=200, choices=range(1, 501), metavar='N',
                            help='Max messages (1-500, default: 200)')
+    p_summary.add_argument('--max-tokens', type=int, metavar='N',
+                           help='Keep the newest ~N tokens of conversation text')
     p_summary.add_argument('--json', action='store_true', help='Output as JSON')
+    p_summary.add_argument('--ndjson', action='store_true',
+                           help='Stream one compact JSON object per line')
     p_summary.set_defaults(func=cmd_summary)
 
     # =========================================================================
@@ -1173,6 +1622,17 @@ Examples:
     p_index.add_argument('--json', action='store_true', help='Output as JSON')
     p_index.set_defaults(func=cmd_index)
 
+    # watch command
+    p_watch = subparsers.add_parser('watch', help='Index new messages as they arrive')
+    p_watch.add_argument('--interval', type=float, default=1.0,
+                         help='Seconds between chat.db checks (default: 1)')
+    p_watch.add_argument('--debounce', type=float, default=2.0,
+                         help='Seconds of quiet before syncing a burst (default: 2)')
+    p_watch.add_argument('--no-rag', action='store_true',
+                         help='Only sync the keyword index and rollups')
+    p_watch.add_argument('--json', action='store_true', help='Output one JSON line per sync')
+    p_watch.set_defaults(func=cmd_watch)
+
     # search command (semantic search)
     p_search = subparsers.add_parser('search', help='Semantic search across indexed content')
     p_search.add_argument('query', help='Search query')
@@ -1181,6 +1641,9 @@ Examples:
                           help='Only search content from last N days')
     p_search.add_argument('--limit', '-l', type=int, default=10,
                           help='Max results (default: 10)')
+    p_search.add_argument('--mode', choices=['hybrid', 'semantic', 'keyword'], default='hybrid',
+                          help='hybrid = vector + keyword fused (default), semantic = vector only, '
+                               'keyword = exact terms (names, URLs, codes)')
     p_search.add_argument('--json', action='store_true', help='Output as JSON')
     p_search.set_defaults(func=cmd_search)
 
@@ -1192,6 +1655,8 @@ Examples:
                        help='Only search content from last N days')
     p_ask.add_argument('--limit', '-l', type=int, default=5,
                        help='Max results to include (default: 5)')
+    p_ask.add_argument('--mode', choices=['hybrid', 'semantic', 'keyword'], default='hybrid',
+                       help='Search mode (default: hybrid)')
     p_ask.add_argument('--json', action='store_true', help='Output as JSON')
     p_ask.set_defaults(func=cmd_ask)
 
@@ -1214,14 +1679,99 @@ Examples:
     p_sources.add_argument('--json', action='store_true', help='Output as JSON')
     p_sources.set_defaults(func=cmd_sources)
 
-    args = parser.parse_args()
+    # =========================================================================
+    # DAEMON COMMANDS - Resident Gateway
+    # =========================================================================
+
+    # daemon command
+    p_daemon = subparsers.add_parser('daemon', help='Run a resident gateway to skip per-command startup')
+    p_daemon.add_argument('action', choices=['start', 'stop', 'status'], help='Daemon action')
+    p_daemon.add_argument('--detach', action='store_true',
+                          help='With start: run in the background')
+    p_daemon.add_argument('--no-rag', action='store_true',
+                          help='With start: do not preload the vector store/embedder')
+    p_daemon.add_argument('--json', action='store_true', help='Output as JSON')
+    p_daemon.set_defaults(func=cmd_daemon)
+
+    # Profiling flags, accepted by every command that runs to completion
+    for name, command_parser in subparsers.choices.items():
+        if name in ('daemon', 'watch'):
+            continue
+        command_parser.add_argument('--profile', action='store_true',
+                                    help='Print a per-stage timing breakdown to stderr')
+        command_parser.add_argument('--metrics-file', metavar='PATH',
+                                    help='Append per-stage timings to a JSONL file (BenchmarkResult records)')
+
+    return parser
+
+
+def run_command(argv):
+    """Parse argv and execute the command in this process."""
+    parser = build_parser()
+    args = parser.parse_args(argv)
 
     if not args.command:
         parser.print_help()
         return 1
 
+    if getattr(args, 'profile', False) or getattr(args, 'metrics_file', None):
+        return run_profiled(args)
     return args.func(args)
 
 
+def run_profiled(args):
+    """
+    Run a parsed command under a trace.
+
+    Stages: init (imports, interface setup), connect, query (time inside
+    MessagesInterface), sync (sidecar catch-up), decode, contacts, embed,
+    store, keyword, plus indexing stages for `index`; time spent in the
+    command itself (formatting and printing) is reported as format.
+    The record deliberately omits argv, which may hold names or message text.
+    """
+    from src.tracing import append_metrics, trace
+
+    with trace(args.command, root_stage="format") as profile:
+        exit_code = args.func(args)
+
+    if args.profile:
+        print(profile.format_report(), file=sys.stderr)
+    if args.metrics_file:
+        append_metrics(args.metrics_file, profile.to_benchmark_record(
+            name=f"cmd_{args.command}", command=args.command, exit_code=exit_code or 0,
+        ))
+    return exit_code
+
+
+def absolute_path_args(argv):
+    """
+    Rewrite --metrics-file paths relative to this process's cwd.
+
+    The daemon has its own working directory, so a relative path forwarded
+    as-is would be written somewhere the caller never looks.
+    """
+    out = list(argv)
+    for i, arg in enumerate(out):
+        if arg == '--metrics-file' and i + 1 < len(out):
+            out[i + 1] = os.path.abspath(os.path.expanduser(out[i + 1]))
+        elif arg.startswith('--metrics-file='):
+            out[i] = '--metrics-file=' + os.path.abspath(os.path.expanduser(arg.split('=', 1)[1]))
+    return out
+
+
+def main(argv=None):
+    argv = sys.argv[1:] if argv is None else list(argv)
+
+    # Thin-client path: hand off to a resident daemon when one is listening.
+    # `daemon` itself always runs locally, as do `send-batch`, which reads
+    # its input from a local path or stdin, and the long-running `watch`.
+    if argv and argv[0] not in LOCAL_COMMANDS and not daemon_disabled():
+        exit_code = run_via_daemon(absolute_path_args(argv))
+        if exit_code is not None:
+            return exit_code
+
+    return run_command(argv)
+
+
 if __name__ == '__main__':
     sys.exit(main())
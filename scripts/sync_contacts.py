@@ -22,6 +22,7 @@ sys.path.insert(0, str(Path(__file__).parent.parent))
 from src.contacts_sync import (
     MacOSContactsReader,
     MacOSContact,
+    match_contacts,
     normalize_phone_number
 )
 
@@ -133,45 +134,47 @@ def sync_contacts(
             logger.warning(f"Could not load existing contacts: {e}")
 
     # Merge contacts
-    # Strategy: Keep existing contacts, add new ones, update changed ones
-    merged_contacts = {}
-
-    # Add existing contacts (keyed by macOS ID or name)
-    for contact in existing_contacts:
-        key = contact.get("macos_contact_id") or contact["name"]
-        merged_contacts[key] = contact
-
-    # Update/add new contacts
-    for contact in new_contacts:
-        key = contact.get("macos_contact_id") or contact["name"]
-
-        if key in merged_contacts:
+    # Strategy: Keep existing contacts, add new ones, update changed ones.
+    # Pairs are found by contact ID, then exact phone, then exact name; those
+    # update the entry. A fuzzy name pair may be a different person ("John"
+    # vs "John Smith"), so it is only reported and the contact added as new.
+    final_contacts = list(existing_contacts)
+    pairs = match_contacts(new_contacts, existing_contacts)
+    suggestions = 0
+
+    for i, contact in enumerate(new_contacts):
+        j, kind = pairs.get(i, (None, None))
+        if kind in ("id", "phone", "name"):
             # Update existing contact (preserve manual fields)
-            existing = merged_contacts[key]
+            existing = existing_contacts[j]
 
             # Update phone and emails from macOS
             existing["phone"] = contact["phone"]
             existing["all_phones"] = contact["all_phones"]
             existing["emails"] = contact["emails"]
 
-            # Update name if changed
+            # Update name if changed; remember the ID so the next sync joins on it
             existing["name"] = contact["name"]
+            existing["macos_contact_id"] = contact["macos_contact_id"]
 
             # Preserve relationship_type and notes if manually set
-            if not existing.get("notes", "").startswith("Synced from"):
-                # Keep existing notes
-                pass
-            else:
+            if existing.get("notes", "").startswith("Synced from"):
                 existing["notes"] = contact["notes"]
 
-            logger.debug(f"Updated contact: {contact['name']}")
+            logger.debug(f"Updated contact ({kind} match): {contact['name']}")
         else:
             # New contact
-            merged_contacts[key] = contact
+            final_contacts.append(contact)
             logger.info(f"Added new contact: {contact['name']}")
-
-    # Convert back to list
-    final_contacts = list(merged_contacts.values())
+            if kind == "fuzzy":
+                suggestions += 1
+                logger.info(
+                    f"  Possible duplicate of '{existing_contacts[j]['name']}' - "
+                    f"merge by hand if they are the same person"
+                )
+
+    if suggestions:
+        logger.info(f"{suggestions} new contacts resemble existing ones by name only")
 
     # Sort by name
     final_contacts.sort(key=lambda c: c["name"])
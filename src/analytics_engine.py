@@ -0,0 +1,449 @@
+"""
+Single-pass analytics over a window of chat.db messages.
+
+get_conversation_analytics used to issue six queries over the same date
+range (totals, hour histogram, weekday histogram, top contacts, attachments,
+reactions) and detect_follow_up_needed ran its own window query plus an
+O(n^2) "did anyone reply after this?" scan. Here the window is read once
+into columnar arrays and every statistic is computed from those columns.
+
+CS Concept: **Columnar layout** - storing each field in its own compact
+array (array('q') for dates, array('b') for flags) instead of one tuple per
+row keeps memory per message at a few bytes per field and lets each
+statistic walk only the columns it needs.
+
+Usage:
+    window = MessageWindow.load(conn, since=datetime.now() - timedelta(days=30))
+    engine = AnalyticsEngine(window)
+    stats = engine.conversation_analytics(days=30)
+"""
+
+import logging
+import re
+import sqlite3
+from array import array
+from collections import Counter
+from datetime import datetime, timedelta
+from statistics import median
+from typing import Callable, Dict, Iterable, List, Optional, Tuple
+
+logger = logging.getLogger(__name__)
+
+COCOA_EPOCH = datetime(2001, 1, 1)
+NS_PER_SECOND = 1_000_000_000
+
+DAYS_OF_WEEK = ["Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"]
+
+# Gaps longer than this are a new conversation, not a slow reply
+MAX_RESPONSE_GAP_SECONDS = 24 * 3600
+
+# Rows fetched per fetchmany() while loading a window
+LOAD_BATCH_SIZE = 5000
+
+# ROWIDs per IN (...) query in fetch_texts (under SQLite's 999-variable limit)
+TEXT_BATCH_SIZE = 500
+
+
+def to_cocoa(dt: datetime) -> int:
+    """datetime -> chat.db date (nanoseconds since 2001-01-01)."""
+    return int((dt - COCOA_EPOCH).total_seconds() * NS_PER_SECOND)
+
+
+def from_cocoa(date_cocoa: int) -> datetime:
+    """chat.db date -> datetime."""
+    return COCOA_EPOCH + timedelta(seconds=date_cocoa / NS_PER_SECOND)
+
+
+def _is_reaction(assoc_type: int) -> bool:
+    return 2000 <= assoc_type <= 3005
+
+
+class MessageWindow:
+    """
+    Columnar snapshot of the messages in a date window, oldest first.
+
+    Columns are parallel: index i in every array is the same message.
+    Message text is not loaded; `has_text` flags rows with text or an
+    attributedBody, and fetch_texts() reads them for chosen ROWIDs only.
+    """
+
+    __slots__ = (
+        "rowids", "dates", "from_me", "handles", "assoc_types",
+        "attachments", "item_types", "has_text",
+    )
+
+    def __init__(self):
+        self.rowids = array("q")
+        self.dates = array("q")
+        self.from_me = array("b")
+        self.handles: List[Optional[str]] = []
+        self.assoc_types = array("i")
+        self.attachments = array("i")
+        self.item_types = array("i")
+        self.has_text = array("b")
+
+    def __len__(self) -> int:
+        return len(self.rowids)
+
+    @classmethod
+    def load(
+        cls,
+        conn: sqlite3.Connection,
+        since: datetime,
+        phone_pattern: Optional[str] = None,
+        batch_size: int = LOAD_BATCH_SIZE,
+    ) -> "MessageWindow":
+        """
+        Read every message dated at or after `since` in one query.
+
+        Args:
+            conn: chat.db connection
+            since: Window start
+            phone_pattern: Optional LIKE pattern on handle.id (already escaped)
+            batch_size: Rows per fetchmany()
+        """
+        query = """
+            SELECT
+                m.ROWID,
+                m.date,
+                m.is_from_me,
+                h.id,
+                COALESCE(m.associated_message_type, 0),
+                (SELECT COUNT(*) FROM message_attachment_join maj WHERE maj.message_id = m.ROWID),
+                COALESCE(m.item_type, 0),
+                m.text IS NOT NULL OR m.attributedBody IS NOT NULL
+            FROM message m
+            LEFT JOIN handle h ON m.handle_id = h.ROWID
+            WHERE m.date >= ?
+        """
+        params: List = [to_cocoa(since)]
+        if phone_pattern:
+            query += " AND h.id LIKE ?"
+            params.append(phone_pattern)
+        query += " ORDER BY m.date"
+
+        window = cls()
+        cursor = conn.execute(query, params)
+        while True:
+            rows = cursor.fetchmany(batch_size)
+            if not rows:
+                break
+            for row in rows:
+                window.rowids.append(row[0])
+                window.dates.append(row[1] or 0)
+                window.from_me.append(1 if row[2] else 0)
+                window.handles.append(row[3])
+                window.assoc_types.append(row[4])
+                window.attachments.append(row[5])
+                window.item_types.append(row[6])
+                window.has_text.append(1 if row[7] else 0)
+        return window
+
+    @staticmethod
+    def fetch_texts(
+        conn: sqlite3.Connection,
+        rowids: Iterable[int],
+        batch_size: int = TEXT_BATCH_SIZE,
+    ) -> Dict[int, Tuple[Optional[str], Optional[bytes]]]:
+        """
+        Read text/attributedBody for the given message ROWIDs.
+
+        Returns:
+            Dict mapping ROWID -> (text, attributedBody)
+        """
+        rowids = list(rowids)
+        found: Dict[int, Tuple[Optional[str], Optional[bytes]]] = {}
+        for start in range(0, len(rowids), batch_size):
+            batch = rowids[start:start + batch_size]
+            placeholders = ",".join("?" * len(batch))
+            for rowid, text, body in conn.execute(
+                f"SELECT ROWID, text, attributedBody FROM message WHERE ROWID IN ({placeholders})",
+                batch,
+            ):
+                found[rowid] = (text, body)
+        return found
+
+
+class AnalyticsEngine:
+    """
+    Computes analytics, reaction summaries and follow-up candidates from
+    one MessageWindow.
+
+    Args:
+        window: Loaded message window
+        now: Reference time for "days ago" fields (default: datetime.now())
+    """
+
+    def __init__(self, window: MessageWindow, now: Optional[datetime] = None):
+        self.window = window
+        self.now = now or datetime.now()
+
+    # ----- analytics -----
+
+    def conversation_analytics(self, days: int, include_top_contacts: bool = True) -> Dict:
+        """
+        Totals, histograms, top contacts, response times, attachments and
+        reactions in one pass over the window.
+
+        Hour/weekday histograms are UTC-based and count regular messages
+        (not tapbacks), matching total_messages.
+        """
+        w = self.window
+        total = sent = 0
+        attachment_count = reaction_count = 0
+        by_hour = [0] * 24
+        by_dow = [0] * 7
+        contacts: Counter = Counter()
+
+        # Response times: last message per handle (date, from_me)
+        last_seen: Dict[Optional[str], Tuple[int, int]] = {}
+        my_replies: List[float] = []
+        their_replies: List[float] = []
+
+        for i in range(len(w)):
+            attachment_count += w.attachments[i]
+            assoc = w.assoc_types[i]
+            if assoc:
+                if _is_reaction(assoc):
+                    reaction_count += 1
+                continue
+
+            date = w.dates[i]
+            from_me = w.from_me[i]
+            handle = w.handles[i]
+
+            total += 1
+            sent += from_me
+            seconds = date // NS_PER_SECOND
+            by_hour[(seconds // 3600) % 24] += 1
+            by_dow[(seconds // 86400 + 1) % 7] += 1
+            if handle is not None:
+                contacts[handle] += 1
+
+            previous = last_seen.get(handle)
+            if previous is not None and previous[1] != from_me:
+                gap = (date - previous[0]) / NS_PER_SECOND
+                if 0 <= gap <= MAX_RESPONSE_GAP_SECONDS:
+                    (my_replies if from_me else their_replies).append(gap / 60)
+            last_seen[handle] = (date, from_me)
+
+        busiest_hour = max(range(24), key=lambda h: by_hour[h]) if total else None
+        busiest_dow = max(range(7), key=lambda d: by_dow[d]) if total else None
+
+        return {
+            "total_messages": total,
+            "sent_count": sent,
+            "received_count": total - sent,
+            "avg_daily_messages": round(total / max(days, 1), 1),
+            "busiest_hour": busiest_hour,
+            "busiest_day": DAYS_OF_WEEK[busiest_dow] if busiest_dow is not None else None,
+            "messages_by_hour": by_hour,
+            "messages_by_day": {DAYS_OF_WEEK[d]: by_dow[d] for d in range(7)},
+            "top_contacts": [
+                {"phone": handle, "message_count": count}
+                for handle, count in contacts.most_common(10)
+            ] if include_top_contacts else [],
+            "response_stats": {
+                "my_avg_minutes": _round_mean(my_replies),
+                "my_median_minutes": round(median(my_replies), 1) if my_replies else None,
+                "their_avg_minutes": _round_mean(their_replies),
+                "their_median_minutes": round(median(their_replies), 1) if their_replies else None,
+                "my_reply_count": len(my_replies),
+                "their_reply_count": len(their_replies),
+            },
+            "attachment_count": attachment_count,
+            "reaction_count": reaction_count,
+            "analysis_period_days": days,
+        }
+
+    # ----- reactions -----
+
+    def reaction_summary(self, reaction_types: Dict[int, str]) -> Dict:
+        """
+        Tapback counts in the window: by type, given vs received, and by
+        reactor. Removals (3000-3005) cancel the matching addition.
+        """
+        w = self.window
+        by_type: Counter = Counter()
+        by_reactor: Counter = Counter()
+        given = received = removals = 0
+
+        for i in range(len(w)):
+            assoc = w.assoc_types[i]
+            if not _is_reaction(assoc):
+                continue
+            name = reaction_types.get(assoc, f"unknown_{assoc}")
+            delta = 1
+            if assoc >= 3000:
+                name = name.replace("remove_", "")
+                delta = -1
+                removals += 1
+            by_type[name] += delta
+            if w.from_me[i]:
+                given += delta
+            else:
+                received += delta
+                by_reactor[w.handles[i] or "unknown"] += delta
+
+        return {
+            "total_reactions": max(given + received, 0),
+            "given": max(given, 0),
+            "received": max(received, 0),
+            "removals": removals,
+            "by_type": {name: count for name, count in by_type.most_common() if count > 0},
+            "top_reactors": [
+                {"handle": handle, "reaction_count": count}
+                for handle, count in by_reactor.most_common(10) if count > 0
+            ],
+        }
+
+    # ----- follow-ups -----
+
+    def follow_ups(
+        self,
+        patterns: Dict[str, List[str]],
+        fetch_texts: Callable[[List[int]], Dict[int, Tuple[Optional[str], Optional[bytes]]]],
+        decode_many: Callable[[Iterable[Tuple]], Dict[int, Optional[str]]],
+        stale_before: datetime,
+        days: int,
+        limit: int = 50,
+        per_contact: int = 20,
+    ) -> Dict:
+        """
+        Follow-up candidates from the window.
+
+        Only each contact's `per_contact` most recent messages have their
+        text fetched, decoded and classified; "has anyone replied since?" is answered from the
+        per-contact latest sent/received dates instead of rescanning.
+
+        Args:
+            patterns: Category -> regexes (MessagesInterface.FOLLOW_UP_PATTERNS)
+            fetch_texts: ROWIDs -> {ROWID: (text, attributedBody)}
+                (MessageWindow.fetch_texts bound to a connection)
+            decode_many: Batch attributedBody decoder ((text, body, ROWID) rows)
+            stale_before: Conversations whose last (received) message is older are stale
+            days: Window length, echoed as analysis_period_days
+            limit: Maximum items per category
+            per_contact: Recent messages per contact to classify
+        """
+        w = self.window
+        compiled = {
+            category: re.compile("|".join(f"(?:{p})" for p in regexes))
+            for category, regexes in patterns.items()
+        }
+
+        # One pass: latest sent/received date and recent candidates per contact
+        latest_sent: Dict[str, int] = {}
+        latest_received: Dict[str, int] = {}
+        recent: Dict[str, List[int]] = {}
+        for i in range(len(w) - 1, -1, -1):  # Newest first
+            handle = w.handles[i]
+            if handle is None or w.assoc_types[i] or w.item_types[i]:
+                continue
+            if not w.has_text[i]:
+                continue
+            latest = latest_sent if w.from_me[i] else latest_received
+            latest.setdefault(handle, w.dates[i])
+            bucket = recent.setdefault(handle, [])
+            if len(bucket) < per_contact:
+                bucket.append(i)
+
+        candidates = [i for indices in recent.values() for i in indices]
+        stored = fetch_texts([w.rowids[i] for i in candidates])
+        decoded = decode_many(
+            (text, body, rowid) for rowid, (text, body) in stored.items() if not text
+        )
+
+        def text_at(i: int) -> Optional[str]:
+            rowid = w.rowids[i]
+            return stored.get(rowid, (None, None))[0] or decoded.get(rowid)
+
+        results = {
+            "unanswered_questions": [],
+            "pending_promises": [],
+            "waiting_on_them": [],
+            "stale_conversations": [],
+            "time_sensitive": [],
+            "analysis_period_days": days,
+        }
+
+        def add(category: str, item: Dict):
+            if len(results[category]) < limit:
+                results[category].append(item)
+
+        for handle in sorted(recent):
+            messages = [(i, text_at(i)) for i in recent[handle]]
+            messages = [(i, text) for i, text in messages if text]
+            if not messages:
+                continue
+
+            # Stale: they messaged last and we haven't replied
+            last_i, last_text = messages[0]
+            last_date = from_cocoa(w.dates[last_i])
+            if not w.from_me[last_i] and last_date < stale_before:
+                results["stale_conversations"].append({
+                    "phone": handle,
+                    "last_message": last_text[:100],
+                    "days_since_reply": (self.now - last_date).days,
+                    "date": last_date.isoformat(),
+                })
+
+            for i, text in messages:
+                text_lower = text.lower()
+                date_cocoa = w.dates[i]
+                date = from_cocoa(date_cocoa)
+                days_ago = (self.now - date).days
+
+                if not w.from_me[i]:
+                    if compiled["question"].search(text_lower):
+                        if latest_sent.get(handle, -1) <= date_cocoa:
+                            add("unanswered_questions", {
+                                "phone": handle,
+                                "text": text[:200],
+                                "date": date.isoformat(),
+                                "days_ago": days_ago,
+                            })
+                else:
+                    if compiled["promise"].search(text_lower):
+                        add("pending_promises", {
+                            "phone": handle,
+                            "text": text[:200],
+                            "date": date.isoformat(),
+                            "days_ago": days_ago,
+                        })
+                    if compiled["waiting"].search(text_lower):
+                        if latest_received.get(handle, -1) <= date_cocoa:
+                            add("waiting_on_them", {
+                                "phone": handle,
+                                "text": text[:200],
+                                "date": date.isoformat(),
+                                "days_waiting": days_ago,
+                            })
+
+                if compiled["time_reference"].search(text_lower):
+                    add("time_sensitive", {
+                        "phone": handle,
+                        "text": text[:200],
+                        "date": date.isoformat(),
+                        "is_from_me": bool(w.from_me[i]),
+                        "days_ago": days_ago,
+                    })
+
+        results["summary"] = {
+            "unanswered_questions": len(results["unanswered_questions"]),
+            "pending_promises": len(results["pending_promises"]),
+            "waiting_on_them": len(results["waiting_on_them"]),
+            "stale_conversations": len(results["stale_conversations"]),
+            "time_sensitive": len(results["time_sensitive"]),
+            "total_action_items": sum([
+                len(results["unanswered_questions"]),
+                len(results["pending_promises"]),
+                len(results["waiting_on_them"]),
+                len(results["stale_conversations"]),
+            ]),
+        }
+        return results
+
+
+def _round_mean(values: List[float]) -> Optional[float]:
+    return round(sum(values) / len(values), 1) if values else None
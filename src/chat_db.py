@@ -0,0 +1,192 @@
+"""
+Long-lived read-only connection to the Messages database (chat.db).
+
+MessagesInterface used to open and close a fresh connection per call, which
+re-parses the schema and discards SQLite's page cache every time. Batch
+callers (the RAG indexer, the gateway daemon) issue hundreds of queries, so
+one tuned connection is kept open and reused instead.
+
+Python's sqlite3 Connection and Cursor objects are not safe to use from
+several threads at once. The gateway daemon serves one request at a time
+on its serving thread, but a MessagesInterface can still be shared with
+other threads (a ChatDBWatcher callback on its polling thread, library
+callers with worker pools), so each thread gets its own connection
+(threading.local) and keeps it for its lifetime.
+
+A thread's connection is reopened transparently when chat.db is replaced
+(inode change), so long-running processes never hold a handle to a stale
+file. WAL checkpoints need no reopen: SQLite readers notice a reset WAL
+through the shared-memory index and keep seeing new writes.
+
+chat.db itself is never written. Derived data (search index, caches) lives in
+a separate writable "sidecar" database opened with open_sidecar().
+"""
+
+import logging
+import os
+import sqlite3
+import threading
+from pathlib import Path
+from typing import Dict, Optional, Tuple
+
+from .tracing import span
+
+logger = logging.getLogger(__name__)
+
+# Tuning for a read-heavy workload against a database we never write
+DEFAULT_MMAP_SIZE = 256 * 1024 * 1024      # 256 MB memory-mapped I/O
+DEFAULT_CACHE_SIZE_KIB = 64 * 1024         # 64 MB page cache
+DEFAULT_CACHED_STATEMENTS = 256            # Prepared statements kept per connection
+
+# Writable database for data derived from chat.db (never chat.db itself)
+DEFAULT_SIDECAR_PATH = Path.home() / ".imessage_rag" / "chat_index.db"
+
+
+class ChatDBConnection:
+    """
+    Hands each thread its own long-lived read-only connection, with automatic reopen.
+
+    Args:
+        db_path: Path to chat.db
+        mmap_size: Bytes of the database to memory-map
+        cache_size_kib: Page cache size in KiB
+        cached_statements: Size of sqlite3's prepared statement cache
+
+    Example:
+        db = ChatDBConnection(Path("~/Library/Messages/chat.db").expanduser())
+        rows = db.get().execute("SELECT COUNT(*) FROM message").fetchone()
+    """
+
+    def __init__(
+        self,
+        db_path: Path,
+        mmap_size: int = DEFAULT_MMAP_SIZE,
+        cache_size_kib: int = DEFAULT_CACHE_SIZE_KIB,
+        cached_statements: int = DEFAULT_CACHED_STATEMENTS,
+    ):
+        self.db_path = Path(db_path)
+        self.mmap_size = mmap_size
+        self.cache_size_kib = cache_size_kib
+        self.cached_statements = cached_statements
+
+        self._local = threading.local()             # .conn, .identity, .generation
+        self._conns: Dict[int, sqlite3.Connection] = {}  # Thread ident -> its connection
+        self._generation = 0                         # Bumped by close()
+        self._lock = threading.Lock()
+        self.open_count = 0  # Exposed for tests/benchmarks
+
+    def _identity(self) -> Optional[Tuple[int, int]]:
+        """(st_dev, st_ino) of chat.db, or None if it can't be stat'ed."""
+        try:
+            st = os.stat(self.db_path)
+            return st.st_dev, st.st_ino
+        except OSError:
+            return None
+
+    def _open(self) -> sqlite3.Connection:
+        with span("connect"):
+            return self._connect()
+
+    def _connect(self) -> sqlite3.Connection:
+        conn = sqlite3.connect(
+            f"file:{self.db_path}?mode=ro",
+            uri=True,
+            cached_statements=self.cached_statements,
+            # Only the opening thread queries it; close() may run on another
+            # thread at shutdown, which the same-thread check would refuse
+            check_same_thread=False,
+        )
+        conn.execute("PRAGMA query_only = ON")
+        conn.execute(f"PRAGMA mmap_size = {int(self.mmap_size)}")
+        conn.execute(f"PRAGMA cache_size = -{int(self.cache_size_kib)}")
+        conn.execute("PRAGMA temp_store = MEMORY")
+        return conn
+
+    def get(self) -> sqlite3.Connection:
+        """
+        Return this thread's connection, (re)opening it if needed.
+
+        Raises:
+            sqlite3.Error: If the database cannot be opened
+        """
+        identity = self._identity()
+        local = self._local
+        conn = getattr(local, "conn", None)
+
+        if conn is not None and local.generation != self._generation:
+            conn = None                              # Closed by close()
+        elif conn is not None and identity != local.identity:
+            logger.debug("Reopening chat.db connection (file replaced)")
+            self._discard(threading.get_ident())
+            conn = None
+
+        if conn is None:
+            conn = self._open()
+            local.conn, local.identity, local.generation = conn, identity, self._generation
+            self._register(conn)
+        return conn
+
+    def _register(self, conn: sqlite3.Connection):
+        """Track conn for close(), dropping connections of threads that have exited."""
+        live = {thread.ident for thread in threading.enumerate()}
+        with self._lock:
+            for ident in [ident for ident in self._conns if ident not in live]:
+                self._close_quietly(self._conns.pop(ident))
+            previous = self._conns.get(threading.get_ident())
+            if previous is not None and previous is not conn:
+                self._close_quietly(previous)
+            self._conns[threading.get_ident()] = conn
+            self.open_count += 1
+            count = self.open_count
+        logger.debug(f"Opened chat.db connection #{count}: {self.db_path}")
+
+    def _discard(self, ident: int):
+        with self._lock:
+            conn = self._conns.pop(ident, None)
+        if conn is not None:
+            self._close_quietly(conn)
+
+    @staticmethod
+    def _close_quietly(conn: sqlite3.Connection):
+        try:
+            conn.close()
+        except sqlite3.Error as e:
+            logger.debug(f"Error closing chat.db connection: {e}")
+
+    def close(self):
+        """
+        Close every thread's connection (each is reopened on its next get()).
+
+        Call when no queries are running, e.g. at shutdown.
+        """
+        with self._lock:
+            conns = list(self._conns.values())
+            self._conns.clear()
+            self._generation += 1
+        for conn in conns:
+            self._close_quietly(conn)
+
+
+def open_sidecar(path: Optional[Path] = None) -> sqlite3.Connection:
+    """
+    Open (creating if needed) the writable sidecar database.
+
+    WAL mode lets the gateway read while an indexer writes; synchronous=NORMAL
+    is safe because sidecars hold only derived data, which callers can rebuild
+    from their source if a crash drops the last commits.
+
+    Raises:
+        sqlite3.Error / OSError: If the sidecar cannot be created
+    """
+    path = Path(path) if path else DEFAULT_SIDECAR_PATH
+    path.parent.mkdir(parents=True, exist_ok=True)
+
+    conn = sqlite3.connect(
+        str(path),
+        cached_statements=DEFAULT_CACHED_STATEMENTS,
+        check_same_thread=False,
+    )
+    conn.execute("PRAGMA journal_mode = WAL")
+    conn.execute("PRAGMA synchronous = NORMAL")
+    conn.execute("PRAGMA temp_store = MEMORY")
+    return conn
@@ -0,0 +1,203 @@
+"""
+Compiled contacts cache for fast ContactsManager startup.
+
+Parsing contacts.json and building Contact objects for every entry costs a
+few milliseconds per thousand contacts on each CLI call, even when the
+command resolves a single handle. The cache is an SQLite file holding the
+contacts plus their prebuilt lookup indexes, so a fresh process answers a
+lookup with a couple of memory-mapped B-tree reads and never touches the JSON.
+
+CS Concept: Compile-once, query-many. The cache is keyed on the JSON file's
+(path, mtime, size); any edit to contacts.json - add-contact or
+scripts/sync_contacts.py - makes it stale and the next load recompiles it.
+It is written to a temp file and atomically renamed into place, so readers
+never see a half-built cache.
+"""
+
+import json
+import logging
+import os
+import sqlite3
+from pathlib import Path
+from typing import List, Optional
+
+logger = logging.getLogger(__name__)
+
+CACHE_FORMAT_VERSION = 1
+CACHE_MMAP_SIZE = 64 * 1024 * 1024
+
+
+def _source_signature(source: Path) -> Optional[dict]:
+    try:
+        stat = source.stat()
+    except OSError:
+        return None
+    return {"source": str(source.resolve()), "mtime_ns": stat.st_mtime_ns, "size": stat.st_size}
+
+
+def default_cache_path(config_path: Path) -> Path:
+    """Hidden cache file next to the config: config/.contacts.cache.db"""
+    return config_path.with_name(f".{config_path.stem}.cache.db")
+
+
+class ContactsCache:
+    """
+    Read side of the compiled cache. Implements the same lookup methods as
+    ContactIndex, so ContactsManager can serve lookups from either.
+
+    Args:
+        conn: Read-only connection to a fresh cache (see open())
+    """
+
+    def __init__(self, conn: sqlite3.Connection):
+        self.conn = conn
+
+    @classmethod
+    def open(cls, cache_path: Path, source: Path) -> Optional["ContactsCache"]:
+        """Open the cache if it was compiled from source's current contents."""
+        signature = _source_signature(source)
+        if signature is None or not cache_path.exists():
+            return None
+        try:
+            conn = sqlite3.connect(
+                f"file:{cache_path}?mode=ro", uri=True, check_same_thread=False
+            )
+            conn.execute(f"PRAGMA mmap_size = {CACHE_MMAP_SIZE}")
+            meta = dict(conn.execute("SELECT key, value FROM cache_meta"))
+        except sqlite3.Error as e:
+            logger.debug(f"Contacts cache unreadable ({e}), recompiling")
+            return None
+
+        if meta.get("format") != str(CACHE_FORMAT_VERSION) or meta.get("signature") != json.dumps(signature):
+            conn.close()
+            return None
+        return cls(conn)
+
+    @staticmethod
+    def write(cache_path: Path, source: Path, index) -> bool:
+        """
+        Compile a ContactIndex into the cache file.
+
+        Returns:
+            True if written; failures are logged and leave lookups in memory
+        """
+        signature = _source_signature(source)
+        if signature is None:
+            return False
+
+        tmp_path = cache_path.with_name(cache_path.name + f".{os.getpid()}.tmp")
+        try:
+            cache_path.parent.mkdir(parents=True, exist_ok=True)
+            tmp_path.unlink(missing_ok=True)
+            conn = sqlite3.connect(tmp_path)
+            conn.executescript("""
+                PRAGMA journal_mode = OFF;
+                PRAGMA synchronous = OFF;
+                CREATE TABLE cache_meta (key TEXT PRIMARY KEY, value TEXT);
+                CREATE TABLE contact (
+                    pos INTEGER PRIMARY KEY, name TEXT, name_lower TEXT, phone TEXT,
+                    relationship_type TEXT, notes TEXT, extra TEXT
+                );
+                CREATE TABLE contact_key (
+                    kind TEXT, key TEXT, pos INTEGER, PRIMARY KEY (kind, key)
+                ) WITHOUT ROWID;
+                CREATE TABLE name_token (key TEXT, pos INTEGER, PRIMARY KEY (key, pos)) WITHOUT ROWID;
+                CREATE TABLE short_phone (key TEXT, pos INTEGER, PRIMARY KEY (key, pos)) WITHOUT ROWID;
+            """)
+            conn.executemany(
+                "INSERT INTO contact VALUES (?, ?, ?, ?, ?, ?, ?)",
+                (
+                    (pos, c.name, c.name.lower(), c.phone, c.relationship_type, c.notes,
+                     json.dumps(c.extra) if c.extra else None)
+                    for pos, c in enumerate(index.contacts)
+                ),
+            )
+            for kind, mapping in index.key_maps().items():
+                conn.executemany(
+                    "INSERT INTO contact_key VALUES (?, ?, ?)",
+                    ((kind, key, pos) for key, pos in mapping.items()),
+                )
+            conn.executemany("INSERT OR IGNORE INTO name_token VALUES (?, ?)", index.name_keys)
+            conn.executemany("INSERT OR IGNORE INTO short_phone VALUES (?, ?)", index.short_phone_keys())
+            conn.executemany(
+                "INSERT INTO cache_meta VALUES (?, ?)",
+                [("format", str(CACHE_FORMAT_VERSION)), ("signature", json.dumps(signature))],
+            )
+            conn.commit()
+            conn.close()
+            os.replace(tmp_path, cache_path)
+            return True
+        except (sqlite3.Error, OSError) as e:
+            logger.warning(f"Could not write contacts cache {cache_path}: {e}")
+            tmp_path.unlink(missing_ok=True)
+            return False
+
+    def close(self):
+        self.conn.close()
+
+    # ===== Lookups (same interface as ContactIndex) =====
+
+    def _contact(self, pos: Optional[int]):
+        if pos is None:
+            return None
+        row = self.conn.execute(
+            "SELECT name, phone, relationship_type, notes, extra FROM contact WHERE pos = ?",
+            (pos,),
+        ).fetchone()
+        if row is None:
+            return None
+
+        from .contacts_manager import Contact
+
+        name, phone, relationship_type, notes, extra = row
+        return Contact(name, phone, relationship_type, notes, json.loads(extra) if extra else None)
+
+    def _scalar(self, query: str, params) -> Optional[int]:
+        row = self.conn.execute(query, params).fetchone()
+        return row[0] if row else None
+
+    def get(self, kind: str, key: str):
+        """Contact for an exact key of the given kind (phone/suffix/email/name)."""
+        return self._contact(self._scalar(
+            "SELECT pos FROM contact_key WHERE kind = ? AND key = ?", (kind, key)
+        ))
+
+    def name_prefix(self, query: str):
+        """Earliest contact whose full name or a name token starts with query."""
+        return self._contact(self._scalar(
+            "SELECT MIN(pos) FROM name_token WHERE key >= ? AND key < ?",
+            (query, query + "\U0010ffff"),
+        ))
+
+    def name_contains(self, query: str):
+        """Earliest contact whose lowercased name contains query."""
+        return self._contact(self._scalar(
+            "SELECT pos FROM contact WHERE instr(name_lower, ?) > 0 ORDER BY pos LIMIT 1",
+            (query,),
+        ))
+
+    def short_phone_ending(self, normalized: str):
+        """Earliest contact whose short number (under 10 digits) ends normalized."""
+        suffixes = [normalized[i:] for i in range(len(normalized))]
+        placeholders = ",".join("?" * len(suffixes))
+        return self._contact(self._scalar(
+            f"SELECT MIN(pos) FROM short_phone WHERE key IN ({placeholders})", suffixes
+        ))
+
+    def suffix_ending_with(self, digits: str):
+        """Earliest contact whose last-10 suffix ends with digits (partial numbers)."""
+        return self._contact(self._scalar(
+            "SELECT MIN(pos) FROM contact_key WHERE kind = 'suffix' AND substr(key, -?) = ?",
+            (len(digits), digits),
+        ))
+
+    def all_contacts(self) -> List:
+        """Every contact in config order."""
+        from .contacts_manager import Contact
+
+        return [
+            Contact(name, phone, relationship_type, notes, json.loads(extra) if extra else None)
+            for name, phone, relationship_type, notes, extra in self.conn.execute(
+                "SELECT name, phone, relationship_type, notes, extra FROM contact ORDER BY pos"
+            )
+        ]
@@ -3,12 +3,20 @@ Contact management for iMessage MCP server.
 
 Sprint 1: Basic contact lookup from JSON config
 Sprint 2: macOS Contacts sync, fuzzy matching, DB integration
+
+CS Concept: Lookups go through hash indexes built once at load time
+(normalized phone, last-10-digit suffix, email) plus a sorted name/token
+list searched by binary search for prefix matches. Resolving a handle is
+O(1) instead of a scan that re-normalizes every contact on every call.
 """
 
+import bisect
 import json
 import logging
 from pathlib import Path
-from typing import Optional, List, Dict
+from typing import Optional, List, Dict, Iterable, Tuple
+
+from .contacts_sync import normalize_phone_number
 
 logger = logging.getLogger(__name__)
 
@@ -21,23 +29,143 @@ class Contact:
         name: str,
         phone: str,
         relationship_type: str = "other",
-        notes: str = ""
+        notes: str = "",
+        extra: Optional[Dict] = None
     ):
         self.name = name
         self.phone = phone
         self.relationship_type = relationship_type
         self.notes = notes
+        # Synced fields (all_phones, emails, macos_contact_id) kept verbatim
+        self.extra = extra or {}
 
     def __repr__(self):
         return f"Contact(name='{self.name}', phone='{self.phone}')"
 
+    @property
+    def phones(self) -> List[str]:
+        """Primary phone plus any synced secondary numbers."""
+        phones = [self.phone] if self.phone else []
+        for entry in self.extra.get("all_phones", []):
+            value = entry.get("value") if isinstance(entry, dict) else entry
+            if value and value not in phones:
+                phones.append(value)
+        return phones
+
+    @property
+    def emails(self) -> List[str]:
+        """Synced email addresses (and a primary "phone" that is an email)."""
+        emails = [self.phone] if "@" in (self.phone or "") else []
+        for entry in self.extra.get("emails", []):
+            value = entry.get("value") if isinstance(entry, dict) else entry
+            if value and value not in emails:
+                emails.append(value)
+        return emails
+
     def to_dict(self) -> dict:
-        return {
+        data = dict(self.extra)
+        data.update({
             "name": self.name,
             "phone": self.phone,
             "relationship_type": self.relationship_type,
             "notes": self.notes
+        })
+        return data
+
+
+def _phone_keys(phone: str) -> Tuple[str, str]:
+    """(normalized number, last-10-digit suffix) for a phone handle."""
+    normalized = normalize_phone_number(phone)
+    return normalized, normalized[-10:]
+
+
+class ContactIndex:
+    """
+    In-memory lookup indexes over a contact list. Dicts map keys to list
+    positions; where several contacts share a key, the earliest one wins, as
+    it did with the old linear scans.
+
+    ContactsCache (src/contacts_cache.py) implements the same lookup methods
+    over a compiled SQLite file.
+    """
+
+    def __init__(self, contacts: List[Contact]):
+        self.contacts = contacts
+        self._keys: Dict[str, Dict[str, int]] = {
+            "phone": {}, "suffix": {}, "email": {}, "name": {}
         }
+        self.name_keys: List[Tuple[str, int]] = []  # Sorted (name or token, position)
+        self._short_phones: List[Tuple[str, int]] = []  # Numbers under 10 digits
+        for position, contact in enumerate(contacts):
+            self._add(contact, position)
+        self.name_keys.sort()
+
+    def add(self, contact: Contact):
+        """Index a contact already appended to self.contacts."""
+        self._add(contact, len(self.contacts) - 1, sort=True)
+
+    def _add(self, contact: Contact, position: int, sort: bool = False):
+        for phone in contact.phones:
+            if "@" in phone:
+                continue
+            normalized, suffix = _phone_keys(phone)
+            if not normalized:
+                continue
+            self._keys["phone"].setdefault(normalized, position)
+            if len(normalized) >= 10:
+                self._keys["suffix"].setdefault(suffix, position)
+            else:
+                self._short_phones.append((normalized, position))
+
+        for email in contact.emails:
+            self._keys["email"].setdefault(email.strip().lower(), position)
+
+        name = contact.name.lower()
+        if not name:
+            return
+        self._keys["name"].setdefault(name, position)
+        keys = {name, *name.split()}
+        if sort:
+            for key in keys:
+                bisect.insort(self.name_keys, (key, position))
+        else:
+            self.name_keys.extend((key, position) for key in keys)
+
+    def key_maps(self) -> Dict[str, Dict[str, int]]:
+        return self._keys
+
+    def short_phone_keys(self) -> List[Tuple[str, int]]:
+        return self._short_phones
+
+    def _at(self, position: Optional[int]) -> Optional[Contact]:
+        return None if position is None else self.contacts[position]
+
+    def get(self, kind: str, key: str) -> Optional[Contact]:
+        """Contact for an exact key of the given kind (phone/suffix/email/name)."""
+        return self._at(self._keys[kind].get(key))
+
+    def name_prefix(self, query: str) -> Optional[Contact]:
+        """Earliest contact whose full name or a name token starts with query."""
+        start = bisect.bisect_left(self.name_keys, (query, -1))
+        best = None
+        for key, position in self.name_keys[start:]:
+            if not key.startswith(query):
+                break
+            if best is None or position < best:
+                best = position
+        return self._at(best)
+
+    def name_contains(self, query: str) -> Optional[Contact]:
+        """Earliest contact whose lowercased name contains query."""
+        return next((c for c in self.contacts if query in c.name.lower()), None)
+
+    def short_phone_ending(self, normalized: str) -> Optional[Contact]:
+        """Earliest contact whose short number (under 10 digits) ends normalized."""
+        return next((self.contacts[i] for short, i in self._short_phones if normalized.endswith(short)), None)
+
+    def suffix_ending_with(self, digits: str) -> Optional[Contact]:
+        """Earliest contact whose last-10 suffix ends with digits (partial numbers)."""
+        return next((self.contacts[i] for key, i in self._keys["suffix"].items() if key.endswith(digits)), None)
 
 
 class ContactsManager:
@@ -46,25 +174,60 @@ class ContactsManager:
 
     Sprint 1: Load from JSON config file
     Sprint 2: Sync with macOS Contacts and Life Planner database
+
+    Lookups go through a compiled cache (see contacts_cache.py) when it
+    matches contacts.json, so startup parses no JSON and builds no Contact
+    objects until self.contacts is first read. Otherwise the JSON is parsed,
+    indexed in memory and the cache recompiled for the next process. Code
+    that mutates self.contacts directly should call _build_index() afterwards.
     """
 
-    def __init__(self, config_path: str = "config/contacts.json"):
+    def __init__(self, config_path: str = "config/contacts.json", cache_path: Optional[str] = None):
         """
         Initialize contacts manager.
 
         Args:
             config_path: Path to contacts configuration file
+            cache_path: Compiled cache location (default: hidden file next
+                to the config); pass "" to disable the cache
         """
         self.config_path = Path(config_path)
-        self.contacts: List[Contact] = []
+        if cache_path is None:
+            from .contacts_cache import default_cache_path
+            self.cache_path: Optional[Path] = default_cache_path(self.config_path)
+        else:
+            self.cache_path = Path(cache_path) if cache_path else None
+        self._contacts: Optional[List[Contact]] = None
+        self._index = None  # ContactIndex or ContactsCache
         self._load_contacts()
 
+    @property
+    def contacts(self) -> List[Contact]:
+        """All contacts in config order (materialized from the cache on first use)."""
+        if self._contacts is None:
+            self._contacts = self._index.all_contacts()
+        return self._contacts
+
+    @contacts.setter
+    def contacts(self, contacts: List[Contact]):
+        self._contacts = contacts
+
     def _load_contacts(self):
-        """Load contacts from configuration file."""
+        """Load contacts from the compiled cache, else the configuration file."""
+        if self.cache_path is not None and self.config_path.exists():
+            from .contacts_cache import ContactsCache
+            cache = ContactsCache.open(self.cache_path, self.config_path)
+            if cache is not None:
+                logger.debug(f"Using compiled contacts cache {self.cache_path}")
+                self._index = cache
+                return
+
+        self.contacts = []
         if not self.config_path.exists():
             logger.warning(f"Contacts config not found: {self.config_path}")
             logger.warning("Creating empty contacts.json - please add your contacts")
             self._create_default_config()
+            self._build_index()
             return
 
         try:
@@ -77,7 +240,11 @@ class ContactsManager:
                     name=c["name"],
                     phone=c["phone"],
                     relationship_type=c.get("relationship_type", "other"),
-                    notes=c.get("notes", "")
+                    notes=c.get("notes", ""),
+                    extra={
+                        k: v for k, v in c.items()
+                        if k not in ("name", "phone", "relationship_type", "notes")
+                    }
                 )
                 for c in contacts_data
             ]
@@ -87,6 +254,27 @@ class ContactsManager:
         except Exception as e:
             logger.error(f"Error loading contacts: {e}")
             self.contacts = []
+            self._build_index()
+            return
+
+        self._build_index()
+        self._write_cache()
+
+    def _build_index(self):
+        """Rebuild the in-memory lookup indexes from self.contacts."""
+        contacts = self.contacts  # Materialize before any cache is closed
+        self._close_cache()
+        self._index = ContactIndex(contacts)
+
+    def _write_cache(self):
+        """Compile the in-memory index to the cache (best-effort)."""
+        if self.cache_path is not None and isinstance(self._index, ContactIndex):
+            from .contacts_cache import ContactsCache
+            ContactsCache.write(self.cache_path, self.config_path, self._index)
+
+    def _close_cache(self):
+        if self._index is not None and not isinstance(self._index, ContactIndex):
+            self._index.close()
 
     def _create_default_config(self):
         """Create default contacts configuration file."""
@@ -113,24 +301,43 @@ class ContactsManager:
             Contact object if found, None otherwise
 
         Note:
-            Sprint 1: Exact match only
-            Sprint 2: Will add fuzzy matching
+            Exact matches and name/token prefixes are index lookups; only a
+            query that appears mid-name falls back to a scan. Prefix matches
+            therefore win over mid-name ones: "ann" finds "Ann Lee" before an
+            earlier "Joanne Park", where the old scan returned the first
+            contact in config order that contained the query anywhere.
         """
-        # Exact match (case-insensitive)
-        for contact in self.contacts:
-            if contact.name.lower() == name.lower():
-                logger.info(f"Found contact: {contact.name} -> {contact.phone}")
-                return contact
+        query = name.strip().lower()
+        if not query:
+            return None
 
-        # Try partial match (contains)
-        for contact in self.contacts:
-            if name.lower() in contact.name.lower():
-                logger.info(f"Partial match: {contact.name} -> {contact.phone}")
-                return contact
+        # Exact match (case-insensitive)
+        contact = self._index.get("name", query)
+        if contact:
+            logger.info(f"Found contact: {contact.name} -> {contact.phone}")
+            return contact
+
+        # Prefix of the full name or of any name token ("john", "doe", "john d"),
+        # then the rare fallback of the query appearing mid-name
+        contact = self._index.name_prefix(query) or self._index.name_contains(query)
+        if contact:
+            logger.info(f"Partial match: {contact.name} -> {contact.phone}")
+            return contact
 
         logger.warning(f"Contact not found: {name}")
         return None
 
+    def get_contact_by_exact_name(self, name: str) -> Optional[Contact]:
+        """
+        Get contact whose full name equals name (case-insensitive).
+
+        Unlike get_contact_by_name there is no prefix or partial fallback,
+        for unattended callers (send-batch) where a near miss must not
+        silently pick a different person.
+        """
+        query = name.strip().lower()
+        return self._index.get("name", query) if query else None
+
     def get_contact_by_phone(self, phone: str) -> Optional[Contact]:
         """
         Get contact by phone number.
@@ -141,22 +348,50 @@ class ContactsManager:
         Returns:
             Contact object if found, None otherwise
         """
-        # Normalize phone for comparison (remove non-digits)
-        normalized_search = ''.join(c for c in phone if c.isdigit())
-
-        for contact in self.contacts:
-            normalized_contact = ''.join(c for c in contact.phone if c.isdigit())
-
-            # Match if search phone is suffix of contact phone
-            # (handles +1 country code differences)
-            if (normalized_contact.endswith(normalized_search) or
-                normalized_search.endswith(normalized_contact)):
-                logger.info(f"Found contact by phone: {contact.name}")
-                return contact
+        contact = self._lookup_handle(phone)
+        if contact:
+            logger.info(f"Found contact by phone: {contact.name}")
+            return contact
 
         logger.warning(f"No contact found for phone: {phone}")
         return None
 
+    def _lookup_handle(self, handle: str) -> Optional[Contact]:
+        """Index lookup for a phone number or email handle (no logging)."""
+        if not handle:
+            return None
+        if "@" in handle:
+            return self._index.get("email", handle.strip().lower())
+
+        normalized, suffix = _phone_keys(handle)
+        if not normalized:
+            return None
+        contact = self._index.get("phone", normalized)
+        if contact is None and len(normalized) >= 10:
+            contact = self._index.get("suffix", suffix)
+        if contact is None:
+            # Short codes and partial numbers: suffix match either way
+            contact = self._index.short_phone_ending(normalized)
+            if contact is None and len(normalized) < 10:
+                contact = self._index.suffix_ending_with(normalized)
+        return contact
+
+    def resolve_handles(self, handles: Iterable[str]) -> Dict[str, Optional[Contact]]:
+        """
+        Resolve many phone/email handles to contacts in one pass.
+
+        Args:
+            handles: Handles as they appear in chat.db (duplicates are fine)
+
+        Returns:
+            Dict mapping each distinct handle to its Contact, or None if unknown
+        """
+        resolved: Dict[str, Optional[Contact]] = {}
+        for handle in handles:
+            if handle not in resolved:
+                resolved[handle] = self._lookup_handle(handle)
+        return resolved
+
     def list_contacts(self) -> List[Contact]:
         """
         Get all contacts.
@@ -190,7 +425,10 @@ class ContactsManager:
             Sprint 2: Will also update Life Planner database
         """
         contact = Contact(name, phone, relationship_type, notes)
+        if not isinstance(self._index, ContactIndex):
+            self._build_index()  # Switch from the cache to in-memory indexes
         self.contacts.append(contact)
+        self._index.add(contact)
 
         # Save to config
         self._save_contacts()
@@ -210,6 +448,7 @@ class ContactsManager:
                 json.dump(data, f, indent=2)
 
             logger.info("Saved contacts to config")
+            self._write_cache()
 
         except Exception as e:
             logger.error(f"Error saving contacts: {e}")
@@ -2,18 +2,25 @@
 macOS Contacts synchronization for iMessage MCP server.
 
 Sprint 2: Reads contacts from macOS Contacts.app and syncs to local JSON store.
+
+CS Concept: Record linkage with blocking. Scoring every Contacts.app entry
+against every contacts.json entry is quadratic, so matching first joins on
+exact identifiers (contact ID, normalized phone, name) and then only scores
+name pairs that share character trigrams, found through an inverted index.
 """
 
+import importlib.util
 import logging
-from typing import List, Dict, Optional, Tuple
+from collections import Counter, defaultdict
+from functools import lru_cache
+from typing import Dict, Iterable, List, Optional, Tuple
 from pathlib import Path
 
-try:
-    from fuzzywuzzy import fuzz
-    FUZZY_AVAILABLE = True
-except ImportError:
-    FUZZY_AVAILABLE = False
-    logging.warning("fuzzywuzzy not available - fuzzy matching disabled")
+# fuzzywuzzy (and difflib behind it) is imported on first use, so callers
+# that only need normalize_phone_number() - ContactsManager on every CLI
+# call - don't pay for it. A missing install is reported by FuzzyNameMatcher,
+# when fuzzy matching is first used, not at import
+FUZZY_AVAILABLE = importlib.util.find_spec("fuzzywuzzy") is not None
 
 logger = logging.getLogger(__name__)
 
@@ -313,6 +320,8 @@ class FuzzyNameMatcher:
             threshold: Minimum similarity score (0-1) to consider a match
         """
         self.threshold = threshold
+        self._blocker_key: Optional[Tuple[str, ...]] = None
+        self._blocker_cache: Optional[NameBlocker] = None
 
         if not FUZZY_AVAILABLE:
             logger.warning(
@@ -320,13 +329,20 @@ class FuzzyNameMatcher:
                 "pip install fuzzywuzzy python-Levenshtein"
             )
 
-    def calculate_similarity(self, name1: str, name2: str) -> float:
+    def calculate_similarity(
+        self,
+        name1: str,
+        name2: str,
+        stop_at: Optional[float] = None
+    ) -> float:
         """
         Calculate similarity between two names.
 
         Args:
             name1: First name
             name2: Second name
+            stop_at: Return as soon as any scorer reaches this score; the
+                result is then a lower bound that is still >= stop_at
 
         Returns:
             Similarity score from 0.0 (no match) to 1.0 (exact match)
@@ -343,26 +359,31 @@ class FuzzyNameMatcher:
         if name1_norm == name2_norm:
             return 1.0
 
-        # Use multiple fuzzy matching strategies and take the best score
-        scores = []
-
-        # 1. Token sort ratio - handles word order differences
-        # "John Doe" vs "Doe John" -> high score
-        scores.append(fuzz.token_sort_ratio(name1_norm, name2_norm))
-
-        # 2. Token set ratio - handles partial matches
-        # "John Michael Doe" vs "John Doe" -> high score
-        scores.append(fuzz.token_set_ratio(name1_norm, name2_norm))
-
-        # 3. Partial ratio - handles substring matches
-        # "John" vs "John Doe" -> high score
-        scores.append(fuzz.partial_ratio(name1_norm, name2_norm))
-
+        # Use multiple fuzzy matching strategies and take the best score:
+        # 1. Token sort ratio - word order ("John Doe" vs "Doe John")
+        # 2. Token set ratio - partial matches ("John Michael Doe" vs "John Doe")
+        # 3. Partial ratio - substrings ("John" vs "John Doe")
         # 4. Simple ratio - basic Levenshtein distance
-        scores.append(fuzz.ratio(name1_norm, name2_norm))
+        best = 0
+        for scorer in _scorers():
+            best = max(best, scorer(name1_norm, name2_norm))
+            if stop_at is not None and best >= stop_at * 100:
+                break  # Caller only needs to know the pair clears stop_at
 
         # Return best score (normalized to 0-1)
-        return max(scores) / 100.0
+        return best / 100.0
+
+    def is_match(self, name1: str, name2: str) -> bool:
+        """True if the names score at or above the threshold (exits early)."""
+        return self.calculate_similarity(name1, name2, stop_at=self.threshold) >= self.threshold
+
+    def _blocker(self, candidates: List[str]) -> "NameBlocker":
+        """Trigram index over candidates, reused while the list is unchanged."""
+        key = tuple(candidates)
+        if self._blocker_key != key:
+            self._blocker_key = key
+            self._blocker_cache = NameBlocker(candidates)
+        return self._blocker_cache
 
     def find_best_match(
         self,
@@ -382,17 +403,19 @@ class FuzzyNameMatcher:
         if not candidates:
             return None
 
-        # Calculate scores for all candidates
-        scored = [
-            (candidate, self.calculate_similarity(query, candidate))
-            for candidate in candidates
-        ]
-
-        # Sort by score (descending)
-        scored.sort(key=lambda x: x[1], reverse=True)
-
-        # Return best match if above threshold
-        best_match, best_score = scored[0]
+        # Score only plausible candidates, most shared trigrams first, and
+        # stop at an exact match since nothing can beat it
+        best_match, best_score = None, -1.0
+        for candidate in self._blocker(candidates).candidates(query):
+            score = self.calculate_similarity(query, candidate)
+            if score > best_score:
+                best_match, best_score = candidate, score
+                if score >= 1.0:
+                    break
+
+        if best_match is None:
+            logger.debug(f"No plausible candidates for '{query}'")
+            return None
 
         if best_score >= self.threshold:
             logger.info(
@@ -427,10 +450,10 @@ class FuzzyNameMatcher:
         if not candidates:
             return []
 
-        # Calculate scores for all candidates
+        # Calculate scores for plausible candidates only
         scored = [
             (candidate, self.calculate_similarity(query, candidate))
-            for candidate in candidates
+            for candidate in self._blocker(candidates).candidates(query)
         ]
 
         # Filter by threshold and sort
@@ -444,6 +467,146 @@ class FuzzyNameMatcher:
         return filtered[:limit]
 
 
+@lru_cache(maxsize=1)
+def _scorers():
+    if not FUZZY_AVAILABLE:
+        return ()
+    from fuzzywuzzy import fuzz
+
+    # Cheapest first, so early exits skip the expensive partial ratio
+    return (fuzz.ratio, fuzz.token_sort_ratio, fuzz.token_set_ratio, fuzz.partial_ratio)
+
+
+def name_trigrams(name: str) -> set:
+    """Character trigrams of each lowercased name token, padded at both ends."""
+    grams = set()
+    for token in name.lower().split():
+        padded = f" {token} "
+        grams.update(padded[i:i + 3] for i in range(len(padded) - 2))
+    return grams
+
+
+class NameBlocker:
+    """
+    Inverted trigram index for candidate generation (blocking).
+
+    A candidate is plausible when it shares at least min_overlap of the
+    shorter name's trigrams with the query. The fuzzy scorers all compare
+    characters in order, so pairs sharing almost no trigrams cannot reach a
+    useful threshold and are never scored.
+    """
+
+    def __init__(self, names: Iterable[str], min_overlap: float = 0.3):
+        self.names: List[str] = list(names)
+        self.min_overlap = min_overlap
+        self._grams: List[set] = [name_trigrams(n) for n in self.names]
+        self._postings: Dict[str, List[int]] = defaultdict(list)
+        for i, grams in enumerate(self._grams):
+            for gram in grams:
+                self._postings[gram].append(i)
+
+    def candidate_ids(self, query: str) -> List[int]:
+        """Indexes of plausible names, most shared trigrams first."""
+        query_grams = name_trigrams(query)
+        if not query_grams:
+            return []
+
+        shared = Counter()
+        for gram in query_grams:
+            shared.update(self._postings.get(gram, ()))
+
+        plausible = [
+            (count, i) for i, count in shared.items()
+            if count >= self.min_overlap * min(len(query_grams), len(self._grams[i]))
+        ]
+        plausible.sort(key=lambda x: (-x[0], x[1]))
+        return [i for _, i in plausible]
+
+    def candidates(self, query: str) -> List[str]:
+        """Plausible names, most shared trigrams first."""
+        return [self.names[i] for i in self.candidate_ids(query)]
+
+
+def match_contacts(
+    incoming: List[Dict],
+    existing: List[Dict],
+    matcher: Optional["FuzzyNameMatcher"] = None
+) -> Dict[int, Tuple[int, str]]:
+    """
+    Pair synced contacts with existing contacts.json entries.
+
+    Joins in order of confidence, each existing entry matched at most once:
+    1. "id": macOS contact ID
+    2. "phone": exact normalized phone (primary or any of all_phones)
+    3. "name": exact name
+    4. "fuzzy": fuzzy name, scored only against trigram-blocked candidates
+
+    Only the first three identify the same person; a fuzzy pair ("John"
+    scores 100 against "John Smith") is a suggestion, and callers must not
+    overwrite the existing entry on its strength.
+
+    Args:
+        incoming: Contact dicts converted from Contacts.app
+        existing: Contact dicts loaded from contacts.json
+        matcher: Name matcher (default: FuzzyNameMatcher())
+
+    Returns:
+        Dict mapping incoming index to (existing index, join kind)
+    """
+    matcher = matcher or FuzzyNameMatcher()
+    pairs: Dict[int, Tuple[int, str]] = {}
+    taken = set()
+
+    def claim(i: int, j: Optional[int], kind: str) -> bool:
+        if j is None or j in taken:
+            return False
+        pairs[i] = (j, kind)
+        taken.add(j)
+        return True
+
+    by_id = {c["macos_contact_id"]: j for j, c in enumerate(existing) if c.get("macos_contact_id")}
+    by_phone: Dict[str, int] = {}
+    by_name: Dict[str, int] = {}
+    for j, contact in enumerate(existing):
+        for phone in _contact_phones(contact):
+            by_phone.setdefault(phone, j)
+        by_name.setdefault(contact["name"], j)
+
+    unmatched = []
+    for i, contact in enumerate(incoming):
+        if claim(i, by_id.get(contact.get("macos_contact_id")), "id"):
+            continue
+        if any(claim(i, by_phone.get(p), "phone") for p in _contact_phones(contact)):
+            continue
+        unmatched.append(i)
+
+    # Exact names before any fuzzy pair can take their entry
+    unmatched = [i for i in unmatched if not claim(i, by_name.get(incoming[i]["name"]), "name")]
+
+    if unmatched:
+        blocker = NameBlocker(c["name"] for c in existing)
+        for i in unmatched:
+            name = incoming[i]["name"]
+            for j in blocker.candidate_ids(name):
+                if j not in taken and matcher.is_match(name, existing[j]["name"]):
+                    claim(i, j, "fuzzy")
+                    break
+
+    return pairs
+
+
+def _contact_phones(contact: Dict) -> List[str]:
+    """Distinct normalized phones of a contact dict."""
+    values = [contact.get("phone") or ""]
+    values.extend(p.get("value", "") for p in contact.get("all_phones", []))
+    phones = []
+    for value in values:
+        normalized = normalize_phone_number(value)
+        if normalized and normalized not in phones:
+            phones.append(normalized)
+    return phones
+
+
 def normalize_phone_number(phone: str, default_country_code: str = "1") -> str:
     """
     Normalize phone number to a standard format.
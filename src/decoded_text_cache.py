@@ -0,0 +1,140 @@
+"""
+Persistent cache of decoded attributedBody text, keyed by message ROWID.
+
+Decoding an attributedBody blob (bplist parse, marker scans, regex fallback)
+is the dominant per-row cost of most chat.db reads. A delivered message's
+blob doesn't change (edits aside), so decoded text is stored in the sidecar
+database alongside a short hash of the blob; a hash mismatch (edited message,
+or a different chat.db reusing the ROWID) is treated as a miss.
+
+Lookups are batched: one query per fetch via json_each(), regardless of how
+many rows the caller is decoding.
+"""
+
+import hashlib
+import json
+import logging
+import sqlite3
+from pathlib import Path
+from typing import Callable, Dict, Iterable, List, Optional, Tuple
+
+from .chat_db import open_sidecar
+
+logger = logging.getLogger(__name__)
+
+_SCHEMA = """
+    CREATE TABLE IF NOT EXISTS decoded_text (
+        rowid INTEGER PRIMARY KEY,      -- chat.db message.ROWID
+        blob_hash BLOB NOT NULL,
+        text TEXT                       -- NULL = blob had no decodable text
+    );
+    CREATE TABLE IF NOT EXISTS decoded_text_meta (
+        key TEXT PRIMARY KEY,
+        value TEXT
+    );
+"""
+
+
+def blob_hash(blob: bytes) -> bytes:
+    """Short, fast fingerprint used to detect changed blobs."""
+    return hashlib.blake2b(blob, digest_size=8).digest()
+
+
+class DecodedTextCache:
+    """
+    ROWID -> decoded text cache stored in the sidecar database.
+
+    Args:
+        path: Sidecar database path (default: ~/.imessage_rag/chat_index.db)
+        decoder_version: Identifies the decoder that produced cached text;
+            a different version clears the cache so improved decoding applies
+    """
+
+    def __init__(self, path: Optional[Path] = None, decoder_version: int = 1):
+        self.conn = open_sidecar(path)
+        self.conn.executescript(_SCHEMA)
+        self.hits = 0
+        self.misses = 0
+
+        row = self.conn.execute(
+            "SELECT value FROM decoded_text_meta WHERE key = 'decoder_version'"
+        ).fetchone()
+        if row is None or row[0] != str(decoder_version):
+            if row is not None:
+                logger.info(f"Decoder changed ({row[0]} -> {decoder_version}), clearing text cache")
+            with self.conn:
+                self.conn.execute("DELETE FROM decoded_text")
+                self.conn.execute(
+                    "INSERT OR REPLACE INTO decoded_text_meta (key, value) VALUES ('decoder_version', ?)",
+                    (str(decoder_version),),
+                )
+
+    def get_many(self, items: Iterable[Tuple[int, bytes]]) -> Dict[int, Optional[str]]:
+        """
+        Look up cached text for (rowid, blob) pairs in a single query.
+
+        Returns:
+            Dict of rowid -> text for hits only (text may be None for blobs
+            known to contain no text). Missing keys are cache misses.
+        """
+        wanted = {rowid: blob_hash(blob) for rowid, blob in items}
+        if not wanted:
+            return {}
+
+        rows = self.conn.execute(
+            "SELECT rowid, blob_hash, text FROM decoded_text "
+            "WHERE rowid IN (SELECT value FROM json_each(?))",
+            (json.dumps(list(wanted)),),
+        ).fetchall()
+
+        found = {rowid: text for rowid, digest, text in rows if wanted.get(rowid) == digest}
+        self.hits += len(found)
+        self.misses += len(wanted) - len(found)
+        return found
+
+    def put_many(self, items: Iterable[Tuple[int, bytes, Optional[str]]]):
+        """Store (rowid, blob, text) triples."""
+        rows = [(rowid, blob_hash(blob), text) for rowid, blob, text in items]
+        if not rows:
+            return
+        with self.conn:
+            self.conn.executemany(
+                "INSERT OR REPLACE INTO decoded_text (rowid, blob_hash, text) VALUES (?, ?, ?)",
+                rows,
+            )
+
+    def decode_many(
+        self,
+        items: List[Tuple[int, bytes]],
+        decode_batch: Callable[[List[bytes]], List[Optional[str]]],
+    ) -> Dict[int, Optional[str]]:
+        """
+        Return decoded text for every (rowid, blob), decoding only misses.
+
+        Args:
+            items: (rowid, attributedBody) pairs
+            decode_batch: Decoder applied to all cache misses in one call
+                (e.g. messages_interface.decode_attributed_bodies)
+
+        Returns:
+            Dict of rowid -> text (None when the blob has no text)
+        """
+        texts = self.get_many(items)
+        misses = [(rowid, blob) for rowid, blob in items if rowid not in texts]
+        decoded = [
+            (rowid, blob, text)
+            for (rowid, blob), text in zip(misses, decode_batch([blob for _, blob in misses]))
+        ] if misses else []
+        try:
+            self.put_many(decoded)
+        except sqlite3.Error as e:
+            # A read-only/locked sidecar must never break message reads
+            logger.debug(f"Could not store decoded text: {e}")
+
+        texts.update((rowid, text) for rowid, _, text in decoded)
+        return texts
+
+    def stats(self) -> Dict[str, int]:
+        """Hit/miss counters for this instance plus total cached rows."""
+        total = self.conn.execute("SELECT COUNT(*) FROM decoded_text").fetchone()[0]
+        return {"hits": self.hits, "misses": self.misses, "cached_rows": total}
@@ -0,0 +1,332 @@
+"""
+Sidecar link index and shared attachment queries for chat.db.
+
+extract_links used to scan chat.db twice per call (plain text LIKE '%http%',
+then attributedBody blobs decoded in Python) and run a regex over every
+candidate until `limit` links turned up; a quiet --all-time query walked
+the whole history. This module extracts URLs once per message and keeps
+them in the sidecar database (see chat_db.open_sidecar), maintained from
+the highest ROWID already scanned, so listing links is one indexed read.
+
+- message_link: one row per (message ROWID, position) with the URL and the
+  message's date, direction, sender and a short snippet. A ROWID with no
+  rows either had no link or sits below the high-water mark unscanned -
+  the mark is what says which.
+
+During sync, blobs are filtered in SQL (instr() on the raw bytes for
+"http") before anything is decoded, and decoding goes through the
+decoded-text cache, so building the index costs roughly one pass over the
+messages that actually contain a URL.
+
+Attachments and voice messages are already structured in chat.db; they
+share one attachment query here instead of two hand-written joins.
+
+All listings page by ROWID: pass the smallest ROWID of a page as
+before_rowid to get the next one. A page never splits a message - when
+`limit` falls inside a message with several links or attachments, the
+rest of that message is added, so a page can run slightly past `limit`
+and the next page's ROWID < cursor doesn't skip anything. ROWID order is
+insertion order, which is send order apart from messages restored from
+backup.
+
+CS Concept: **Keyset pagination** - "WHERE rowid < last_seen ORDER BY rowid
+DESC LIMIT n" reads n index entries per page no matter how deep the page,
+where OFFSET would re-read every skipped row.
+"""
+
+import logging
+import re
+import sqlite3
+from pathlib import Path
+from typing import Any, Callable, Dict, Iterable, List, Optional, Tuple
+
+from .chat_db import open_sidecar
+
+logger = logging.getLogger(__name__)
+
+# ROWID range scanned per transaction during sync
+SYNC_BATCH_SIZE = 5000
+
+# Characters of message text kept beside each link
+SNIPPET_CHARS = 200
+
+URL_RE = re.compile(r'https?://[^\s<>"{}|\\^`\[\]]+')
+
+_SCHEMA = """
+    CREATE TABLE IF NOT EXISTS media_index_meta (
+        key TEXT PRIMARY KEY,
+        value TEXT
+    );
+    CREATE TABLE IF NOT EXISTS message_link (
+        rowid INTEGER NOT NULL,         -- chat.db message.ROWID
+        position INTEGER NOT NULL,      -- Order of the URL within the message
+        url TEXT NOT NULL,
+        date INTEGER,                   -- Cocoa nanoseconds
+        is_from_me INTEGER,
+        handle TEXT,
+        snippet TEXT,
+        PRIMARY KEY (rowid, position)
+    ) WITHOUT ROWID;
+    CREATE INDEX IF NOT EXISTS idx_message_link_handle ON message_link(handle, rowid);
+"""
+
+# Columns returned by attachment_rows(), in order
+ATTACHMENT_COLUMNS = (
+    "message_rowid", "attachment_id", "filename", "mime_type", "uti", "total_bytes",
+    "is_outgoing", "transfer_name", "created_date", "is_sticker", "message_date",
+    "is_from_me", "is_played", "sender_handle",
+)
+
+# Attachment filter for voice/audio messages
+AUDIO_FILTER = "(m.is_audio_message = 1 OR a.mime_type LIKE 'audio/%' OR a.uti LIKE '%audio%')"
+
+
+def extract_urls(text: Optional[str]) -> List[str]:
+    """URLs in text, with trailing sentence punctuation trimmed."""
+    if not text or "http" not in text:
+        return []
+    return [url.rstrip(".,;:!?)") for url in URL_RE.findall(text)]
+
+
+def snippet(text: str) -> str:
+    return text[:SNIPPET_CHARS] + "..." if len(text) > SNIPPET_CHARS else text
+
+
+class MediaIndex:
+    """
+    Sidecar link index maintained from the chat.db ROWID high-water mark.
+
+    Args:
+        index_path: Sidecar database path (default: ~/.imessage_rag/chat_index.db)
+        source_db: chat.db path the index is built from; a different
+            source triggers a rebuild so links never mix databases
+    """
+
+    def __init__(self, index_path: Optional[Path] = None, source_db: Optional[Path] = None):
+        self.conn = open_sidecar(index_path)
+        self.conn.executescript(_SCHEMA)
+        self.source_db = str(source_db) if source_db else ""
+
+        if self.source_db and self._get_meta("source_db") not in (None, self.source_db):
+            logger.info("Link index built from a different chat.db - rebuilding")
+            self.clear()
+        self._set_meta("source_db", self.source_db)
+        self.conn.commit()
+
+    # ----- metadata -----
+
+    def _get_meta(self, key: str) -> Optional[str]:
+        row = self.conn.execute("SELECT value FROM media_index_meta WHERE key = ?", (key,)).fetchone()
+        return row[0] if row else None
+
+    def _set_meta(self, key: str, value: Any):
+        self.conn.execute(
+            "INSERT OR REPLACE INTO media_index_meta (key, value) VALUES (?, ?)", (key, str(value))
+        )
+
+    @property
+    def max_rowid(self) -> int:
+        """Highest chat.db ROWID already scanned for links."""
+        value = self._get_meta("max_rowid")
+        return int(value) if value else 0
+
+    def clear(self):
+        """Drop all links (next sync rescans from ROWID 0)."""
+        self.conn.execute("DELETE FROM message_link")
+        self.conn.execute("DELETE FROM media_index_meta WHERE key = 'max_rowid'")
+        self.conn.commit()
+
+    # ----- maintenance -----
+
+    def sync(
+        self,
+        chat_conn: sqlite3.Connection,
+        decode_many: Callable[[Iterable[Tuple]], Dict[int, Optional[str]]],
+        batch_size: int = SYNC_BATCH_SIZE,
+    ) -> int:
+        """
+        Extract links from messages added since the last sync.
+
+        Args:
+            chat_conn: Read-only connection to chat.db
+            decode_many: Batch decoder taking (text, attributedBody, ROWID)
+                rows and returning ROWID -> text (MessagesInterface._decode_bodies)
+            batch_size: ROWID range per transaction
+
+        Returns:
+            Number of links added
+        """
+        last_rowid = self.max_rowid
+
+        # chat.db was reset/restored: ROWIDs are no longer comparable
+        chat_max = chat_conn.execute("SELECT COALESCE(MAX(ROWID), 0) FROM message").fetchone()[0]
+        if chat_max < last_rowid:
+            logger.info("chat.db ROWIDs went backwards - rebuilding link index")
+            self.clear()
+            last_rowid = 0
+
+        if chat_max == last_rowid:
+            return 0
+
+        if last_rowid == 0:
+            logger.info("Building link index (first run, may take a moment)...")
+
+        added = 0
+        while last_rowid < chat_max:
+            upper = min(last_rowid + batch_size, chat_max)
+            # Only rows that can hold a URL: plain text mentioning http, or a
+            # blob whose bytes contain it (instr() on a BLOB is a byte search)
+            rows = chat_conn.execute("""
+                SELECT m.text, m.attributedBody, m.date, m.is_from_me, h.id, m.ROWID
+                FROM message m
+                LEFT JOIN handle h ON m.handle_id = h.ROWID
+                WHERE m.ROWID > ? AND m.ROWID <= ?
+                  AND (m.text LIKE '%http%'
+                       OR (m.text IS NULL AND instr(m.attributedBody, X'68747470') > 0))
+            """, (last_rowid, upper)).fetchall()
+
+            texts = decode_many(rows)
+            links = []
+            for text, _, date, is_from_me, handle, rowid in rows:
+                text = text or texts.get(rowid)
+                for position, url in enumerate(extract_urls(text)):
+                    links.append((rowid, position, url, date, 1 if is_from_me else 0, handle, snippet(text)))
+
+            with self.conn:
+                self.conn.executemany(
+                    "INSERT OR REPLACE INTO message_link "
+                    "(rowid, position, url, date, is_from_me, handle, snippet) VALUES (?, ?, ?, ?, ?, ?, ?)",
+                    links,
+                )
+                self._set_meta("max_rowid", upper)
+            added += len(links)
+            last_rowid = upper
+
+        logger.info(f"Link index: added {added} links (max ROWID {last_rowid})")
+        return added
+
+    # ----- queries -----
+
+    def links(
+        self,
+        handle_pattern: Optional[str] = None,
+        since_cocoa: Optional[int] = None,
+        before_rowid: Optional[int] = None,
+        limit: int = 100,
+    ) -> List[Dict[str, Any]]:
+        """
+        Newest links first, one page of at most `limit`.
+
+        Args:
+            handle_pattern: SQL LIKE pattern on the sender handle (already escaped)
+            since_cocoa: Only messages at or after this Cocoa date
+            before_rowid: Only messages with a smaller ROWID (next page)
+            limit: Links per page; the last message's remaining links
+                are always included, so a page may hold a few more
+
+        Returns:
+            Dicts with rowid, url, snippet, date (Cocoa ns), is_from_me, handle
+        """
+        where, params = [], []
+        if handle_pattern:
+            where.append("handle LIKE ? ESCAPE '\\'")
+            params.append(handle_pattern)
+        if since_cocoa is not None:
+            where.append("date >= ?")
+            params.append(since_cocoa)
+        if before_rowid is not None:
+            where.append("rowid < ?")
+            params.append(before_rowid)
+
+        def select(extra: List[str], extra_params: List[Any], limit_sql: str = "") -> List[Tuple]:
+            clauses = where + extra
+            where_sql = f"WHERE {' AND '.join(clauses)}" if clauses else ""
+            return self.conn.execute(f"""
+                SELECT rowid, url, snippet, date, is_from_me, handle, position
+                FROM message_link
+                {where_sql}
+                ORDER BY rowid DESC, position
+                {limit_sql}
+            """, (*params, *extra_params)).fetchall()
+
+        rows = select([], [limit], "LIMIT ?")
+        if rows and len(rows) >= limit:
+            # Finish the last message so the next page (rowid < cursor) misses nothing
+            last_rowid, last_position = rows[-1][0], rows[-1][6]
+            rows += select(["rowid = ?", "position > ?"], [last_rowid, last_position])
+        return [
+            {"rowid": rowid, "url": url, "snippet": text, "date": date,
+             "is_from_me": bool(is_from_me), "handle": handle}
+            for rowid, url, text, date, is_from_me, handle, _ in rows
+        ]
+
+    def stats(self) -> Dict[str, int]:
+        total = self.conn.execute("SELECT COUNT(*) FROM message_link").fetchone()[0]
+        return {"links": total, "max_rowid": self.max_rowid}
+
+
+def attachment_rows(
+    chat_conn: sqlite3.Connection,
+    handle_pattern: Optional[str] = None,
+    mime_prefix: Optional[str] = None,
+    audio_only: bool = False,
+    before_rowid: Optional[int] = None,
+    limit: int = 50,
+) -> List[Dict[str, Any]]:
+    """
+    One page of attachments from chat.db, newest message first.
+
+    The shared query behind get_attachments and get_voice_messages. Walking
+    message by ROWID (its primary key) lets SQLite stop after `limit`
+    matches instead of sorting every attachment by date. Like
+    MediaIndex.links, a page never stops partway through a message.
+
+    Args:
+        chat_conn: Read-only connection to chat.db
+        handle_pattern: SQL LIKE pattern on the sender handle (already escaped)
+        mime_prefix: MIME type prefix, e.g. "image/"
+        audio_only: Only voice/audio attachments
+        before_rowid: Only messages with a smaller ROWID (next page)
+        limit: Attachments per page; the last message's remaining
+            attachments are always included, so a page may hold a few more
+
+    Returns:
+        Dicts keyed by ATTACHMENT_COLUMNS (dates are raw Cocoa values)
+    """
+    where: List[str] = []
+    params: List[Any] = []
+    if handle_pattern:
+        where.append("h.id LIKE ? ESCAPE '\\'")
+        params.append(handle_pattern)
+    if mime_prefix:
+        where.append("a.mime_type LIKE ?")
+        params.append(f"{mime_prefix}%")
+    if audio_only:
+        where.append(AUDIO_FILTER)
+    if before_rowid is not None:
+        where.append("m.ROWID < ?")
+        params.append(before_rowid)
+
+    def select(extra: List[str], extra_params: List[Any], limit_sql: str = "") -> List[Tuple]:
+        clauses = where + extra
+        where_sql = f"WHERE {' AND '.join(clauses)}" if clauses else ""
+        return chat_conn.execute(f"""
+            SELECT
+                m.ROWID, a.ROWID, a.filename, a.mime_type, a.uti, a.total_bytes,
+                a.is_outgoing, a.transfer_name, a.created_date, a.is_sticker, m.date,
+                m.is_from_me, m.is_played, h.id
+            FROM message m
+            JOIN message_attachment_join maj ON maj.message_id = m.ROWID
+            JOIN attachment a ON a.ROWID = maj.attachment_id
+            LEFT JOIN handle h ON m.handle_id = h.ROWID
+            {where_sql}
+            ORDER BY m.ROWID DESC, a.ROWID
+            {limit_sql}
+        """, (*params, *extra_params)).fetchall()
+
+    rows = select([], [limit], "LIMIT ?")
+    if rows and len(rows) >= limit:
+        # Finish the last message so the next page (ROWID < cursor) misses nothing
+        rows += select(["m.ROWID = ?", "a.ROWID > ?"], [rows[-1][0], rows[-1][1]])
+    return [dict(zip(ATTACHMENT_COLUMNS, row)) for row in rows]
+
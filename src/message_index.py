@@ -0,0 +1,317 @@
+"""
+FTS5 shadow index of chat.db message text for keyword search.
+
+chat.db is read-only and, on macOS Ventura+, most message text only exists
+inside the attributedBody blob, so SQL LIKE cannot search it. This module
+keeps a sidecar SQLite database (see chat_db.open_sidecar) holding decoded
+text keyed by message.ROWID in an FTS5 table, maintained incrementally from
+the highest ROWID already indexed.
+
+Usage:
+    index = MessageSearchIndex()
+    index.sync(chat_conn, decode_many=messages_interface._decode_bodies)
+    rows = index.search(chat_conn, "dinner plans", limit=20)
+"""
+
+import logging
+import re
+import sqlite3
+from pathlib import Path
+from typing import Any, Callable, Dict, Iterable, List, Optional, Tuple
+
+from .chat_db import open_sidecar
+
+logger = logging.getLogger(__name__)
+
+# Messages decoded and inserted per transaction during sync
+SYNC_BATCH_SIZE = 5000
+
+# Tokens of context FTS5 snippet() shows around a match
+SNIPPET_TOKENS = 20
+
+SORT_RECENT = "recent"
+SORT_RELEVANCE = "relevance"
+
+_SCHEMA = """
+    CREATE TABLE IF NOT EXISTS message_index_meta (
+        key TEXT PRIMARY KEY,
+        value TEXT
+    );
+    CREATE TABLE IF NOT EXISTS message_meta (
+        rowid INTEGER PRIMARY KEY,      -- chat.db message.ROWID
+        date INTEGER,                   -- Cocoa nanoseconds
+        is_from_me INTEGER,
+        handle TEXT,
+        cache_roomnames TEXT
+    );
+    CREATE INDEX IF NOT EXISTS idx_message_meta_date ON message_meta(date);
+    CREATE VIRTUAL TABLE IF NOT EXISTS message_fts USING fts5(
+        text,
+        tokenize = 'unicode61 remove_diacritics 2'
+    );
+"""
+
+# Same tokenisation as unicode61: letters/digits, underscore is a separator
+_TOKEN_RE = re.compile(r"[^\W_]+", re.UNICODE)
+
+
+def fts5_available() -> bool:
+    """Return True if this SQLite build supports FTS5."""
+    try:
+        conn = sqlite3.connect(":memory:")
+        conn.execute("CREATE VIRTUAL TABLE t USING fts5(x)")
+        conn.close()
+        return True
+    except sqlite3.Error:
+        return False
+
+
+def build_fts_query(query: str) -> Optional[str]:
+    """
+    Convert free text into a safe FTS5 MATCH expression.
+
+    The query is matched as a phrase with a prefix on the last token, which
+    mirrors the old substring behaviour ("SF" matches "SFO", "dinner pl"
+    matches "dinner plans") without exposing FTS5 operator syntax.
+
+    Returns:
+        MATCH expression, or None if the query has no searchable tokens
+    """
+    tokens = _TOKEN_RE.findall(query or "")
+    if not tokens:
+        return None
+    return '"' + " ".join(tokens) + '"*'
+
+
+class MessageSearchIndex:
+    """
+    Incrementally maintained FTS5 index of message text.
+
+    Args:
+        index_path: Sidecar database path (default: ~/.imessage_rag/chat_index.db)
+        source_db: chat.db path the index is built from; a different source
+            triggers a rebuild so indexes never mix databases
+    """
+
+    def __init__(self, index_path: Optional[Path] = None, source_db: Optional[Path] = None):
+        self.conn = open_sidecar(index_path)
+        self.conn.executescript(_SCHEMA)
+        self.source_db = str(source_db) if source_db else ""
+
+        if self.source_db and self._get_meta("source_db") not in (None, self.source_db):
+            logger.info("Message index built from a different chat.db - rebuilding")
+            self.clear()
+        self._set_meta("source_db", self.source_db)
+        self.conn.commit()
+
+    # ----- metadata -----
+
+    def _get_meta(self, key: str) -> Optional[str]:
+        row = self.conn.execute(
+            "SELECT value FROM message_index_meta WHERE key = ?", (key,)
+        ).fetchone()
+        return row[0] if row else None
+
+    def _set_meta(self, key: str, value: Any):
+        self.conn.execute(
+            "INSERT OR REPLACE INTO message_index_meta (key, value) VALUES (?, ?)",
+            (key, str(value)),
+        )
+
+    @property
+    def max_rowid(self) -> int:
+        """Highest chat.db ROWID already processed."""
+        value = self._get_meta("max_rowid")
+        return int(value) if value else 0
+
+    def clear(self):
+        """Drop all indexed messages (next sync rebuilds from ROWID 0)."""
+        self.conn.execute("DELETE FROM message_fts")
+        self.conn.execute("DELETE FROM message_meta")
+        self.conn.execute("DELETE FROM message_index_meta WHERE key = 'max_rowid'")
+        self.conn.commit()
+
+    # ----- maintenance -----
+
+    def sync(
+        self,
+        chat_conn: sqlite3.Connection,
+        decode_many: Callable[[Iterable[Tuple]], Dict[int, Optional[str]]],
+        batch_size: int = SYNC_BATCH_SIZE,
+    ) -> int:
+        """
+        Index messages added to chat.db since the last sync.
+
+        Args:
+            chat_conn: Read-only connection to chat.db
+            decode_many: Batch decoder taking (text, attributedBody, ROWID)
+                rows and returning ROWID -> text (MessagesInterface._decode_bodies)
+            batch_size: Messages per transaction
+
+        Returns:
+            Number of messages added to the index
+        """
+        last_rowid = self.max_rowid
+
+        # chat.db was reset/restored: ROWIDs are no longer comparable
+        chat_max = chat_conn.execute("SELECT COALESCE(MAX(ROWID), 0) FROM message").fetchone()[0]
+        if chat_max < last_rowid:
+            logger.info("chat.db ROWIDs went backwards - rebuilding message index")
+            self.clear()
+            last_rowid = 0
+
+        if chat_max == last_rowid:
+            return 0
+
+        if last_rowid == 0:
+            logger.info("Building message search index (first run, may take a moment)...")
+
+        added = 0
+        while True:
+            rows = chat_conn.execute("""
+                SELECT
+                    message.ROWID,
+                    message.text,
+                    message.attributedBody,
+                    message.date,
+                    message.is_from_me,
+                    handle.id,
+                    message.cache_roomnames
+                FROM message
+                LEFT JOIN handle ON message.handle_id = handle.ROWID
+                WHERE message.ROWID > ?
+                ORDER BY message.ROWID
+                LIMIT ?
+            """, (last_rowid, batch_size)).fetchall()
+
+            if not rows:
+                break
+
+            texts = decode_many((row[1], row[2], row[0]) for row in rows)
+
+            fts_rows: List[Tuple[int, str]] = []
+            meta_rows: List[Tuple] = []
+            for rowid, text, attributed_body, date_cocoa, is_from_me, handle_id, roomnames in rows:
+                message_text = text
+                if not message_text and attributed_body:
+                    message_text = texts.get(rowid)
+                if not message_text:
+                    continue  # Attachments, tapbacks without text, etc.
+                fts_rows.append((rowid, message_text))
+                meta_rows.append((rowid, date_cocoa, is_from_me, handle_id, roomnames))
+
+            last_rowid = rows[-1][0]
+            with self.conn:
+                self.conn.executemany(
+                    "INSERT OR REPLACE INTO message_fts (rowid, text) VALUES (?, ?)", fts_rows
+                )
+                self.conn.executemany(
+                    "INSERT OR REPLACE INTO message_meta "
+                    "(rowid, date, is_from_me, handle, cache_roomnames) VALUES (?, ?, ?, ?, ?)",
+                    meta_rows,
+                )
+                self._set_meta("max_rowid", last_rowid)
+            added += len(fts_rows)
+
+            if len(rows) < batch_size:
+                break
+
+        logger.info(f"Message index: added {added} messages (max ROWID {last_rowid})")
+        return added
+
+    def remove(self, rowids: List[int]):
+        """Remove messages (e.g. deleted from chat.db) from the index."""
+        if not rowids:
+            return
+        with self.conn:
+            self.conn.executemany("DELETE FROM message_fts WHERE rowid = ?", [(r,) for r in rowids])
+            self.conn.executemany("DELETE FROM message_meta WHERE rowid = ?", [(r,) for r in rowids])
+
+    # ----- querying -----
+
+    def search(
+        self,
+        chat_conn: sqlite3.Connection,
+        query: str,
+        handle_pattern: Optional[str] = None,
+        limit: int = 50,
+        sort: str = SORT_RECENT,
+    ) -> Optional[List[Dict[str, Any]]]:
+        """
+        Search indexed messages.
+
+        Args:
+            chat_conn: chat.db connection, used to drop messages deleted since indexing
+            query: Free-text query
+            handle_pattern: Optional LIKE pattern on the handle (already
+                escaped with sanitize_like_pattern; matched with ESCAPE '\\')
+            limit: Max results
+            sort: "recent" (newest first) or "relevance" (BM25 rank)
+
+        Returns:
+            Row dicts (rowid, text, date, is_from_me, handle, cache_roomnames,
+            snippet, rank), or None if the query has no searchable tokens.
+        """
+        match = build_fts_query(query)
+        if match is None:
+            return None
+
+        sql = f"""
+            SELECT
+                message_fts.rowid,
+                message_fts.text,
+                message_meta.date,
+                message_meta.is_from_me,
+                message_meta.handle,
+                message_meta.cache_roomnames,
+                snippet(message_fts, 0, '', '', '...', {SNIPPET_TOKENS}),
+                bm25(message_fts)
+            FROM message_fts
+            JOIN message_meta ON message_meta.rowid = message_fts.rowid
+            WHERE message_fts MATCH ?
+        """
+        params: List[Any] = [match]
+        if handle_pattern:
+            sql += " AND message_meta.handle LIKE ? ESCAPE '\\'"
+            params.append(handle_pattern)
+        if sort == SORT_RELEVANCE:
+            sql += " ORDER BY bm25(message_fts), message_meta.date DESC"
+        else:
+            sql += " ORDER BY message_meta.date DESC"
+        sql += " LIMIT ?"
+        params.append(limit)
+
+        # Deleted messages are pruned lazily; retry so the caller still gets `limit` rows
+        for _ in range(3):
+            rows = self.conn.execute(sql, params).fetchall()
+            missing = self._missing_rowids(chat_conn, [r[0] for r in rows])
+            if not missing:
+                break
+            self.remove(missing)
+
+        return [
+            {
+                "rowid": r[0],
+                "text": r[1],
+                "date": r[2],
+                "is_from_me": r[3],
+                "handle": r[4],
+                "cache_roomnames": r[5],
+                "snippet": r[6],
+                "rank": r[7],
+            }
+            for r in rows
+            if r[0] not in missing
+        ]
+
+    @staticmethod
+    def _missing_rowids(chat_conn: sqlite3.Connection, rowids: List[int]) -> List[int]:
+        if not rowids:
+            return []
+        placeholders = ",".join("?" * len(rowids))
+        present = {
+            row[0] for row in chat_conn.execute(
+                f"SELECT ROWID FROM message WHERE ROWID IN ({placeholders})", rowids
+            )
+        }
+        return [r for r in rowids if r not in present]
@@ -8,39 +8,19 @@ Sprint 1: Basic AppleScript sending
 Sprint 1.5: Message history reading with attributedBody parsing (macOS Ventura+)
 """
 
-import subprocess
+import json
 import sqlite3
 import logging
 import plistlib
 import re
 from pathlib import Path
-from typing import Optional, List, Dict, Tuple
+from typing import Optional, List, Dict, Tuple, Iterable, Iterator
 from datetime import datetime, timedelta
 
-logger = logging.getLogger(__name__)
-
-
-def escape_applescript_string(s: str) -> str:
-    r"""
-    Escape a string for safe use in AppleScript.
+from .chat_db import ChatDBConnection
+from .tracing import span
 
-    AppleScript strings use backslash escapes, so we must:
-    1. Escape backslashes first (\ -> \\)
-    2. Then escape double quotes (" -> \")
-
-    This prevents injection attacks where user data could break out of
-    the quoted string context in AppleScript commands.
-
-    Args:
-        s: The string to escape
-
-    Returns:
-        Escaped string safe for AppleScript double-quoted strings
-    """
-    if s is None:
-        return ""
-    # Escape backslashes first, then quotes
-    return s.replace('\\', '\\\\').replace('"', '\\"')
+logger = logging.getLogger(__name__)
 
 
 def is_group_chat_identifier(chat_identifier: Optional[str]) -> bool:
@@ -95,6 +75,22 @@ def sanitize_like_pattern(value: str) -> str:
     return value.replace('\\', '\\\\').replace('%', '\\%').replace('_', '\\_')
 
 
+# Rough characters per token for English chat text (GPT/Claude tokenizers)
+CHARS_PER_TOKEN = 4
+
+
+def estimate_tokens(text: str) -> int:
+    """Cheap token estimate used for output budgets (no tokenizer dependency)."""
+    return (len(text) + CHARS_PER_TOKEN - 1) // CHARS_PER_TOKEN
+
+
+def cocoa_to_iso(cocoa_ns: Optional[int]) -> Optional[str]:
+    """Convert a chat.db Cocoa timestamp (ns since 2001-01-01) to ISO 8601."""
+    if not cocoa_ns:
+        return None
+    return (datetime(2001, 1, 1) + timedelta(seconds=cocoa_ns / 1_000_000_000)).isoformat()
+
+
 def parse_attributed_body(blob: bytes) -> Optional[str]:
     """
     Parse the attributedBody column from macOS Messages database.
@@ -168,10 +164,119 @@ def parse_attributed_body(blob: bytes) -> Optional[str]:
         return None
 
 
+# Bump when extract_text_from_blob output changes so cached text is discarded
+DECODER_VERSION = 2
+
+# Every streamtyped archive starts with this header (version 4, "streamtyped")
+STREAMTYPED_HEADER = b"\x04\x0bstreamtyped"
+
+# Class names whose first instance holds the message string
+_STREAMTYPED_STRING_CLASSES = (b"NSString", b"NSMutableString")
+
+
+def parse_streamtyped_string(blob: bytes) -> Optional[str]:
+    """
+    Extract the message string from a streamtyped attributedBody in one pass.
+
+    Layout after the string class name:
+        <class info> 0x2B('+') <length> <UTF-8 bytes>
+    where <length> is a single byte (< 0x80), 0x81 + uint16 LE, or
+    0x82 + uint32 LE. The text is taken with a single slice of that length,
+    so multi-byte characters containing 0x84/0x86 bytes are preserved.
+
+    Args:
+        blob: Raw bytes from the attributedBody column
+
+    Returns:
+        Decoded text, or None if the blob doesn't have the expected layout
+    """
+    for class_name in _STREAMTYPED_STRING_CLASSES:
+        class_idx = blob.find(class_name)
+        if class_idx != -1:
+            break
+    else:
+        return None
+
+    search_start = class_idx + len(class_name)
+    plus_idx = blob.find(b"+", search_start, search_start + 12)
+    if plus_idx == -1 or plus_idx + 1 >= len(blob):
+        return None
+
+    pos = plus_idx + 1
+    length = blob[pos]
+    if length < 0x80:
+        pos += 1
+    elif length == 0x81:
+        length = int.from_bytes(blob[pos + 1:pos + 3], "little")
+        pos += 3
+    elif length == 0x82:
+        length = int.from_bytes(blob[pos + 1:pos + 5], "little")
+        pos += 5
+    else:
+        return None
+
+    end = pos + length
+    if length == 0 or end > len(blob):
+        return None
+
+    text = blob[pos:end].decode("utf-8", errors="ignore").strip()
+    return text or None
+
+
 def extract_text_from_blob(blob: bytes) -> Optional[str]:
     """
     Extract readable text from a binary blob (attributedBody format).
 
+    Streamtyped blobs (what Messages writes) are parsed directly using the
+    length prefix. Anything else - bplist/NSKeyedArchiver blobs or unusual
+    layouts - goes through the older multi-pass heuristics.
+
+    Args:
+        blob: Raw bytes from attributedBody column
+
+    Returns:
+        Extracted text or None
+    """
+    if not blob:
+        return None
+
+    if blob.startswith(STREAMTYPED_HEADER):
+        text = parse_streamtyped_string(blob)
+        if text:
+            return text
+
+    return _extract_text_legacy(blob)
+
+
+def decode_attributed_bodies(blobs: Iterable[Optional[bytes]]) -> List[Optional[str]]:
+    """
+    Decode many attributedBody blobs at once.
+
+    Args:
+        blobs: Blobs in any order (None/empty entries yield None)
+
+    Returns:
+        Decoded text for each blob, in input order
+    """
+    header = STREAMTYPED_HEADER
+    parse = parse_streamtyped_string
+    legacy = _extract_text_legacy
+
+    results: List[Optional[str]] = []
+    append = results.append
+    for blob in blobs:
+        if not blob:
+            append(None)
+            continue
+        text = parse(blob) if blob.startswith(header) else None
+        append(text if text else legacy(blob))
+    return results
+
+
+def _extract_text_legacy(blob: bytes) -> Optional[str]:
+    """
+    Multi-pass heuristic extraction, used when the streamtyped parse fails.
+
     macOS Messages uses a "streamtyped" format where:
     - Header: streamtyped + class hierarchy
     - After "NSString" marker: 5 control bytes + length byte + actual text
@@ -266,19 +371,188 @@ def extract_text_from_blob(blob: bytes) -> Optional[str]:
     return None
 
 
+class MessageRecord:
+    """
+    Lightweight message row yielded by the MessagesInterface.iter_* APIs.
+
+    Uses __slots__ instead of a per-message dict so long streams stay small,
+    but supports the dict-style access the chunker and indexers rely on
+    (record.get("text"), record["_contact_name"] = ..., "phone" in record).
+    Keys without a slot (e.g. "display_name") read as absent.
+    """
+
+    __slots__ = (
+        "rowid", "text", "date", "is_from_me", "phone", "is_group_chat",
+        "group_id", "sender_handle", "contact_name", "_contact_name",
+    )
+
+    def __init__(
+        self,
+        rowid: int,
+        text: str,
+        date: Optional[str],
+        is_from_me: bool,
+        phone: str,
+        is_group_chat: bool,
+        group_id: Optional[str],
+        sender_handle: Optional[str],
+    ):
+        self.rowid = rowid
+        self.text = text
+        self.date = date
+        self.is_from_me = is_from_me
+        self.phone = phone
+        self.is_group_chat = is_group_chat
+        self.group_id = group_id
+        self.sender_handle = sender_handle
+        self.contact_name = None
+        self._contact_name = None
+
+    def get(self, key: str, default=None):
+        value = getattr(self, key, None) if key in self.__slots__ else None
+        return default if value is None else value
+
+    def __getitem__(self, key: str):
+        if key not in self.__slots__:
+            raise KeyError(key)
+        return getattr(self, key)
+
+    def __setitem__(self, key: str, value):
+        if key not in self.__slots__:
+            raise KeyError(f"MessageRecord has no field '{key}'")
+        setattr(self, key, value)
+
+    def __contains__(self, key: str) -> bool:
+        return self.get(key) is not None
+
+    def to_dict(self) -> Dict:
+        """Dict in the get_messages_since() shape, plus rowid."""
+        result = {key: getattr(self, key) for key in self.__slots__ if key != "_contact_name"}
+        if self._contact_name is not None:
+            result["_contact_name"] = self._contact_name
+        return result
+
+    def __repr__(self) -> str:
+        return f"MessageRecord(rowid={self.rowid}, phone={self.phone!r}, date={self.date!r})"
+
+
 class MessagesInterface:
     """Interface to macOS Messages app."""
 
-    def __init__(self, messages_db_path: str = "~/Library/Messages/chat.db"):
+    def __init__(
+        self,
+        messages_db_path: str = "~/Library/Messages/chat.db",
+        sidecar_path: Optional[str] = None,
+    ):
         """
         Initialize Messages interface.
 
         Args:
             messages_db_path: Path to Messages database (default: standard location)
+            sidecar_path: Writable database for derived data such as the
+                keyword search index (default: ~/.imessage_rag/chat_index.db)
         """
         self.messages_db_path = Path(messages_db_path).expanduser()
+        self.sidecar_path = Path(sidecar_path).expanduser() if sidecar_path else None
+        self._db = ChatDBConnection(self.messages_db_path)
+        self._search_index = None
+        self._search_index_failed = False
+        self._text_cache = None
+        self._text_cache_failed = False
+        self._rollups = None
+        self._rollups_failed = False
+        self._media_index = None
+        self._media_index_failed = False
+        self._send_queue = None
         logger.info(f"Initialized MessagesInterface with DB: {self.messages_db_path}")
 
+    def _get_connection(self) -> sqlite3.Connection:
+        """
+        Return this thread's long-lived read-only connection to chat.db.
+
+        The connection is reused across calls (callers must not close it) and
+        reopened automatically if chat.db is replaced.
+        """
+        return self._db.get()
+
+    def close(self):
+        """Release the chat.db connections. Safe to call more than once."""
+        self._db.close()
+
+    def _get_text_cache(self):
+        """Return the persistent decoded-text cache, or None if unavailable."""
+        if self._text_cache is None and not self._text_cache_failed:
+            try:
+                from .decoded_text_cache import DecodedTextCache
+
+                self._text_cache = DecodedTextCache(
+                    self.sidecar_path, decoder_version=DECODER_VERSION
+                )
+            except (sqlite3.Error, OSError) as e:
+                logger.warning(f"Decoded-text cache unavailable, decoding directly: {e}")
+                self._text_cache_failed = True
+        return self._text_cache
+
+    def _decode_bodies(self, rows) -> Dict[int, Optional[str]]:
+        """
+        Decode attributedBody blobs for a batch of rows in one cache lookup.
+
+        Args:
+            rows: Iterable of rows laid out as (text, attributedBody, ..., ROWID).
+                Rows that already have plain text or no blob are skipped.
+
+        Returns:
+            Dict of ROWID -> decoded text (None if the blob holds no text)
+        """
+        with span("decode"):
+            return self._decode_items([(row[-1], row[1]) for row in rows if not row[0] and row[1]])
+
+    def _decode_items(self, items: List[Tuple[int, bytes]]) -> Dict[int, Optional[str]]:
+        """Decode (ROWID, attributedBody) pairs, through the cache when available."""
+        if not items:
+            return {}
+
+        cache = self._get_text_cache()
+        if cache is not None:
+            try:
+                return cache.decode_many(items, decode_attributed_bodies)
+            except sqlite3.Error as e:
+                logger.warning(f"Decoded-text cache failed, decoding directly: {e}")
+                self._text_cache_failed = True
+                self._text_cache = None
+
+        texts = decode_attributed_bodies(blob for _, blob in items)
+        return {rowid: text for (rowid, _), text in zip(items, texts)}
+
+    def _get_search_index(self):
+        """
+        Return the FTS5 keyword index, or None if it can't be used.
+
+        Failures (no FTS5 support, unwritable sidecar) are remembered so
+        search_messages falls back to scanning without retrying every call.
+        """
+        if self._search_index is None and not self._search_index_failed:
+            try:
+                from .message_index import MessageSearchIndex, fts5_available
+
+                if not fts5_available():
+                    raise sqlite3.OperationalError("SQLite built without FTS5")
+                self._search_index = MessageSearchIndex(
+                    index_path=self.sidecar_path,
+                    source_db=self.messages_db_path,
+                )
+            except (sqlite3.Error, OSError) as e:
+                logger.warning(f"Keyword index unavailable, using full scan: {e}")
+                self._search_index_failed = True
+        return self._search_index
+
+    def _get_send_queue(self):
+        """Shared SendQueue, so the compiled send script is reused across calls."""
+        if self._send_queue is None:
+            from .send_queue import SendQueue
+            self._send_queue = SendQueue()
+        return self._send_queue
+
     def send_message(self, phone: str, message: str) -> dict:
         """
         Send an iMessage using AppleScript.
@@ -295,48 +569,29 @@ class MessagesInterface:
         """
         logger.info(f"Sending message to {phone}")
 
-        # Escape user data for safe AppleScript string interpolation
-        # This prevents injection attacks where special characters in
-        # contact names or messages could break out of the quoted context
-        escaped_message = escape_applescript_string(message)
-        escaped_phone = escape_applescript_string(phone)
-
-        # AppleScript to send message
-        # Uses Messages.app automation
-        script = f'''
-        tell application "Messages"
-            set targetService to 1st account whose service type = iMessage
-            set targetBuddy to participant "{escaped_phone}" of targetService
-            send "{escaped_message}" to targetBuddy
-        end tell
-        '''
+        result = self._get_send_queue().send(phone, message)
+        if result["success"]:
+            logger.info(f"Message sent successfully to {phone}")
+        return {"success": result["success"], "error": result["error"]}
 
-        try:
-            # Execute AppleScript
-            result = subprocess.run(
-                ['osascript', '-e', script],
-                capture_output=True,
-                text=True,
-                timeout=10
-            )
+    def send_messages(
+        self,
+        messages: Iterable[Tuple[str, str]],
+        concurrency: Optional[int] = None,
+        on_result=None
+    ) -> List[Dict]:
+        """
+        Send many iMessages through the batched send queue.
 
-            if result.returncode == 0:
-                logger.info(f"Message sent successfully to {phone}")
-                return {"success": True, "error": None}
-            else:
-                error_msg = result.stderr.strip()
-                logger.error(f"Failed to send message: {error_msg}")
-                return {"success": False, "error": error_msg}
-
-        except subprocess.TimeoutExpired:
-            logger.error("AppleScript timeout - Messages.app may not be running")
-            return {
-                "success": False,
-                "error": "Timeout - ensure Messages.app is running"
-            }
-        except Exception as e:
-            logger.error(f"Exception sending message: {e}")
-            return {"success": False, "error": str(e)}
+        Args:
+            messages: (phone or email handle, text) pairs
+            concurrency: osascript processes in flight (default: queue default)
+            on_result: Optional callback(index, result) for progress
+
+        Returns:
+            List[Dict]: {"handle", "success", "error"} per message, in input order
+        """
+        return self._get_send_queue().send_batch(messages, on_result=on_result, concurrency=concurrency)
 
     def get_recent_messages(
         self,
@@ -375,8 +630,8 @@ class MessagesInterface:
             return []
 
         try:
-            # Connect to Messages database (read-only)
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            # Shared read-only connection (see _get_connection)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # Query messages for this contact
@@ -388,7 +643,8 @@ class MessagesInterface:
                     message.attributedBody,
                     message.date,
                     message.is_from_me,
-                    message.cache_roomnames
+                    message.cache_roomnames,
+                    message.ROWID
                 FROM message
                 JOIN handle ON message.handle_id = handle.ROWID
                 WHERE handle.id LIKE ?
@@ -399,17 +655,18 @@ class MessagesInterface:
             # macOS Messages uses time since 2001-01-01 (Cocoa reference date)
             cursor.execute(query, (f"%{phone}%", limit, offset))
             rows = cursor.fetchall()
+            texts = self._decode_bodies(rows)
 
             messages = []
             for row in rows:
-                text, attributed_body, date_cocoa, is_from_me, cache_roomnames = row
+                text, attributed_body, date_cocoa, is_from_me, cache_roomnames, rowid = row
 
                 # Try to get text content:
                 # 1. Use text column if available (older messages)
-                # 2. Parse attributedBody for macOS Ventura+ messages
+                # 2. Parse attributedBody for macOS Ventura+ messages (cached)
                 message_text = text
                 if not message_text and attributed_body:
-                    message_text = extract_text_from_blob(attributed_body)
+                    message_text = texts.get(rowid)
 
                 # Convert Cocoa timestamp to Python datetime
                 # Cocoa epoch: 2001-01-01 00:00:00 UTC
@@ -430,7 +687,6 @@ class MessagesInterface:
                     "group_id": cache_roomnames if is_group_chat else None
                 })
 
-            conn.close()
             logger.info(f"Retrieved {len(messages)} messages")
             return messages
 
@@ -489,7 +745,7 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # Query recent messages across all conversations
@@ -500,7 +756,8 @@ class MessagesInterface:
                     message.date,
                     message.is_from_me,
                     handle.id,
-                    message.cache_roomnames
+                    message.cache_roomnames,
+                    message.ROWID
                 FROM message
                 LEFT JOIN handle ON message.handle_id = handle.ROWID
                 ORDER BY message.date DESC
@@ -509,15 +766,16 @@ class MessagesInterface:
 
             cursor.execute(query, (limit,))
             rows = cursor.fetchall()
+            texts = self._decode_bodies(rows)
 
             messages = []
             for row in rows:
-                text, attributed_body, date_cocoa, is_from_me, handle_id, cache_roomnames = row
+                text, attributed_body, date_cocoa, is_from_me, handle_id, cache_roomnames, rowid = row
 
                 # Extract message text
                 message_text = text
                 if not message_text and attributed_body:
-                    message_text = extract_text_from_blob(attributed_body)
+                    message_text = texts.get(rowid)
 
                 # Convert timestamp
                 if date_cocoa:
@@ -540,7 +798,6 @@ class MessagesInterface:
                     "sender_handle": handle_id  # For group chats, identifies who sent this message
                 })
 
-            conn.close()
             logger.info(f"Retrieved {len(messages)} messages from all conversations")
             return messages
 
@@ -551,6 +808,126 @@ class MessagesInterface:
             logger.error(f"Error retrieving messages: {e}")
             return []
 
+    def list_conversations(self, limit: int = 20) -> List[Dict]:
+        """
+        List conversations (one entry per chat) by most recent activity.
+
+        Served from the sidecar rollups (src/rollup_store.py), so the cost
+        doesn't grow with message history; falls back to a GROUP BY scan
+        if the sidecar can't be used.
+
+        Args:
+            limit: Maximum number of conversations
+
+        Returns:
+            List[Dict]: Conversation dicts with keys:
+                - handle_id: Last sender's handle (or the chat identifier)
+                - chat_identifier / display_name
+                - is_group_chat: Whether the chat has several participants
+                - participants: Participant handles
+                - last_message / last_message_date / last_is_from_me
+                - unread_count: Unread received messages
+                - message_count / sent_count / received_count
+        """
+        logger.info(f"Listing {limit} most recent conversations")
+
+        if not self.messages_db_path.exists():
+            logger.error(f"Messages database not found: {self.messages_db_path}")
+            return []
+
+        try:
+            conn = self._get_connection()
+            rollups = self._synced_rollups(conn)
+            if rollups is not None:
+                chats = rollups.conversations(limit=limit)
+            else:
+                chats = self._scan_conversations(conn, limit)
+
+            conversations = []
+            for chat in chats:
+                last_date_cocoa = chat["last_date"]
+                if last_date_cocoa:
+                    cocoa_epoch = datetime(2001, 1, 1)
+                    last_date = cocoa_epoch + timedelta(seconds=last_date_cocoa / 1_000_000_000)
+                else:
+                    last_date = None
+
+                identifier = chat["chat_identifier"]
+                is_group_chat = len(chat["participants"]) > 1 or is_group_chat_identifier(identifier)
+                conversations.append({
+                    "handle_id": (chat["participants"][0] if len(chat["participants"]) == 1
+                                  else chat["last_handle"] or identifier) or "unknown",
+                    "chat_identifier": identifier,
+                    "display_name": chat["display_name"] or None,
+                    "is_group_chat": is_group_chat,
+                    "participants": chat["participants"],
+                    "last_message": chat["last_text"] or "[message content not available]",
+                    "last_message_date": last_date.isoformat() if last_date else None,
+                    "last_is_from_me": bool(chat["last_is_from_me"]),
+                    "unread_count": chat["unread_count"],
+                    "message_count": chat["sent_count"] + chat["received_count"],
+                    "sent_count": chat["sent_count"],
+                    "received_count": chat["received_count"],
+                })
+
+            logger.info(f"Listed {len(conversations)} conversations")
+            return conversations
+
+        except sqlite3.Error as e:
+            logger.error(f"Database error: {e}")
+            return []
+        except Exception as e:
+            logger.error(f"Error listing conversations: {e}")
+            return []
+
+    def _scan_conversations(self, conn: sqlite3.Connection, limit: int) -> List[Dict]:
+        """Rollup-shaped conversation rows computed directly from chat.db."""
+        rows = conn.execute("""
+            WITH stats AS (
+                SELECT
+                    cmj.chat_id,
+                    MAX(m.ROWID) AS last_rowid,
+                    SUM(CASE WHEN m.is_from_me = 1 THEN 1 ELSE 0 END) AS sent,
+                    SUM(CASE WHEN m.is_from_me = 0 THEN 1 ELSE 0 END) AS received,
+                    SUM(CASE WHEN m.is_from_me = 0 AND m.is_read = 0 THEN 1 ELSE 0 END) AS unread
+                FROM chat_message_join cmj
+                JOIN message m ON m.ROWID = cmj.message_id
+                GROUP BY cmj.chat_id
+            )
+            SELECT
+                stats.chat_id, c.chat_identifier, c.display_name,
+                m.text, m.attributedBody, m.date, m.is_from_me, h.id,
+                stats.sent, stats.received, stats.unread, m.ROWID
+            FROM stats
+            JOIN message m ON m.ROWID = stats.last_rowid
+            LEFT JOIN handle h ON m.handle_id = h.ROWID
+            LEFT JOIN chat c ON c.ROWID = stats.chat_id
+            ORDER BY m.date DESC
+            LIMIT ?
+        """, (limit,)).fetchall()
+        texts = self._decode_bodies([(r[3], r[4], r[11]) for r in rows])
+
+        chats = []
+        for (chat_id, identifier, display_name, text, _, date, is_from_me, handle,
+             sent, received, unread, rowid) in rows:
+            participants = [p[0] for p in conn.execute(
+                "SELECT h.id FROM chat_handle_join chj JOIN handle h ON h.ROWID = chj.handle_id "
+                "WHERE chj.chat_id = ?", (chat_id,)
+            )]
+            chats.append({
+                "chat_identifier": identifier,
+                "display_name": display_name,
+                "participants": participants,
+                "last_date": date,
+                "last_is_from_me": is_from_me,
+                "last_handle": handle,
+                "last_text": text or texts.get(rowid),
+                "sent_count": sent or 0,
+                "received_count": received or 0,
+                "unread_count": unread or 0,
+            })
+        return chats
+
     def get_messages_since(
         self,
         since: datetime,
@@ -581,7 +958,7 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # Convert datetime to Cocoa timestamp (nanoseconds since 2001-01-01)
@@ -598,7 +975,8 @@ class MessagesInterface:
                     message.date,
                     message.is_from_me,
                     handle.id,
-                    message.cache_roomnames
+                    message.cache_roomnames,
+                    message.ROWID
                 FROM message
                 LEFT JOIN handle ON message.handle_id = handle.ROWID
                 WHERE message.date >= ?
@@ -612,15 +990,16 @@ class MessagesInterface:
 
             cursor.execute(query, params)
             rows = cursor.fetchall()
+            texts = self._decode_bodies(rows)
 
             messages = []
             for row in rows:
-                text, attributed_body, date_cocoa, is_from_me, handle_id, cache_roomnames = row
+                text, attributed_body, date_cocoa, is_from_me, handle_id, cache_roomnames, rowid = row
 
                 # Extract message text
                 message_text = text
                 if not message_text and attributed_body:
-                    message_text = extract_text_from_blob(attributed_body)
+                    message_text = texts.get(rowid)
 
                 # Convert timestamp
                 if date_cocoa:
@@ -642,7 +1021,6 @@ class MessagesInterface:
                     "sender_handle": handle_id
                 })
 
-            conn.close()
             logger.info(f"Retrieved {len(messages)} messages since {since.isoformat()}")
             return messages
 
@@ -653,21 +1031,315 @@ class MessagesInterface:
             logger.error(f"Error retrieving messages: {e}")
             return []
 
+    def get_max_rowid(self) -> int:
+        """Highest message ROWID in chat.db (0 if empty or unreadable)."""
+        try:
+            row = self._get_connection().execute("SELECT MAX(ROWID) FROM message").fetchone()
+            return row[0] or 0
+        except sqlite3.Error as e:
+            logger.error(f"Database error: {e}")
+            return 0
+
+    def iter_messages(
+        self,
+        after_rowid: int = 0,
+        since: Optional[datetime] = None,
+        phone: Optional[str] = None,
+        limit: Optional[int] = None,
+        latest: bool = False,
+        batch_size: int = 1000,
+        rowids: Optional[Iterable[int]] = None,
+    ) -> Iterator[MessageRecord]:
+        """
+        Stream messages in ROWID (arrival) order with bounded memory.
+
+        Pages through chat.db by ROWID range (the primary key), one
+        `batch_size` page at a time, so a full-history scan never holds more
+        than one page of rows and decoded text. Each page is a fresh indexed
+        query, so the connection is free between pages and a replaced
+        chat.db (see ChatDBConnection) is picked up mid-stream.
+
+        Args:
+            after_rowid: Only yield messages with ROWID > this value
+            since: Only yield messages with date >= this timestamp
+            phone: Only yield messages with handles matching this phone/handle
+            limit: Maximum number of messages to yield
+            latest: With `limit`, yield the newest `limit` matching messages
+                (still in ascending order) instead of the oldest
+            batch_size: Rows fetched and decoded per page
+            rowids: Only yield messages with these ROWIDs (e.g. to re-read
+                a conversation window recorded by the indexer)
+
+        Yields:
+            MessageRecord for each message, oldest ROWID first
+
+        Example:
+            for msg in interface.iter_messages(batch_size=5000):
+                process(msg.get("text"))
+        """
+        if not self.messages_db_path.exists():
+            logger.error(f"Messages database not found: {self.messages_db_path}")
+            return
+
+        cocoa_epoch = datetime(2001, 1, 1)
+        filters, params = [], []
+        if since is not None:
+            filters.append("message.date >= ?")
+            params.append(int((since - cocoa_epoch).total_seconds() * 1_000_000_000))
+        if phone:
+            filters.append("handle.id LIKE ?")
+            params.append(f"%{phone}%")
+        if rowids is not None:
+            # One JSON parameter instead of a variable-length IN (?, ?, ...)
+            filters.append("message.ROWID IN (SELECT value FROM json_each(?))")
+            params.append(json.dumps(sorted(set(rowids))))
+        where = "".join(f" AND {f}" for f in filters)
+
+        remaining = limit
+        yielded = 0
+        try:
+            conn = self._get_connection()
+            cursor = conn.cursor()
+
+            if latest and limit:
+                # Lowest ROWID among the newest `limit` matches becomes the floor
+                cursor.execute(
+                    f"""
+                    SELECT MIN(rid) FROM (
+                        SELECT message.ROWID AS rid
+                        FROM message
+                        LEFT JOIN handle ON message.handle_id = handle.ROWID
+                        WHERE message.ROWID > ?{where}
+                        ORDER BY message.ROWID DESC
+                        LIMIT ?
+                    )
+                    """,
+                    [after_rowid, *params, limit],
+                )
+                floor = cursor.fetchone()[0]
+                if floor is None:
+                    return
+                after_rowid = floor - 1
+
+            query = f"""
+                SELECT
+                    message.text,
+                    message.attributedBody,
+                    message.date,
+                    message.is_from_me,
+                    handle.id,
+                    message.cache_roomnames,
+                    message.ROWID
+                FROM message
+                LEFT JOIN handle ON message.handle_id = handle.ROWID
+                WHERE message.ROWID > ?{where}
+                ORDER BY message.ROWID ASC
+                LIMIT ?
+            """
+
+            last_rowid = after_rowid
+            while remaining is None or remaining > 0:
+                page_size = batch_size if remaining is None else min(batch_size, remaining)
+                cursor = self._get_connection().cursor()
+                cursor.execute(query, [last_rowid, *params, page_size])
+                rows = cursor.fetchmany(page_size)
+                if not rows:
+                    break
+                texts = self._decode_bodies(rows)
+
+                for text, attributed_body, date_cocoa, is_from_me, handle_id, cache_roomnames, rowid in rows:
+                    message_text = text
+                    if not message_text and attributed_body:
+                        message_text = texts.get(rowid)
+
+                    if date_cocoa:
+                        date = (cocoa_epoch + timedelta(seconds=date_cocoa / 1_000_000_000)).isoformat()
+                    else:
+                        date = None
+
+                    is_group_chat = is_group_chat_identifier(cache_roomnames)
+                    yield MessageRecord(
+                        rowid=rowid,
+                        text=message_text or "[message content not available]",
+                        date=date,
+                        is_from_me=bool(is_from_me),
+                        phone=handle_id or "unknown",
+                        is_group_chat=is_group_chat,
+                        group_id=cache_roomnames if is_group_chat else None,
+                        sender_handle=handle_id,
+                    )
+
+                yielded += len(rows)
+                last_rowid = rows[-1][-1]
+                if remaining is not None:
+                    remaining -= len(rows)
+                if len(rows) < page_size:
+                    break
+
+        except sqlite3.Error as e:
+            logger.error(f"Database error: {e}")
+        except Exception as e:
+            logger.error(f"Error streaming messages: {e}")
+
+        logger.info(f"Streamed {yielded} messages")
+
+    def iter_messages_since(
+        self,
+        since: datetime,
+        limit: Optional[int] = None,
+        batch_size: int = 1000,
+    ) -> Iterator[MessageRecord]:
+        """
+        Streaming variant of get_messages_since().
+
+        Yields MessageRecords in ROWID order instead of building a list;
+        see iter_messages() for paging details.
+        """
+        return self.iter_messages(since=since, limit=limit, batch_size=batch_size)
+
+    def iter_recent_messages(
+        self,
+        phone: str,
+        limit: Optional[int] = None,
+        batch_size: int = 1000,
+    ) -> Iterator[MessageRecord]:
+        """
+        Streaming variant of get_recent_messages().
+
+        Yields the newest `limit` messages with a contact (all of them when
+        limit is None), oldest first.
+        """
+        return self.iter_messages(phone=phone, limit=limit, latest=True, batch_size=batch_size)
+
+    def iter_all_recent_conversations(
+        self,
+        limit: Optional[int] = None,
+        batch_size: int = 1000,
+    ) -> Iterator[MessageRecord]:
+        """
+        Streaming variant of get_all_recent_conversations().
+
+        Yields the newest `limit` messages across all conversations (full
+        history when limit is None), oldest first.
+        """
+        return self.iter_messages(limit=limit, latest=True, batch_size=batch_size)
+
+    def _synced_rollups(self, conn: sqlite3.Connection):
+        """
+        Return conversation rollups brought up to date with chat.db, or None.
+
+        Like the keyword index, failures are remembered so listing commands
+        fall back to GROUP BY scans without retrying every call.
+        """
+        if self._rollups is None and not self._rollups_failed:
+            try:
+                from .rollup_store import ConversationRollups
+
+                self._rollups = ConversationRollups(
+                    index_path=self.sidecar_path,
+                    source_db=self.messages_db_path,
+                )
+            except (sqlite3.Error, OSError) as e:
+                logger.warning(f"Conversation rollups unavailable, using full scans: {e}")
+                self._rollups_failed = True
+                return None
+        if self._rollups is None:
+            return None
+
+        try:
+            with span("sync"):
+                self._rollups.sync(conn, decode_many=self._decode_bodies)
+            return self._rollups
+        except sqlite3.Error as e:
+            logger.warning(f"Conversation rollup sync failed, using full scan: {e}")
+            return None
+
+    def _synced_media_index(self, conn: sqlite3.Connection):
+        """
+        Return the link index brought up to date with chat.db, or None.
+
+        Failures are remembered so extract_links falls back to scanning
+        chat.db without retrying every call.
+        """
+        if self._media_index is None and not self._media_index_failed:
+            try:
+                from .media_index import MediaIndex
+
+                self._media_index = MediaIndex(
+                    index_path=self.sidecar_path,
+                    source_db=self.messages_db_path,
+                )
+            except (sqlite3.Error, OSError) as e:
+                logger.warning(f"Link index unavailable, scanning messages: {e}")
+                self._media_index_failed = True
+                return None
+        if self._media_index is None:
+            return None
+
+        try:
+            with span("sync"):
+                self._media_index.sync(conn, decode_many=self._decode_bodies)
+            return self._media_index
+        except sqlite3.Error as e:
+            logger.warning(f"Link index sync failed, scanning messages: {e}")
+            return None
+
+    def sync_sidecars(self) -> Dict[str, bool]:
+        """
+        Bring the keyword index, conversation rollups and link index up to date now.
+
+        All normally sync lazily on the next query; a watcher calls this
+        after each chat.db change so queries never pay for a backlog. Each
+        sync reads only rows above its stored ROWID high-water mark.
+
+        Returns:
+            {"search_index": synced?, "rollups": synced?, "links": synced?}
+        """
+        status = {"search_index": False, "rollups": False, "links": False}
+        if not self.messages_db_path.exists():
+            logger.error(f"Messages database not found: {self.messages_db_path}")
+            return status
+
+        try:
+            conn = self._get_connection()
+        except sqlite3.Error as e:
+            logger.error(f"Cannot open Messages database: {e}")
+            return status
+
+        index = self._get_search_index()
+        if index is not None:
+            try:
+                with span("sync"):
+                    index.sync(conn, decode_many=self._decode_bodies)
+                status["search_index"] = True
+            except sqlite3.Error as e:
+                logger.warning(f"Keyword index sync failed: {e}")
+
+        status["rollups"] = self._synced_rollups(conn) is not None
+        status["links"] = self._synced_media_index(conn) is not None
+        return status
+
     def search_messages(
         self,
         query: str,
         phone: Optional[str] = None,
-        limit: int = 50
+        limit: int = 50,
+        sort: str = "recent"
     ) -> List[Dict]:
         """
         Search messages by content/keyword.
 
         Sprint 2.5: Full-text search across all messages or filtered by contact.
 
+        Served from the FTS5 shadow index (src/message_index.py), which is
+        brought up to date with any new messages before each query. Falls back
+        to a full scan if the index can't be used.
+
         Args:
             query: Search query (keyword or phrase)
             phone: Optional phone number to filter by specific contact
             limit: Maximum number of results
+            sort: "recent" (newest first) or "relevance" (BM25 ranking)
 
         Returns:
             List[Dict]: List of matching message dicts with keys:
@@ -692,61 +1364,129 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
-            cursor = conn.cursor()
+            conn = self._get_connection()
+
+            index = self._get_search_index()
+            if index is not None:
+                try:
+                    with span("sync"):
+                        index.sync(conn, decode_many=self._decode_bodies)
+                    rows = index.search(
+                        conn, query,
+                        handle_pattern=f"%{sanitize_like_pattern(phone)}%" if phone else None,
+                        limit=limit, sort=sort,
+                    )
+                except sqlite3.Error as e:
+                    logger.warning(f"Keyword index query failed, using full scan: {e}")
+                    rows = None
+
+                if rows is not None:
+                    messages = []
+                    for row in rows:
+                        date_cocoa = row["date"]
+                        if date_cocoa:
+                            cocoa_epoch = datetime(2001, 1, 1)
+                            date = cocoa_epoch + timedelta(seconds=date_cocoa / 1_000_000_000)
+                        else:
+                            date = None
+
+                        cache_roomnames = row["cache_roomnames"]
+                        is_group_chat = is_group_chat_identifier(cache_roomnames)
+
+                        messages.append({
+                            "text": row["text"],
+                            "date": date.isoformat() if date else None,
+                            "is_from_me": bool(row["is_from_me"]),
+                            "phone": row["handle"] or "unknown",
+                            "match_snippet": row["snippet"],
+                            "is_group_chat": is_group_chat,
+                            "group_id": cache_roomnames if is_group_chat else None
+                        })
+
+                    logger.info(f"Found {len(messages)} messages matching '{query}'")
+                    return messages
+
+            return self._search_messages_scan(conn, query, phone, limit)
 
-            # Build query based on whether we're filtering by phone
-            if phone:
-                sql_query = """
-                    SELECT
-                        message.text,
-                        message.attributedBody,
-                        message.date,
-                        message.is_from_me,
-                        handle.id,
-                        message.cache_roomnames
-                    FROM message
-                    JOIN handle ON message.handle_id = handle.ROWID
-                    WHERE (message.text LIKE ? OR message.attributedBody IS NOT NULL)
-                        AND handle.id LIKE ?
-                    ORDER BY message.date DESC
-                    LIMIT ?
-                """
-                cursor.execute(sql_query, (f"%{query}%", f"%{phone}%", limit))
-            else:
-                sql_query = """
-                    SELECT
-                        message.text,
-                        message.attributedBody,
-                        message.date,
-                        message.is_from_me,
-                        handle.id,
-                        message.cache_roomnames
-                    FROM message
-                    LEFT JOIN handle ON message.handle_id = handle.ROWID
-                    WHERE message.text LIKE ? OR message.attributedBody IS NOT NULL
-                    ORDER BY message.date DESC
-                    LIMIT ?
-                """
-                cursor.execute(sql_query, (f"%{query}%", limit))
+        except sqlite3.Error as e:
+            logger.error(f"Database error: {e}")
+            return []
+        except Exception as e:
+            logger.error(f"Error searching messages: {e}")
+            return []
 
-            rows = cursor.fetchall()
+    def _search_messages_scan(
+        self,
+        conn: sqlite3.Connection,
+        query: str,
+        phone: Optional[str],
+        limit: int
+    ) -> List[Dict]:
+        """
+        Fallback keyword search that decodes and filters every candidate row.
+
+        The limit is applied after the Python text filter so matches in
+        attributedBody-only messages aren't cut off by the SQL LIMIT.
+        """
+        cursor = conn.cursor()
+
+        # Build query based on whether we're filtering by phone
+        if phone:
+            sql_query = """
+                SELECT
+                    message.text,
+                    message.attributedBody,
+                    message.date,
+                    message.is_from_me,
+                    handle.id,
+                    message.cache_roomnames,
+                    message.ROWID
+                FROM message
+                JOIN handle ON message.handle_id = handle.ROWID
+                WHERE (message.text LIKE ? OR message.attributedBody IS NOT NULL)
+                    AND handle.id LIKE ? ESCAPE '\\'
+                ORDER BY message.date DESC
+            """
+            cursor.execute(sql_query, (f"%{query}%", f"%{sanitize_like_pattern(phone)}%"))
+        else:
+            sql_query = """
+                SELECT
+                    message.text,
+                    message.attributedBody,
+                    message.date,
+                    message.is_from_me,
+                    handle.id,
+                    message.cache_roomnames,
+                    message.ROWID
+                FROM message
+                LEFT JOIN handle ON message.handle_id = handle.ROWID
+                WHERE message.text LIKE ? OR message.attributedBody IS NOT NULL
+                ORDER BY message.date DESC
+            """
+            cursor.execute(sql_query, (f"%{query}%",))
+
+        messages = []
+        query_lower = query.lower()
+        while len(messages) < limit:
+            rows = cursor.fetchmany(500)
+            if not rows:
+                break
+            texts = self._decode_bodies(rows)
 
-            messages = []
             for row in rows:
-                text, attributed_body, date_cocoa, is_from_me, handle_id, cache_roomnames = row
+                text, attributed_body, date_cocoa, is_from_me, handle_id, cache_roomnames, rowid = row
 
                 # Extract message text
                 message_text = text
                 if not message_text and attributed_body:
-                    message_text = extract_text_from_blob(attributed_body)
+                    message_text = texts.get(rowid)
 
                 # Skip if no text content (attachments only, etc.)
                 if not message_text:
                     continue
 
                 # Check if query matches (for attributedBody messages)
-                if query.lower() not in message_text.lower():
+                if query_lower not in message_text.lower():
                     continue
 
                 # Convert timestamp
@@ -771,17 +1511,12 @@ class MessagesInterface:
                     "is_group_chat": is_group_chat,
                     "group_id": cache_roomnames if is_group_chat else None
                 })
+                if len(messages) >= limit:
+                    break
 
-            conn.close()
-            logger.info(f"Found {len(messages)} messages matching '{query}'")
-            return messages
-
-        except sqlite3.Error as e:
-            logger.error(f"Database error: {e}")
-            return []
-        except Exception as e:
-            logger.error(f"Error searching messages: {e}")
-            return []
+        cursor.close()
+        logger.info(f"Found {len(messages)} messages matching '{query}' (full scan)")
+        return messages
 
     def list_group_chats(self, limit: int = 50) -> List[Dict]:
         """
@@ -812,7 +1547,31 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
+
+            rollups = self._synced_rollups(conn)
+            if rollups is not None:
+                groups = []
+                for chat in rollups.group_chats(limit=limit):
+                    last_date_cocoa = chat["last_date"]
+                    if last_date_cocoa:
+                        cocoa_epoch = datetime(2001, 1, 1)
+                        last_date = cocoa_epoch + timedelta(seconds=last_date_cocoa / 1_000_000_000)
+                    else:
+                        last_date = None
+
+                    groups.append({
+                        "group_id": chat["chat_identifier"],
+                        "display_name": chat["display_name"],
+                        "participants": chat["participants"],
+                        "participant_count": chat["participant_count"],
+                        "last_message_date": last_date.isoformat() if last_date else None,
+                        "message_count": chat["sent_count"] + chat["received_count"],
+                    })
+
+                logger.info(f"Found {len(groups)} group chats")
+                return groups
+
             cursor = conn.cursor()
 
             # Query group chats from chat table
@@ -871,7 +1630,6 @@ class MessagesInterface:
                     "message_count": msg_count or 0
                 })
 
-            conn.close()
             logger.info(f"Found {len(groups)} group chats")
             return groups
 
@@ -927,7 +1685,7 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # First, find the chat(s) that match
@@ -951,7 +1709,6 @@ class MessagesInterface:
             chats = cursor.fetchall()
 
             if not chats:
-                conn.close()
                 return []
 
             # Get messages from all matching chats
@@ -973,7 +1730,8 @@ class MessagesInterface:
                         m.attributedBody,
                         m.date,
                         m.is_from_me,
-                        h.id as sender_handle
+                        h.id as sender_handle,
+                        m.ROWID
                     FROM message m
                     JOIN chat_message_join cmj ON m.ROWID = cmj.message_id
                     LEFT JOIN handle h ON m.handle_id = h.ROWID
@@ -981,14 +1739,16 @@ class MessagesInterface:
                     ORDER BY m.date DESC
                     LIMIT ?
                 """, (chat_rowid, limit))
+                rows = cursor.fetchall()
+                texts = self._decode_bodies(rows)
 
-                for row in cursor.fetchall():
-                    text, attributed_body, date_cocoa, is_from_me, sender_handle = row
+                for row in rows:
+                    text, attributed_body, date_cocoa, is_from_me, sender_handle, rowid = row
 
                     # Extract message text
                     message_text = text
                     if not message_text and attributed_body:
-                        message_text = extract_text_from_blob(attributed_body)
+                        message_text = texts.get(rowid)
 
                     # Convert timestamp
                     if date_cocoa:
@@ -1011,7 +1771,6 @@ class MessagesInterface:
             messages.sort(key=lambda m: m["date"] or "", reverse=True)
             messages = messages[:limit]
 
-            conn.close()
             logger.info(f"Retrieved {len(messages)} group messages")
             return messages
 
@@ -1086,7 +1845,8 @@ class MessagesInterface:
         self,
         phone: Optional[str] = None,
         mime_type_filter: Optional[str] = None,
-        limit: int = 50
+        limit: int = 50,
+        before_rowid: Optional[int] = None
     ) -> List[Dict]:
         """
         Get attachments from messages, optionally filtered by contact or type.
@@ -1097,10 +1857,13 @@ class MessagesInterface:
             phone: Optional phone number to filter by contact
             mime_type_filter: Filter by MIME type (e.g., "image/", "video/", "application/pdf")
             limit: Maximum number of attachments to return
+            before_rowid: Only attachments on messages older than this ROWID;
+                pass the last result's message_rowid to get the next page
 
         Returns:
             List[Dict]: Attachment information including:
                 - attachment_id: Unique ID
+                - message_rowid: ROWID of the message (pagination cursor)
                 - filename: Full path to the attachment file
                 - mime_type: MIME type (e.g., "image/jpeg")
                 - uti: Uniform Type Identifier
@@ -1109,96 +1872,52 @@ class MessagesInterface:
                 - transfer_name: Display filename
                 - created_date: When attachment was created
                 - message_date: When the message was sent
-                - sender_handle: Who sent it
-                - is_sticker: Whether this is a sticker
-
-        Example:
-            # Get all image attachments
-            images = interface.get_attachments(mime_type_filter="image/")
-
-            # Get attachments from specific contact
-            files = interface.get_attachments(phone="+14155551234")
-        """
-        logger.info(f"Getting attachments (phone: {phone}, type: {mime_type_filter})")
-
-        if not self.messages_db_path.exists():
-            logger.error(f"Messages database not found: {self.messages_db_path}")
-            return []
-
-        try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
-            cursor = conn.cursor()
-
-            # Build query with optional filters
-            query = """
-                SELECT
-                    a.ROWID as attachment_id,
-                    a.filename,
-                    a.mime_type,
-                    a.uti,
-                    a.total_bytes,
-                    a.is_outgoing,
-                    a.transfer_name,
-                    a.created_date,
-                    a.is_sticker,
-                    m.date as message_date,
-                    m.is_from_me,
-                    h.id as sender_handle
-                FROM attachment a
-                JOIN message_attachment_join maj ON a.ROWID = maj.attachment_id
-                JOIN message m ON maj.message_id = m.ROWID
-                LEFT JOIN handle h ON m.handle_id = h.ROWID
-                WHERE 1=1
-            """
-            params = []
-
-            if phone:
-                query += " AND h.id LIKE ?"
-                params.append(f"%{sanitize_like_pattern(phone)}%")
-
-            if mime_type_filter:
-                query += " AND a.mime_type LIKE ?"
-                params.append(f"{mime_type_filter}%")
+                - sender_handle: Who sent it
+                - is_sticker: Whether this is a sticker
 
-            query += " ORDER BY m.date DESC LIMIT ?"
-            params.append(limit)
+        Example:
+            # Get all image attachments
+            images = interface.get_attachments(mime_type_filter="image/")
 
-            cursor.execute(query, params)
-            rows = cursor.fetchall()
+            # Get attachments from specific contact
+            files = interface.get_attachments(phone="+14155551234")
+        """
+        logger.info(f"Getting attachments (phone: {phone}, type: {mime_type_filter})")
 
-            attachments = []
-            for row in rows:
-                (attachment_id, filename, mime_type, uti, total_bytes, is_outgoing,
-                 transfer_name, created_date_cocoa, is_sticker, message_date_cocoa,
-                 is_from_me, sender_handle) = row
+        if not self.messages_db_path.exists():
+            logger.error(f"Messages database not found: {self.messages_db_path}")
+            return []
 
-                # Convert Cocoa timestamps
-                message_date = None
-                if message_date_cocoa:
-                    cocoa_epoch = datetime(2001, 1, 1)
-                    message_date = cocoa_epoch + timedelta(seconds=message_date_cocoa / 1_000_000_000)
+        try:
+            from .media_index import attachment_rows
+
+            rows = attachment_rows(
+                self._get_connection(),
+                handle_pattern=f"%{sanitize_like_pattern(phone)}%" if phone else None,
+                mime_prefix=mime_type_filter,
+                before_rowid=before_rowid,
+                limit=limit,
+            )
 
-                created_date = None
-                if created_date_cocoa:
-                    cocoa_epoch = datetime(2001, 1, 1)
-                    created_date = cocoa_epoch + timedelta(seconds=created_date_cocoa / 1_000_000_000)
-
-                attachments.append({
-                    "attachment_id": attachment_id,
-                    "filename": filename,
-                    "mime_type": mime_type,
-                    "uti": uti,
-                    "total_bytes": total_bytes,
-                    "is_outgoing": bool(is_outgoing),
-                    "transfer_name": transfer_name,
-                    "created_date": created_date.isoformat() if created_date else None,
-                    "message_date": message_date.isoformat() if message_date else None,
-                    "sender_handle": sender_handle or "unknown",
-                    "is_from_me": bool(is_from_me),
-                    "is_sticker": bool(is_sticker)
-                })
+            attachments = [
+                {
+                    "attachment_id": row["attachment_id"],
+                    "message_rowid": row["message_rowid"],
+                    "filename": row["filename"],
+                    "mime_type": row["mime_type"],
+                    "uti": row["uti"],
+                    "total_bytes": row["total_bytes"],
+                    "is_outgoing": bool(row["is_outgoing"]),
+                    "transfer_name": row["transfer_name"],
+                    "created_date": cocoa_to_iso(row["created_date"]),
+                    "message_date": cocoa_to_iso(row["message_date"]),
+                    "sender_handle": row["sender_handle"] or "unknown",
+                    "is_from_me": bool(row["is_from_me"]),
+                    "is_sticker": bool(row["is_sticker"])
+                }
+                for row in rows
+            ]
 
-            conn.close()
             logger.info(f"Found {len(attachments)} attachments")
             return attachments
 
@@ -1239,7 +1958,7 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # Query for unread incoming messages
@@ -1251,7 +1970,8 @@ class MessagesInterface:
                     m.date,
                     h.id as sender_handle,
                     m.cache_roomnames,
-                    c.display_name
+                    c.display_name,
+                    m.ROWID
                 FROM message m
                 LEFT JOIN handle h ON m.handle_id = h.ROWID
                 LEFT JOIN chat_message_join cmj ON m.ROWID = cmj.message_id
@@ -1267,16 +1987,17 @@ class MessagesInterface:
 
             cursor.execute(query, (limit,))
             rows = cursor.fetchall()
+            texts = self._decode_bodies(rows)
 
             now = datetime.now()
             messages = []
             for row in rows:
-                text, attributed_body, date_cocoa, sender_handle, cache_roomnames, display_name = row
+                text, attributed_body, date_cocoa, sender_handle, cache_roomnames, display_name, rowid = row
 
                 # Extract message text
                 message_text = text
                 if not message_text and attributed_body:
-                    message_text = extract_text_from_blob(attributed_body)
+                    message_text = texts.get(rowid)
 
                 # Convert timestamp
                 if date_cocoa:
@@ -1300,7 +2021,6 @@ class MessagesInterface:
                     "days_old": days_old
                 })
 
-            conn.close()
             logger.info(f"Found {len(messages)} unread messages")
             return messages
 
@@ -1347,7 +2067,7 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # Build query for reaction messages
@@ -1361,7 +2081,8 @@ class MessagesInterface:
                     r.is_from_me,
                     h.id as reactor_handle,
                     orig.text as original_text,
-                    orig.attributedBody as original_body
+                    orig.attributedBody as original_body,
+                    orig.ROWID as original_rowid
                 FROM message r
                 LEFT JOIN handle h ON r.handle_id = h.ROWID
                 LEFT JOIN message orig ON r.associated_message_guid = orig.guid
@@ -1378,11 +2099,14 @@ class MessagesInterface:
 
             cursor.execute(query, params)
             rows = cursor.fetchall()
+            texts = self._decode_bodies(
+                (row[6], row[7], row[8]) for row in rows if row[8] is not None
+            )
 
             reactions = []
             for row in rows:
                 (reaction_code, orig_guid, custom_emoji, date_cocoa, is_from_me,
-                 reactor_handle, orig_text, orig_body) = row
+                 reactor_handle, orig_text, orig_body, orig_rowid) = row
 
                 # Get reaction type name
                 reaction_type = self.REACTION_TYPES.get(reaction_code, f"unknown_{reaction_code}")
@@ -1391,7 +2115,7 @@ class MessagesInterface:
                 # Get original message preview
                 orig_preview = orig_text
                 if not orig_preview and orig_body:
-                    orig_preview = extract_text_from_blob(orig_body)
+                    orig_preview = texts.get(orig_rowid)
                 if orig_preview and len(orig_preview) > 100:
                     orig_preview = orig_preview[:100] + "..."
 
@@ -1413,7 +2137,6 @@ class MessagesInterface:
                     "is_removal": is_removal
                 })
 
-            conn.close()
             logger.info(f"Found {len(reactions)} reactions")
             return reactions
 
@@ -1424,6 +2147,43 @@ class MessagesInterface:
             logger.error(f"Error getting reactions: {e}")
             return []
 
+    def get_reaction_summary(self, phone: Optional[str] = None, days: int = 30) -> Dict:
+        """
+        Summarize tapbacks over a date window.
+
+        Args:
+            phone: Optional filter by contact
+            days: Number of days to analyze
+
+        Returns:
+            Dict: total_reactions, given, received, removals, by_type
+            (net of removals) and top_reactors; {} on error
+        """
+        logger.info(f"Getting reaction summary (phone: {phone}, days: {days})")
+
+        if not self.messages_db_path.exists():
+            logger.error(f"Messages database not found: {self.messages_db_path}")
+            return {}
+
+        try:
+            from .analytics_engine import AnalyticsEngine, MessageWindow
+
+            window = MessageWindow.load(
+                self._get_connection(),
+                since=datetime.now() - timedelta(days=days),
+                phone_pattern=f"%{sanitize_like_pattern(phone)}%" if phone else None,
+            )
+            summary = AnalyticsEngine(window).reaction_summary(self.REACTION_TYPES)
+            summary["analysis_period_days"] = days
+            return summary
+
+        except sqlite3.Error as e:
+            logger.error(f"Database error: {e}")
+            return {}
+        except Exception as e:
+            logger.error(f"Error summarizing reactions: {e}")
+            return {}
+
     def get_conversation_analytics(
         self,
         phone: Optional[str] = None,
@@ -1446,8 +2206,10 @@ class MessagesInterface:
                 - avg_daily_messages: Average messages per day
                 - busiest_hour: Hour with most messages (0-23)
                 - busiest_day: Day of week with most messages
+                - messages_by_hour / messages_by_day: Volume histograms (UTC)
                 - top_contacts: Top 10 contacts by message volume
-                - response_stats: Average response time stats
+                - response_stats: Average/median reply times in minutes,
+                  yours and theirs (gaps over 24h are not counted)
                 - attachment_count: Number of attachments
                 - reaction_count: Number of reactions sent/received
 
@@ -1462,120 +2224,19 @@ class MessagesInterface:
             return {}
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
-            cursor = conn.cursor()
-
-            # Calculate date threshold
-            cutoff_date = datetime.now() - timedelta(days=days)
-            cocoa_epoch = datetime(2001, 1, 1)
-            cutoff_cocoa = int((cutoff_date - cocoa_epoch).total_seconds() * 1_000_000_000)
-
-            base_filter = "WHERE m.date >= ?"
-            params = [cutoff_cocoa]
-
-            if phone:
-                base_filter += " AND h.id LIKE ?"
-                params.append(f"%{sanitize_like_pattern(phone)}%")
-
-            # Get total counts
-            cursor.execute(f"""
-                SELECT
-                    COUNT(*) as total,
-                    SUM(CASE WHEN m.is_from_me = 1 THEN 1 ELSE 0 END) as sent,
-                    SUM(CASE WHEN m.is_from_me = 0 THEN 1 ELSE 0 END) as received
-                FROM message m
-                LEFT JOIN handle h ON m.handle_id = h.ROWID
-                {base_filter}
-                AND (m.associated_message_type IS NULL OR m.associated_message_type = 0)
-            """, params)
-            row = cursor.fetchone()
-            total, sent, received = row if row else (0, 0, 0)
-
-            # Get messages by hour (for busiest hour)
-            cursor.execute(f"""
-                SELECT
-                    CAST((m.date / 1000000000 / 3600) % 24 AS INTEGER) as hour,
-                    COUNT(*) as count
-                FROM message m
-                LEFT JOIN handle h ON m.handle_id = h.ROWID
-                {base_filter}
-                GROUP BY hour
-                ORDER BY count DESC
-                LIMIT 1
-            """, params)
-            hour_row = cursor.fetchone()
-            busiest_hour = hour_row[0] if hour_row else None
-
-            # Get messages by day of week
-            cursor.execute(f"""
-                SELECT
-                    CAST((m.date / 1000000000 / 86400 + 1) % 7 AS INTEGER) as dow,
-                    COUNT(*) as count
-                FROM message m
-                LEFT JOIN handle h ON m.handle_id = h.ROWID
-                {base_filter}
-                GROUP BY dow
-                ORDER BY count DESC
-                LIMIT 1
-            """, params)
-            dow_row = cursor.fetchone()
-            days_of_week = ["Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"]
-            busiest_day = days_of_week[dow_row[0]] if dow_row and dow_row[0] is not None else None
-
-            # Get top contacts (only if not filtering by phone)
-            top_contacts = []
-            if not phone:
-                cursor.execute(f"""
-                    SELECT
-                        h.id,
-                        COUNT(*) as msg_count
-                    FROM message m
-                    JOIN handle h ON m.handle_id = h.ROWID
-                    WHERE m.date >= ?
-                    AND (m.associated_message_type IS NULL OR m.associated_message_type = 0)
-                    GROUP BY h.id
-                    ORDER BY msg_count DESC
-                    LIMIT 10
-                """, [cutoff_cocoa])
-                top_contacts = [{"phone": row[0], "message_count": row[1]} for row in cursor.fetchall()]
-
-            # Get attachment count
-            cursor.execute(f"""
-                SELECT COUNT(DISTINCT a.ROWID)
-                FROM attachment a
-                JOIN message_attachment_join maj ON a.ROWID = maj.attachment_id
-                JOIN message m ON maj.message_id = m.ROWID
-                LEFT JOIN handle h ON m.handle_id = h.ROWID
-                {base_filter}
-            """, params)
-            attachment_count = cursor.fetchone()[0] or 0
-
-            # Get reaction count
-            cursor.execute(f"""
-                SELECT COUNT(*)
-                FROM message m
-                LEFT JOIN handle h ON m.handle_id = h.ROWID
-                {base_filter}
-                AND m.associated_message_type BETWEEN 2000 AND 3005
-            """, params)
-            reaction_count = cursor.fetchone()[0] or 0
+            from .analytics_engine import AnalyticsEngine, MessageWindow
 
-            conn.close()
-
-            analytics = {
-                "total_messages": total or 0,
-                "sent_count": sent or 0,
-                "received_count": received or 0,
-                "avg_daily_messages": round((total or 0) / max(days, 1), 1),
-                "busiest_hour": busiest_hour,
-                "busiest_day": busiest_day,
-                "top_contacts": top_contacts,
-                "attachment_count": attachment_count,
-                "reaction_count": reaction_count,
-                "analysis_period_days": days
-            }
+            # One windowed read; every statistic is computed from its columns
+            window = MessageWindow.load(
+                self._get_connection(),
+                since=datetime.now() - timedelta(days=days),
+                phone_pattern=f"%{sanitize_like_pattern(phone)}%" if phone else None,
+            )
+            analytics = AnalyticsEngine(window).conversation_analytics(
+                days, include_top_contacts=not phone
+            )
 
-            logger.info(f"Generated analytics: {total} messages over {days} days")
+            logger.info(f"Generated analytics: {analytics['total_messages']} messages over {days} days")
             return analytics
 
         except sqlite3.Error as e:
@@ -1629,7 +2290,7 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # If we have message_guid but not thread_originator, find the originator
@@ -1644,7 +2305,6 @@ class MessagesInterface:
                     thread_originator_guid = row[0] or row[1]
 
             if not thread_originator_guid:
-                conn.close()
                 return []
 
             # Get all messages in this thread
@@ -1657,7 +2317,8 @@ class MessagesInterface:
                     m.is_from_me,
                     h.id as sender_handle,
                     m.thread_originator_guid,
-                    m.reply_to_guid
+                    m.reply_to_guid,
+                    m.ROWID
                 FROM message m
                 LEFT JOIN handle h ON m.handle_id = h.ROWID
                 WHERE m.guid = ?
@@ -1667,16 +2328,17 @@ class MessagesInterface:
             """, (thread_originator_guid, thread_originator_guid, limit))
 
             rows = cursor.fetchall()
+            texts = self._decode_bodies((row[1], row[2], row[8]) for row in rows)
 
             messages = []
             for row in rows:
                 (guid, text, attributed_body, date_cocoa, is_from_me,
-                 sender_handle, orig_guid, reply_guid) = row
+                 sender_handle, orig_guid, reply_guid, rowid) = row
 
                 # Extract text
                 message_text = text
                 if not message_text and attributed_body:
-                    message_text = extract_text_from_blob(attributed_body)
+                    message_text = texts.get(rowid)
 
                 # Convert timestamp
                 if date_cocoa:
@@ -1695,7 +2357,6 @@ class MessagesInterface:
                     "reply_to_guid": reply_guid
                 })
 
-            conn.close()
             logger.info(f"Found {len(messages)} messages in thread")
             return messages
 
@@ -1710,21 +2371,29 @@ class MessagesInterface:
         self,
         phone: Optional[str] = None,
         days: Optional[int] = None,
-        limit: int = 100
+        limit: int = 100,
+        before_rowid: Optional[int] = None
     ) -> List[Dict]:
         """
         Extract URLs shared in conversations.
 
         T1 Feature: Find all links that have been shared.
 
+        Served from the sidecar link index (see media_index.py), which
+        extracts URLs once per message; falls back to scanning chat.db when
+        the index can't be used.
+
         Args:
             phone: Optional filter by contact
             days: Optional filter by recency
             limit: Maximum links to return
+            before_rowid: Only links from messages older than this ROWID;
+                pass the last result's rowid to get the next page
 
         Returns:
-            List[Dict]: Link information including:
+            List[Dict]: Link information, newest first, including:
                 - url: The extracted URL
+                - rowid: ROWID of the message (pagination cursor)
                 - message_text: Context from the message
                 - date: When shared
                 - is_from_me: Whether you shared it
@@ -1742,13 +2411,54 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
-            cursor = conn.cursor()
+            conn = self._get_connection()
+        except sqlite3.Error as e:
+            logger.error(f"Database error: {e}")
+            return []
 
-            # URL regex pattern
-            url_pattern = re.compile(
-                r'https?://[^\s<>"{}|\\^`\[\]]+'
-            )
+        index = self._synced_media_index(conn)
+        if index is None:
+            links = self._extract_links_scan(conn, phone, days, limit, before_rowid)
+        else:
+            since_cocoa = None
+            if days:
+                cutoff = datetime.now() - timedelta(days=days)
+                since_cocoa = int((cutoff - datetime(2001, 1, 1)).total_seconds() * 1_000_000_000)
+            try:
+                links = [
+                    {
+                        "url": row["url"],
+                        "rowid": row["rowid"],
+                        "message_text": row["snippet"],
+                        "date": cocoa_to_iso(row["date"]),
+                        "is_from_me": row["is_from_me"],
+                        "sender_handle": row["handle"] or ("me" if row["is_from_me"] else "unknown")
+                    }
+                    for row in index.links(
+                        handle_pattern=f"%{sanitize_like_pattern(phone)}%" if phone else None,
+                        since_cocoa=since_cocoa,
+                        before_rowid=before_rowid,
+                        limit=limit,
+                    )
+                ]
+            except sqlite3.Error as e:
+                logger.warning(f"Link index query failed, scanning messages: {e}")
+                links = self._extract_links_scan(conn, phone, days, limit, before_rowid)
+
+        logger.info(f"Found {len(links)} links")
+        return links
+
+    def _extract_links_scan(
+        self,
+        conn: sqlite3.Connection,
+        phone: Optional[str],
+        days: Optional[int],
+        limit: int,
+        before_rowid: Optional[int]
+    ) -> List[Dict]:
+        """Fallback for extract_links: two-pass scan of chat.db (plain text, then blobs)."""
+        try:
+            from .media_index import extract_urls, snippet
 
             cocoa_epoch = datetime(2001, 1, 1)
             cutoff_cocoa = None
@@ -1764,88 +2474,96 @@ class MessagesInterface:
             if cutoff_cocoa is not None:
                 filters.append("m.date >= ?")
                 params_base.append(cutoff_cocoa)
+            if before_rowid is not None:
+                filters.append("m.ROWID < ?")
+                params_base.append(before_rowid)
             filter_sql = (" AND " + " AND ".join(filters)) if filters else ""
 
             links: List[Dict] = []
 
-            def add_links_from_text(message_text: str, date_cocoa: Optional[int], is_from_me: int, sender_handle: Optional[str]):
-                if not message_text:
-                    return
-
-                urls = url_pattern.findall(message_text)
-                if not urls:
-                    return
-
-                date = None
-                if date_cocoa:
-                    date = cocoa_epoch + timedelta(seconds=date_cocoa / 1_000_000_000)
-
-                for url in urls:
-                    url = url.rstrip('.,;:!?)')
+            def add_links_from_text(message_text: str, date_cocoa: Optional[int], is_from_me: int, sender_handle: Optional[str], rowid: int):
+                for url in extract_urls(message_text):
                     links.append({
                         "url": url,
-                        "message_text": message_text[:200] + "..." if len(message_text) > 200 else message_text,
-                        "date": date.isoformat() if date else None,
+                        "rowid": rowid,
+                        "message_text": snippet(message_text),
+                        "date": cocoa_to_iso(date_cocoa),
                         "is_from_me": bool(is_from_me),
                         "sender_handle": sender_handle or ("me" if is_from_me else "unknown")
                     })
-                    if len(links) >= limit:
+                # Every URL of a message is kept even past `limit`: the next
+                # page starts below this ROWID, so dropping some would lose them
+
+            # Each pass reads lazily and stops once it has `limit` links; the
+            # ROWID it stopped at is as far down as its results are complete
+            floors: List[int] = []
+
+            def scan(rows, text_of, found_before=0):
+                while True:
+                    batch = rows.fetchmany(200)
+                    if not batch:
                         return
+                    texts = text_of(batch)
+                    for row in batch:
+                        message_text = texts.get(row[4])
+                        if message_text:
+                            add_links_from_text(message_text, row[1], row[2], row[3], row[4])
+                            if len(links) - found_before >= limit:
+                                floors.append(row[4])
+                                return
 
             # Pass 1 (fast): only messages with plain text containing "http".
-            cursor.execute(
+            scan(conn.execute(
                 f"""
                 SELECT
                     m.text,
                     m.date,
                     m.is_from_me,
-                    h.id as sender_handle
+                    h.id as sender_handle,
+                    m.ROWID
                 FROM message m
                 LEFT JOIN handle h ON m.handle_id = h.ROWID
                 WHERE m.text IS NOT NULL
                   AND m.text LIKE '%http%'
                 {filter_sql}
-                ORDER BY m.date DESC
-                LIMIT ?
+                ORDER BY m.ROWID DESC
                 """,
-                (*params_base, limit * 4),
-            )
-            for text, date_cocoa, is_from_me, sender_handle in cursor.fetchall():
-                add_links_from_text(text or "", date_cocoa, is_from_me, sender_handle)
-                if len(links) >= limit:
-                    break
+                params_base,
+            ), lambda batch: {row[4]: row[0] for row in batch})
 
             # Pass 2 (slower): messages with null text but data-detected; parse attributedBody.
-            remaining = limit - len(links)
-            if remaining > 0:
-                cursor.execute(
-                    f"""
-                    SELECT
-                        m.attributedBody,
-                        m.date,
-                        m.is_from_me,
-                        h.id as sender_handle
-                    FROM message m
-                    LEFT JOIN handle h ON m.handle_id = h.ROWID
-                    WHERE m.text IS NULL
-                      AND m.attributedBody IS NOT NULL
-                      AND m.was_data_detected = 1
-                    {filter_sql}
-                    ORDER BY m.date DESC
-                    LIMIT ?
-                    """,
-                    (*params_base, min(5000, remaining * 10)),
-                )
-                for attributed_body, date_cocoa, is_from_me, sender_handle in cursor.fetchall():
-                    message_text = extract_text_from_blob(attributed_body) if attributed_body else None
-                    if message_text:
-                        add_links_from_text(message_text, date_cocoa, is_from_me, sender_handle)
-                        if len(links) >= limit:
-                            break
-
-            conn.close()
-            logger.info(f"Found {len(links)} links")
-            return links
+            # Only down to where pass 1 stopped - older rows can't land on this page.
+            # Decoding goes in batches so a cold cache stops early once enough links are found.
+            scan(conn.execute(
+                f"""
+                SELECT
+                    m.attributedBody,
+                    m.date,
+                    m.is_from_me,
+                    h.id as sender_handle,
+                    m.ROWID
+                FROM message m
+                LEFT JOIN handle h ON m.handle_id = h.ROWID
+                WHERE m.text IS NULL
+                  AND m.attributedBody IS NOT NULL
+                  AND m.was_data_detected = 1
+                {filter_sql}{" AND m.ROWID >= ?" if floors else ""}
+                ORDER BY m.ROWID DESC
+                """,
+                (*params_base, *floors),
+            ), lambda batch: self._decode_bodies((None, row[0], row[4]) for row in batch), len(links))
+
+            # Newest first, complete down to the higher floor, cut at a message
+            # boundary so the next page (ROWID < last rowid here) misses nothing
+            floor = max(floors) if floors else None
+            links = [link for link in links if floor is None or link["rowid"] >= floor]
+            links.sort(key=lambda link: -link["rowid"])
+            page: List[Dict] = []
+            for link in links:
+                if len(page) >= limit and link["rowid"] != page[-1]["rowid"]:
+                    break
+                page.append(link)
+            return page
 
         except sqlite3.Error as e:
             logger.error(f"Database error: {e}")
@@ -1857,7 +2575,8 @@ class MessagesInterface:
     def get_voice_messages(
         self,
         phone: Optional[str] = None,
-        limit: int = 50
+        limit: int = 50,
+        before_rowid: Optional[int] = None
     ) -> List[Dict]:
         """
         Get voice/audio messages with file paths for transcription.
@@ -1867,12 +2586,15 @@ class MessagesInterface:
         Args:
             phone: Optional filter by contact
             limit: Maximum messages to return
+            before_rowid: Only messages older than this ROWID; pass the last
+                result's message_rowid to get the next page
 
         Returns:
             List[Dict]: Voice message information including:
                 - attachment_path: Path to the audio file
+                - message_rowid: ROWID of the message (pagination cursor)
                 - mime_type: Audio format
-                - duration_seconds: Length if available
+                - size_bytes: File size in bytes
                 - date: When sent
                 - is_from_me: Whether you sent it
                 - sender_handle: Who sent it
@@ -1891,62 +2613,30 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
-            cursor = conn.cursor()
-
-            # Query for audio messages
-            query = """
-                SELECT
-                    a.filename,
-                    a.mime_type,
-                    a.total_bytes,
-                    m.date,
-                    m.is_from_me,
-                    m.is_played,
-                    h.id as sender_handle
-                FROM message m
-                JOIN message_attachment_join maj ON m.ROWID = maj.message_id
-                JOIN attachment a ON maj.attachment_id = a.ROWID
-                LEFT JOIN handle h ON m.handle_id = h.ROWID
-                WHERE (m.is_audio_message = 1
-                    OR a.mime_type LIKE 'audio/%'
-                    OR a.uti LIKE '%audio%')
-            """
-            params = []
-
-            if phone:
-                query += " AND h.id LIKE ?"
-                params.append(f"%{sanitize_like_pattern(phone)}%")
-
-            query += " ORDER BY m.date DESC LIMIT ?"
-            params.append(limit)
-
-            cursor.execute(query, params)
-            rows = cursor.fetchall()
-
-            voice_messages = []
-            for row in rows:
-                (filename, mime_type, total_bytes, date_cocoa,
-                 is_from_me, is_played, sender_handle) = row
-
-                # Convert timestamp
-                if date_cocoa:
-                    cocoa_epoch = datetime(2001, 1, 1)
-                    date = cocoa_epoch + timedelta(seconds=date_cocoa / 1_000_000_000)
-                else:
-                    date = None
+            from .media_index import attachment_rows
+
+            rows = attachment_rows(
+                self._get_connection(),
+                handle_pattern=f"%{sanitize_like_pattern(phone)}%" if phone else None,
+                audio_only=True,
+                before_rowid=before_rowid,
+                limit=limit,
+            )
 
-                voice_messages.append({
-                    "attachment_path": filename,
-                    "mime_type": mime_type,
-                    "size_bytes": total_bytes,
-                    "date": date.isoformat() if date else None,
-                    "is_from_me": bool(is_from_me),
-                    "is_played": bool(is_played),
-                    "sender_handle": sender_handle or ("me" if is_from_me else "unknown")
-                })
+            voice_messages = [
+                {
+                    "attachment_path": row["filename"],
+                    "message_rowid": row["message_rowid"],
+                    "mime_type": row["mime_type"],
+                    "size_bytes": row["total_bytes"],
+                    "date": cocoa_to_iso(row["message_date"]),
+                    "is_from_me": bool(row["is_from_me"]),
+                    "is_played": bool(row["is_played"]),
+                    "sender_handle": row["sender_handle"] or ("me" if row["is_from_me"] else "unknown")
+                }
+                for row in rows
+            ]
 
-            conn.close()
             logger.info(f"Found {len(voice_messages)} voice messages")
             return voice_messages
 
@@ -1985,7 +2675,7 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # Query for scheduled messages (schedule_type = 2)
@@ -1995,7 +2685,8 @@ class MessagesInterface:
                     m.attributedBody,
                     m.date,
                     m.schedule_state,
-                    h.id as recipient_handle
+                    h.id as recipient_handle,
+                    m.ROWID
                 FROM message m
                 LEFT JOIN handle h ON m.handle_id = h.ROWID
                 WHERE m.schedule_type = 2
@@ -2003,15 +2694,16 @@ class MessagesInterface:
             """)
 
             rows = cursor.fetchall()
+            texts = self._decode_bodies(rows)
 
             scheduled = []
             for row in rows:
-                text, attributed_body, date_cocoa, schedule_state, recipient = row
+                text, attributed_body, date_cocoa, schedule_state, recipient, rowid = row
 
                 # Extract text
                 message_text = text
                 if not message_text and attributed_body:
-                    message_text = extract_text_from_blob(attributed_body)
+                    message_text = texts.get(rowid)
 
                 # Convert timestamp
                 if date_cocoa:
@@ -2027,7 +2719,6 @@ class MessagesInterface:
                     "schedule_state": schedule_state
                 })
 
-            conn.close()
             logger.info(f"Found {len(scheduled)} scheduled messages")
             return scheduled
 
@@ -2061,7 +2752,8 @@ class MessagesInterface:
         self,
         phone: str,
         days: Optional[int] = None,
-        limit: int = 200
+        limit: int = 200,
+        max_tokens: Optional[int] = None
     ) -> Dict:
         """
         Get conversation data formatted for AI summarization.
@@ -2073,6 +2765,8 @@ class MessagesInterface:
             phone: Contact phone number or handle
             days: Optional limit to last N days
             limit: Maximum messages to include
+            max_tokens: Optional budget for conversation_text (estimated
+                tokens); the newest messages that fit are kept
 
         Returns:
             Dict: Formatted conversation data including:
@@ -2083,19 +2777,61 @@ class MessagesInterface:
                 - key_stats: {sent, received, avg_length, topics_mentioned}
                 - recent_topics: Detected topics/keywords
                 - last_interaction: When the last message was
+                - truncated: True if max_tokens cut the conversation short
+                - estimated_tokens: Estimated size of conversation_text
 
         Example:
             data = interface.get_conversation_for_summary(phone="+14155551234", days=7)
             # Pass data['conversation_text'] to Claude for summarization
         """
+        lines = []
+        for record in self.iter_conversation_for_summary(phone, days=days, limit=limit, max_tokens=max_tokens):
+            if record["type"] == "message":
+                lines.append(record["line"])
+            elif record["type"] == "error":
+                return {"error": record["error"]}
+            else:
+                summary = {key: value for key, value in record.items() if key != "type"}
+                if summary["message_count"]:
+                    summary["conversation_text"] = "\n".join(lines)
+                return summary
+        return {}
+
+    def iter_conversation_for_summary(
+        self,
+        phone: str,
+        days: Optional[int] = None,
+        limit: int = 200,
+        max_tokens: Optional[int] = None,
+        batch_size: int = 200
+    ) -> Iterator[Dict]:
+        """
+        Streaming variant of get_conversation_for_summary().
+
+        Rows are fetched and decoded `batch_size` at a time and each message
+        is yielded as soon as it is formatted, so a caller writing NDJSON can
+        send the first lines before the rest of the conversation is read.
+        With max_tokens, rows are read newest first and fetching stops at
+        the budget, so the oldest messages are the ones dropped; the kept
+        messages are then yielded in chronological order.
+
+        Yields:
+            {"type": "message", "date", "sender", "line"} per message, where
+            line is its conversation_text form (preceded by a date header on
+            the first message of each day), then one
+            {"type": "summary", ...} with every get_conversation_for_summary
+            key except conversation_text - or {"type": "error", "error"}
+        """
         logger.info(f"Getting conversation for summary (phone: {phone}, days: {days})")
 
         if not self.messages_db_path.exists():
             logger.error(f"Messages database not found: {self.messages_db_path}")
-            return {}
+            return
+
+        stop_words = {'that', 'this', 'with', 'from', 'have', 'just', 'what', 'when', 'where', 'would', 'could', 'should', 'about', 'their', 'there', 'these', 'those', 'been', 'were', 'will', 'your', 'some', 'them'}
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # Build query
@@ -2104,7 +2840,8 @@ class MessagesInterface:
                     m.text,
                     m.attributedBody,
                     m.date,
-                    m.is_from_me
+                    m.is_from_me,
+                    m.ROWID
                 FROM message m
                 JOIN handle h ON m.handle_id = h.ROWID
                 WHERE h.id LIKE ?
@@ -2122,118 +2859,143 @@ class MessagesInterface:
 
             query += " ORDER BY m.date ASC LIMIT ?"
             params.append(limit)
+            if max_tokens is not None:
+                # Spend the budget from the newest end: walk the same rows
+                # newest first, then emit the survivors oldest first
+                query = f"SELECT * FROM ({query}) ORDER BY date DESC"
 
             cursor.execute(query, params)
-            rows = cursor.fetchall()
 
-            if not rows:
-                conn.close()
-                return {
-                    "phone": phone,
-                    "message_count": 0,
-                    "conversation_text": "",
-                    "error": "No messages found"
-                }
+            def decoded_messages():
+                nonlocal rows_seen
+                while True:
+                    rows = cursor.fetchmany(batch_size)
+                    if not rows:
+                        return
+                    rows_seen += len(rows)
+
+                    texts = self._decode_bodies(rows)
+                    for text, attributed_body, date_cocoa, is_from_me, rowid in rows:
+                        # Extract text
+                        message_text = text
+                        if not message_text and attributed_body:
+                            message_text = texts.get(rowid)
+
+                        if not message_text:
+                            continue
+
+                        # Convert timestamp
+                        if date_cocoa:
+                            cocoa_epoch = datetime(2001, 1, 1)
+                            date = cocoa_epoch + timedelta(seconds=date_cocoa / 1_000_000_000)
+                        else:
+                            date = datetime.now()
+                        yield date, bool(is_from_me), message_text
+
+            rows_seen = 0
+            truncated = False
+            messages = decoded_messages()
+
+            if max_tokens is not None:
+                # Each body line and each day header is costed separately,
+                # which never underestimates the joined text
+                kept = []
+                budget_used = 0
+                newer_date = None
+                for date, is_from_me, message_text in messages:
+                    msg_date = date.strftime("%Y-%m-%d")
+                    cost = estimate_tokens(f"[{date.strftime('%H:%M')}] {'You' if is_from_me else 'Them'}: {message_text}") + 1
+                    if msg_date != newer_date:
+                        cost += estimate_tokens(f"\n=== {msg_date} ===\n\n")
+                    if budget_used + cost > max_tokens:
+                        truncated = True
+                        break
+                    budget_used += cost
+                    newer_date = msg_date
+                    kept.append((date, is_from_me, message_text))
+                messages = reversed(kept)
 
-            # Process messages
-            messages = []
+            message_count = 0
             sent_count = 0
             received_count = 0
             total_length = 0
             word_freq = {}
+            first_date = last_date = None
+            current_date = None
+            tokens_used = 0
 
-            for row in rows:
-                text, attributed_body, date_cocoa, is_from_me = row
-
-                # Extract text
-                message_text = text
-                if not message_text and attributed_body:
-                    message_text = extract_text_from_blob(attributed_body)
-
-                if not message_text:
-                    continue
+            for date, is_from_me, message_text in messages:
+                sender = "You" if is_from_me else "Them"
 
-                # Convert timestamp
-                if date_cocoa:
-                    cocoa_epoch = datetime(2001, 1, 1)
-                    date = cocoa_epoch + timedelta(seconds=date_cocoa / 1_000_000_000)
-                else:
-                    date = datetime.now()
+                # Formatted line, with a header when the day changes
+                msg_date = date.strftime("%Y-%m-%d")
+                line = f"[{date.strftime('%H:%M')}] {sender}: {message_text}"
+                if msg_date != current_date:
+                    line = f"\n=== {msg_date} ===\n\n{line}"
+                tokens_used += estimate_tokens(line) + 1   # +1 for the joining newline
+                current_date = msg_date
 
                 # Track stats
                 if is_from_me:
                     sent_count += 1
-                    sender = "You"
                 else:
                     received_count += 1
-                    sender = "Them"
-
+                message_count += 1
                 total_length += len(message_text)
+                first_date = first_date or date
+                last_date = date
 
                 # Simple word frequency for topic detection
-                words = re.findall(r'\b\w{4,}\b', message_text.lower())
-                for word in words:
-                    if word not in {'that', 'this', 'with', 'from', 'have', 'just', 'what', 'when', 'where', 'would', 'could', 'should', 'about', 'their', 'there', 'these', 'those', 'been', 'were', 'will', 'your', 'some', 'them'}:
+                for word in re.findall(r'\b\w{4,}\b', message_text.lower()):
+                    if word not in stop_words:
                         word_freq[word] = word_freq.get(word, 0) + 1
 
-                messages.append({
-                    "date": date,
+                yield {
+                    "type": "message",
+                    "date": date.isoformat(),
                     "sender": sender,
-                    "text": message_text
-                })
-
-            conn.close()
+                    "line": line
+                }
 
-            if not messages:
-                return {
+            if not message_count:
+                yield {
+                    "type": "summary",
                     "phone": phone,
                     "message_count": 0,
                     "conversation_text": "",
-                    "error": "No text messages found"
+                    "error": "No messages found" if not rows_seen else "No text messages found"
                 }
-
-            # Build formatted conversation text
-            conversation_lines = []
-            current_date = None
-
-            for msg in messages:
-                msg_date = msg["date"].strftime("%Y-%m-%d")
-                if msg_date != current_date:
-                    conversation_lines.append(f"\n=== {msg_date} ===\n")
-                    current_date = msg_date
-
-                time_str = msg["date"].strftime("%H:%M")
-                conversation_lines.append(f"[{time_str}] {msg['sender']}: {msg['text']}")
+                return
 
             # Get top topics
             top_topics = sorted(word_freq.items(), key=lambda x: x[1], reverse=True)[:10]
 
-            result = {
+            logger.info(f"Prepared summary data: {message_count} messages")
+            yield {
+                "type": "summary",
                 "phone": phone,
-                "message_count": len(messages),
+                "message_count": message_count,
                 "date_range": {
-                    "start": messages[0]["date"].isoformat(),
-                    "end": messages[-1]["date"].isoformat()
+                    "start": first_date.isoformat(),
+                    "end": last_date.isoformat()
                 },
-                "conversation_text": "\n".join(conversation_lines),
                 "key_stats": {
                     "sent": sent_count,
                     "received": received_count,
-                    "avg_message_length": round(total_length / len(messages)) if messages else 0,
+                    "avg_message_length": round(total_length / message_count),
                 },
                 "recent_topics": [word for word, count in top_topics if count >= 2],
-                "last_interaction": messages[-1]["date"].isoformat()
+                "last_interaction": last_date.isoformat(),
+                "truncated": truncated,
+                "estimated_tokens": tokens_used
             }
 
-            logger.info(f"Prepared summary data: {len(messages)} messages")
-            return result
-
         except sqlite3.Error as e:
             logger.error(f"Database error: {e}")
-            return {"error": str(e)}
+            yield {"type": "error", "error": str(e)}
         except Exception as e:
             logger.error(f"Error getting conversation for summary: {e}")
-            return {"error": str(e)}
+            yield {"type": "error", "error": str(e)}
 
     # Follow-up detection patterns
     FOLLOW_UP_PATTERNS = {
@@ -2322,189 +3084,20 @@ class MessagesInterface:
             return {}
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
-            cursor = conn.cursor()
-
-            # Calculate date thresholds
-            cutoff_date = datetime.now() - timedelta(days=days)
-            stale_date = datetime.now() - timedelta(days=min_stale_days)
-            cocoa_epoch = datetime(2001, 1, 1)
-            cutoff_cocoa = int((cutoff_date - cocoa_epoch).total_seconds() * 1_000_000_000)
-            stale_cocoa = int((stale_date - cocoa_epoch).total_seconds() * 1_000_000_000)
-
-            results = {
-                "unanswered_questions": [],
-                "pending_promises": [],
-                "waiting_on_them": [],
-                "stale_conversations": [],
-                "time_sensitive": [],
-                "analysis_period_days": days
-            }
+            from .analytics_engine import AnalyticsEngine, MessageWindow
 
-            # Get recent messages with context
-            # Windowed query: only keep the most recent N messages per handle.
-            # This avoids scanning/processing every message within the time range for high-volume users.
-            per_contact_limit = max(50, limit)
-            cursor.execute(
-                """
-                WITH recent AS (
-                    SELECT
-                        m.text,
-                        m.attributedBody,
-                        m.date,
-                        m.is_from_me,
-                        h.id AS phone,
-                        m.ROWID AS rowid,
-                        ROW_NUMBER() OVER (PARTITION BY h.id ORDER BY m.date DESC) AS rn
-                    FROM message m
-                    JOIN handle h ON m.handle_id = h.ROWID
-                    WHERE m.date >= ?
-                        AND (m.associated_message_type IS NULL OR m.associated_message_type = 0)
-                        AND m.item_type = 0
-                        AND (m.text IS NOT NULL OR m.attributedBody IS NOT NULL)
-                )
-                SELECT text, attributedBody, date, is_from_me, phone, rowid
-                FROM recent
-                WHERE rn <= ?
-                ORDER BY phone, date DESC
-                """,
-                (cutoff_cocoa, per_contact_limit),
+            now = datetime.now()
+            conn = self._get_connection()
+            window = MessageWindow.load(conn, since=now - timedelta(days=days))
+            results = AnalyticsEngine(window, now=now).follow_ups(
+                self.FOLLOW_UP_PATTERNS,
+                fetch_texts=lambda rowids: MessageWindow.fetch_texts(conn, rowids),
+                decode_many=self._decode_bodies,
+                stale_before=now - timedelta(days=min_stale_days),
+                days=days,
+                limit=limit,
             )
 
-            rows = cursor.fetchall()
-
-            # Group messages by phone
-            conversations = {}
-            for row in rows:
-                text, attributed_body, date_cocoa, is_from_me, phone, rowid = row
-
-                message_text = text
-                if not message_text and attributed_body:
-                    message_text = extract_text_from_blob(attributed_body)
-
-                if not message_text:
-                    continue
-
-                if date_cocoa:
-                    date = cocoa_epoch + timedelta(seconds=date_cocoa / 1_000_000_000)
-                else:
-                    date = datetime.now()
-
-                if phone not in conversations:
-                    conversations[phone] = []
-
-                conversations[phone].append({
-                    "text": message_text,
-                    "date": date,
-                    "is_from_me": bool(is_from_me),
-                    "rowid": rowid
-                })
-
-            # Analyze each conversation
-            for phone, messages in conversations.items():
-                if not messages:
-                    continue
-
-                # Messages are ordered DESC, so [0] is most recent
-                last_msg = messages[0]
-                last_from_me = last_msg["is_from_me"]
-                last_date = last_msg["date"]
-
-                # Check for stale conversations (they messaged last, we haven't replied)
-                if not last_from_me and last_date < stale_date:
-                    days_ago = (datetime.now() - last_date).days
-                    results["stale_conversations"].append({
-                        "phone": phone,
-                        "last_message": last_msg["text"][:100],
-                        "days_since_reply": days_ago,
-                        "date": last_date.isoformat()
-                    })
-
-                # Analyze individual messages
-                for msg in messages[:20]:  # Check last 20 messages per contact
-                    text_lower = msg["text"].lower()
-
-                    # Unanswered questions (from them, not replied)
-                    if not msg["is_from_me"]:
-                        for pattern in self.FOLLOW_UP_PATTERNS["question"]:
-                            if re.search(pattern, text_lower):
-                                # Check if we replied after this
-                                has_reply = any(
-                                    m["is_from_me"] and m["date"] > msg["date"]
-                                    for m in messages
-                                )
-                                if not has_reply:
-                                    if len(results["unanswered_questions"]) < limit:
-                                        results["unanswered_questions"].append({
-                                            "phone": phone,
-                                            "text": msg["text"][:200],
-                                            "date": msg["date"].isoformat(),
-                                            "days_ago": (datetime.now() - msg["date"]).days
-                                        })
-                                break
-
-                    # Promises we made
-                    if msg["is_from_me"]:
-                        for pattern in self.FOLLOW_UP_PATTERNS["promise"]:
-                            if re.search(pattern, text_lower):
-                                if len(results["pending_promises"]) < limit:
-                                    results["pending_promises"].append({
-                                        "phone": phone,
-                                        "text": msg["text"][:200],
-                                        "date": msg["date"].isoformat(),
-                                        "days_ago": (datetime.now() - msg["date"]).days
-                                    })
-                                break
-
-                    # Things we're waiting on
-                    if msg["is_from_me"]:
-                        for pattern in self.FOLLOW_UP_PATTERNS["waiting"]:
-                            if re.search(pattern, text_lower):
-                                # Check if they replied
-                                has_reply = any(
-                                    not m["is_from_me"] and m["date"] > msg["date"]
-                                    for m in messages
-                                )
-                                if not has_reply:
-                                    if len(results["waiting_on_them"]) < limit:
-                                        results["waiting_on_them"].append({
-                                            "phone": phone,
-                                            "text": msg["text"][:200],
-                                            "date": msg["date"].isoformat(),
-                                            "days_waiting": (datetime.now() - msg["date"]).days
-                                        })
-                                break
-
-                    # Time-sensitive messages
-                    for pattern in self.FOLLOW_UP_PATTERNS["time_reference"]:
-                        if re.search(pattern, text_lower):
-                            if len(results["time_sensitive"]) < limit:
-                                results["time_sensitive"].append({
-                                    "phone": phone,
-                                    "text": msg["text"][:200],
-                                    "date": msg["date"].isoformat(),
-                                    "is_from_me": msg["is_from_me"],
-                                    "days_ago": (datetime.now() - msg["date"]).days
-                                })
-                            break
-
-            conn.close()
-
-            # Add summary counts
-            results["summary"] = {
-                "unanswered_questions": len(results["unanswered_questions"]),
-                "pending_promises": len(results["pending_promises"]),
-                "waiting_on_them": len(results["waiting_on_them"]),
-                "stale_conversations": len(results["stale_conversations"]),
-                "time_sensitive": len(results["time_sensitive"]),
-                "total_action_items": sum([
-                    len(results["unanswered_questions"]),
-                    len(results["pending_promises"]),
-                    len(results["waiting_on_them"]),
-                    len(results["stale_conversations"]),
-                ])
-            }
-
             logger.info(f"Found {results['summary']['total_action_items']} follow-up items")
             return results
 
@@ -2520,6 +3113,8 @@ class MessagesInterface:
         List all unique phone numbers/email handles from recent messages.
 
         Useful for finding temporary numbers or people not in contacts.
+        Served from the sidecar rollups when available, which count whole
+        UTC days (the window starts at midnight UTC of the cutoff day).
 
         Args:
             days: Number of days to look back
@@ -2540,7 +3135,7 @@ class MessagesInterface:
             return []
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # Calculate cutoff date in Cocoa timestamp format
@@ -2548,6 +3143,13 @@ class MessagesInterface:
             cocoa_epoch = datetime(2001, 1, 1)
             cutoff_cocoa = (cutoff - cocoa_epoch).total_seconds() * 1_000_000_000
 
+            # Rollups count whole UTC days; the scan below is exact to the second
+            rollups = self._synced_rollups(conn)
+            if rollups is not None:
+                rows = rollups.handles(cutoff_cocoa, limit=limit)
+            else:
+                rows = None
+
             query = """
                 SELECT
                     handle.id as handle,
@@ -2563,8 +3165,9 @@ class MessagesInterface:
                 LIMIT ?
             """
 
-            cursor.execute(query, (cutoff_cocoa, limit))
-            rows = cursor.fetchall()
+            if rows is None:
+                cursor.execute(query, (cutoff_cocoa, limit))
+                rows = cursor.fetchall()
 
             handles = []
             for row in rows:
@@ -2584,7 +3187,6 @@ class MessagesInterface:
                     "is_to_me_count": to_me or 0
                 })
 
-            conn.close()
             logger.info(f"Found {len(handles)} unique handles")
             return handles
 
@@ -2599,7 +3201,8 @@ class MessagesInterface:
         self,
         known_phones: List[str],
         days: int = 30,
-        limit: int = 100
+        limit: int = 100,
+        contacts=None
     ) -> List[Dict]:
         """
         Find messages from senders not in contacts.
@@ -2612,6 +3215,9 @@ class MessagesInterface:
             known_phones: List of normalized phone numbers from contacts
             days: Number of days to look back
             limit: Maximum messages to return
+            contacts: Optional ContactsManager; when given, handles are
+                resolved through its indexes (phones and emails) instead
+                of known_phones
 
         Returns:
             List[Dict]: Unknown senders with their messages, keys:
@@ -2626,18 +3232,18 @@ class MessagesInterface:
             logger.error(f"Messages database not found: {self.messages_db_path}")
             return []
 
-        # Normalize known phones for comparison (remove non-digits)
+        # Normalize known phones once: full digits plus last-10 suffix, so
+        # "+1 (415) 555-1234" and "4155551234" both match either handle form
         normalized_known = set()
         for phone in known_phones:
             normalized = "".join(c for c in phone if c.isdigit())
             if normalized:
                 normalized_known.add(normalized)
-                # Also add without country code for matching
                 if len(normalized) > 10:
                     normalized_known.add(normalized[-10:])
 
         try:
-            conn = sqlite3.connect(f"file:{self.messages_db_path}?mode=ro", uri=True)
+            conn = self._get_connection()
             cursor = conn.cursor()
 
             # Calculate cutoff date in Cocoa timestamp format
@@ -2658,34 +3264,26 @@ class MessagesInterface:
                 ORDER BY last_message_date DESC
             """
 
-            cursor.execute(handles_query, (cutoff_cocoa,))
-            all_handles = cursor.fetchall()
+            rollups = self._synced_rollups(conn)
+            if rollups is not None:
+                all_handles = [row[:3] for row in rollups.handles(cutoff_cocoa)]
+            else:
+                cursor.execute(handles_query, (cutoff_cocoa,))
+                all_handles = cursor.fetchall()
 
             # Filter to unknown handles
-            unknown_handles = []
-            for handle, msg_count, last_date in all_handles:
-                handle_normalized = "".join(c for c in handle if c.isdigit())
-
-                # Check if this handle matches any known phone (bidirectional matching)
-                is_known = False
-
-                # Direct full match
-                if handle_normalized in normalized_known:
-                    is_known = True
-                # Check if handle's last 10 digits match any known phone
-                elif len(handle_normalized) >= 10 and handle_normalized[-10:] in normalized_known:
-                    is_known = True
-                # Bidirectional check: does any known phone end with this handle's last 10?
-                elif len(handle_normalized) >= 10:
-                    handle_last_10 = handle_normalized[-10:]
-                    for known in known_phones:
-                        known_digits = "".join(c for c in known if c.isdigit())
-                        if len(known_digits) >= 10 and known_digits.endswith(handle_last_10):
-                            is_known = True
-                            break
-
-                if not is_known:
-                    unknown_handles.append((handle, msg_count, last_date))
+            if contacts is not None:
+                resolved = contacts.resolve_handles(h[0] for h in all_handles)
+                unknown_handles = [h for h in all_handles if resolved.get(h[0]) is None]
+            else:
+                unknown_handles = []
+                for handle, msg_count, last_date in all_handles:
+                    digits = "".join(c for c in handle if c.isdigit())
+                    is_known = digits in normalized_known or (
+                        len(digits) >= 10 and digits[-10:] in normalized_known
+                    )
+                    if not is_known:
+                        unknown_handles.append((handle, msg_count, last_date))
 
             # Get recent messages for each unknown handle (limited)
             unknown_senders = []
@@ -2698,7 +3296,8 @@ class MessagesInterface:
                         message.text,
                         message.attributedBody,
                         message.date,
-                        message.is_from_me
+                        message.is_from_me,
+                        message.ROWID
                     FROM message
                     JOIN handle ON message.handle_id = handle.ROWID
                     WHERE handle.id = ? AND message.date > ?
@@ -2708,15 +3307,14 @@ class MessagesInterface:
 
                 cursor.execute(msg_query, (handle, cutoff_cocoa, messages_per_handle))
                 msg_rows = cursor.fetchall()
+                texts = self._decode_bodies(msg_rows)
 
                 messages = []
-                for text, blob, date_cocoa, is_from_me in msg_rows:
+                for text, blob, date_cocoa, is_from_me, rowid in msg_rows:
                     # Extract text content
                     msg_text = text
                     if not msg_text and blob:
-                        # Fixed 01/04/2026: extract_text_from_blob is a module-level function (line ~147),
-                        # not a class method. Previously incorrectly called as self.extract_text_from_blob()
-                        msg_text = extract_text_from_blob(blob)
+                        msg_text = texts.get(rowid)
                     if not msg_text:
                         msg_text = "[attachment or empty]"
 
@@ -2745,7 +3343,6 @@ class MessagesInterface:
                     "last_message_date": last_date.isoformat() if last_date else None
                 })
 
-            conn.close()
             logger.info(f"Found {len(unknown_senders)} unknown senders")
             return unknown_senders
 
@@ -11,8 +11,30 @@ Components:
 - retriever: Combines search with context synthesis
 """
 
-from .chunker import ConversationChunker, ConversationChunk
-from .store import MessageVectorStore
+from typing import TYPE_CHECKING
+
+# Public name -> submodule that defines it (imported on first access, so
+# `import src.rag.unified` doesn't load the iMessage chunker and store)
+_EXPORTS = {
+    "ConversationChunker": "chunker",
+    "ConversationChunk": "chunker",
+    "MessageVectorStore": "store",
+}
+
+if TYPE_CHECKING:
+    from .chunker import ConversationChunker, ConversationChunk
+    from .store import MessageVectorStore
+
+
+def __getattr__(name):
+    module = _EXPORTS.get(name)
+    if module is None:
+        raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+    from importlib import import_module
+    value = getattr(import_module(f".{module}", __name__), name)
+    globals()[name] = value
+    return value
+
 
 __all__ = [
     "ConversationChunker",
@@ -21,7 +21,7 @@ import hashlib
 import logging
 from dataclasses import dataclass, field
 from datetime import datetime, timedelta
-from typing import List, Dict, Optional, Iterator
+from typing import List, Dict, Optional, Iterator, Tuple
 from collections import defaultdict
 
 logger = logging.getLogger(__name__)
@@ -115,6 +115,46 @@ class ConversationChunk:
         return result
 
 
+@dataclass
+class OpenWindow:
+    """
+    A conversation's trailing time window, which later messages may extend.
+
+    Persisted between incremental runs so the next run can re-chunk just
+    this window (re-reading its messages by ROWID) together with the new
+    messages, instead of starting a fresh window that overlaps the stored
+    chunk or re-chunking the whole history.
+
+    Attributes:
+        rowids: chat.db ROWIDs of the window's messages
+        start_time: First message timestamp
+        end_time: Last message timestamp
+        chunk_ids: IDs of the chunks stored for the window so far (none
+            while it is still too short to be a chunk)
+    """
+    rowids: List[int]
+    start_time: datetime
+    end_time: datetime
+    chunk_ids: List[str] = field(default_factory=list)
+
+    def to_dict(self) -> Dict:
+        return {
+            "rowids": self.rowids,
+            "start_time": self.start_time.isoformat(),
+            "end_time": self.end_time.isoformat(),
+            "chunk_ids": self.chunk_ids,
+        }
+
+    @classmethod
+    def from_dict(cls, data: Dict) -> "OpenWindow":
+        return cls(
+            rowids=list(data.get("rowids", [])),
+            start_time=datetime.fromisoformat(data["start_time"]),
+            end_time=datetime.fromisoformat(data["end_time"]),
+            chunk_ids=list(data.get("chunk_ids", [])),
+        )
+
+
 class ConversationChunker:
     """
     Groups messages into embeddable conversation chunks.
@@ -212,16 +252,108 @@ class ConversationChunker:
         grouped = defaultdict(list)
 
         for msg in messages:
-            if msg.get("is_group_chat"):
-                # Group chats use group_id as key
-                key = msg.get("group_id") or "unknown_group"
+            grouped[self.conversation_key(msg)].append(msg)
+
+        return dict(grouped)
+
+    @staticmethod
+    def conversation_key(msg: Dict) -> str:
+        """Conversation a message belongs to (group_id, contact name or phone)."""
+        if msg.get("is_group_chat"):
+            # Group chats use group_id as key
+            return msg.get("group_id") or "unknown_group"
+        # Prefer enriched contact name, fall back to phone
+        return msg.get("_contact_name") or msg.get("phone") or "unknown"
+
+    def split_open_windows(
+        self,
+        messages: List[Dict],
+        max_open: Optional[int] = None,
+    ) -> Tuple[List[Dict], List[Dict]]:
+        """
+        Separate messages whose time window can't still grow.
+
+        Used when chunking a chronological message stream batch by batch:
+        a conversation's trailing window stays open while it's within
+        `window_hours` of the newest message seen, since the next batch may
+        extend it. Everything else (earlier windows, and trailing windows
+        that have gone quiet) is safe to chunk now.
+
+        Args:
+            messages: Messages in roughly chronological order
+            max_open: If the open windows hold at least this many messages,
+                close them anyway so carry-over stays bounded
+
+        Returns:
+            (closed, still_open) message lists
+        """
+        window_delta = timedelta(hours=self.window_hours)
+        parsed = [(msg, self._parse_datetime(msg.get("date"))) for msg in messages]
+        times = [t for _, t in parsed if t is not None]
+        if not times:
+            return list(messages), []
+        newest = max(times)
+
+        # Start of each conversation's trailing window
+        last_time: Dict[str, datetime] = {}
+        window_start: Dict[str, datetime] = {}
+        for msg, msg_time in sorted(
+            ((m, t) for m, t in parsed if t is not None), key=lambda p: p[1]
+        ):
+            key = self.conversation_key(msg)
+            if key not in last_time or msg_time - last_time[key] > window_delta:
+                window_start[key] = msg_time
+            last_time[key] = msg_time
+
+        closed, still_open = [], []
+        for msg, msg_time in parsed:
+            key = self.conversation_key(msg)
+            if (
+                msg_time is not None
+                and msg_time >= window_start[key]
+                and newest - last_time[key] <= window_delta
+            ):
+                still_open.append(msg)
             else:
-                # Prefer enriched contact name, fall back to phone
-                key = msg.get("_contact_name") or msg.get("phone") or "unknown"
+                closed.append(msg)
 
-            grouped[key].append(msg)
+        if max_open is not None and len(still_open) >= max_open:
+            return list(messages), []
+        return closed, still_open
 
-        return dict(grouped)
+    def open_windows(self, still_open: List[Dict]) -> Dict[str, OpenWindow]:
+        """
+        Describe the trailing windows returned by split_open_windows().
+
+        Args:
+            still_open: Open-window messages (each carrying a "rowid")
+
+        Returns:
+            Dict mapping conversation key to its OpenWindow (chunk_ids empty;
+            the caller fills them in once the window is chunked and stored)
+        """
+        windows: Dict[str, OpenWindow] = {}
+        for msg in still_open:
+            msg_time = self._parse_datetime(msg.get("date"))
+            rowid = msg.get("rowid")
+            if msg_time is None or rowid is None:
+                continue
+            key = self.conversation_key(msg)
+            window = windows.get(key)
+            if window is None:
+                windows[key] = OpenWindow([rowid], msg_time, msg_time)
+            else:
+                window.rowids.append(rowid)
+                window.start_time = min(window.start_time, msg_time)
+                window.end_time = max(window.end_time, msg_time)
+        return windows
+
+    def can_extend(self, window: OpenWindow, date: Optional[str]) -> bool:
+        """Whether a message at `date` could still fall inside `window`."""
+        msg_time = self._parse_datetime(date)
+        if msg_time is None:
+            return True
+        return msg_time - window.end_time <= timedelta(hours=self.window_hours)
 
     def _create_time_windows(
         self,
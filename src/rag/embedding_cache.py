@@ -0,0 +1,222 @@
+"""
+Persistent, content-addressed embedding cache.
+
+Embeddings are a pure function of (model, text), so vectors are stored by
+a hash of exactly that pair. Clearing and rebuilding an index, switching
+between MessageVectorStore and UnifiedVectorStore, or embedding the same
+query twice then reuses the stored vector instead of paying for another
+OpenAI round-trip or local model pass.
+
+Vectors are stored as little-endian float32 blobs (6 KB for a 1536-dim
+OpenAI vector), or float16 to halve that at ~3 significant digits, which
+is well within what nearest-neighbour ranking can distinguish.
+
+CS Concept: **Content-addressed storage** - the key is derived from the
+content itself, so identical inputs share one entry no matter which source,
+store or process produced them, and entries never go stale.
+"""
+
+import hashlib
+import logging
+import sqlite3
+import struct
+import threading
+import weakref
+from pathlib import Path
+from typing import Dict, List, Optional, Sequence
+
+from ..chat_db import open_sidecar
+
+logger = logging.getLogger(__name__)
+
+DEFAULT_CACHE_PATH = Path.home() / ".imessage_rag" / "embedding_cache.db"
+
+# struct format codes for supported storage dtypes
+DTYPES = {"float32": "f", "float16": "e"}
+
+# Lookups counted in memory before the lifetime counters are written out
+COUNTER_FLUSH_EVERY = 10_000
+
+_SCHEMA = """
+    CREATE TABLE IF NOT EXISTS embedding (
+        key BLOB PRIMARY KEY,           -- blake2b(model NUL text), 16 bytes
+        model TEXT NOT NULL,
+        dtype TEXT NOT NULL,
+        vector BLOB NOT NULL
+    ) WITHOUT ROWID;
+    CREATE TABLE IF NOT EXISTS embedding_meta (
+        key TEXT PRIMARY KEY,
+        value INTEGER NOT NULL
+    );
+"""
+
+
+def cache_key(model: str, text: str) -> bytes:
+    """Content address for a (model, text) pair."""
+    return hashlib.blake2b(f"{model}\0{text}".encode("utf-8"), digest_size=16).digest()
+
+
+def pack_vector(vector: Sequence[float], dtype: str = "float32") -> bytes:
+    """Serialize a vector to a compact little-endian blob."""
+    return struct.pack(f"<{len(vector)}{DTYPES[dtype]}", *vector)
+
+
+def unpack_vector(blob: bytes, dtype: str = "float32") -> List[float]:
+    """Inverse of pack_vector."""
+    code = DTYPES[dtype]
+    return list(struct.unpack(f"<{len(blob) // struct.calcsize(code)}{code}", blob))
+
+
+class EmbeddingCache:
+    """
+    (model, text) -> vector cache stored in SQLite.
+
+    Safe to share between threads (the pipelined indexer embeds from a
+    worker pool). Hit/miss counters are kept per instance and accumulated
+    in the database so `stats` can report a lifetime hit rate. Lookups
+    never write: counts are buffered in memory and written with the next
+    put_many, every COUNTER_FLUSH_EVERY lookups, and on stats(), close()
+    or interpreter exit.
+
+    Args:
+        path: Cache database (default: ~/.imessage_rag/embedding_cache.db)
+        dtype: Storage precision for new vectors, "float32" or "float16"
+
+    Example:
+        cache = EmbeddingCache()
+        found = cache.get_many("text-embedding-3-small", ["hello"])
+        if "hello" not in found:
+            cache.put_many("text-embedding-3-small", {"hello": embed("hello")})
+    """
+
+    def __init__(self, path: Optional[Path] = None, dtype: str = "float32"):
+        if dtype not in DTYPES:
+            raise ValueError(f"Unsupported dtype: {dtype} (use one of {sorted(DTYPES)})")
+        self.path = Path(path) if path else DEFAULT_CACHE_PATH
+        self.dtype = dtype
+        self.conn = open_sidecar(self.path)
+        self.conn.executescript(_SCHEMA)
+        self._lock = threading.Lock()
+        self.hits = 0
+        self.misses = 0
+        self._pending = [0, 0]                   # Hits, misses not yet in embedding_meta
+        self._finalizer = weakref.finalize(self, _flush_counts, self.conn, self._lock, self._pending)
+
+    def get_many(self, model: str, texts: Sequence[str]) -> Dict[str, List[float]]:
+        """
+        Look up cached vectors for texts (batched primary-key lookups).
+
+        Returns:
+            Dict of text -> vector for hits only; missing texts are misses
+        """
+        keys = {cache_key(model, text): text for text in texts}
+        if not keys:
+            return {}
+
+        with self._lock:
+            rows = self._select_keys(list(keys))
+
+        found = {keys[bytes(key)]: unpack_vector(vector, dtype) for key, dtype, vector in rows}
+        misses = len(keys) - len(found)
+        self._count(len(found), misses)
+        return found
+
+    def _select_keys(self, keys: List[bytes]):
+        """Fetch rows for keys, 500 bound parameters per query."""
+        rows = []
+        for i in range(0, len(keys), 500):
+            batch = keys[i:i + 500]
+            rows.extend(self.conn.execute(
+                f"SELECT key, dtype, vector FROM embedding WHERE key IN ({','.join('?' * len(batch))})",
+                batch,
+            ).fetchall())
+        return rows
+
+    def put_many(self, model: str, vectors: Dict[str, Sequence[float]]):
+        """Store text -> vector pairs for model."""
+        rows = [
+            (cache_key(model, text), model, self.dtype, pack_vector(vector, self.dtype))
+            for text, vector in vectors.items()
+        ]
+        if not rows:
+            return
+        with self._lock, self.conn:
+            self.conn.executemany(
+                "INSERT OR REPLACE INTO embedding (key, model, dtype, vector) VALUES (?, ?, ?, ?)",
+                rows,
+            )
+            _write_counts(self.conn, self._pending)
+
+    def _count(self, hits: int, misses: int):
+        """Update instance counters; lifetime ones are buffered (see flush)."""
+        with self._lock:
+            self.hits += hits
+            self.misses += misses
+            self._pending[0] += hits
+            self._pending[1] += misses
+            due = sum(self._pending) >= COUNTER_FLUSH_EVERY
+        if due:
+            self.flush()
+
+    def flush(self):
+        """Write buffered hit/miss counts to the lifetime counters."""
+        _flush_counts(self.conn, self._lock, self._pending)
+
+    def close(self):
+        """Flush counters and close the database."""
+        self._finalizer()
+        self.conn.close()
+
+    def stats(self) -> Dict[str, object]:
+        """Entry count, size on disk and hit rates (this process and lifetime)."""
+        self.flush()
+        with self._lock:
+            entries, size = self.conn.execute(
+                "SELECT COUNT(*), COALESCE(SUM(LENGTH(vector)), 0) FROM embedding"
+            ).fetchone()
+            lifetime = dict(self.conn.execute("SELECT key, value FROM embedding_meta").fetchall())
+
+        def rate(hits, misses):
+            return round(hits / (hits + misses), 3) if hits + misses else None
+
+        lifetime_hits = lifetime.get("hits", 0)
+        lifetime_misses = lifetime.get("misses", 0)
+        return {
+            "path": str(self.path),
+            "entries": entries,
+            "vector_bytes": size,
+            "hits": self.hits,
+            "misses": self.misses,
+            "hit_rate": rate(self.hits, self.misses),
+            "lifetime_hits": lifetime_hits,
+            "lifetime_misses": lifetime_misses,
+            "lifetime_hit_rate": rate(lifetime_hits, lifetime_misses),
+        }
+
+    def clear(self):
+        """Drop every cached vector and reset counters."""
+        with self._lock, self.conn:
+            self.conn.execute("DELETE FROM embedding")
+            self.conn.execute("DELETE FROM embedding_meta")
+            self._pending[:] = [0, 0]
+
+
+def _write_counts(conn: sqlite3.Connection, pending: List[int]):
+    """Add pending [hits, misses] to embedding_meta (caller holds the lock and a transaction)."""
+    hits, misses = pending
+    if hits or misses:
+        conn.executemany(
+            "INSERT INTO embedding_meta (key, value) VALUES (?, ?) "
+            "ON CONFLICT(key) DO UPDATE SET value = value + excluded.value",
+            [("hits", hits), ("misses", misses)],
+        )
+        pending[:] = [0, 0]
+
+
+def _flush_counts(conn: sqlite3.Connection, lock: threading.Lock, pending: List[int]):
+    """Write pending counts in their own transaction; also the exit-time finalizer."""
+    try:
+        with lock, conn:
+            _write_counts(conn, pending)
+    except sqlite3.Error as e:
+        logger.debug(f"Could not update embedding cache counters: {e}")
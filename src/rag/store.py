@@ -15,12 +15,21 @@ the storage mechanism (ChromaDB) behind a clean interface. If we wanted to
 switch to FAISS or Pinecone later, only this module changes.
 """
 
+import importlib.util
 import logging
 import os
+import random
+import sqlite3
+import threading
+import time
+from collections import OrderedDict, deque
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
-from typing import List, Dict, Optional, Tuple
+from typing import Callable, List, Dict, Optional, Tuple
 from datetime import datetime
 
+from ..tracing import span
+
 logger = logging.getLogger(__name__)
 
 # Lazy imports to avoid startup cost if not using RAG
@@ -57,6 +66,170 @@ def _get_openai():
     return _openai
 
 
+# IDs per existence-check query (keeps each get() well under SQLite's
+# bound-parameter limit inside ChromaDB)
+EXISTENCE_CHECK_BATCH = 500
+
+
+def find_existing_ids(collection, ids: List[str], batch_size: int = EXISTENCE_CHECK_BATCH) -> set:
+    """
+    Return the subset of `ids` already stored in a ChromaDB collection.
+
+    Looks up only the candidate IDs, in batches, with include=[] so no
+    embeddings, documents or metadata are loaded. Cost scales with the
+    number of candidates, not with the size of the collection (unlike
+    set(collection.get()["ids"])).
+
+    Args:
+        collection: ChromaDB collection
+        ids: Candidate chunk IDs
+        batch_size: IDs per get() call
+
+    Returns:
+        Set of IDs that already exist
+    """
+    existing = set()
+    unique_ids = list(dict.fromkeys(ids))
+    for i in range(0, len(unique_ids), batch_size):
+        batch = unique_ids[i:i + batch_size]
+        existing.update(collection.get(ids=batch, include=[])["ids"])
+    return existing
+
+
+def filter_new_chunks(collection, chunks: List) -> List:
+    """
+    Drop chunks whose chunk_id is already in the collection (or repeated).
+
+    Args:
+        collection: ChromaDB collection
+        chunks: Chunks with a chunk_id attribute
+
+    Returns:
+        Chunks to add, first occurrence of each ID only
+    """
+    existing = find_existing_ids(collection, [c.chunk_id for c in chunks])
+    new_chunks = []
+    for chunk in chunks:
+        if chunk.chunk_id not in existing:
+            existing.add(chunk.chunk_id)
+            new_chunks.append(chunk)
+    return new_chunks
+
+
+_RETRYABLE_ERRORS = {"RateLimitError", "APITimeoutError", "APIConnectionError", "InternalServerError"}
+
+
+def _status_code(error: Exception) -> Optional[int]:
+    """HTTP status from an OpenAI SDK error, if any."""
+    return getattr(error, "status_code", None) or getattr(getattr(error, "response", None), "status_code", None)
+
+
+def _is_retryable(error: Exception) -> bool:
+    """Whether an OpenAI error is transient (rate limit, timeout, 5xx)."""
+    if type(error).__name__ in _RETRYABLE_ERRORS:
+        return True
+    status = _status_code(error)
+    return status == 429 or (status is not None and status >= 500)
+
+
+def _retry_after_seconds(error: Exception) -> Optional[float]:
+    """Retry-After header (seconds) from an OpenAI error response, if present."""
+    headers = getattr(getattr(error, "response", None), "headers", None) or {}
+    try:
+        value = headers.get("retry-after")
+        return float(value) if value is not None else None
+    except (TypeError, ValueError, AttributeError):
+        return None
+
+
+def embed_and_add_pipelined(
+    collection,
+    embedder: "EmbeddingProvider",
+    chunks: List,
+    batch_size: int = 100,
+    max_in_flight: Optional[int] = None,
+    store_embeddings: Optional[Callable[[List[str], List[List[float]]], List[List[float]]]] = None,
+) -> int:
+    """
+    Embed chunks and write them to a collection with overlapping batches.
+
+    Up to `max_in_flight` embedding requests run concurrently on worker
+    threads while the calling thread writes finished batches to ChromaDB
+    in submission order, so network latency and Chroma writes overlap
+    instead of alternating. At most `max_in_flight` batches are pending at
+    once, which bounds memory. All collection writes happen on the calling
+    thread.
+
+    Args:
+        collection: ChromaDB collection to add to
+        embedder: EmbeddingProvider (its max_concurrency and
+            preferred_batch_size apply when not overridden)
+        chunks: Chunks with chunk_id, to_embedding_text() and to_dict()
+        batch_size: Chunks per embedding request (the local backend may
+            use larger batches; see EmbeddingProvider.preferred_batch_size)
+        max_in_flight: Concurrent embedding requests (default: per backend)
+        store_embeddings: Called on the writing thread with each batch's
+            (ids, vectors) before the Chroma write; returns the vectors
+            to write (e.g. truncated ones, see quantized_vectors)
+
+    Returns:
+        Number of chunks added
+
+    Raises:
+        Whatever the embedder raises once its retries are exhausted;
+        batches already written stay in the collection.
+    """
+    if not chunks:
+        return 0
+
+    batch_size = embedder.preferred_batch_size(batch_size)
+    max_in_flight = max(1, max_in_flight or embedder.max_concurrency)
+
+    def prepare(batch):
+        return (
+            [c.chunk_id for c in batch],
+            [c.to_embedding_text() for c in batch],
+            [c.to_dict() for c in batch],
+        )
+
+    batches = (chunks[i:i + batch_size] for i in range(0, len(chunks), batch_size))
+    added = 0
+    pending = deque()
+
+    def write_oldest():
+        nonlocal added
+        ids, texts, metadatas, future = pending.popleft()
+        # Embedding runs on the pool; this is the part not hidden behind writes
+        with span("embed"):
+            embeddings = future.result()
+        if store_embeddings is not None:
+            embeddings = store_embeddings(ids, embeddings)
+        collection.add(
+            ids=ids,
+            embeddings=embeddings,
+            documents=texts,
+            metadatas=metadatas,
+        )
+        added += len(ids)
+        logger.debug(f"Added batch of {len(ids)} chunks ({added}/{len(chunks)})")
+
+    with ThreadPoolExecutor(max_workers=max_in_flight, thread_name_prefix="embed") as pool:
+        try:
+            for batch in batches:
+                ids, texts, metadatas = prepare(batch)
+                pending.append((ids, texts, metadatas, pool.submit(embedder.embed, texts)))
+                if len(pending) >= max_in_flight:
+                    write_oldest()
+            while pending:
+                write_oldest()
+        except BaseException:
+            for *_, future in pending:
+                future.cancel()
+            raise
+
+    return added
+
+
 class EmbeddingProvider:
     """
     Generates embeddings for text using OpenAI or local models.
@@ -68,14 +241,58 @@ class EmbeddingProvider:
     Args:
         use_local: If True, use local sentence-transformers instead of OpenAI
         model: Model name (OpenAI: "text-embedding-3-small", local: "all-MiniLM-L6-v2")
+        max_retries: OpenAI retries on rate limits/transient errors (default: 5)
+        cache: EmbeddingCache to consult before computing vectors
+            (default: shared cache at ~/.imessage_rag/embedding_cache.db)
+        use_cache: Set False to always recompute
+        dimensions: Shorter output vectors: sent as the OpenAI `dimensions`
+            parameter (text-embedding-3 models), or applied to local vectors
+            by truncating and renormalizing. To keep full vectors for
+            re-ranking instead, use a reduced VectorConfig on the store.
+
+    Thread safety: embed() may be called from several threads at once (see
+    embed_and_add_pipelined). A rate-limit response pauses every thread,
+    not just the one that received it.
+
+    Search queries go through embed_query(), which normalizes the text and
+    keeps recent query vectors in an in-memory LRU in front of the disk
+    cache. The local model is loaded on first use (or by warm_up() in the
+    daemon), so a CLI search whose query is already cached never pays for
+    importing torch and loading weights.
     """
 
+    # Concurrent OpenAI requests per indexing run (env: IMESSAGE_RAG_EMBED_CONCURRENCY)
+    DEFAULT_OPENAI_CONCURRENCY = 4
+
+    # Texts per encode() call for sentence-transformers; encode() sub-batches
+    # internally (LOCAL_ENCODE_BATCH), so larger calls amortize per-call overhead
+    LOCAL_CALL_BATCH = 512
+    LOCAL_ENCODE_BATCH = 64
+
+    # Recent query vectors kept in memory (per provider instance)
+    QUERY_CACHE_SIZE = 256
+
+    # Requested output size (None = the model's native dimensions)
+    output_dimensions: Optional[int] = None
+
     def __init__(
         self,
         use_local: bool = False,
         model: Optional[str] = None,
+        max_retries: int = 5,
+        cache=None,
+        use_cache: bool = True,
+        dimensions: Optional[int] = None,
     ):
         self.use_local = use_local
+        self.output_dimensions = dimensions
+        self.max_retries = max_retries
+        self._pause_until = 0.0
+        self._pause_lock = threading.Lock()
+        self._cache = cache
+        self._cache_enabled = use_cache
+        self._query_cache: "OrderedDict[str, List[float]]" = OrderedDict()
+        self._query_lock = threading.Lock()
 
         if use_local:
             self.model = model or "all-MiniLM-L6-v2"
@@ -94,25 +311,74 @@ class EmbeddingProvider:
                 "Either set it or use use_local=True for local embeddings."
             )
         self.client = OpenAI(api_key=api_key)
-        self.dimensions = 1536  # text-embedding-3-small dimensions
+        self.dimensions = self.output_dimensions or 1536  # text-embedding-3-small dimensions
         logger.info(f"Initialized OpenAI embeddings with model: {self.model}")
 
     def _init_local_model(self):
-        """Initialize local sentence-transformers model."""
-        global _sentence_transformers
-        try:
-            from sentence_transformers import SentenceTransformer
-            _sentence_transformers = SentenceTransformer
-        except ImportError:
+        """
+        Check sentence-transformers is available; the model loads on first use.
+
+        find_spec() fails fast without importing torch, which alone costs
+        seconds per process.
+        """
+        if importlib.util.find_spec("sentence_transformers") is None:
             raise ImportError(
                 "sentence-transformers not installed. "
                 "Run: pip install sentence-transformers"
             )
+        self.client = None
+        self.dimensions = None
+        self._model_lock = threading.Lock()
 
-        self.client = _sentence_transformers(self.model)
-        # Get dimensions from model
-        self.dimensions = self.client.get_sentence_embedding_dimension()
-        logger.info(f"Initialized local embeddings with model: {self.model} (dim={self.dimensions})")
+    def _load_local_model(self):
+        """Load the sentence-transformers model once per provider."""
+        global _sentence_transformers
+        with self._model_lock:
+            if self.client is None:
+                if _sentence_transformers is None:
+                    from sentence_transformers import SentenceTransformer
+                    _sentence_transformers = SentenceTransformer
+
+                self.client = _sentence_transformers(self.model)
+                # Get dimensions from model
+                self.dimensions = self.client.get_sentence_embedding_dimension()
+                if self.output_dimensions:
+                    self.dimensions = min(self.dimensions, self.output_dimensions)
+                logger.info(f"Initialized local embeddings with model: {self.model} (dim={self.dimensions})")
+        return self.client
+
+    def warm_up(self):
+        """
+        Load everything the first query needs (for resident processes).
+
+        Loads the local model and opens the embedding cache so the daemon's
+        first search is as fast as the rest.
+        """
+        if self.use_local:
+            self._load_local_model()
+        self._get_cache()
+
+    @property
+    def max_concurrency(self) -> int:
+        """
+        Embedding calls worth running concurrently.
+
+        OpenAI requests are latency-bound, so several are kept in flight.
+        The local model already uses every core per call, so extra threads
+        would only contend.
+        """
+        if self.use_local:
+            return 1
+        try:
+            return max(1, int(os.environ.get("IMESSAGE_RAG_EMBED_CONCURRENCY", "")))
+        except ValueError:
+            return self.DEFAULT_OPENAI_CONCURRENCY
+
+    def preferred_batch_size(self, requested: int) -> int:
+        """Texts per embed() call: as requested for OpenAI, larger for local."""
+        if self.use_local:
+            return max(requested, self.LOCAL_CALL_BATCH)
+        return requested
 
     def embed(self, texts: List[str]) -> List[List[float]]:
         """
@@ -125,32 +391,123 @@ class EmbeddingProvider:
             List of embedding vectors (each is a list of floats)
 
         Complexity: O(n) where n = total tokens across all texts.
-        API calls are batched for efficiency.
+        API calls are batched for efficiency, and texts already in the
+        embedding cache (same model + text) are not sent at all.
         """
         if not texts:
             return []
 
+        cache = self._get_cache()
+        if cache is None:
+            return self._compute(texts)
+
+        model_key = self.cache_model_key
+        try:
+            found = cache.get_many(model_key, texts)
+        except sqlite3.Error as e:
+            logger.warning(f"Embedding cache lookup failed, computing directly: {e}")
+            return self._compute(texts)
+
+        missing = list(dict.fromkeys(t for t in texts if t not in found))
+        if missing:
+            computed = dict(zip(missing, self._compute(missing)))
+            try:
+                cache.put_many(model_key, computed)
+            except sqlite3.Error as e:
+                logger.debug(f"Could not store embeddings in cache: {e}")
+            found.update(computed)
+
+        return [found[t] for t in texts]
+
+    def _compute(self, texts: List[str]) -> List[List[float]]:
+        """Embed texts with the configured backend, bypassing the cache."""
         if self.use_local:
             return self._embed_local(texts)
         else:
             return self._embed_openai(texts)
 
+    @property
+    def cache_model_key(self) -> str:
+        """Model identity used in cache keys (backend + model name + output size)."""
+        key = f"{'local' if self.use_local else 'openai'}:{self.model}"
+        return f"{key}@{self.output_dimensions}" if self.output_dimensions else key
+
+    def _get_cache(self):
+        """Return the embedding cache, opening the default one on first use."""
+        if self._cache is None and self._cache_enabled:
+            try:
+                from .embedding_cache import EmbeddingCache
+                self._cache = EmbeddingCache()
+            except (sqlite3.Error, OSError) as e:
+                logger.warning(f"Embedding cache unavailable: {e}")
+                self._cache_enabled = False
+        return self._cache if self._cache_enabled else None
+
+    def cache_stats(self) -> Optional[Dict]:
+        """Hit/miss stats for the embedding cache, or None if disabled."""
+        cache = self._get_cache()
+        return cache.stats() if cache is not None else None
+
     def _embed_openai(self, texts: List[str]) -> List[List[float]]:
-        """Generate embeddings using OpenAI API."""
-        try:
-            response = self.client.embeddings.create(
-                model=self.model,
-                input=texts,
-            )
-            return [item.embedding for item in response.data]
-        except Exception as e:
-            logger.error(f"OpenAI embedding error: {e}")
-            raise
+        """
+        Generate embeddings using OpenAI API.
+
+        Rate limits (429), timeouts, connection errors and 5xx responses are
+        retried with exponential backoff and jitter, honoring Retry-After
+        when the API sends it.
+        """
+        attempt = 0
+        while True:
+            self._wait_for_rate_limit()
+            try:
+                extra = {"dimensions": self.output_dimensions} if self.output_dimensions else {}
+                response = self.client.embeddings.create(
+                    model=self.model,
+                    input=texts,
+                    **extra,
+                )
+                return [item.embedding for item in response.data]
+            except Exception as e:
+                if attempt >= self.max_retries or not _is_retryable(e):
+                    logger.error(f"OpenAI embedding error: {e}")
+                    raise
+                delay = _retry_after_seconds(e) or min(30.0, 0.5 * 2 ** attempt)
+                delay *= 1 + random.random() * 0.25
+                attempt += 1
+                logger.warning(
+                    f"OpenAI embedding {type(e).__name__}, retry {attempt}/{self.max_retries} in {delay:.1f}s"
+                )
+                if _status_code(e) == 429:
+                    self._pause_all(delay)
+                else:
+                    time.sleep(delay)
+
+    def _wait_for_rate_limit(self):
+        """Block while another thread's rate-limit pause is in effect."""
+        while True:
+            with self._pause_lock:
+                remaining = self._pause_until - time.monotonic()
+            if remaining <= 0:
+                return
+            time.sleep(remaining)
+
+    def _pause_all(self, seconds: float):
+        """Pause every embedding thread for `seconds` (extends, never shortens)."""
+        with self._pause_lock:
+            self._pause_until = max(self._pause_until, time.monotonic() + seconds)
+        self._wait_for_rate_limit()
 
     def _embed_local(self, texts: List[str]) -> List[List[float]]:
         """Generate embeddings using local model."""
         try:
-            embeddings = self.client.encode(texts, convert_to_numpy=True)
+            embeddings = self._load_local_model().encode(
+                texts,
+                batch_size=self.LOCAL_ENCODE_BATCH,
+                convert_to_numpy=True,
+            )
+            if self.output_dimensions:
+                from .unified.quantized_vectors import truncate
+                return [truncate(vector, self.output_dimensions) for vector in embeddings.tolist()]
             return embeddings.tolist()
         except Exception as e:
             logger.error(f"Local embedding error: {e}")
@@ -158,7 +515,8 @@ class EmbeddingProvider:
 
     def embed_single(self, text: str) -> List[float]:
         """
-        Generate embedding for a single text.
+        Generate embedding for a single text (served from the cache when
+        the same text was embedded before).
 
         Args:
             text: Text string to embed
@@ -168,6 +526,43 @@ class EmbeddingProvider:
         """
         return self.embed([text])[0]
 
+    @staticmethod
+    def normalize_query(text: str) -> str:
+        """Canonical form of a search query: trimmed, single-spaced, casefolded."""
+        return " ".join(text.split()).casefold()
+
+    def embed_query(self, query: str) -> List[float]:
+        """
+        Embed a search query via the in-memory LRU, then the disk cache.
+
+        The LRU is keyed by the normalized query, so "Dinner plans" and
+        " dinner  plans" share one entry, but the model always embeds the
+        query as typed: casing carries signal (names, acronyms), and the
+        vectors stay the ones earlier versions produced. On an LRU miss the
+        disk cache is keyed by that original text, like document text.
+
+        Args:
+            query: Natural language search query
+
+        Returns:
+            Embedding vector as list of floats
+        """
+        key = self.normalize_query(query)
+        with self._query_lock:
+            vector = self._query_cache.get(key)
+            if vector is not None:
+                self._query_cache.move_to_end(key)
+                return vector
+
+        vector = self.embed([query])[0]
+
+        with self._query_lock:
+            self._query_cache[key] = vector
+            self._query_cache.move_to_end(key)
+            while len(self._query_cache) > self.QUERY_CACHE_SIZE:
+                self._query_cache.popitem(last=False)
+        return vector
+
 
 class MessageVectorStore:
     """
@@ -244,14 +639,14 @@ class MessageVectorStore:
         Returns:
             Number of new chunks added
 
-        Complexity: O(n) for n chunks, with n/batch_size API calls.
+        Complexity: O(n) for n chunks, with n/batch_size API calls
+        (several in flight at once; see embed_and_add_pipelined).
         """
         if not chunks:
             return 0
 
-        # Filter out already-indexed chunks
-        existing_ids = set(self.collection.get()["ids"])
-        new_chunks = [c for c in chunks if c.chunk_id not in existing_ids]
+        # Filter out already-indexed chunks (looks up only these IDs)
+        new_chunks = filter_new_chunks(self.collection, chunks)
 
         if not new_chunks:
             logger.info("All chunks already indexed, nothing to add")
@@ -259,29 +654,8 @@ class MessageVectorStore:
 
         logger.info(f"Indexing {len(new_chunks)} new chunks (skipping {len(chunks) - len(new_chunks)} existing)")
 
-        # Process in batches
-        added = 0
-        for i in range(0, len(new_chunks), batch_size):
-            batch = new_chunks[i:i + batch_size]
-
-            # Prepare data for ChromaDB
-            ids = [c.chunk_id for c in batch]
-            texts = [c.to_embedding_text() for c in batch]
-            metadatas = [c.to_dict() for c in batch]
-
-            # Generate embeddings
-            embeddings = self.embedder.embed(texts)
-
-            # Add to collection
-            self.collection.add(
-                ids=ids,
-                embeddings=embeddings,
-                documents=texts,
-                metadatas=metadatas,
-            )
-
-            added += len(batch)
-            logger.debug(f"Added batch of {len(batch)} chunks ({added}/{len(new_chunks)})")
+        # Concurrent embedding, overlapped with Chroma writes
+        added = embed_and_add_pipelined(self.collection, self.embedder, new_chunks, batch_size=batch_size)
 
         logger.info(f"Successfully indexed {added} chunks")
         return added
@@ -328,7 +702,7 @@ class MessageVectorStore:
             where = {"contact": {"$eq": contact_filter}}
 
         # Generate query embedding
-        query_embedding = self.embedder.embed_single(query)
+        query_embedding = self.embedder.embed_query(query)
 
         # Search
         results = self.collection.query(
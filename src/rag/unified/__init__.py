@@ -8,22 +8,61 @@ Supports indexing and semantic search across:
 - Calendar events
 - Slack messages
 - SuperWhisper voice transcriptions
+
+Exports are resolved lazily (PEP 562 module __getattr__): importing one
+indexer, or the retriever for `stats`, doesn't import every other source's
+indexer and its dependencies.
 """
 
-from .chunk import UnifiedChunk, SOURCE_TYPES, CONTEXT_TYPES
-from .store import UnifiedVectorStore
-from .base_indexer import BaseSourceIndexer
-from .superwhisper_indexer import SuperWhisperIndexer
-from .notes_indexer import NotesIndexer
-from .gmail_indexer import GmailIndexer
-from .slack_indexer import SlackIndexer
-from .calendar_indexer import CalendarIndexer
-from .retriever import UnifiedRetriever
+from typing import TYPE_CHECKING
+
+# Public name -> submodule that defines it
+_EXPORTS = {
+    "UnifiedChunk": "chunk",
+    "SOURCE_TYPES": "chunk",
+    "CONTEXT_TYPES": "chunk",
+    "UnifiedVectorStore": "store",
+    "VectorConfig": "quantized_vectors",
+    "BaseSourceIndexer": "base_indexer",
+    "SuperWhisperIndexer": "superwhisper_indexer",
+    "NotesIndexer": "notes_indexer",
+    "GmailIndexer": "gmail_indexer",
+    "SlackIndexer": "slack_indexer",
+    "CalendarIndexer": "calendar_indexer",
+    "UnifiedRetriever": "retriever",
+}
+
+if TYPE_CHECKING:
+    from .chunk import UnifiedChunk, SOURCE_TYPES, CONTEXT_TYPES
+    from .store import UnifiedVectorStore
+    from .quantized_vectors import VectorConfig
+    from .base_indexer import BaseSourceIndexer
+    from .superwhisper_indexer import SuperWhisperIndexer
+    from .notes_indexer import NotesIndexer
+    from .gmail_indexer import GmailIndexer
+    from .slack_indexer import SlackIndexer
+    from .calendar_indexer import CalendarIndexer
+    from .retriever import UnifiedRetriever
+
+
+def __getattr__(name):
+    module = _EXPORTS.get(name)
+    if module is None:
+        raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+    from importlib import import_module
+    value = getattr(import_module(f".{module}", __name__), name)
+    globals()[name] = value  # Later lookups skip __getattr__
+    return value
+
+
+def __dir__():
+    return sorted(list(globals()) + list(_EXPORTS))
 
 __all__ = [
     # Core
     "UnifiedChunk",
     "UnifiedVectorStore",
+    "VectorConfig",
     "BaseSourceIndexer",
     "UnifiedRetriever",
     # Constants
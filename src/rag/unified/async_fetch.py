@@ -0,0 +1,193 @@
+"""
+Asynchronous paged fetching for remote sources (Gmail, Slack, Calendar).
+
+Remote APIs return results a page at a time behind a page token, with
+rate limits and transient failures. This module runs one pagination loop
+per stream (a Gmail label, a Slack channel, a calendar) concurrently, caps
+the number of requests in flight, retries transient errors with
+exponential backoff, and hands pages to the consumer as they arrive so
+chunking and embedding overlap with the network.
+
+CS Concept: Bounded concurrency with backpressure. A semaphore limits
+in-flight requests (rate limits are per account, not per stream), and the
+bounded queue between fetchers and the consumer stops fetching from
+running ahead of embedding, so memory stays at a few pages.
+
+Fetchers are async callables supplied by the caller (an MCP tool wrapper,
+an API client), called as:
+
+    await fetcher(page_token=None | str, **stream.params)
+
+and returning a Page, a {"items": [...], "next_page_token": ...} dict, or
+a plain list (a single page). Raise RetryableError (e.g. for HTTP 429/5xx)
+to request a retry; ConnectionError and timeouts are retried too.
+"""
+
+import asyncio
+import logging
+import random
+from dataclasses import dataclass, field
+from typing import Any, AsyncIterator, Awaitable, Callable, Dict, List, Optional
+
+logger = logging.getLogger(__name__)
+
+DEFAULT_CONCURRENCY = 4        # Requests in flight across all streams
+DEFAULT_RETRIES = 4            # Retries per request after the first attempt
+BASE_BACKOFF = 0.5             # Seconds before the first retry (doubles each time)
+MAX_BACKOFF = 30.0
+REQUEST_TIMEOUT = 60.0         # Seconds per page request
+
+
+class RetryableError(Exception):
+    """
+    Transient upstream failure (rate limit, 5xx); the request is retried.
+
+    Args:
+        retry_after: Seconds the server asked us to wait, if it said
+    """
+
+    def __init__(self, message: str = "", retry_after: Optional[float] = None):
+        super().__init__(message)
+        self.retry_after = retry_after
+
+
+RETRYABLE_ERRORS = (RetryableError, ConnectionError, asyncio.TimeoutError, TimeoutError)
+
+
+@dataclass
+class Page:
+    """One page of upstream results."""
+    items: List[Dict[str, Any]]
+    next_page_token: Optional[str] = None
+
+    @classmethod
+    def coerce(cls, result: Any) -> "Page":
+        """Accept a Page, a dict with items/next_page_token, or a list."""
+        if isinstance(result, Page):
+            return result
+        if isinstance(result, dict):
+            return cls(
+                items=list(result.get("items") or []),
+                next_page_token=result.get("next_page_token") or result.get("nextPageToken"),
+            )
+        return cls(items=list(result or []))
+
+
+PageFetcher = Callable[..., Awaitable[Any]]
+
+
+@dataclass
+class FetchStream:
+    """
+    One independently paginated feed.
+
+    Attributes:
+        key: Stream identifier, also its key in the source's cursor
+        fetcher: Async page fetcher (see module docstring)
+        params: Keyword arguments passed to every fetcher call
+    """
+    key: str
+    fetcher: PageFetcher
+    params: Dict[str, Any] = field(default_factory=dict)
+
+
+@dataclass
+class StreamEvent:
+    """A fetched page, or the end of a stream (done, or failed with error)."""
+    key: str
+    page: Optional[Page] = None
+    done: bool = False
+    error: Optional[BaseException] = None
+
+
+async def call_with_backoff(
+    call: Callable[[], Awaitable[Any]],
+    retries: int = DEFAULT_RETRIES,
+    base_delay: float = BASE_BACKOFF,
+    max_delay: float = MAX_BACKOFF,
+    timeout: Optional[float] = REQUEST_TIMEOUT,
+    sleep: Callable[[float], Awaitable[None]] = asyncio.sleep,
+) -> Any:
+    """
+    Await call(), retrying transient failures with jittered exponential backoff.
+
+    Raises:
+        The last error once retries are exhausted, or any non-retryable error
+    """
+    attempt = 0
+    while True:
+        try:
+            if timeout is None:
+                return await call()
+            return await asyncio.wait_for(call(), timeout)
+        except RETRYABLE_ERRORS as e:
+            if attempt >= retries:
+                raise
+            delay = min(max_delay, base_delay * (2 ** attempt))
+            retry_after = getattr(e, "retry_after", None)
+            if retry_after is not None:
+                delay = max(delay, retry_after)
+            delay *= 1 + random.random() * 0.25
+            attempt += 1
+            logger.debug(f"Retrying after {delay:.1f}s ({attempt}/{retries}): {e!r}")
+            await sleep(delay)
+
+
+async def fetch_pages(
+    streams: List[FetchStream],
+    concurrency: int = DEFAULT_CONCURRENCY,
+    queue_size: Optional[int] = None,
+    **backoff,
+) -> AsyncIterator[StreamEvent]:
+    """
+    Page through every stream concurrently, yielding events as they arrive.
+
+    Each stream yields its pages in order, then one done (or error) event.
+    Closing the iterator early (e.g. a limit was reached) cancels the
+    remaining fetches.
+
+    Args:
+        streams: Feeds to paginate
+        concurrency: Maximum requests in flight across all streams
+        queue_size: Pages buffered ahead of the consumer (default: 2x concurrency)
+        **backoff: Passed to call_with_backoff (retries, base_delay, ...)
+    """
+    if not streams:
+        return
+
+    semaphore = asyncio.Semaphore(max(1, concurrency))
+    queue: asyncio.Queue = asyncio.Queue(maxsize=queue_size or 2 * max(1, concurrency))
+
+    async def paginate(stream: FetchStream):
+        token = None
+        try:
+            while True:
+                async with semaphore:
+                    result = await call_with_backoff(
+                        lambda: stream.fetcher(page_token=token, **stream.params), **backoff
+                    )
+                page = Page.coerce(result)
+                await queue.put(StreamEvent(stream.key, page=page))
+                token = page.next_page_token
+                if not token:
+                    break
+        except asyncio.CancelledError:
+            raise
+        except Exception as e:
+            logger.error(f"Fetching {stream.key} failed: {e}")
+            await queue.put(StreamEvent(stream.key, done=True, error=e))
+            return
+        await queue.put(StreamEvent(stream.key, done=True))
+
+    tasks = [asyncio.create_task(paginate(stream)) for stream in streams]
+    remaining = len(tasks)
+    try:
+        while remaining:
+            event = await queue.get()
+            if event.done:
+                remaining -= 1
+            yield event
+    finally:
+        for task in tasks:
+            task.cancel()
+        await asyncio.gather(*tasks, return_exceptions=True)
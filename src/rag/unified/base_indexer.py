@@ -9,17 +9,47 @@ skeleton of the indexing algorithm in the base class, and subclasses
 implement the source-specific steps.
 """
 
+import functools
+import inspect
 import logging
 from abc import ABC, abstractmethod
 from datetime import datetime, timedelta
-from typing import List, Optional, Dict, Any, Generator
+from typing import TYPE_CHECKING, List, Optional, Dict, Any, Generator
 
+from ...tracing import span, trace
 from .chunk import UnifiedChunk
 from .store import UnifiedVectorStore
 
+if TYPE_CHECKING:
+    from .async_fetch import FetchStream
+
 logger = logging.getLogger(__name__)
 
 
+def record_stages(index_method):
+    """
+    Trace an index()/index_async() implementation and add its per-stage
+    wall times (fetch, decode, enrich, chunk, embed, store, other) to the
+    returned stats as "stages". Overrides of index() apply it too.
+    """
+    if inspect.iscoroutinefunction(index_method):
+        @functools.wraps(index_method)
+        async def run_async(self, *args, **kwargs):
+            with trace(f"index_{self.source_name}") as stages:
+                result = await index_method(self, *args, **kwargs)
+            result["stages"] = stages.stage_seconds()
+            return result
+        return run_async
+
+    @functools.wraps(index_method)
+    def run(self, *args, **kwargs):
+        with trace(f"index_{self.source_name}") as stages:
+            result = index_method(self, *args, **kwargs)
+        result["stages"] = stages.stage_seconds()
+        return result
+    return run
+
+
 class BaseSourceIndexer(ABC):
     """
     Abstract base class for data source indexers.
@@ -63,6 +93,18 @@ class BaseSourceIndexer(ABC):
         )
         self._indexed_count = 0
 
+        # Incremental cursor support: subclasses with an IndexState set
+        # self.state, and fetch_data() stages the new high-water mark in
+        # _pending_cursor; index() persists it only after a successful store.
+        self.state = None
+        self._pending_cursor: Optional[Dict[str, Any]] = None
+
+        # File-backed sources also keep a FileManifest; fetch_data() stages
+        # its updates plus the chunk IDs of edited/removed files, which are
+        # deleted and committed together with the cursor.
+        self.manifest = None
+        self._stale_chunk_ids: List[str] = []
+
     @abstractmethod
     def fetch_data(
         self,
@@ -96,6 +138,7 @@ class BaseSourceIndexer(ABC):
         """
         pass
 
+    @record_stages
     def index(
         self,
         days: Optional[int] = None,
@@ -115,15 +158,17 @@ class BaseSourceIndexer(ABC):
             **kwargs: Source-specific options
 
         Returns:
-            Dict with indexing stats
+            Dict with indexing stats, including per-stage seconds in "stages"
         """
         start_time = datetime.now()
 
         logger.info(f"Starting {self.source_name} indexing (days={days}, limit={limit})")
 
         # Step 1: Fetch data
+        self._pending_cursor = None
         try:
-            data = self.fetch_data(days=days, limit=limit, **kwargs)
+            with span("fetch"):
+                data = self.fetch_data(days=days, limit=limit, **kwargs)
         except Exception as e:
             logger.error(f"Failed to fetch {self.source_name} data: {e}")
             return {
@@ -134,7 +179,8 @@ class BaseSourceIndexer(ABC):
 
         # Step 2: Convert to chunks
         try:
-            chunks = self.chunk_data(data)
+            with span("chunk"):
+                chunks = self.chunk_data(data)
         except Exception as e:
             logger.error(f"Failed to chunk {self.source_name} data: {e}")
             return {
@@ -145,6 +191,7 @@ class BaseSourceIndexer(ABC):
 
         if not chunks:
             logger.info(f"No {self.source_name} chunks to index")
+            self._commit_cursor()
             return {
                 "success": True,
                 "source": self.source_name,
@@ -170,6 +217,7 @@ class BaseSourceIndexer(ABC):
 
         duration = (datetime.now() - start_time).total_seconds()
         self._indexed_count += indexed_count
+        self._commit_cursor()
 
         logger.info(
             f"Indexed {indexed_count} {self.source_name} chunks in {duration:.1f}s"
@@ -183,6 +231,200 @@ class BaseSourceIndexer(ABC):
             "duration_seconds": duration,
         }
 
+    # ===== Async remote fetching (Gmail, Slack, Calendar) =====
+
+    # Chunk each page as it arrives; sources whose chunks span many items
+    # (Slack's time windows) set this False to chunk each stream at its end
+    chunk_per_page: bool = True
+
+    def fetch_streams(
+        self,
+        days: Optional[int] = None,
+        watermarks: Optional[Dict[str, Any]] = None,
+    ) -> List["FetchStream"]:
+        """
+        Remote feeds for index_async(); empty when no fetcher is configured.
+
+        Args:
+            days: Only fetch items from the last N days; applies to streams
+                without a watermark (first sync), the rest resume from theirs
+            watermarks: Stream key -> newest item watermark already indexed
+        """
+        return []
+
+    def item_watermark(self, item: Dict[str, Any]) -> Any:
+        """Monotonic per-item marker (historyId, ts, updated) for cursors, or None."""
+        return None
+
+    @record_stages
+    async def index_async(
+        self,
+        days: Optional[int] = None,
+        limit: Optional[int] = None,
+        batch_size: int = 100,
+        incremental: bool = True,
+        concurrency: Optional[int] = None,
+        **backoff,
+    ) -> Dict[str, Any]:
+        """
+        Fetch -> chunk -> store pipeline for remote sources, streamed.
+
+        All of the source's streams are paged concurrently (see
+        fetch_pages); each page is chunked and handed to add_chunks() in a
+        worker thread while the next pages download. A stream's cursor
+        (newest watermark seen) is committed only once the stream was read
+        to the end and stored, so an interrupted or limited run never skips
+        older unfetched pages.
+
+        Args:
+            days: History window for streams synced for the first time;
+                streams with a cursor resume from it instead
+            limit: Maximum items to index across all streams
+            batch_size: Batch size for embedding API
+            incremental: Resume each stream after its stored watermark
+            concurrency: Maximum requests in flight (default: DEFAULT_CONCURRENCY)
+            **backoff: Retry settings for call_with_backoff
+
+        Returns:
+            Dict with indexing stats; `errors` maps failed streams to messages.
+            In "stages", embed/store run on worker threads and overlap the
+            fetch time, so stages can sum to more than duration_seconds.
+        """
+        import asyncio
+        from .async_fetch import DEFAULT_CONCURRENCY, fetch_pages
+
+        start_time = datetime.now()
+        cursor = self.state.get_cursor(self.source_name) if self.state is not None else {}
+        stored = dict(cursor.get("streams", {}))
+        watermarks = stored if incremental else {}
+
+        streams = self.fetch_streams(days=days, watermarks=watermarks)
+        if not streams:
+            return {
+                "success": False,
+                "error": f"No {self.source_name} fetcher configured",
+                "source": self.source_name,
+            }
+
+        buffers: Dict[str, List[Dict[str, Any]]] = {stream.key: [] for stream in streams}
+        newest: Dict[str, Any] = {}
+        completed: List[str] = []
+        errors: Dict[str, str] = {}
+        items_fetched = 0
+        chunks_found = 0
+        chunks_indexed = 0
+
+        async def store_items(items: List[Dict[str, Any]]):
+            nonlocal chunks_found, chunks_indexed
+            with span("chunk"):
+                chunks = self.chunk_data(items) if items else []
+            if not chunks:
+                return
+            chunks_found += len(chunks)
+            result = await asyncio.to_thread(self.store.add_chunks, chunks, batch_size=batch_size)
+            chunks_indexed += result.get(self.source_name, 0)
+
+        pages = fetch_pages(streams, concurrency=concurrency or DEFAULT_CONCURRENCY, **backoff)
+        try:
+            async for event in pages:
+                if event.error is not None:
+                    errors[event.key] = str(event.error)
+                    buffers.pop(event.key, None)
+                    continue
+
+                if event.page is not None:
+                    old = watermarks.get(event.key)
+                    items = []
+                    for item in event.page.items:
+                        mark = self.item_watermark(item)
+                        if mark is not None:
+                            if old is not None and mark <= old:
+                                continue
+                            if event.key not in newest or mark > newest[event.key]:
+                                newest[event.key] = mark
+                        items.append(item)
+                    if limit:
+                        items = items[:max(limit - items_fetched, 0)]
+                    items_fetched += len(items)
+
+                    if self.chunk_per_page:
+                        await store_items(items)
+                    else:
+                        buffers[event.key].extend(items)
+
+                if event.done:
+                    if not self.chunk_per_page:
+                        await store_items(buffers.pop(event.key, []))
+                    completed.append(event.key)
+
+                if limit and items_fetched >= limit:
+                    break
+
+            # Limited runs may stop mid-stream; buffered items still get stored
+            for key in list(buffers):
+                if key not in completed and buffers[key]:
+                    await store_items(buffers.pop(key))
+        except Exception as e:
+            logger.error(f"Failed to index {self.source_name} data: {e}")
+            return {
+                "success": False,
+                "error": str(e),
+                "source": self.source_name,
+                "chunks_found": chunks_found,
+                "chunks_indexed": chunks_indexed,
+            }
+        finally:
+            await pages.aclose()
+
+        if self.state is not None and completed:
+            for key in completed:
+                if key in newest:
+                    stored[key] = newest[key]
+            self.state.update_cursor(self.source_name, {**cursor, "streams": stored})
+
+        duration = (datetime.now() - start_time).total_seconds()
+        self._indexed_count += chunks_indexed
+        logger.info(
+            f"Indexed {chunks_indexed} {self.source_name} chunks from {items_fetched} items "
+            f"({len(completed)}/{len(streams)} streams complete) in {duration:.1f}s"
+        )
+
+        result = {
+            "success": not errors,
+            "source": self.source_name,
+            "items_fetched": items_fetched,
+            "chunks_found": chunks_found,
+            "chunks_indexed": chunks_indexed,
+            "duration_seconds": duration,
+        }
+        if errors:
+            result["errors"] = errors
+        return result
+
+    def _commit_cursor(self):
+        """
+        Persist the cursor staged by fetch_data(), if any.
+
+        Superseded chunks are deleted first; if that fails, nothing is
+        committed so the next run finds the same files changed and retries.
+        """
+        if self._stale_chunk_ids:
+            try:
+                self.store.delete_chunks(self.source_name, self._stale_chunk_ids)
+            except Exception as e:
+                logger.error(f"Failed to delete superseded {self.source_name} chunks: {e}")
+                self._pending_cursor = None
+                if self.manifest is not None:
+                    self.manifest.discard()
+                return
+            self._stale_chunk_ids = []
+
+        if self._pending_cursor is not None and self.state is not None:
+            self.state.update_cursor(self.source_name, self._pending_cursor)
+        self._pending_cursor = None
+        if self.manifest is not None:
+            self.manifest.commit()
+
     def get_stats(self) -> Dict[str, Any]:
         """Get stats for this source from the store."""
         return self.store.get_stats(source=self.source_name)
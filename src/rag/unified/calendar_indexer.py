@@ -10,10 +10,15 @@ via external APIs or MCP tools.
 
 import logging
 from datetime import datetime
-from typing import List, Dict, Any, Optional, Callable
+from pathlib import Path
+from typing import TYPE_CHECKING, List, Dict, Any, Optional, Callable, Sequence
 
 from .base_indexer import BaseSourceIndexer
 from .chunk import UnifiedChunk
+from .index_state import IndexState
+
+if TYPE_CHECKING:
+    from .async_fetch import FetchStream
 
 logger = logging.getLogger(__name__)
 
@@ -26,7 +31,11 @@ class CalendarIndexer(BaseSourceIndexer):
     notes, and meeting information.
 
     Args:
-        calendar_fetcher: Function to fetch calendar events
+        calendar_fetcher: Async page fetcher for index_async(), called as
+            fetcher(page_token=..., calendar_id=..., time_min=..., updated_min=...)
+            (see async_fetch)
+        calendar_ids: Calendars fetched as separate concurrent streams
+        state_file: Incremental index state (default: ~/.imessage_rag/index_state.json)
         store: Optional UnifiedVectorStore to use
         use_local_embeddings: Use local embeddings instead of OpenAI
 
@@ -34,6 +43,10 @@ class CalendarIndexer(BaseSourceIndexer):
         indexer = CalendarIndexer()
         events = [...]  # Fetched via Google Calendar API
         result = indexer.index_with_data(events)
+
+        # Or page through calendars directly
+        indexer = CalendarIndexer(calendar_fetcher=list_events, calendar_ids=["primary"])
+        result = await indexer.index_async(days=90)
     """
 
     source_name = "calendar"
@@ -41,10 +54,14 @@ class CalendarIndexer(BaseSourceIndexer):
     def __init__(
         self,
         calendar_fetcher: Optional[Callable] = None,
+        calendar_ids: Sequence[str] = ("primary",),
+        state_file: Optional[Path] = None,
         **kwargs,
     ):
         super().__init__(**kwargs)
         self.calendar_fetcher = calendar_fetcher
+        self.calendar_ids = list(calendar_ids)
+        self.state = IndexState(state_file)
 
     def fetch_data(
         self,
@@ -55,14 +72,42 @@ class CalendarIndexer(BaseSourceIndexer):
         """
         Fetch events - requires calendar_fetcher to be set.
 
-        For direct use, call index_with_data() with pre-fetched events.
+        Fetching is asynchronous: use index_async() with a calendar_fetcher,
+        or index_with_data() with pre-fetched events.
         """
         logger.warning(
             "CalendarIndexer.fetch_data() is a stub. "
-            "Use index_with_data() with pre-fetched events."
+            "Use index_with_data() with pre-fetched events or "
+            "provide a calendar_fetcher and call index_async()."
         )
         return []
 
+    def fetch_streams(
+        self,
+        days: Optional[int] = None,
+        watermarks: Optional[Dict[str, Any]] = None,
+    ) -> List["FetchStream"]:
+        """One stream per calendar, resuming from the newest `updated` seen."""
+        if self.calendar_fetcher is None:
+            return []
+        from .async_fetch import FetchStream
+
+        watermarks = watermarks or {}
+        time_min = self.days_ago(days).isoformat() if days else None
+        return [
+            FetchStream(calendar_id, self.calendar_fetcher, {
+                "calendar_id": calendar_id,
+                "time_min": None if calendar_id in watermarks else time_min,
+                "updated_min": watermarks.get(calendar_id),
+            })
+            for calendar_id in self.calendar_ids
+        ]
+
+    def item_watermark(self, item: Dict[str, Any]) -> Optional[str]:
+        # RFC 3339 in UTC, so string order is time order
+        updated = item.get("updated")
+        return updated if isinstance(updated, str) else None
+
     def index_with_data(
         self,
         events: List[Dict[str, Any]],
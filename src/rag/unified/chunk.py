@@ -35,6 +35,46 @@ CONTEXT_TYPES = frozenset([
     "transcription",  # SuperWhisper
 ])
 
+# Metadata key prefixes for per-value boolean flags. ChromaDB `where`
+# clauses can't test substring membership in the comma-joined
+# participants/tags strings, but they can match `{"participant:Alice": True}`.
+PARTICIPANT_KEY_PREFIX = "participant:"
+TAG_KEY_PREFIX = "tag:"
+
+# timestamp_epoch of chunks without a timestamp. A `where` clause can't
+# match a missing key, so undated chunks carry this value and date filters
+# OR it in - they pass date filters, as they did before filtering moved
+# into the vector store.
+UNDATED_EPOCH = -1.0
+
+
+def filter_metadata(
+    timestamp: Optional[datetime],
+    end_timestamp: Optional[datetime],
+    participants: List[str],
+    tags: List[str],
+) -> Dict[str, Any]:
+    """
+    Build the filterable metadata fields for a chunk.
+
+    Timestamps become numeric epoch seconds (so `$gte`/`$lte` work; undated
+    chunks get UNDATED_EPOCH) and each participant/tag becomes its own
+    boolean key. Shared by to_dict() and the
+    vector store's backfill of chunks indexed before these fields existed.
+    """
+    result: Dict[str, Any] = {
+        "timestamp_epoch": timestamp.timestamp() if timestamp else UNDATED_EPOCH,
+    }
+    if end_timestamp:
+        result["end_timestamp_epoch"] = end_timestamp.timestamp()
+    for name in participants:
+        if name:
+            result[f"{PARTICIPANT_KEY_PREFIX}{name}"] = True
+    for tag in tags:
+        if tag:
+            result[f"{TAG_KEY_PREFIX}{tag}"] = True
+    return result
+
 
 @dataclass
 class UnifiedChunk:
@@ -172,6 +212,11 @@ class UnifiedChunk:
         if self.tags:
             result["tags"] = ",".join(self.tags)
 
+        # Epoch timestamps and per-participant/tag flags for where-filters
+        result.update(filter_metadata(
+            self.timestamp, self.end_timestamp, self.participants, self.tags
+        ))
+
         # Flatten simple metadata values
         for key, value in self.metadata.items():
             if isinstance(value, (str, int, float, bool)):
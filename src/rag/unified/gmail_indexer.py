@@ -13,10 +13,15 @@ import hashlib
 import logging
 import re
 from datetime import datetime
-from typing import List, Dict, Any, Optional, Callable
+from pathlib import Path
+from typing import TYPE_CHECKING, List, Dict, Any, Optional, Callable, Sequence
 
 from .base_indexer import BaseSourceIndexer
 from .chunk import UnifiedChunk
+from .index_state import IndexState
+
+if TYPE_CHECKING:
+    from .async_fetch import FetchStream
 
 logger = logging.getLogger(__name__)
 
@@ -26,19 +31,24 @@ class GmailIndexer(BaseSourceIndexer):
     Indexes Gmail emails.
 
     This indexer can work in two modes:
-    1. MCP mode: Uses gmail_fetch function to get emails
+    1. Fetcher mode: index_async() pages through each label with
+       gmail_fetcher (see async_fetch for the page contract)
     2. Direct mode: Accepts pre-fetched email data
 
     Args:
-        gmail_fetcher: Async function to fetch emails (for MCP mode)
+        gmail_fetcher: Async page fetcher, called as
+            fetcher(page_token=..., label=..., query=..., start_history_id=...)
+        labels: Labels fetched as separate concurrent streams
+        state_file: Incremental index state (default: ~/.imessage_rag/index_state.json)
         store: Optional UnifiedVectorStore to use
         use_local_embeddings: Use local embeddings instead of OpenAI
 
-    Example (MCP mode):
-        async def fetch_gmail(max_results, after_date):
-            return await mcp_gmail_list_emails(max_results=max_results, after_date=after_date)
+    Example (fetcher mode):
+        async def fetch_gmail(page_token, label, query, start_history_id):
+            page = await gmail_api_list(label=label, q=query, page_token=page_token)
+            return {"items": page["emails"], "next_page_token": page.get("nextPageToken")}
 
-        indexer = GmailIndexer(gmail_fetcher=fetch_gmail)
+        indexer = GmailIndexer(gmail_fetcher=fetch_gmail, labels=["INBOX", "SENT"])
         result = await indexer.index_async(days=30)
 
     Example (Direct mode):
@@ -53,10 +63,24 @@ class GmailIndexer(BaseSourceIndexer):
     def __init__(
         self,
         gmail_fetcher: Optional[Callable] = None,
+        labels: Sequence[str] = ("INBOX",),
+        state_file: Optional[Path] = None,
         **kwargs,
     ):
         super().__init__(**kwargs)
         self.gmail_fetcher = gmail_fetcher
+        self.labels = list(labels)
+        self.state = IndexState(state_file)
+
+    @property
+    def last_history_id(self) -> Optional[int]:
+        """
+        Highest Gmail historyId indexed so far, or None before the first run.
+
+        Fetchers can pass this as startHistoryId to users.history.list to
+        request only mailbox changes since the last index.
+        """
+        return self.state.get_cursor(self.source_name).get("history_id")
 
     def fetch_data(
         self,
@@ -67,19 +91,45 @@ class GmailIndexer(BaseSourceIndexer):
         """
         Fetch emails - requires gmail_fetcher to be set.
 
-        For async fetching, use index_with_data() instead.
+        Fetching is asynchronous: use index_async() with a gmail_fetcher,
+        or index_with_data() with pre-fetched emails.
         """
         logger.warning(
             "GmailIndexer.fetch_data() is a stub. "
             "Use index_with_data() with pre-fetched emails or "
-            "provide a gmail_fetcher in async context."
+            "provide a gmail_fetcher and call index_async()."
         )
         return []
 
+    def fetch_streams(
+        self,
+        days: Optional[int] = None,
+        watermarks: Optional[Dict[str, Any]] = None,
+    ) -> List["FetchStream"]:
+        """One stream per label, resuming from that label's historyId."""
+        if self.gmail_fetcher is None:
+            return []
+        from .async_fetch import FetchStream
+
+        watermarks = watermarks or {}
+        query = f"after:{self.days_ago(days):%Y/%m/%d}" if days else None
+        return [
+            FetchStream(label, self.gmail_fetcher, {
+                "label": label,
+                "query": None if label in watermarks else query,
+                "start_history_id": watermarks.get(label),
+            })
+            for label in self.labels
+        ]
+
+    def item_watermark(self, item: Dict[str, Any]) -> Optional[int]:
+        return self._history_id(item)
+
     def index_with_data(
         self,
         emails: List[Dict[str, Any]],
         batch_size: int = 100,
+        incremental: bool = True,
     ) -> Dict[str, Any]:
         """
         Index pre-fetched email data.
@@ -90,13 +140,26 @@ class GmailIndexer(BaseSourceIndexer):
         Args:
             emails: List of email dicts from Gmail API/MCP
             batch_size: Batch size for embeddings
+            incremental: Skip emails whose historyId is at or below the
+                last indexed one (emails without a historyId are kept)
 
         Returns:
             Dict with indexing stats
         """
         start_time = datetime.now()
 
+        watermark = (self.last_history_id or 0) if incremental else 0
+        history_ids = [self._history_id(email) for email in emails]
+        if watermark:
+            emails = [
+                email for email, history_id in zip(emails, history_ids)
+                if history_id is None or history_id > watermark
+            ]
+        newest = max([h for h in history_ids if h is not None] + [watermark])
+        self._pending_cursor = {"history_id": newest} if newest else None
+
         if not emails:
+            self._commit_cursor()
             return {
                 "success": True,
                 "source": self.source_name,
@@ -109,6 +172,7 @@ class GmailIndexer(BaseSourceIndexer):
         chunks = self.chunk_data(emails)
 
         if not chunks:
+            self._commit_cursor()
             return {
                 "success": True,
                 "source": self.source_name,
@@ -122,6 +186,7 @@ class GmailIndexer(BaseSourceIndexer):
         indexed_count = result.get(self.source_name, 0)
 
         duration = (datetime.now() - start_time).total_seconds()
+        self._commit_cursor()
 
         return {
             "success": True,
@@ -131,6 +196,15 @@ class GmailIndexer(BaseSourceIndexer):
             "duration_seconds": duration,
         }
 
+    @staticmethod
+    def _history_id(email: Dict[str, Any]) -> Optional[int]:
+        """historyId from a Gmail API/MCP email dict, if present."""
+        value = email.get("historyId") or email.get("history_id")
+        try:
+            return int(value) if value is not None else None
+        except (TypeError, ValueError):
+            return None
+
     def chunk_data(self, emails: List[Dict[str, Any]]) -> List[UnifiedChunk]:
         """
         Convert emails to UnifiedChunks.
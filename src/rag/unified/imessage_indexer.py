@@ -10,13 +10,15 @@ This follows the proven approach from the legacy iMessage RAG system.
 
 import logging
 from datetime import datetime
+from itertools import chain, islice
 from pathlib import Path
-from typing import List, Dict, Any, Optional
+from typing import List, Dict, Any, Iterable, Iterator, Optional
 
-from .base_indexer import BaseSourceIndexer
+from ...tracing import traced_iter
+from .base_indexer import BaseSourceIndexer, record_stages
 from .chunk import UnifiedChunk
 from .index_state import IndexState
-from ..chunker import ConversationChunker, ConversationChunk
+from ..chunker import ConversationChunker, ConversationChunk, OpenWindow
 
 logger = logging.getLogger(__name__)
 
@@ -37,6 +39,13 @@ class ImessageIndexer(BaseSourceIndexer):
 
     source_name = "imessage"
 
+    # Messages per resolve_handles() call during enrichment
+    ENRICH_BATCH_SIZE = 500
+
+    # Open windows larger than this are treated as closed rather than
+    # re-read and re-chunked on every incremental run
+    MAX_OPEN_WINDOW_MESSAGES = 1000
+
     def __init__(
         self,
         messages_interface=None,
@@ -75,38 +84,62 @@ class ImessageIndexer(BaseSourceIndexer):
             state_file = Path.home() / ".imessage_rag" / "index_state.json"
         self.state = IndexState(state_file)
 
-    def fetch_data(
+        # Trailing windows left open by the last iter_chunks() pass
+        self.open_windows: Dict[str, OpenWindow] = {}
+
+    def iter_data(
         self,
         days: Optional[int] = None,
         limit: Optional[int] = None,
         contact_name: Optional[str] = None,
         incremental: bool = True,
+        batch_size: int = 1000,
         **kwargs,
-    ) -> List[Dict[str, Any]]:
+    ) -> Iterator[Any]:
         """
-        Fetch iMessages from local database.
+        Stream iMessages from the local database, enriched with contact names.
+
+        Same fetch strategies as fetch_data(), but messages are paged out of
+        chat.db by ROWID (MessagesInterface.iter_messages) and yielded one
+        at a time, so memory doesn't grow with history size. Without a
+        limit, full mode covers the entire history.
 
         Args:
             days: Days of history to fetch (overrides incremental mode if set)
-            limit: Maximum messages to fetch
+            limit: Maximum messages to fetch (newest, except in days and
+                incremental modes which take the oldest new messages first)
             contact_name: Fetch messages only with this contact
             incremental: If True, only fetch messages since last index (default: True)
+            batch_size: Rows per chat.db page
 
-        Returns:
-            List of message dicts from MessagesInterface
+        Yields:
+            MessageRecords (dict-style access, see MessageRecord)
         """
+        contact = None
+
         # Determine fetch strategy
         if incremental and not days and not contact_name:
             # Incremental mode: fetch only new messages
+            after_rowid = self._resume_rowid()
             last_indexed = self.state.get_last_indexed("imessage")
 
-            if last_indexed:
+            if after_rowid is not None:
+                # Primary-key range scan: strictly new rows, no clock window
+                logger.info(f"Incremental mode: fetching messages after ROWID {after_rowid}")
+                messages = self.messages.iter_messages(
+                    after_rowid=after_rowid, limit=limit, batch_size=batch_size
+                )
+            elif last_indexed and not self.state.get_cursor("imessage"):
+                # State written before ROWID cursors existed
                 logger.info(f"Incremental mode: fetching messages since {last_indexed.isoformat()}")
-                messages = self.messages.get_messages_since(last_indexed, limit=limit)
+                messages = self.messages.iter_messages_since(
+                    last_indexed, limit=limit, batch_size=batch_size
+                )
             else:
                 logger.info("No previous index state, doing full index")
-                limit = limit or 10000
-                messages = self.messages.get_all_recent_conversations(limit=limit)
+                messages = self.messages.iter_all_recent_conversations(
+                    limit=limit, batch_size=batch_size
+                )
 
         elif days:
             # Days mode: fetch last N days
@@ -114,7 +147,7 @@ class ImessageIndexer(BaseSourceIndexer):
             from datetime import timedelta
             cutoff = datetime.now() - timedelta(days=days)
 
-            messages = self.messages.get_messages_since(cutoff, limit=limit)
+            messages = self.messages.iter_messages_since(cutoff, limit=limit, batch_size=batch_size)
 
         elif contact_name:
             # Contact-specific mode
@@ -123,35 +156,175 @@ class ImessageIndexer(BaseSourceIndexer):
             if not contact:
                 raise ValueError(f"Contact '{contact_name}' not found")
 
-            limit = limit or 10000
-            messages = self.messages.get_recent_messages(
-                contact.phone,
-                limit=limit
+            messages = self.messages.iter_recent_messages(
+                contact.phone, limit=limit, batch_size=batch_size
             )
 
-            # Enrich with contact name
-            for msg in messages:
-                msg["_contact_name"] = contact.name
-                msg["phone"] = contact.phone
-
         else:
             # Full mode: fetch all recent
             logger.info("Full mode: fetching all messages")
-            limit = limit or 10000
-            messages = self.messages.get_all_recent_conversations(limit=limit)
+            messages = self.messages.iter_all_recent_conversations(
+                limit=limit, batch_size=batch_size
+            )
+
+        # Lazy: paging chat.db (and decoding) happens as the stream is consumed
+        return traced_iter(self._enrich_messages(traced_iter(messages, "fetch"), contact), "enrich")
 
-        # Enrich messages with contact names where available
-        if not contact_name:  # Skip if already enriched above
+    def _resume_rowid(self) -> Optional[int]:
+        """
+        ROWID to resume incremental indexing after, or None for no usable cursor.
+
+        The cursor is discarded if it was recorded against a different
+        chat.db, or if chat.db's ROWIDs went backwards (database restored or
+        replaced), since new rows could then sit below the watermark.
+        """
+        cursor = self.state.get_cursor("imessage")
+        rowid = cursor.get("rowid")
+        if rowid is None:
+            return None
+        if cursor.get("db") != str(self.messages.messages_db_path):
+            logger.info("Index cursor belongs to a different chat.db, ignoring it")
+            return None
+        if self.messages.get_max_rowid() < rowid:
+            logger.info("chat.db ROWIDs went backwards, ignoring index cursor")
+            return None
+        return rowid
+
+    def _saved_open_windows(self) -> Dict[str, OpenWindow]:
+        """Open windows recorded with the cursor, if it belongs to this chat.db."""
+        cursor = self.state.get_cursor("imessage")
+        if cursor.get("db") != str(self.messages.messages_db_path):
+            return {}
+        try:
+            return {
+                key: OpenWindow.from_dict(data)
+                for key, data in cursor.get("open_windows", {}).items()
+            }
+        except (KeyError, TypeError, ValueError) as e:
+            logger.warning(f"Ignoring unreadable open-window state: {e}")
+            return {}
+
+    def _window_messages(self, windows: Dict[str, OpenWindow]) -> Iterator[Any]:
+        """Re-read (and enrich) the messages of saved open windows by ROWID."""
+        rowids = [rowid for window in windows.values() for rowid in window.rowids]
+        if not rowids:
+            return iter(())
+        logger.info(f"Re-chunking {len(windows)} open windows ({len(rowids)} messages)")
+        return self._enrich_messages(self.messages.iter_messages(rowids=rowids))
+
+    def _enrich_messages(self, messages: Iterable[Any], contact=None) -> Iterator[Any]:
+        """Attach _contact_name (and the contact's phone in contact mode)."""
+        if contact is not None:
             for msg in messages:
-                phone = msg.get("phone")
-                if phone and "_contact_name" not in msg:
-                    contact = self.contacts.get_contact_by_phone(phone)
-                    if contact:
-                        msg["_contact_name"] = contact.name
+                msg["_contact_name"] = contact.name
+                msg["phone"] = contact.phone
+                yield msg
+            return
+
+        # Resolve handles a batch at a time so the stream stays lazy
+        iterator = iter(messages)
+        while True:
+            batch = list(islice(iterator, self.ENRICH_BATCH_SIZE))
+            if not batch:
+                return
+            names = self.contacts.resolve_handles(
+                msg.get("phone") for msg in batch
+                if msg.get("phone") and "_contact_name" not in msg
+            )
+            for msg in batch:
+                match = names.get(msg.get("phone"))
+                if match and "_contact_name" not in msg:
+                    msg["_contact_name"] = match.name
+                yield msg
 
+    def fetch_data(
+        self,
+        days: Optional[int] = None,
+        limit: Optional[int] = None,
+        contact_name: Optional[str] = None,
+        incremental: bool = True,
+        **kwargs,
+    ) -> List[Dict[str, Any]]:
+        """
+        Fetch iMessages from local database.
+
+        Args:
+            days: Days of history to fetch (overrides incremental mode if set)
+            limit: Maximum messages to fetch
+            contact_name: Fetch messages only with this contact
+            incremental: If True, only fetch messages since last index (default: True)
+
+        Returns:
+            List of message dicts from MessagesInterface
+
+        Note:
+            Materializes the whole result; index() streams via iter_data()
+            instead. Full and contact modes default to the newest 10000
+            messages here to keep the list bounded.
+        """
+        if limit is None and not days and not (
+            incremental and not contact_name and (
+                self.state.get_cursor("imessage") or self.state.get_last_indexed("imessage")
+            )
+        ):
+            limit = 10000
+
+        messages = [
+            msg.to_dict()
+            for msg in self.iter_data(
+                days=days, limit=limit, contact_name=contact_name, incremental=incremental
+            )
+        ]
         logger.info(f"Fetched {len(messages)} iMessages")
         return messages
 
+    def iter_chunks(
+        self,
+        messages: Iterable[Any],
+        batch_size: int = 5000,
+    ) -> Iterator[List[UnifiedChunk]]:
+        """
+        Chunk a message stream incrementally.
+
+        Buffers up to `batch_size` messages, chunks every conversation
+        window that can no longer grow, and carries the still-open windows
+        over into the next batch so no window is split at a batch boundary.
+        Memory stays proportional to batch_size, not history size.
+
+        At the end of the stream, the windows that are still open are
+        recorded in `self.open_windows` (conversation key -> OpenWindow,
+        with the IDs of the chunks built from them) for the next
+        incremental run to extend.
+
+        Args:
+            messages: Chronological message stream (e.g. from iter_data())
+            batch_size: Messages buffered before chunking
+
+        Yields:
+            Lists of UnifiedChunks, one per processed batch (may be empty)
+        """
+        self.open_windows = {}
+        pending: List[Any] = []
+        for msg in messages:
+            pending.append(msg)
+            if len(pending) >= batch_size:
+                closed, pending = self.chunker.split_open_windows(pending, max_open=batch_size)
+                yield self.chunk_data(closed)
+
+        if pending:
+            closed, still_open = self.chunker.split_open_windows(pending)
+            open_chunks = self.chunk_data(still_open)
+
+            windows = self.chunker.open_windows(still_open)
+            for chunk in open_chunks:
+                if chunk.context_id in windows:
+                    windows[chunk.context_id].chunk_ids.append(chunk.chunk_id)
+            self.open_windows = {
+                key: window for key, window in windows.items()
+                if len(window.rowids) <= self.MAX_OPEN_WINDOW_MESSAGES
+            }
+            yield self.chunk_data(closed) + open_chunks
+
     def chunk_data(self, messages: List[Dict[str, Any]]) -> List[UnifiedChunk]:
         """
         Convert iMessages to UnifiedChunks using time-windowed conversation chunks.
@@ -181,47 +354,133 @@ class ImessageIndexer(BaseSourceIndexer):
         )
         return unified_chunks
 
+    @record_stages
     def index(
         self,
         days: Optional[int] = None,
         limit: Optional[int] = None,
         batch_size: int = 100,
         incremental: bool = True,
+        stream_batch_size: int = 5000,
         **kwargs,
     ) -> Dict[str, Any]:
         """
         Index iMessages with incremental state tracking.
 
-        Overrides base method to add state management for incremental indexing.
+        Overrides the base fetch -> chunk -> store pipeline to stream:
+        messages are paged out of chat.db, chunked `stream_batch_size` at a
+        time (open windows carried over) and stored batch by batch, so
+        full-history runs use bounded memory.
+
+        Each conversation's trailing window is saved with the ROWID cursor.
+        When new messages could extend it, an incremental run re-reads just
+        that window's messages, re-chunks them together with the new ones,
+        and replaces the window's stored chunk; the cost is proportional to
+        the new messages plus the open windows, not the history.
 
         Args:
             days: How many days of history to index
-            limit: Maximum items to index
+            limit: Maximum items to index (default: full history)
             batch_size: Batch size for embedding API
             incremental: If True, only index new messages (default: True)
+            stream_batch_size: Messages chunked per batch
             **kwargs: Source-specific options (e.g., contact_name)
 
         Returns:
-            Dict with indexing stats
+            Dict with indexing stats, including per-stage seconds in "stages"
         """
         start_time = datetime.now()
+        logger.info(f"Starting imessage indexing (days={days}, limit={limit})")
 
-        # Store incremental flag for fetch_data
-        kwargs["incremental"] = incremental
-
-        # Call parent's index method
-        result = super().index(days=days, limit=limit, batch_size=batch_size, **kwargs)
+        chunks_found = 0
+        chunks_indexed = 0
+        messages_seen = 0
+        max_rowid = 0
 
-        # Update state on successful indexing (incremental mode only)
-        if result.get("success") and incremental and not days:
-            # Get the latest message timestamp from this indexing run
-            # We'll update state to current time (conservative approach)
-            # Alternatively, we could track max message timestamp from fetch_data
-            self.state.update_last_indexed("imessage", datetime.now())
+        def counted(messages):
+            nonlocal messages_seen, max_rowid
+            for msg in messages:
+                messages_seen += 1
+                max_rowid = max(max_rowid, msg.get("rowid", 0))
+                yield msg
+
+        tracks_windows = not days and not kwargs.get("contact_name")
+        resume_rowid = self._resume_rowid() if incremental and tracks_windows else None
+        previous_windows = self._saved_open_windows() if tracks_windows else {}
+        superseded: List[str] = []
+        produced = set()
+
+        try:
+            new_messages = counted(
+                self.iter_data(days=days, limit=limit, incremental=incremental, **kwargs)
+            )
+            first = next(new_messages, None)
+            if first is None:
+                messages = iter(())
+            elif resume_rowid is not None:
+                # Re-read the windows the new messages may extend
+                reopened = {
+                    key: window for key, window in previous_windows.items()
+                    if self.chunker.can_extend(window, first.get("date"))
+                }
+                superseded = [cid for window in reopened.values() for cid in window.chunk_ids]
+                messages = chain(traced_iter(self._window_messages(reopened), "fetch"), [first], new_messages)
+            else:
+                if not incremental and limit is None:
+                    superseded = [cid for window in previous_windows.values() for cid in window.chunk_ids]
+                messages = chain([first], new_messages)
+
+            for chunks in traced_iter(self.iter_chunks(messages, batch_size=stream_batch_size), "chunk"):
+                if not chunks:
+                    continue
+                chunks_found += len(chunks)
+                produced.update(chunk.chunk_id for chunk in chunks)
+                result = self.store.add_chunks(chunks, batch_size=batch_size)
+                chunks_indexed += result.get(self.source_name, 0)
+
+            # Chunks of windows that grew are replaced, not duplicated
+            stale = [cid for cid in superseded if cid not in produced]
+            if stale:
+                self.store.delete_chunks(self.source_name, stale)
+        except Exception as e:
+            logger.error(f"Failed to index {self.source_name} data: {e}")
+            return {
+                "success": False,
+                "error": str(e),
+                "source": self.source_name,
+                "chunks_found": chunks_found,
+                "chunks_indexed": chunks_indexed,
+            }
+
+        duration = (datetime.now() - start_time).total_seconds()
+        self._indexed_count += chunks_indexed
+        logger.info(
+            f"Indexed {chunks_indexed} imessage chunks from {messages_seen} messages in {duration:.1f}s"
+        )
 
+        # Advance the ROWID cursor on successful indexing (incremental and
+        # full mode; days/contact runs cover a slice, not everything so far)
+        if tracks_windows:
+            previous = (resume_rowid or 0) if incremental else 0
+            if messages_seen:
+                windows = self.open_windows
+            else:
+                windows = previous_windows if resume_rowid is not None else {}
+            self.state.update_cursor("imessage", {
+                "rowid": max(max_rowid, previous),
+                "db": str(self.messages.messages_db_path),
+                "open_windows": {key: window.to_dict() for key, window in windows.items()},
+            })
             logger.info("Updated incremental index state")
 
-        return result
+        return {
+            "success": True,
+            "source": self.source_name,
+            "messages_processed": messages_seen,
+            "chunks_found": chunks_found,
+            "chunks_indexed": chunks_indexed,
+            "duration_seconds": duration,
+        }
 
     def _conversation_chunk_to_unified(
         self,
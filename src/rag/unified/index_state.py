@@ -1,8 +1,12 @@
 """
 Persistent state tracking for incremental indexing.
 
-Stores last_indexed_at timestamps per source to enable delta indexing.
-This prevents re-processing unchanged messages and dramatically speeds up
+Stores last_indexed_at timestamps per source to enable delta indexing,
+plus a per-source high-water-mark cursor (chat.db ROWID for iMessage,
+historyId for Gmail) so incremental runs fetch strictly new items instead
+of re-querying a clock window. File-backed sources (Notes, SuperWhisper)
+track per-file state in a FileManifest kept next to the state file. This
+prevents re-processing unchanged messages and dramatically speeds up
 re-indexing operations (35s → <1s for no-op runs).
 
 CS Concept: **Watermarking** - tracking progress through infinite streams.
@@ -12,11 +16,16 @@ Similar to Kafka consumer offsets or database replication cursors.
 from pathlib import Path
 from datetime import datetime
 import json
-from typing import Optional
+import os
+import tempfile
+from typing import Any, Dict, Optional
 import logging
 
 logger = logging.getLogger(__name__)
 
+# Reserved top-level key holding per-source cursors (not a source name)
+CURSORS_KEY = "_cursors"
+
 
 class IndexState:
     """
@@ -41,6 +50,10 @@ class IndexState:
 
         # Second run - state exists
         last_indexed = state.get_last_indexed("imessage")  # Returns datetime
+
+        # Cursor: resume strictly after the last indexed ROWID
+        state.update_cursor("imessage", {"rowid": 482113})
+        state.get_cursor("imessage")  # {"rowid": 482113}
     """
 
     def __init__(self, state_file: Optional[Path] = None):
@@ -68,14 +81,43 @@ class IndexState:
             self._state = {}
 
     def _save(self):
-        """Save state to JSON file."""
+        """
+        Save state to JSON file atomically.
+
+        Writes a temp file in the same directory and os.replace()s it over
+        the state file, so a crash mid-write never leaves truncated JSON.
+        """
         try:
-            with open(self.state_file, 'w') as f:
-                json.dump(self._state, f, indent=2)
+            fd, tmp_path = tempfile.mkstemp(
+                dir=self.state_file.parent, prefix=self.state_file.name, suffix=".tmp"
+            )
+            try:
+                with os.fdopen(fd, 'w') as f:
+                    json.dump(self._state, f, indent=2)
+                    f.flush()
+                    os.fsync(f.fileno())
+                os.replace(tmp_path, self.state_file)
+            except BaseException:
+                os.unlink(tmp_path)
+                raise
             logger.debug(f"Saved index state to {self.state_file}")
-        except IOError as e:
+        except (IOError, OSError) as e:
             logger.error(f"Failed to save index state: {e}")
 
+    def _reload(self):
+        """
+        Pick up changes other IndexState instances saved to the same file.
+
+        Indexers for different sources share one state file; reloading
+        before each update keeps one source's save from discarding another's.
+        """
+        if self.state_file.exists():
+            try:
+                with open(self.state_file) as f:
+                    self._state = json.load(f)
+            except (json.JSONDecodeError, IOError) as e:
+                logger.warning(f"Failed to reload index state: {e}")
+
     def get_last_indexed(self, source: str) -> Optional[datetime]:
         """
         Get last indexed timestamp for source.
@@ -105,6 +147,7 @@ class IndexState:
 
         Note: Automatically saves to disk after updating.
         """
+        self._reload()
         self._state[source] = timestamp.isoformat()
         self._save()
         logger.info(f"Updated index state for {source}: {timestamp.isoformat()}")
@@ -123,10 +166,12 @@ class IndexState:
             # Reset everything
             state.reset()
         """
+        self._reload()
         if source:
             if source in self._state:
                 del self._state[source]
                 logger.info(f"Reset index state for {source}")
+            self._state.get(CURSORS_KEY, {}).pop(source, None)
         else:
             self._state = {}
             logger.info("Reset all index state")
@@ -139,5 +184,39 @@ class IndexState:
 
         Returns:
             Dict mapping source names to ISO timestamp strings
+            (cursors are available via get_cursor)
         """
-        return self._state.copy()
+        return {k: v for k, v in self._state.items() if k != CURSORS_KEY}
+
+    def get_cursor(self, source: str) -> Dict[str, Any]:
+        """
+        Get the high-water-mark cursor for source.
+
+        Args:
+            source: Source name (e.g., "imessage", "gmail", "notes")
+
+        Returns:
+            Source-specific cursor dict (e.g. {"rowid": 482113}),
+            or {} if the source has no cursor yet
+        """
+        return dict(self._state.get(CURSORS_KEY, {}).get(source, {}))
+
+    def update_cursor(
+        self,
+        source: str,
+        cursor: Dict[str, Any],
+        timestamp: Optional[datetime] = None,
+    ):
+        """
+        Replace the cursor for source, in the same atomic save as its timestamp.
+
+        Args:
+            source: Source name (e.g., "imessage", "gmail", "notes")
+            cursor: JSON-serializable high-water mark
+            timestamp: last_indexed time to record (default: now)
+        """
+        self._reload()
+        self._state.setdefault(CURSORS_KEY, {})[source] = cursor
+        self._state[source] = (timestamp or datetime.now()).isoformat()
+        self._save()
+        logger.info(f"Updated index cursor for {source}: {cursor}")
@@ -0,0 +1,244 @@
+"""
+FTS5 keyword index over UnifiedChunk text, kept beside the vector store.
+
+Embeddings blur exact tokens: names, URLs, flight numbers and short codes
+("UA 837", "PR-1234") often rank below loosely related chunks. This index
+holds the same chunks in a sidecar SQLite database (see chat_db.open_sidecar)
+so the retriever can rank them by BM25 and fuse both lists.
+
+CS Concept: **BM25** (Okapi Best Match 25) scores a document by how often
+it contains each query term, discounted by how common the term is across
+the corpus and normalised for document length - so rare, exact tokens like
+a flight number dominate the score, which is exactly what vectors miss.
+
+Usage:
+    index = ChunkKeywordIndex(Path("data/chroma/keyword_index.db"))
+    index.add_chunks(chunks)
+    hits = index.search("UA 837", sources=["gmail"], limit=20)
+"""
+
+import json
+import logging
+import re
+import threading
+from datetime import datetime
+from pathlib import Path
+from typing import Any, Dict, Iterable, List, Optional, Tuple
+
+from ...chat_db import open_sidecar
+from .chunk import UNDATED_EPOCH
+
+logger = logging.getLogger(__name__)
+
+_SCHEMA = """
+    CREATE TABLE IF NOT EXISTS chunk_meta (
+        rowid INTEGER PRIMARY KEY,
+        chunk_id TEXT NOT NULL UNIQUE,
+        source TEXT NOT NULL,
+        timestamp_epoch REAL,
+        participants TEXT,              -- comma-joined, as in Chroma metadata
+        tags TEXT,
+        metadata TEXT NOT NULL          -- JSON of UnifiedChunk.to_dict()
+    );
+    CREATE INDEX IF NOT EXISTS idx_chunk_meta_source ON chunk_meta(source);
+    CREATE VIRTUAL TABLE IF NOT EXISTS chunk_fts USING fts5(
+        title,
+        text,
+        participants,
+        tags,
+        tokenize = 'unicode61 remove_diacritics 2'
+    );
+"""
+
+# Same tokenisation as unicode61: letters/digits, underscore is a separator
+_TOKEN_RE = re.compile(r"[^\W_]+", re.UNICODE)
+
+# bm25() column weights: title, text, participants, tags
+_BM25_WEIGHTS = (2.0, 1.0, 1.5, 1.5)
+
+
+def build_keyword_query(query: str) -> Optional[str]:
+    """
+    Convert free text into a safe FTS5 MATCH expression for BM25 ranking.
+
+    Each whitespace-separated word becomes a quoted phrase of its tokens
+    ("example.com" -> "example com"), and words are OR-ed so chunks that
+    match more of them rank higher rather than being required to match all.
+
+    Returns:
+        MATCH expression, or None if the query has no searchable tokens
+    """
+    phrases = []
+    for word in (query or "").split():
+        tokens = _TOKEN_RE.findall(word)
+        if tokens:
+            phrases.append('"' + " ".join(tokens) + '"')
+    if not phrases:
+        return None
+    return " OR ".join(dict.fromkeys(phrases))
+
+
+class ChunkKeywordIndex:
+    """
+    BM25-searchable copy of indexed chunks.
+
+    Chunk IDs are content hashes, so inserts are idempotent (INSERT OR
+    IGNORE) and re-indexing never duplicates rows.
+
+    Args:
+        path: Index database path (the vector store puts it next to Chroma)
+    """
+
+    def __init__(self, path: Path):
+        self.path = Path(path)
+        self.conn = open_sidecar(self.path)
+        self.conn.executescript(_SCHEMA)
+        self._lock = threading.Lock()
+
+    def add_chunks(self, chunks: Iterable[Any]) -> int:
+        """Index UnifiedChunks; already-present chunk IDs are skipped."""
+        return self.add_metadatas(chunk.to_dict() for chunk in chunks)
+
+    def add_metadatas(self, metadatas: Iterable[Dict[str, Any]]) -> int:
+        """
+        Index chunks from their stored metadata dicts (UnifiedChunk.to_dict()).
+
+        Used directly when backfilling from Chroma.
+
+        Returns:
+            Number of chunks newly added
+        """
+        added = 0
+        with self._lock, self.conn:
+            for meta in metadatas:
+                cursor = self.conn.execute(
+                    "INSERT OR IGNORE INTO chunk_meta "
+                    "(chunk_id, source, timestamp_epoch, participants, tags, metadata) "
+                    "VALUES (?, ?, ?, ?, ?, ?)",
+                    (
+                        meta["chunk_id"],
+                        meta["source"],
+                        _epoch(meta),
+                        meta.get("participants", ""),
+                        meta.get("tags", ""),
+                        json.dumps(meta),
+                    ),
+                )
+                if cursor.rowcount:
+                    self.conn.execute(
+                        "INSERT INTO chunk_fts (rowid, title, text, participants, tags) "
+                        "VALUES (?, ?, ?, ?, ?)",
+                        (
+                            cursor.lastrowid,
+                            meta.get("title", ""),
+                            meta.get("text", ""),
+                            meta.get("participants", "").replace(",", " "),
+                            meta.get("tags", "").replace(",", " "),
+                        ),
+                    )
+                    added += 1
+        return added
+
+    def count(self, source: str) -> int:
+        """Chunks indexed for a source."""
+        with self._lock:
+            return self.conn.execute(
+                "SELECT COUNT(*) FROM chunk_meta WHERE source = ?", (source,)
+            ).fetchone()[0]
+
+    def delete(self, chunk_ids: Iterable[str]) -> int:
+        """Drop specific chunks (superseded by a re-chunked window)."""
+        deleted = 0
+        with self._lock, self.conn:
+            for chunk_id in chunk_ids:
+                self.conn.execute(
+                    "DELETE FROM chunk_fts WHERE rowid IN (SELECT rowid FROM chunk_meta WHERE chunk_id = ?)",
+                    (chunk_id,),
+                )
+                deleted += self.conn.execute(
+                    "DELETE FROM chunk_meta WHERE chunk_id = ?", (chunk_id,)
+                ).rowcount
+        return deleted
+
+    def clear(self, source: Optional[str] = None):
+        """Drop indexed chunks for one source (or all)."""
+        with self._lock, self.conn:
+            if source is None:
+                self.conn.execute("DELETE FROM chunk_fts")
+                self.conn.execute("DELETE FROM chunk_meta")
+                return
+            self.conn.execute(
+                "DELETE FROM chunk_fts WHERE rowid IN (SELECT rowid FROM chunk_meta WHERE source = ?)",
+                (source,),
+            )
+            self.conn.execute("DELETE FROM chunk_meta WHERE source = ?", (source,))
+
+    def search(
+        self,
+        query: str,
+        sources: Optional[List[str]] = None,
+        limit: int = 10,
+        min_date: Optional[datetime] = None,
+        max_date: Optional[datetime] = None,
+        participants: Optional[List[str]] = None,
+        tags: Optional[List[str]] = None,
+    ) -> List[Tuple[Dict[str, Any], float]]:
+        """
+        BM25-ranked keyword search.
+
+        Filters mirror UnifiedVectorStore.search (participants/tags match
+        any of the given values).
+
+        Returns:
+            List of (metadata dict, bm25 relevance) best first; relevance is
+            positive, larger is better
+        """
+        match = build_keyword_query(query)
+        if match is None:
+            return []
+
+        where = ["chunk_fts MATCH ?"]
+        params: List[Any] = [match]
+        if sources:
+            where.append(f"m.source IN ({','.join('?' * len(sources))})")
+            params.extend(sources)
+        # Undated chunks (NULL) pass date filters, as in vector search
+        if min_date:
+            where.append("(m.timestamp_epoch >= ? OR m.timestamp_epoch IS NULL)")
+            params.append(min_date.timestamp())
+        if max_date:
+            where.append("(m.timestamp_epoch <= ? OR m.timestamp_epoch IS NULL)")
+            params.append(max_date.timestamp())
+        for column, values in (("participants", participants), ("tags", tags)):
+            if values:
+                where.append("(" + " OR ".join(
+                    f"(',' || m.{column} || ',') LIKE ?" for _ in values
+                ) + ")")
+                params.extend(f"%,{value},%" for value in values)
+
+        weights = ", ".join(str(w) for w in _BM25_WEIGHTS)
+        sql = f"""
+            SELECT m.metadata, bm25(chunk_fts, {weights}) AS rank
+            FROM chunk_fts
+            JOIN chunk_meta m ON m.rowid = chunk_fts.rowid
+            WHERE {' AND '.join(where)}
+            ORDER BY rank
+            LIMIT ?
+        """
+        params.append(limit)
+
+        with self._lock:
+            rows = self.conn.execute(sql, params).fetchall()
+        # FTS5 bm25() is negative (more negative = better match)
+        return [(json.loads(metadata), -rank) for metadata, rank in rows]
+
+
+def _epoch(meta: Dict[str, Any]) -> Optional[float]:
+    """Epoch timestamp from metadata, parsing the ISO field for legacy chunks."""
+    if "timestamp_epoch" in meta:
+        epoch = meta["timestamp_epoch"]
+        return None if epoch == UNDATED_EPOCH else epoch
+    try:
+        return datetime.fromisoformat(meta["timestamp"]).timestamp()
+    except (KeyError, ValueError, TypeError):
+        return None
@@ -12,18 +12,25 @@ Indexes markdown files from the data/notes/ directory structure:
 Chunks documents by headers (H1/H2) or fixed-size windows.
 """
 
+import hashlib
 import logging
 import os
 import re
+from concurrent.futures import ThreadPoolExecutor
 from datetime import datetime
 from pathlib import Path
 from typing import List, Dict, Any, Optional, Tuple
 
 from .base_indexer import BaseSourceIndexer
 from .chunk import UnifiedChunk
+from .file_manifest import FileManifest, content_digest, scan_tree
+from .index_state import IndexState
 
 logger = logging.getLogger(__name__)
 
+# Threads reading and chunking changed files
+READ_WORKERS = 8
+
 
 class NotesIndexer(BaseSourceIndexer):
     """
@@ -39,6 +46,8 @@ class NotesIndexer(BaseSourceIndexer):
         notes_path: Path to notes directory
         min_chunk_words: Minimum words for a valid chunk
         max_chunk_words: Maximum words before splitting
+        state_file: Incremental index state (default: ~/.imessage_rag/index_state.json);
+            the file manifest is kept beside it as notes_manifest.json
         store: Optional UnifiedVectorStore to use
         use_local_embeddings: Use local embeddings instead of OpenAI
 
@@ -55,9 +64,14 @@ class NotesIndexer(BaseSourceIndexer):
         notes_path: Optional[Path] = None,
         min_chunk_words: int = 20,
         max_chunk_words: int = 500,
+        state_file: Optional[Path] = None,
         **kwargs,
     ):
         super().__init__(**kwargs)
+        self.state = IndexState(state_file)
+        self.manifest = FileManifest(
+            self.state.state_file.with_name(f"{self.source_name}_manifest.json")
+        )
 
         # Default notes path relative to project
         if notes_path is None:
@@ -75,73 +89,119 @@ class NotesIndexer(BaseSourceIndexer):
         self,
         days: Optional[int] = None,
         limit: Optional[int] = None,
+        incremental: bool = True,
         **kwargs,
     ) -> List[Dict[str, Any]]:
         """
-        Load markdown files from the notes directory.
+        Load (and chunk) changed markdown files from the notes directory.
+
+        The tree is walked once; in incremental mode only files whose
+        mtime/size differ from the file manifest are read, in parallel, and
+        chunked as they load. Edited and deleted files have their old chunks
+        staged for deletion. Days runs cover a slice and leave the manifest
+        alone.
 
         Args:
             days: Only fetch files modified in last N days
             limit: Maximum number of files to fetch
+            incremental: Only fetch files changed since the last run
+                (ignored when days is set)
 
         Returns:
-            List of document dicts with path, content, and metadata
+            List of document dicts with path, content, metadata and chunks
         """
+        self._stale_chunk_ids = []
+        self.manifest.discard()
         if not self.notes_path.exists():
             return []
 
-        documents = []
-        cutoff_date = None
-        if days:
-            cutoff_date = self.days_ago(days)
-
-        # Find all markdown files
-        md_files = list(self.notes_path.rglob("*.md"))
-
-        # Sort by modification time (most recent first)
-        md_files.sort(key=lambda p: p.stat().st_mtime, reverse=True)
+        cutoff_date = self.days_ago(days) if days else None
+        tracked = not days
 
-        for file_path in md_files:
-            try:
-                # Get file stats
-                stat = file_path.stat()
-                mtime = datetime.fromtimestamp(stat.st_mtime)
-
-                # Apply date filter
-                if cutoff_date and mtime < cutoff_date:
-                    continue
+        seen = set()
+        candidates = []
+        for relative_path, stat in scan_tree(self.notes_path, lambda e: e.name.endswith(".md")):
+            seen.add(relative_path)
+            if cutoff_date and datetime.fromtimestamp(stat.st_mtime) < cutoff_date:
+                continue
+            if incremental and tracked and self.manifest.is_unchanged(relative_path, stat):
+                continue
+            candidates.append((relative_path, stat))
 
-                # Read content
-                with open(file_path, "r", encoding="utf-8") as f:
-                    content = f.read()
+        # Most recently modified first, so a limit keeps the newest edits
+        candidates.sort(key=lambda item: item[1].st_mtime_ns, reverse=True)
+        if limit:
+            candidates = candidates[:limit]
 
-                # Skip empty files
-                if len(content.strip()) < 20:
-                    continue
+        use_hashes = incremental and tracked
+        documents = []
+        with ThreadPoolExecutor(max_workers=READ_WORKERS) as executor:
+            loaded = executor.map(lambda item: self._load_document(*item, use_hashes), candidates)
+            for (relative_path, stat), (digest, doc, chunk_ids) in zip(candidates, loaded):
+                if digest is None:
+                    continue  # Unreadable; retried next run
+                if tracked:
+                    self._stale_chunk_ids += self.manifest.stage(relative_path, stat, digest, chunk_ids)
+                if doc is not None:
+                    documents.append(doc)
+
+        if tracked:
+            self._stale_chunk_ids += self.manifest.stage_removed(seen)
+            self._pending_cursor = {"files": len(seen)}
+
+        logger.info(
+            f"Found {len(documents)} changed markdown documents "
+            f"({len(seen)} files, {len(candidates)} read)"
+        )
+        return documents
 
-                # Get folder name as category
-                relative_path = file_path.relative_to(self.notes_path)
-                folder = relative_path.parts[0] if len(relative_path.parts) > 1 else "notes"
-
-                documents.append({
-                    "path": str(file_path),
-                    "relative_path": str(relative_path),
-                    "filename": file_path.stem,
-                    "folder": folder,
-                    "content": content,
-                    "mtime": mtime,
-                    "size": stat.st_size,
-                })
-
-                if limit and len(documents) >= limit:
-                    break
-
-            except (IOError, OSError) as e:
-                logger.warning(f"Failed to read {file_path}: {e}")
-                continue
+    def _load_document(
+        self,
+        relative_path: str,
+        stat: os.stat_result,
+        incremental: bool,
+    ) -> Tuple[Optional[str], Optional[Dict[str, Any]], List[str]]:
+        """
+        Read, hash and chunk one file (runs in a worker thread).
 
-        logger.info(f"Found {len(documents)} markdown documents")
-        return documents
+        Returns:
+            (content digest or None if unreadable, document or None if
+            empty/unchanged, chunk IDs the file now maps to)
+        """
+        file_path = self.notes_path / relative_path
+        try:
+            data = file_path.read_bytes()
+        except (IOError, OSError) as e:
+            logger.warning(f"Failed to read {file_path}: {e}")
+            return None, None, []
+
+        digest = content_digest(data)
+        previous = self.manifest.get(relative_path)
+        if incremental and previous and previous.get("sha1") == digest:
+            # Touched but not edited: its chunks are still current
+            return digest, None, previous.get("chunk_ids", [])
+
+        content = data.decode("utf-8", errors="replace")
+
+        # Skip empty files
+        if len(content.strip()) < 20:
+            return digest, None, []
+
+        # Get folder name as category
+        parts = Path(relative_path).parts
+        folder = parts[0] if len(parts) > 1 else "notes"
+
+        doc = {
+            "path": str(file_path),
+            "relative_path": relative_path,
+            "filename": file_path.stem,
+            "folder": folder,
+            "content": content,
+            "mtime": datetime.fromtimestamp(stat.st_mtime),
+            "size": stat.st_size,
+        }
+        doc["chunks"] = self._document_to_chunks(doc)
+        return digest, doc, [chunk.chunk_id for chunk in doc["chunks"]]
 
     def chunk_data(self, documents: List[Dict[str, Any]]) -> List[UnifiedChunk]:
         """
@@ -153,7 +213,10 @@ class NotesIndexer(BaseSourceIndexer):
         chunks = []
 
         for doc in documents:
-            doc_chunks = self._document_to_chunks(doc)
+            # fetch_data() already chunked in its worker threads
+            doc_chunks = doc.get("chunks")
+            if doc_chunks is None:
+                doc_chunks = self._document_to_chunks(doc)
             chunks.extend(doc_chunks)
 
         logger.info(f"Created {len(chunks)} chunks from {len(documents)} documents")
@@ -279,7 +342,15 @@ class NotesIndexer(BaseSourceIndexer):
         if not doc_date:
             doc_date = doc["mtime"]
 
+        # Hash the whole section, not the default text[:100]: an edit further
+        # down must change the ID, or add_chunks skips it as already stored
+        # while the manifest records the file as indexed
+        chunk_id = hashlib.sha256(
+            f"notes|{doc['relative_path']}|{doc_date.isoformat()}|{text}".encode()
+        ).hexdigest()[:12]
+
         return UnifiedChunk(
+            chunk_id=chunk_id,
             source="notes",
             text=text,
             title=title,
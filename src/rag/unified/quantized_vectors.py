@@ -0,0 +1,214 @@
+"""
+Reduced-dimension vector layouts with quantized full-precision re-ranking.
+
+At 1536 float32 dimensions per chunk (text-embedding-3-small), the HNSW
+index Chroma keeps in memory dominates both RAM and cold-load time. A
+collection can instead be created with a reduced layout:
+
+    1. Chroma stores only the first N dimensions of each embedding,
+       renormalized (**Matryoshka truncation**: text-embedding-3 models are
+       trained so that a prefix is itself a usable embedding; this is what
+       the API's `dimensions` parameter returns)
+    2. The full vector is kept beside Chroma in a SQLite sidecar, quantized
+       to float16 (2 bytes/dim) or int8 (1 byte/dim + a per-vector scale)
+    3. A search asks Chroma for RERANK_FACTOR x more candidates with the
+       truncated query, then re-scores just those with the full vectors
+
+CS Concept: **Two-stage retrieval** - a cheap, approximate first stage
+narrows millions of candidates to a few dozen, and an exact second stage
+orders them. Recall is bounded by whether the true top-k survive stage
+one, which over-fetching makes very likely; the benchmark in
+benchmarks/bench_search.py measures it.
+
+Chroma itself only stores float32, so quantization applies to the
+re-rank copy; the memory saving in Chroma comes from the truncation.
+"""
+
+import logging
+import math
+import sqlite3
+import struct
+import threading
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Sequence
+
+from ...chat_db import open_sidecar
+from ..embedding_cache import pack_vector, unpack_vector
+
+logger = logging.getLogger(__name__)
+
+# Precisions for the re-rank copy of each vector
+STORAGE_TYPES = ("float32", "float16", "int8")
+
+# Candidates fetched from Chroma per requested result when re-ranking
+RERANK_FACTOR = 4
+
+_SCHEMA = """
+    CREATE TABLE IF NOT EXISTS rerank_vector (
+        source TEXT NOT NULL,
+        chunk_id TEXT NOT NULL,
+        storage TEXT NOT NULL,
+        vector BLOB NOT NULL,
+        PRIMARY KEY (source, chunk_id)
+    ) WITHOUT ROWID;
+"""
+
+
+def truncate(vector: Sequence[float], dimensions: int) -> List[float]:
+    """First `dimensions` components, rescaled to unit length."""
+    prefix = list(vector[:dimensions])
+    norm = math.sqrt(sum(x * x for x in prefix))
+    return [x / norm for x in prefix] if norm else prefix
+
+
+def quantize(vector: Sequence[float], storage: str) -> bytes:
+    """
+    Encode a vector for the re-rank sidecar.
+
+    int8 is symmetric per-vector quantization: a float32 scale
+    (max |x| / 127) followed by one signed byte per dimension.
+    """
+    if storage == "int8":
+        peak = max((abs(x) for x in vector), default=0.0)
+        scale = peak / 127 if peak else 1.0
+        codes = [max(-127, min(127, round(x / scale))) for x in vector]
+        return struct.pack(f"<f{len(codes)}b", scale, *codes)
+    return pack_vector(vector, storage)
+
+
+def dequantize(blob: bytes, storage: str) -> List[float]:
+    """Inverse of quantize (approximately, for the lossy storages)."""
+    if storage == "int8":
+        (scale,) = struct.unpack_from("<f", blob)
+        return [code * scale for code in struct.unpack_from(f"<{len(blob) - 4}b", blob, 4)]
+    return unpack_vector(blob, storage)
+
+
+def cosine(a: Sequence[float], b: Sequence[float]) -> float:
+    dot = sum(x * y for x, y in zip(a, b))
+    norm = math.sqrt(sum(x * x for x in a)) * math.sqrt(sum(y * y for y in b))
+    return dot / norm if norm else 0.0
+
+
+@dataclass(frozen=True)
+class VectorConfig:
+    """
+    Vector layout of one source collection.
+
+    Attributes:
+        dimensions: Dimensions stored in Chroma (None = full embedding,
+            no re-rank sidecar)
+        rerank_storage: Precision of the full vectors used to re-rank
+            ("float32", "float16" or "int8")
+
+    The layout is fixed when a collection is created and recorded in its
+    Chroma metadata; clear() the source to re-index with another.
+    """
+    dimensions: Optional[int] = None
+    rerank_storage: str = "float16"
+
+    def __post_init__(self):
+        if self.dimensions is not None and self.dimensions < 1:
+            raise ValueError(f"dimensions must be positive, got {self.dimensions}")
+        if self.rerank_storage not in STORAGE_TYPES:
+            raise ValueError(
+                f"Unsupported rerank_storage: {self.rerank_storage} (use one of {', '.join(STORAGE_TYPES)})"
+            )
+
+    @property
+    def reduced(self) -> bool:
+        return self.dimensions is not None
+
+    def to_metadata(self) -> Dict[str, Any]:
+        """Chroma collection metadata entries for this layout."""
+        if not self.reduced:
+            return {}
+        return {"vector:dimensions": self.dimensions, "vector:rerank_storage": self.rerank_storage}
+
+    @classmethod
+    def from_metadata(cls, metadata: Optional[Dict[str, Any]]) -> "VectorConfig":
+        metadata = metadata or {}
+        if "vector:dimensions" not in metadata:
+            return cls()
+        return cls(
+            dimensions=int(metadata["vector:dimensions"]),
+            rerank_storage=metadata.get("vector:rerank_storage", "float16"),
+        )
+
+
+class RerankVectorStore:
+    """
+    (source, chunk_id) -> quantized full vector, in SQLite beside Chroma.
+
+    Only the re-rank candidates of a query are read (primary-key lookups),
+    so the full vectors cost disk, not memory. The vectors are embeddings of
+    chunks from every RAG source (Notes, SuperWhisper, Gmail, ...), so a lost
+    write is recovered by re-indexing those sources.
+
+    Args:
+        path: Database file (UnifiedVectorStore uses
+            <persist_directory>/rerank_vectors.db)
+    """
+
+    def __init__(self, path: Path):
+        self.path = Path(path)
+        self.conn = open_sidecar(self.path)
+        self.conn.executescript(_SCHEMA)
+        self._lock = threading.Lock()
+
+    def put_many(self, source: str, storage: str, vectors: Dict[str, Sequence[float]]):
+        rows = [
+            (source, chunk_id, storage, quantize(vector, storage))
+            for chunk_id, vector in vectors.items()
+        ]
+        if not rows:
+            return
+        with self._lock, self.conn:
+            self.conn.executemany(
+                "INSERT OR REPLACE INTO rerank_vector (source, chunk_id, storage, vector) VALUES (?, ?, ?, ?)",
+                rows,
+            )
+
+    def get_many(self, source: str, chunk_ids: Sequence[str]) -> Dict[str, List[float]]:
+        """Dequantized vectors for the chunk IDs that have one."""
+        ids = list(dict.fromkeys(chunk_ids))
+        found = {}
+        with self._lock:
+            for i in range(0, len(ids), 500):
+                batch = ids[i:i + 500]
+                found.update(
+                    (chunk_id, dequantize(vector, storage))
+                    for chunk_id, storage, vector in self.conn.execute(
+                        f"SELECT chunk_id, storage, vector FROM rerank_vector "
+                        f"WHERE source = ? AND chunk_id IN ({','.join('?' * len(batch))})",
+                        [source, *batch],
+                    )
+                )
+        return found
+
+    def delete(self, source: str, chunk_ids: Sequence[str]):
+        with self._lock, self.conn:
+            self.conn.executemany(
+                "DELETE FROM rerank_vector WHERE source = ? AND chunk_id = ?",
+                [(source, chunk_id) for chunk_id in chunk_ids],
+            )
+
+    def clear(self, source: str):
+        with self._lock, self.conn:
+            self.conn.execute("DELETE FROM rerank_vector WHERE source = ?", (source,))
+
+    def stats(self, source: str) -> Dict[str, int]:
+        """Vector count and bytes stored for a source."""
+        with self._lock:
+            count, size = self.conn.execute(
+                "SELECT COUNT(*), COALESCE(SUM(LENGTH(vector)), 0) FROM rerank_vector WHERE source = ?",
+                (source,),
+            ).fetchone()
+        return {"vectors": count, "bytes": size}
+
+    def close(self):
+        try:
+            self.conn.close()
+        except sqlite3.Error:
+            pass
@@ -7,23 +7,84 @@ sources with result formatting for Claude consumption.
 CS Concept: This is the **Facade Pattern** again - hiding the
 complexity of multiple collections and search logic behind a
 simple interface.
+
+Hybrid search fuses vector and BM25 keyword rankings with **Reciprocal
+Rank Fusion**: each result scores sum(1 / (k + rank)) over the lists it
+appears in. Only ranks are used, so cosine similarities and BM25 scores
+never need to be calibrated against each other.
 """
 
 import logging
 from datetime import datetime, timedelta
 from pathlib import Path
-from typing import List, Dict, Any, Optional
+from typing import TYPE_CHECKING, List, Dict, Any, Optional, Callable, Sequence, Union
 
 from .chunk import SOURCE_TYPES
+from .quantized_vectors import VectorConfig
 from .store import UnifiedVectorStore
-from .superwhisper_indexer import SuperWhisperIndexer
-from .notes_indexer import NotesIndexer
-from .gmail_indexer import GmailIndexer
-from .slack_indexer import SlackIndexer
-from .calendar_indexer import CalendarIndexer
+
+if TYPE_CHECKING:
+    from .superwhisper_indexer import SuperWhisperIndexer
+    from .notes_indexer import NotesIndexer
+    from .gmail_indexer import GmailIndexer
+    from .slack_indexer import SlackIndexer
+    from .calendar_indexer import CalendarIndexer
 
 logger = logging.getLogger(__name__)
 
+SEARCH_MODES = ("hybrid", "semantic", "keyword")
+
+# RRF damping constant (k=60 from Cormack et al., 2009)
+RRF_K = 60
+
+# Candidates taken from each ranking before fusion, per requested result
+HYBRID_CANDIDATE_FACTOR = 3
+HYBRID_MIN_CANDIDATES = 30
+
+
+def reciprocal_rank_fusion(
+    rankings: Dict[str, List[Dict]],
+    limit: int,
+    k: int = RRF_K,
+) -> List[Dict]:
+    """
+    Fuse ranked result lists by chunk_id.
+
+    Args:
+        rankings: Name ("semantic", "keyword") -> results, best first
+        limit: Number of fused results to return
+        k: Damping constant; larger values flatten the rank curve
+
+    Returns:
+        Results best first. `score` is the fused score normalised so a
+        chunk ranked first in every list scores 1.0; each result also
+        carries `match` (which lists found it) and `<name>_rank`.
+    """
+    fused: Dict[str, Dict] = {}
+    totals: Dict[str, float] = {}
+
+    for name, results in rankings.items():
+        for rank, result in enumerate(results, 1):
+            chunk_id = result["chunk_id"]
+            if chunk_id not in fused:
+                fused[chunk_id] = {**result, "match": []}
+            entry = fused[chunk_id]
+            entry["match"].append(name)
+            entry[f"{name}_rank"] = rank
+            entry[f"{name}_score"] = result.get("score")
+            totals[chunk_id] = totals.get(chunk_id, 0.0) + 1.0 / (k + rank)
+
+    best_possible = len(rankings) / (k + 1)
+    ordered = sorted(fused, key=lambda cid: totals[cid], reverse=True)[:limit]
+
+    results = []
+    for chunk_id in ordered:
+        entry = fused[chunk_id]
+        entry["score"] = totals[chunk_id] / best_possible
+        entry["match"] = "+".join(entry["match"])
+        results.append(entry)
+    return results
+
 
 class UnifiedRetriever:
     """
@@ -37,6 +98,8 @@ class UnifiedRetriever:
     Args:
         persist_directory: ChromaDB storage location
         use_local_embeddings: Use local embeddings instead of OpenAI
+        vector_config: VectorConfig (or source -> VectorConfig) for new
+            collections; see UnifiedVectorStore
 
     Example:
         retriever = UnifiedRetriever()
@@ -56,6 +119,7 @@ class UnifiedRetriever:
         self,
         persist_directory: Optional[str] = None,
         use_local_embeddings: bool = False,
+        vector_config: Optional[Union[VectorConfig, Dict[str, VectorConfig]]] = None,
     ):
         # Default persist directory
         if persist_directory is None:
@@ -65,14 +129,15 @@ class UnifiedRetriever:
         self.store = UnifiedVectorStore(
             persist_directory=persist_directory,
             use_local_embeddings=use_local_embeddings,
+            vector_config=vector_config,
         )
 
-        # Lazy-initialize indexers
-        self._superwhisper_indexer: Optional[SuperWhisperIndexer] = None
-        self._notes_indexer: Optional[NotesIndexer] = None
-        self._gmail_indexer: Optional[GmailIndexer] = None
-        self._slack_indexer: Optional[SlackIndexer] = None
-        self._calendar_indexer: Optional[CalendarIndexer] = None
+        # Lazy-initialize indexers (their modules are imported on first use)
+        self._superwhisper_indexer: Optional["SuperWhisperIndexer"] = None
+        self._notes_indexer: Optional["NotesIndexer"] = None
+        self._gmail_indexer: Optional["GmailIndexer"] = None
+        self._slack_indexer: Optional["SlackIndexer"] = None
+        self._calendar_indexer: Optional["CalendarIndexer"] = None
 
     # === Indexing Methods ===
 
@@ -81,6 +146,7 @@ class UnifiedRetriever:
         days: Optional[int] = None,
         limit: Optional[int] = None,
         recordings_path: Optional[Path] = None,
+        incremental: bool = True,
     ) -> Dict[str, Any]:
         """
         Index SuperWhisper voice transcriptions.
@@ -89,23 +155,26 @@ class UnifiedRetriever:
             days: Only index recordings from last N days
             limit: Maximum recordings to index
             recordings_path: Custom path to recordings
+            incremental: Only index recordings changed since the last run
 
         Returns:
             Dict with indexing stats
         """
         if self._superwhisper_indexer is None:
+            from .superwhisper_indexer import SuperWhisperIndexer
             self._superwhisper_indexer = SuperWhisperIndexer(
                 store=self.store,
                 recordings_path=recordings_path,
             )
 
-        return self._superwhisper_indexer.index(days=days, limit=limit)
+        return self._superwhisper_indexer.index(days=days, limit=limit, incremental=incremental)
 
     def index_notes(
         self,
         days: Optional[int] = None,
         limit: Optional[int] = None,
         notes_path: Optional[Path] = None,
+        incremental: bool = True,
     ) -> Dict[str, Any]:
         """
         Index markdown notes/documents.
@@ -114,17 +183,19 @@ class UnifiedRetriever:
             days: Only index files modified in last N days
             limit: Maximum files to index
             notes_path: Custom path to notes directory
+            incremental: Only index files changed since the last run
 
         Returns:
             Dict with indexing stats
         """
         if self._notes_indexer is None:
+            from .notes_indexer import NotesIndexer
             self._notes_indexer = NotesIndexer(
                 store=self.store,
                 notes_path=notes_path,
             )
 
-        return self._notes_indexer.index(days=days, limit=limit)
+        return self._notes_indexer.index(days=days, limit=limit, incremental=incremental)
 
     def index_gmail(
         self,
@@ -142,6 +213,7 @@ class UnifiedRetriever:
             Dict with indexing stats
         """
         if self._gmail_indexer is None:
+            from .gmail_indexer import GmailIndexer
             self._gmail_indexer = GmailIndexer(store=self.store)
 
         return self._gmail_indexer.index_with_data(emails, batch_size=batch_size)
@@ -162,6 +234,7 @@ class UnifiedRetriever:
             Dict with indexing stats
         """
         if self._slack_indexer is None:
+            from .slack_indexer import SlackIndexer
             self._slack_indexer = SlackIndexer(store=self.store)
 
         return self._slack_indexer.index_with_data(messages, batch_size=batch_size)
@@ -182,6 +255,7 @@ class UnifiedRetriever:
             Dict with indexing stats
         """
         if self._calendar_indexer is None:
+            from .calendar_indexer import CalendarIndexer
             self._calendar_indexer = CalendarIndexer(store=self.store)
 
         return self._calendar_indexer.index_with_data(events, batch_size=batch_size)
@@ -224,6 +298,82 @@ class UnifiedRetriever:
             "total_chunks_indexed": total_chunks,
         }
 
+    def index_remote_sources(
+        self,
+        gmail_fetcher: Optional[Callable] = None,
+        gmail_labels: Sequence[str] = ("INBOX",),
+        slack_fetcher: Optional[Callable] = None,
+        slack_channels: Sequence[str] = (),
+        calendar_fetcher: Optional[Callable] = None,
+        calendar_ids: Sequence[str] = ("primary",),
+        days: Optional[int] = 30,
+        concurrency: Optional[int] = None,
+    ) -> Dict[str, Any]:
+        """
+        Fetch and index Gmail, Slack and Calendar concurrently.
+
+        Each source pages through its streams with its own fetcher (see
+        async_fetch); sources without a fetcher are skipped. Runs an event
+        loop, so call this from synchronous code only; async callers await
+        each indexer's index_async() directly.
+
+        Args:
+            gmail_fetcher: Async Gmail page fetcher
+            gmail_labels: Labels to fetch
+            slack_fetcher: Async Slack page fetcher
+            slack_channels: Channel IDs to fetch
+            calendar_fetcher: Async Calendar page fetcher
+            calendar_ids: Calendars to fetch
+            days: Days of history to index for streams synced for the
+                first time; streams with a cursor resume from it
+            concurrency: Maximum requests in flight per source
+
+        Returns:
+            Combined indexing stats
+        """
+        import asyncio
+
+        indexers = {}
+        if gmail_fetcher is not None:
+            from .gmail_indexer import GmailIndexer
+            indexers["gmail"] = GmailIndexer(
+                store=self.store, gmail_fetcher=gmail_fetcher, labels=gmail_labels,
+            )
+        if slack_fetcher is not None:
+            from .slack_indexer import SlackIndexer
+            indexers["slack"] = SlackIndexer(
+                store=self.store, slack_fetcher=slack_fetcher, channels=slack_channels,
+            )
+        if calendar_fetcher is not None:
+            from .calendar_indexer import CalendarIndexer
+            indexers["calendar"] = CalendarIndexer(
+                store=self.store, calendar_fetcher=calendar_fetcher, calendar_ids=calendar_ids,
+            )
+
+        async def run_all():
+            return await asyncio.gather(
+                *(indexer.index_async(days=days, concurrency=concurrency) for indexer in indexers.values()),
+                return_exceptions=True,
+            )
+
+        results = {}
+        for source, result in zip(indexers, asyncio.run(run_all()) if indexers else []):
+            if isinstance(result, BaseException):
+                logger.error(f"Failed to index {source}: {result}")
+                result = {"success": False, "error": str(result), "source": source}
+            results[source] = result
+
+        total_chunks = sum(
+            r.get("chunks_indexed", 0)
+            for r in results.values()
+            if isinstance(r, dict)
+        )
+
+        return {
+            "by_source": results,
+            "total_chunks_indexed": total_chunks,
+        }
+
     # === Search Methods ===
 
     def search(
@@ -234,9 +384,10 @@ class UnifiedRetriever:
         days: Optional[int] = None,
         participants: Optional[List[str]] = None,
         tags: Optional[List[str]] = None,
+        mode: str = "hybrid",
     ) -> List[Dict]:
         """
-        Semantic search across indexed sources.
+        Search across indexed sources.
 
         Args:
             query: Natural language search query
@@ -245,30 +396,50 @@ class UnifiedRetriever:
             days: Only search content from last N days
             participants: Filter by participant names
             tags: Filter by tags
+            mode: "hybrid" (vector + BM25 keyword, fused with RRF),
+                "semantic" (vector only) or "keyword" (BM25 only)
 
         Returns:
             List of search result dicts sorted by relevance
         """
+        if mode not in SEARCH_MODES:
+            raise ValueError(f"Invalid search mode: {mode} (use one of {', '.join(SEARCH_MODES)})")
+
         # Convert days to date filter
         min_date = None
         if days:
             min_date = datetime.now() - timedelta(days=days)
 
-        return self.store.search(
-            query=query,
+        filters = dict(
             sources=sources,
-            limit=limit,
             min_date=min_date,
             participants=participants,
             tags=tags,
         )
 
+        if mode == "semantic":
+            return self.store.search(query=query, limit=limit, **filters)
+        if mode == "keyword":
+            return self.store.keyword_search(query=query, limit=limit, **filters)
+
+        candidates = max(limit * HYBRID_CANDIDATE_FACTOR, HYBRID_MIN_CANDIDATES)
+        semantic = self.store.search(query=query, limit=candidates, **filters)
+        keyword = self.store.keyword_search(query=query, limit=candidates, **filters)
+        if not keyword:
+            return semantic[:limit]
+
+        return reciprocal_rank_fusion(
+            {"semantic": semantic, "keyword": keyword},
+            limit=limit,
+        )
+
     def ask(
         self,
         question: str,
         sources: Optional[List[str]] = None,
         limit: int = 5,
         days: Optional[int] = None,
+        mode: str = "hybrid",
     ) -> str:
         """
         Search and format results for Claude consumption.
@@ -278,6 +449,7 @@ class UnifiedRetriever:
             sources: Sources to search (None = all)
             limit: Maximum results to include
             days: Only search recent content
+            mode: Search mode (see search())
 
         Returns:
             Formatted context string ready for Claude
@@ -287,6 +459,7 @@ class UnifiedRetriever:
             sources=sources,
             limit=limit,
             days=days,
+            mode=mode,
         )
 
         if not results:
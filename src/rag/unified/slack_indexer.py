@@ -11,10 +11,15 @@ where Rube/Slack tools are available.
 
 import logging
 from datetime import datetime, timedelta
-from typing import List, Dict, Any, Optional, Callable
+from pathlib import Path
+from typing import TYPE_CHECKING, List, Dict, Any, Optional, Callable, Sequence
 
 from .base_indexer import BaseSourceIndexer
 from .chunk import UnifiedChunk
+from .index_state import IndexState
+
+if TYPE_CHECKING:
+    from .async_fetch import FetchStream
 
 logger = logging.getLogger(__name__)
 
@@ -27,9 +32,12 @@ class SlackIndexer(BaseSourceIndexer):
     coherent conversation chunks for semantic search.
 
     Args:
-        slack_fetcher: Function to fetch Slack messages
+        slack_fetcher: Async page fetcher for index_async(), called as
+            fetcher(page_token=..., channel=..., oldest=...) (see async_fetch)
+        channels: Channel IDs fetched as separate concurrent streams
         window_hours: Hours for grouping messages into chunks
         min_messages: Minimum messages per chunk
+        state_file: Incremental index state (default: ~/.imessage_rag/index_state.json)
         store: Optional UnifiedVectorStore to use
         use_local_embeddings: Use local embeddings instead of OpenAI
 
@@ -37,20 +45,31 @@ class SlackIndexer(BaseSourceIndexer):
         indexer = SlackIndexer(window_hours=4.0)
         messages = [...]  # Fetched via Rube MCP
         result = indexer.index_with_data(messages)
+
+        # Or page through channels directly
+        indexer = SlackIndexer(slack_fetcher=fetch_history, channels=["C123", "C456"])
+        result = await indexer.index_async(days=30)
     """
 
     source_name = "slack"
 
+    # Time windows span pages, so each channel is chunked once fully read
+    chunk_per_page = False
+
     def __init__(
         self,
         slack_fetcher: Optional[Callable] = None,
+        channels: Sequence[str] = (),
         window_hours: float = 4.0,
         min_messages: int = 2,
         min_words: int = 20,
+        state_file: Optional[Path] = None,
         **kwargs,
     ):
         super().__init__(**kwargs)
         self.slack_fetcher = slack_fetcher
+        self.channels = list(channels)
+        self.state = IndexState(state_file)
         self.window_hours = window_hours
         self.min_messages = min_messages
         self.min_words = min_words
@@ -64,14 +83,48 @@ class SlackIndexer(BaseSourceIndexer):
         """
         Fetch messages - requires slack_fetcher to be set.
 
-        For direct use, call index_with_data() with pre-fetched messages.
+        Fetching is asynchronous: use index_async() with a slack_fetcher,
+        or index_with_data() with pre-fetched messages.
         """
         logger.warning(
             "SlackIndexer.fetch_data() is a stub. "
-            "Use index_with_data() with pre-fetched messages."
+            "Use index_with_data() with pre-fetched messages or "
+            "provide a slack_fetcher and call index_async()."
         )
         return []
 
+    def fetch_streams(
+        self,
+        days: Optional[int] = None,
+        watermarks: Optional[Dict[str, Any]] = None,
+    ) -> List["FetchStream"]:
+        """One stream per channel, resuming after the newest indexed ts."""
+        if self.slack_fetcher is None:
+            return []
+        from .async_fetch import FetchStream, Page
+
+        watermarks = watermarks or {}
+        since = f"{self.days_ago(days).timestamp():.6f}" if days else None
+
+        async def fetch_channel(page_token=None, channel=None, **params):
+            page = Page.coerce(await self.slack_fetcher(page_token=page_token, channel=channel, **params))
+            for msg in page.items:
+                msg.setdefault("channel", channel)
+            return page
+
+        return [
+            FetchStream(channel, fetch_channel, {
+                "channel": channel,
+                "oldest": watermarks.get(channel) or since,
+            })
+            for channel in self.channels
+        ]
+
+    def item_watermark(self, item: Dict[str, Any]) -> Optional[str]:
+        # "1712345678.000100": fixed-width, so string order is time order
+        ts = item.get("ts")
+        return ts if isinstance(ts, str) else None
+
     def index_with_data(
         self,
         messages: List[Dict[str, Any]],
@@ -9,14 +9,51 @@ Extends the base MessageVectorStore to support:
 
 CS Concept: This uses the **Facade Pattern** - providing a simplified
 interface to a complex subsystem (multiple ChromaDB collections).
+
+Date/participant/tag filters are compiled into a ChromaDB `where` clause
+(**predicate pushdown**) so the ANN query itself only considers matching
+chunks, instead of ranking the whole collection and discarding most hits.
+
+A BM25 keyword index of the same chunks (keyword_index.ChunkKeywordIndex)
+is maintained alongside the collections for hybrid retrieval.
+
+Multi-source searches fan out across collections on a thread pool and
+merge with a bounded top-k heap, so latency is the slowest collection
+rather than the sum of all six.
+
+Construction is cheap: the Chroma client, the embedder (OpenAI client or
+sentence-transformers) and each collection are created on first use, so
+commands like `stats` never load an embedding backend, and an empty store
+never imports chromadb at all.
+
+Collections can be created with a reduced vector layout (VectorConfig):
+Chroma holds truncated embeddings and the top candidates are re-ranked
+with quantized full vectors; see quantized_vectors.
 """
 
+import heapq
+import json
 import logging
+import sqlite3
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
-from typing import List, Dict, Optional, Any
+from typing import List, Dict, Optional, Any, Union
 from datetime import datetime
 
-from .chunk import UnifiedChunk, SOURCE_TYPES
+from .chunk import (
+    UnifiedChunk,
+    SOURCE_TYPES,
+    PARTICIPANT_KEY_PREFIX,
+    TAG_KEY_PREFIX,
+    UNDATED_EPOCH,
+    filter_metadata,
+)
+from .keyword_index import ChunkKeywordIndex
+from .quantized_vectors import RERANK_FACTOR, RerankVectorStore, VectorConfig, cosine, truncate
+from ..store import embed_and_add_pipelined, filter_new_chunks
+from ...tracing import span
 
 logger = logging.getLogger(__name__)
 
@@ -36,6 +73,91 @@ def _get_chromadb():
     return _chromadb
 
 
+# Bump when filter_metadata() gains fields that existing chunks must be
+# backfilled with before where-filters can rely on them.
+FILTER_SCHEMA_VERSION = 2  # 2: UNDATED_EPOCH on chunks without a timestamp
+
+# Over-fetch multiplier for the retry when a filtered query comes back short
+FILTER_OVERFETCH_FACTOR = 4
+
+# Seconds a cached collection.count() is trusted. Local writes invalidate
+# the entry; the TTL bounds staleness from other indexing processes.
+COUNT_CACHE_TTL = 30.0
+
+
+def _any_of(clauses: List[Dict]) -> Dict:
+    """Chroma requires $or/$and to have at least two operands."""
+    return clauses[0] if len(clauses) == 1 else {"$or": clauses}
+
+
+def build_where(
+    min_date: Optional[datetime] = None,
+    max_date: Optional[datetime] = None,
+    participants: Optional[List[str]] = None,
+    tags: Optional[List[str]] = None,
+) -> Optional[Dict]:
+    """
+    Compile search filters into a ChromaDB `where` clause.
+
+    Dates compare against numeric `timestamp_epoch`; chunks without a
+    timestamp (UNDATED_EPOCH) pass either bound. Participants and tags
+    match any of the given values via their boolean flag keys.
+
+    Returns:
+        where dict, or None when no filters are set
+    """
+    clauses: List[Dict] = []
+    if min_date:
+        clauses.append({"$or": [
+            {"timestamp_epoch": {"$gte": min_date.timestamp()}},
+            {"timestamp_epoch": {"$eq": UNDATED_EPOCH}},
+        ]})
+    if max_date:
+        # UNDATED_EPOCH sorts below every real date, so $lte keeps undated chunks
+        clauses.append({"timestamp_epoch": {"$lte": max_date.timestamp()}})
+    if participants:
+        clauses.append(_any_of([{f"{PARTICIPANT_KEY_PREFIX}{p}": True} for p in participants]))
+    if tags:
+        clauses.append(_any_of([{f"{TAG_KEY_PREFIX}{t}": True} for t in tags]))
+
+    if not clauses:
+        return None
+    return clauses[0] if len(clauses) == 1 else {"$and": clauses}
+
+
+def _backfill_fields(meta: Dict[str, Any]) -> Dict[str, Any]:
+    """Filter fields for a chunk stored before to_dict() emitted them."""
+    def parse(value):
+        try:
+            return datetime.fromisoformat(value) if value else None
+        except (ValueError, TypeError):
+            return None
+
+    return filter_metadata(
+        parse(meta.get("timestamp")),
+        parse(meta.get("end_timestamp")),
+        meta.get("participants", "").split(",") if meta.get("participants") else [],
+        meta.get("tags", "").split(",") if meta.get("tags") else [],
+    )
+
+
+def _result_dict(chunk_id: str, source: str, document: str, metadata: Dict[str, Any], score: float) -> Dict:
+    """Search result in the format shared by vector and keyword search."""
+    return {
+        "chunk_id": chunk_id,
+        "source": source,
+        "text": metadata.get("text", document),
+        "title": metadata.get("title"),
+        "context_id": metadata.get("context_id"),
+        "context_type": metadata.get("context_type"),
+        "timestamp": metadata.get("timestamp"),
+        "participants": metadata.get("participants", "").split(",") if metadata.get("participants") else [],
+        "tags": metadata.get("tags", "").split(",") if metadata.get("tags") else [],
+        "score": score,
+        "metadata": metadata,
+    }
+
+
 class UnifiedVectorStore:
     """
     Multi-collection vector store for unified RAG.
@@ -46,11 +168,19 @@ class UnifiedVectorStore:
     Args:
         persist_directory: Where to store ChromaDB data
         use_local_embeddings: Use local embeddings instead of OpenAI
+        vector_config: Layout for newly created collections: one
+            VectorConfig for all sources, or a dict of source -> VectorConfig
+            (existing collections keep the layout they were created with)
 
     Example:
         store = UnifiedVectorStore()
         store.add_chunks([chunk1, chunk2])  # Auto-routes to correct collection
         results = store.search("dinner plans", sources=["imessage", "gmail"])
+
+        # 256-dim ANN index, int8 full vectors for re-ranking
+        store = UnifiedVectorStore(vector_config={
+            "imessage": VectorConfig(dimensions=256, rerank_storage="int8"),
+        })
     """
 
     # Collection name prefix for unified sources
@@ -60,6 +190,7 @@ class UnifiedVectorStore:
         self,
         persist_directory: Optional[str] = None,
         use_local_embeddings: bool = False,
+        vector_config: Union[VectorConfig, Dict[str, VectorConfig], None] = None,
     ):
         # Default persist directory
         if persist_directory is None:
@@ -72,19 +203,76 @@ class UnifiedVectorStore:
         # Ensure directory exists
         Path(persist_directory).mkdir(parents=True, exist_ok=True)
 
-        # Initialize ChromaDB client
-        chromadb = _get_chromadb()
-        self.client = chromadb.PersistentClient(path=persist_directory)
-
-        # Initialize embedding provider (shared across collections)
-        from ..store import EmbeddingProvider
-        self.embedder = EmbeddingProvider(use_local=use_local_embeddings)
+        # ChromaDB client and embedding provider (shared across collections)
+        # are created on first use
+        self._client = None
+        self._embedder = None
 
-        # Collection cache
+        # Collection cache, and each collection's vector layout
         self._collections: Dict[str, Any] = {}
+        self._requested_configs = vector_config
+        self._configs: Dict[str, VectorConfig] = {}
+
+        # Full vectors for re-ranking reduced collections (opened on first use)
+        self._rerank_path = Path(persist_directory) / "rerank_vectors.db"
+        self._rerank: Optional[RerankVectorStore] = None
+
+        # Which collections already carry the filterable metadata fields
+        self._schema_path = Path(persist_directory) / "filter_schema.json"
+        self._filter_ready: Optional[Dict[str, int]] = None
+        self._schema_lock = threading.Lock()
+
+        # source -> (count, monotonic time fetched)
+        self._counts: Dict[str, tuple] = {}
+        self._executor: Optional[ThreadPoolExecutor] = None
+
+        # BM25 index beside the Chroma data (opened on first use)
+        self._keyword_path = Path(persist_directory) / "keyword_index.db"
+        self._keywords: Optional[ChunkKeywordIndex] = None
+        self._keywords_failed = False
 
         logger.info(f"Initialized UnifiedVectorStore at {persist_directory}")
 
+    @property
+    def client(self):
+        """ChromaDB client, opened on first use."""
+        if self._client is None:
+            chromadb = _get_chromadb()
+            self._client = chromadb.PersistentClient(path=self.persist_directory)
+        return self._client
+
+    @property
+    def embedder(self):
+        """Embedding provider, created on first embed or search."""
+        if self._embedder is None:
+            from ..store import EmbeddingProvider
+            self._embedder = EmbeddingProvider(use_local=self.use_local_embeddings)
+        return self._embedder
+
+    @embedder.setter
+    def embedder(self, embedder):
+        self._embedder = embedder
+
+    @property
+    def loaded_embedder(self):
+        """The embedder if something already created it, else None."""
+        return self._embedder
+
+    def warm_up(self):
+        """Open everything lazily created (for resident processes like the daemon)."""
+        if self.has_data():
+            for source in SOURCE_TYPES:
+                self._get_collection(source)
+        self.embedder.warm_up()
+
+    def has_data(self) -> bool:
+        """
+        Whether Chroma has ever written to persist_directory (chroma.sqlite3).
+
+        Lets stats/clear on a fresh install answer without importing chromadb.
+        """
+        return self._client is not None or (Path(self.persist_directory) / "chroma.sqlite3").exists()
+
     def _get_collection(self, source: str):
         """
         Get or create collection for a source type.
@@ -96,14 +284,143 @@ class UnifiedVectorStore:
 
         if source not in self._collections:
             collection_name = f"{self.COLLECTION_PREFIX}{source}_chunks"
-            self._collections[source] = self.client.get_or_create_collection(
-                name=collection_name,
-                metadata={"hnsw:space": "cosine"},
-            )
+            requested = self._requested_config(source)
+            try:
+                # Existing collections are opened as-is (their metadata, and
+                # so their layout, must not be rewritten)
+                collection = self.client.get_collection(name=collection_name)
+            except Exception:
+                collection = self.client.get_or_create_collection(
+                    name=collection_name,
+                    metadata={"hnsw:space": "cosine", **requested.to_metadata()},
+                )
+            config = VectorConfig.from_metadata(collection.metadata)
+            if config != requested:
+                logger.warning(
+                    f"{collection_name} keeps its stored vector layout {config}; "
+                    f"clear the source to re-index with {requested}"
+                )
+            self._collections[source] = collection
+            self._configs[source] = config
             logger.debug(f"Loaded collection: {collection_name}")
 
         return self._collections[source]
 
+    def _requested_config(self, source: str) -> VectorConfig:
+        """Layout asked for in the constructor for a source."""
+        requested = self._requested_configs
+        if isinstance(requested, dict):
+            return requested.get(source) or VectorConfig()
+        return requested or VectorConfig()
+
+    def _get_rerank_store(self) -> RerankVectorStore:
+        if self._rerank is None:
+            self._rerank = RerankVectorStore(self._rerank_path)
+        return self._rerank
+
+    def _vector_writer(self, source: str):
+        """
+        store_embeddings hook for a reduced collection (None otherwise):
+        keeps the full vectors for re-ranking, hands Chroma truncated ones.
+        """
+        config = self._configs.get(source)
+        if config is None or not config.reduced:
+            return None
+        rerank = self._get_rerank_store()
+
+        def store_embeddings(ids, vectors):
+            rerank.put_many(source, config.rerank_storage, dict(zip(ids, vectors)))
+            return [truncate(vector, config.dimensions) for vector in vectors]
+
+        return store_embeddings
+
+    def _get_keyword_index(self) -> Optional[ChunkKeywordIndex]:
+        """Open the keyword index, or None if SQLite/FTS5 is unavailable."""
+        if self._keywords is None and not self._keywords_failed:
+            try:
+                self._keywords = ChunkKeywordIndex(self._keyword_path)
+            except (sqlite3.Error, OSError) as e:
+                logger.warning(f"Keyword index unavailable, hybrid search disabled: {e}")
+                self._keywords_failed = True
+        return self._keywords
+
+    def _sync_keyword_index(self, source: str, collection, count: int, keywords: ChunkKeywordIndex):
+        """Copy chunks indexed before the keyword index existed out of Chroma."""
+        if keywords.count(source) >= count:
+            return
+
+        logger.info(f"Building {source} keyword index from {count} stored chunks...")
+        page_size = 1000
+        offset = 0
+        while True:
+            page = collection.get(include=["metadatas"], limit=page_size, offset=offset)
+            if not page["ids"]:
+                break
+            keywords.add_metadatas(
+                {**(meta or {}), "chunk_id": chunk_id, "source": source}
+                for chunk_id, meta in zip(page["ids"], page["metadatas"])
+            )
+            offset += len(page["ids"])
+
+    def _count(self, source: str, collection) -> int:
+        """collection.count(), cached for COUNT_CACHE_TTL seconds."""
+        cached = self._counts.get(source)
+        if cached and time.monotonic() - cached[1] < COUNT_CACHE_TTL:
+            return cached[0]
+        count = collection.count()
+        self._counts[source] = (count, time.monotonic())
+        return count
+
+    def _ensure_filter_metadata(self, source: str, collection) -> None:
+        """
+        Backfill epoch/flag metadata on chunks indexed before it existed.
+
+        Runs once per collection (tracked in filter_schema.json next to the
+        Chroma data); without it, where-filters would silently drop every
+        legacy chunk.
+        """
+        with self._schema_lock:
+            if self._filter_ready is None:
+                try:
+                    self._filter_ready = json.loads(self._schema_path.read_text())
+                except (OSError, ValueError):
+                    self._filter_ready = {}
+
+            if self._filter_ready.get(source, 0) >= FILTER_SCHEMA_VERSION:
+                return
+
+        updated = 0
+        page_size = 1000
+        offset = 0
+        while True:
+            page = collection.get(include=["metadatas"], limit=page_size, offset=offset)
+            ids = page["ids"]
+            if not ids:
+                break
+
+            stale_ids, stale_metas = [], []
+            for chunk_id, meta in zip(ids, page["metadatas"]):
+                meta = meta or {}
+                fields = _backfill_fields(meta)
+                if any(key not in meta for key in fields):
+                    stale_ids.append(chunk_id)
+                    stale_metas.append({**meta, **fields})
+            if stale_ids:
+                collection.update(ids=stale_ids, metadatas=stale_metas)
+                updated += len(stale_ids)
+
+            offset += len(ids)
+
+        if updated:
+            logger.info(f"Backfilled filter metadata on {updated} {source} chunks")
+
+        with self._schema_lock:
+            self._filter_ready[source] = FILTER_SCHEMA_VERSION
+            try:
+                self._schema_path.write_text(json.dumps(self._filter_ready))
+            except OSError as e:
+                logger.warning(f"Could not record filter schema version: {e}")
+
     def add_chunks(
         self,
         chunks: List[UnifiedChunk],
@@ -134,46 +451,39 @@ class UnifiedVectorStore:
 
         results = {}
 
-        for source, source_chunks in by_source.items():
-            collection = self._get_collection(source)
-
-            # Filter out existing chunks
-            existing_ids = set(collection.get()["ids"])
-            new_chunks = [c for c in source_chunks if c.chunk_id not in existing_ids]
-
-            if not new_chunks:
-                results[source] = 0
-                continue
-
-            logger.info(
-                f"Indexing {len(new_chunks)} new {source} chunks "
-                f"(skipping {len(source_chunks) - len(new_chunks)} existing)"
-            )
+        with span("store"):
+            for source, source_chunks in by_source.items():
+                collection = self._get_collection(source)
 
-            # Process in batches
-            added = 0
-            for i in range(0, len(new_chunks), batch_size):
-                batch = new_chunks[i:i + batch_size]
+                # Filter out existing chunks (targeted lookup of candidate IDs only)
+                new_chunks = filter_new_chunks(collection, source_chunks)
 
-                ids = [c.chunk_id for c in batch]
-                texts = [c.to_embedding_text() for c in batch]
-                metadatas = [c.to_dict() for c in batch]
+                if not new_chunks:
+                    results[source] = 0
+                    continue
 
-                # Generate embeddings
-                embeddings = self.embedder.embed(texts)
+                logger.info(
+                    f"Indexing {len(new_chunks)} new {source} chunks "
+                    f"(skipping {len(source_chunks) - len(new_chunks)} existing)"
+                )
 
-                # Add to collection
-                collection.add(
-                    ids=ids,
-                    embeddings=embeddings,
-                    documents=texts,
-                    metadatas=metadatas,
+                # Concurrent embedding, overlapped with Chroma writes
+                added = embed_and_add_pipelined(
+                    collection, self.embedder, new_chunks, batch_size=batch_size,
+                    store_embeddings=self._vector_writer(source),
                 )
 
-                added += len(batch)
+                results[source] = added
+                self._counts.pop(source, None)
+                logger.info(f"Indexed {added} {source} chunks")
 
-            results[source] = added
-            logger.info(f"Indexed {added} {source} chunks")
+            # Keyword index gets every chunk seen (idempotent by chunk_id)
+            keywords = self._get_keyword_index()
+            if keywords is not None:
+                try:
+                    keywords.add_chunks(chunks)
+                except sqlite3.Error as e:
+                    logger.warning(f"Could not update keyword index: {e}")
 
         return results
 
@@ -196,6 +506,7 @@ class UnifiedVectorStore:
             limit: Max results per source
             min_date: Filter chunks after this date
             max_date: Filter chunks before this date
+                (chunks without a timestamp are kept by either date filter)
             participants: Filter by participant names
             tags: Filter by tags
 
@@ -211,78 +522,212 @@ class UnifiedVectorStore:
         if invalid_sources:
             raise ValueError(f"Invalid sources: {invalid_sources}")
 
-        # Generate query embedding once
-        query_embedding = self.embedder.embed_single(query)
+        # Generate query embedding once (LRU + disk cached)
+        with span("embed"):
+            query_embedding = self.embedder.embed_query(query)
 
-        all_results = []
+        where = build_where(min_date, max_date, participants, tags)
 
-        for source in sources:
-            collection = self._get_collection(source)
+        with span("store"):
+            # Resolve collections and counts on the caller thread; empty
+            # collections are skipped without a query round-trip.
+            active = []
+            for source in sources:
+                collection = self._get_collection(source)
+                count = self._count(source, collection)
+                if count > 0:
+                    active.append((source, collection, count))
+
+            if len(active) <= 1:
+                per_source = [
+                    self._search_source(source, collection, count, query_embedding, limit, where)
+                    for source, collection, count in active
+                ]
+            else:
+                executor = self._get_executor()
+                futures = [
+                    executor.submit(self._search_source, source, collection, count,
+                                    query_embedding, limit, where)
+                    for source, collection, count in active
+                ]
+                per_source = [future.result() for future in futures]
+
+        # Top results across all sources (bounded heap, highest score first)
+        return heapq.nlargest(
+            limit,
+            (result for results in per_source for result in results),
+            key=lambda x: x["score"],
+        )
+
+    def _get_executor(self) -> ThreadPoolExecutor:
+        """Thread pool for per-collection queries (one worker per source)."""
+        if self._executor is None:
+            self._executor = ThreadPoolExecutor(
+                max_workers=len(SOURCE_TYPES),
+                thread_name_prefix="unified-search",
+            )
+        return self._executor
 
-            if collection.count() == 0:
-                continue
+    def _search_source(
+        self,
+        source: str,
+        collection,
+        count: int,
+        query_embedding: List[float],
+        limit: int,
+        where: Optional[Dict],
+    ) -> List[Dict]:
+        """Query one source collection and convert hits to result dicts."""
+        if where is not None:
+            self._ensure_filter_metadata(source, collection)
 
-            # Query this collection
+        config = self._configs.get(source)
+        if config is not None and config.reduced:
+            return self._search_reduced(source, collection, count, query_embedding, limit, where, config)
+
+        results = self._query_collection(collection, query_embedding, limit, where, count)
+
+        source_results = []
+        for i in range(len(results["ids"][0])):
+            chunk_id = results["ids"][0][i]
+            document = results["documents"][0][i]
+            metadata = results["metadatas"][0][i]
+            distance = results["distances"][0][i]
+
+            # Convert distance to similarity
+            score = 1 - distance
+
+            source_results.append(_result_dict(chunk_id, source, document, metadata, score))
+
+        return source_results
+
+    def _search_reduced(
+        self,
+        source: str,
+        collection,
+        count: int,
+        query_embedding: List[float],
+        limit: int,
+        where: Optional[Dict],
+        config: VectorConfig,
+    ) -> List[Dict]:
+        """
+        Two-stage search of a reduced collection: RERANK_FACTOR x limit
+        candidates from the truncated ANN index, re-scored with the full
+        (quantized) vectors. Candidates without a stored full vector keep
+        their truncated-space score.
+        """
+        results = self._query_collection(
+            collection, truncate(query_embedding, config.dimensions),
+            limit * RERANK_FACTOR, where, count,
+        )
+        ids = results["ids"][0]
+        try:
+            full = self._get_rerank_store().get_many(source, ids)
+        except sqlite3.Error as e:
+            logger.warning(f"Re-rank vectors unavailable, using truncated scores: {e}")
+            full = {}
+
+        candidates = []
+        for i, chunk_id in enumerate(ids):
+            vector = full.get(chunk_id)
+            score = cosine(query_embedding, vector) if vector else 1 - results["distances"][0][i]
+            candidates.append(_result_dict(
+                chunk_id, source, results["documents"][0][i], results["metadatas"][0][i], score,
+            ))
+        return heapq.nlargest(limit, candidates, key=lambda x: x["score"])
+
+    def keyword_search(
+        self,
+        query: str,
+        sources: Optional[List[str]] = None,
+        limit: int = 10,
+        min_date: Optional[datetime] = None,
+        max_date: Optional[datetime] = None,
+        participants: Optional[List[str]] = None,
+        tags: Optional[List[str]] = None,
+    ) -> List[Dict]:
+        """
+        BM25 keyword search across one or more sources.
+
+        Same arguments and result format as search(); `score` is the BM25
+        relevance squashed into 0-1 (bm25 / (1 + bm25)).
+
+        Returns:
+            List of result dicts, best match first ([] if the keyword
+            index is unavailable)
+        """
+        if sources is None:
+            sources = list(SOURCE_TYPES)
+
+        invalid_sources = set(sources) - SOURCE_TYPES
+        if invalid_sources:
+            raise ValueError(f"Invalid sources: {invalid_sources}")
+
+        keywords = self._get_keyword_index()
+        if keywords is None:
+            return []
+
+        try:
+            active = []
+            for source in sources:
+                collection = self._get_collection(source)
+                count = self._count(source, collection)
+                if count > 0:
+                    self._sync_keyword_index(source, collection, count, keywords)
+                    active.append(source)
+            if not active:
+                return []
+
+            with span("keyword"):
+                hits = keywords.search(
+                    query,
+                    sources=active,
+                    limit=limit,
+                    min_date=min_date,
+                    max_date=max_date,
+                    participants=participants,
+                    tags=tags,
+                )
+        except sqlite3.Error as e:
+            logger.warning(f"Keyword search failed: {e}")
+            return []
+
+        return [
+            _result_dict(meta["chunk_id"], meta["source"], meta.get("text", ""), meta, rank / (1 + rank))
+            for meta, rank in hits
+        ]
+
+    @staticmethod
+    def _query_collection(collection, query_embedding, limit: int, where: Optional[Dict], count: int):
+        """
+        Run one ANN query, over-fetching once if a filtered query comes back short.
+
+        Chroma applies `where` before ranking, but a very selective filter can
+        still starve the HNSW candidate list; asking for more neighbours lets
+        the graph search widen until the filtered result set is full.
+        """
+        n_results = min(limit, count)
+        kwargs = {"where": where} if where is not None else {}
+        results = collection.query(
+            query_embeddings=[query_embedding],
+            n_results=n_results,
+            include=["documents", "metadatas", "distances"],
+            **kwargs,
+        )
+
+        if where is not None and len(results["ids"][0]) < n_results < count:
+            wider = min(count, limit * FILTER_OVERFETCH_FACTOR)
             results = collection.query(
                 query_embeddings=[query_embedding],
-                n_results=limit,
+                n_results=wider,
                 include=["documents", "metadatas", "distances"],
+                **kwargs,
             )
+            for key in ("ids", "documents", "metadatas", "distances"):
+                results[key] = [results[key][0][:limit]]
 
-            # Process results
-            for i in range(len(results["ids"][0])):
-                chunk_id = results["ids"][0][i]
-                document = results["documents"][0][i]
-                metadata = results["metadatas"][0][i]
-                distance = results["distances"][0][i]
-
-                # Convert distance to similarity
-                score = 1 - distance
-
-                # Apply date filters
-                if min_date or max_date:
-                    chunk_time = metadata.get("timestamp")
-                    if chunk_time:
-                        try:
-                            chunk_dt = datetime.fromisoformat(chunk_time)
-                            if min_date and chunk_dt < min_date:
-                                continue
-                            if max_date and chunk_dt > max_date:
-                                continue
-                        except (ValueError, TypeError):
-                            pass
-
-                # Apply participant filter
-                if participants:
-                    chunk_participants = metadata.get("participants", "").split(",")
-                    if not any(p in chunk_participants for p in participants):
-                        continue
-
-                # Apply tags filter
-                if tags:
-                    chunk_tags = metadata.get("tags", "").split(",")
-                    if not any(t in chunk_tags for t in tags):
-                        continue
-
-                all_results.append({
-                    "chunk_id": chunk_id,
-                    "source": source,
-                    "text": metadata.get("text", document),
-                    "title": metadata.get("title"),
-                    "context_id": metadata.get("context_id"),
-                    "context_type": metadata.get("context_type"),
-                    "timestamp": metadata.get("timestamp"),
-                    "participants": metadata.get("participants", "").split(",") if metadata.get("participants") else [],
-                    "tags": metadata.get("tags", "").split(",") if metadata.get("tags") else [],
-                    "score": score,
-                    "metadata": metadata,
-                })
-
-        # Sort by score (highest first)
-        all_results.sort(key=lambda x: x["score"], reverse=True)
-
-        # Return top results across all sources
-        return all_results[:limit]
+        return results
 
     def get_stats(self, source: Optional[str] = None) -> Dict[str, Any]:
         """
@@ -303,10 +748,16 @@ class UnifiedVectorStore:
         newest = None
         all_participants = set()
         all_tags = set()
+        has_data = self.has_data()
 
         for src in sources_to_check:
+            if not has_data:
+                by_source[src] = {"chunk_count": 0}
+                continue
+
             collection = self._get_collection(src)
             count = collection.count()
+            self._counts[src] = (count, time.monotonic())
 
             if count == 0:
                 by_source[src] = {"chunk_count": 0}
@@ -347,6 +798,13 @@ class UnifiedVectorStore:
                 "oldest": source_oldest,
                 "newest": source_newest,
             }
+            config = self._configs.get(src)
+            if config is not None and config.reduced:
+                by_source[src]["vectors"] = {
+                    "dimensions": config.dimensions,
+                    "rerank_storage": config.rerank_storage,
+                    **self._get_rerank_store().stats(src),
+                }
 
             total_chunks += count
 
@@ -367,6 +825,38 @@ class UnifiedVectorStore:
             "persist_directory": self.persist_directory,
         }
 
+    def delete_chunks(self, source: str, chunk_ids: List[str]) -> int:
+        """
+        Remove specific chunks from a source's collection and keyword index.
+
+        Used with add_chunks() to replace a chunk whose content (and so
+        chunk_id) changed, e.g. a conversation window that grew.
+
+        Returns:
+            Number of chunk IDs requested for deletion
+        """
+        if not chunk_ids:
+            return 0
+
+        with span("store"):
+            collection = self._get_collection(source)
+            collection.delete(ids=list(chunk_ids))
+            self._counts.pop(source, None)
+
+            config = self._configs.get(source)
+            if config is not None and config.reduced:
+                self._get_rerank_store().delete(source, chunk_ids)
+
+            keywords = self._get_keyword_index()
+            if keywords is not None:
+                try:
+                    keywords.delete(chunk_ids)
+                except sqlite3.Error as e:
+                    logger.warning(f"Could not update keyword index: {e}")
+
+        logger.info(f"Deleted {len(chunk_ids)} superseded {source} chunks")
+        return len(chunk_ids)
+
     def clear(self, source: Optional[str] = None) -> int:
         """
         Clear indexed data.
@@ -379,25 +869,42 @@ class UnifiedVectorStore:
         """
         sources_to_clear = [source] if source else list(SOURCE_TYPES)
         total_deleted = 0
+        has_data = self.has_data()
 
         for src in sources_to_clear:
             if src not in SOURCE_TYPES:
                 continue
 
-            collection_name = f"{self.COLLECTION_PREFIX}{src}_chunks"
-            try:
-                collection = self.client.get_collection(collection_name)
-                count = collection.count()
-                if count > 0:
-                    self.client.delete_collection(collection_name)
-                    total_deleted += count
-                    logger.info(f"Cleared {count} chunks from {src}")
-
-                # Remove from cache
-                if src in self._collections:
-                    del self._collections[src]
-            except Exception:
-                # Collection doesn't exist
-                pass
+            if has_data:
+                collection_name = f"{self.COLLECTION_PREFIX}{src}_chunks"
+                try:
+                    collection = self.client.get_collection(collection_name)
+                    count = collection.count()
+                    if count > 0:
+                        self.client.delete_collection(collection_name)
+                        total_deleted += count
+                        logger.info(f"Cleared {count} chunks from {src}")
+
+                    # Remove from cache; the next collection gets the requested layout
+                    if src in self._collections:
+                        del self._collections[src]
+                    self._configs.pop(src, None)
+                    self._counts.pop(src, None)
+                except Exception:
+                    # Collection doesn't exist
+                    pass
+
+            if self._rerank is not None or self._rerank_path.exists():
+                try:
+                    self._get_rerank_store().clear(src)
+                except sqlite3.Error as e:
+                    logger.warning(f"Could not clear {src} re-rank vectors: {e}")
+
+            keywords = self._get_keyword_index()
+            if keywords is not None:
+                try:
+                    keywords.clear(src)
+                except sqlite3.Error as e:
+                    logger.warning(f"Could not clear {src} keyword index: {e}")
 
         return total_deleted
@@ -10,12 +10,15 @@ This is the simplest indexer since data is local JSON files.
 import json
 import logging
 import os
+from concurrent.futures import ThreadPoolExecutor
 from datetime import datetime
 from pathlib import Path
-from typing import List, Dict, Any, Optional
+from typing import List, Dict, Any, Optional, Tuple
 
 from .base_indexer import BaseSourceIndexer
 from .chunk import UnifiedChunk
+from .file_manifest import FileManifest, content_digest
+from .index_state import IndexState
 
 logger = logging.getLogger(__name__)
 
@@ -23,6 +26,9 @@ logger = logging.getLogger(__name__)
 # Default SuperWhisper data location
 DEFAULT_SUPERWHISPER_PATH = Path.home() / "Documents" / "superwhisper" / "recordings"
 
+# Threads reading changed meta.json files
+READ_WORKERS = 8
+
 
 class SuperWhisperIndexer(BaseSourceIndexer):
     """
@@ -35,6 +41,8 @@ class SuperWhisperIndexer(BaseSourceIndexer):
 
     Args:
         recordings_path: Path to recordings directory
+        state_file: Incremental index state (default: ~/.imessage_rag/index_state.json);
+            the file manifest is kept beside it as superwhisper_manifest.json
         store: Optional UnifiedVectorStore to use
         use_local_embeddings: Use local embeddings instead of OpenAI
 
@@ -49,10 +57,15 @@ class SuperWhisperIndexer(BaseSourceIndexer):
     def __init__(
         self,
         recordings_path: Optional[Path] = None,
+        state_file: Optional[Path] = None,
         **kwargs,
     ):
         super().__init__(**kwargs)
         self.recordings_path = recordings_path or DEFAULT_SUPERWHISPER_PATH
+        self.state = IndexState(state_file)
+        self.manifest = FileManifest(
+            self.state.state_file.with_name(f"{self.source_name}_manifest.json")
+        )
 
         if not self.recordings_path.exists():
             logger.warning(
@@ -63,76 +76,128 @@ class SuperWhisperIndexer(BaseSourceIndexer):
         self,
         days: Optional[int] = None,
         limit: Optional[int] = None,
+        incremental: bool = True,
         **kwargs,
     ) -> List[Dict[str, Any]]:
         """
-        Load recordings from the filesystem.
+        Load changed recordings from the filesystem.
+
+        One scandir of the recordings directory plus one stat per
+        meta.json; in incremental mode only recordings whose meta.json
+        differs from the file manifest are read (in parallel). Chunks of
+        edited and deleted recordings are staged for deletion. Days runs
+        cover a slice and leave the manifest alone.
 
         Args:
             days: Only fetch recordings from last N days
             limit: Maximum number of recordings to fetch
+            incremental: Only fetch recordings whose meta.json changed since
+                the last run (ignored when days is set)
 
         Returns:
-            List of recording dicts with id and meta
+            List of recording dicts with id, meta and chunk
         """
+        self._stale_chunk_ids = []
+        self.manifest.discard()
         if not self.recordings_path.exists():
             logger.warning(f"Recordings path does not exist: {self.recordings_path}")
             return []
 
-        recordings = []
-        cutoff_date = None
-        if days:
-            cutoff_date = self.days_ago(days)
-
-        # Get all recording directories
-        recording_dirs = []
-        for item in self.recordings_path.iterdir():
-            if item.is_dir() and item.name.isdigit():
-                recording_dirs.append(item)
+        cutoff_date = self.days_ago(days) if days else None
+        tracked = not days
 
-        # Sort by timestamp (most recent first for limit)
-        recording_dirs.sort(key=lambda x: int(x.name), reverse=True)
-
-        for recording_dir in recording_dirs:
-            meta_path = recording_dir / "meta.json"
-            if not meta_path.exists():
-                continue
-
-            try:
-                with open(meta_path, "r", encoding="utf-8") as f:
-                    meta = json.load(f)
-            except (json.JSONDecodeError, IOError) as e:
-                logger.warning(f"Failed to read {meta_path}: {e}")
-                continue
-
-            # Parse datetime for filtering
-            recording_dt = None
-            if meta.get("datetime"):
+        seen = set()
+        candidates = []
+        with os.scandir(self.recordings_path) as entries:
+            for entry in entries:
+                if not entry.name.isdigit() or not entry.is_dir():
+                    continue
                 try:
-                    recording_dt = datetime.fromisoformat(meta["datetime"])
-                except ValueError:
-                    pass
-
-            # Apply date filter
-            if cutoff_date and recording_dt and recording_dt < cutoff_date:
-                continue
+                    stat = os.stat(os.path.join(entry.path, "meta.json"))
+                except OSError:
+                    continue
+                seen.add(entry.name)
+                if incremental and tracked and self.manifest.is_unchanged(entry.name, stat):
+                    continue
+                candidates.append((entry.name, stat))
 
-            # Skip empty transcriptions
-            if not meta.get("result"):
-                continue
+        # Sort by timestamp (most recent first for limit)
+        candidates.sort(key=lambda item: int(item[0]), reverse=True)
 
-            recordings.append({
-                "id": recording_dir.name,
-                "meta": meta,
-                "datetime": recording_dt,
-            })
+        use_hashes = incremental and tracked
+        recordings = []
+        pending = candidates
+        while pending and (not limit or len(recordings) < limit):
+            # Read in limit-sized waves so a limited run reads little more than it keeps
+            wave_size = max(limit - len(recordings), 1) if limit else len(pending)
+            wave, pending = pending[:wave_size], pending[wave_size:]
+            with ThreadPoolExecutor(max_workers=READ_WORKERS) as executor:
+                loaded = list(executor.map(lambda item: self._load_recording(*item, use_hashes), wave))
+
+            for (recording_id, stat), (digest, recording) in zip(wave, loaded):
+                if digest is None:
+                    continue  # Unreadable; retried next run
+                if recording is not None and cutoff_date and recording["datetime"] \
+                        and recording["datetime"] < cutoff_date:
+                    continue
+                chunk_ids = []
+                if recording is not None:
+                    chunk_ids = [recording["chunk"].chunk_id] if recording["chunk"] else []
+                elif self.manifest.get(recording_id):
+                    chunk_ids = self.manifest.get(recording_id).get("chunk_ids", [])
+                if tracked:
+                    self._stale_chunk_ids += self.manifest.stage(recording_id, stat, digest, chunk_ids)
+                if recording is not None and recording["chunk"] is not None:
+                    recordings.append(recording)
+
+        if tracked:
+            self._stale_chunk_ids += self.manifest.stage_removed(seen)
+            self._pending_cursor = {"files": len(seen)}
+
+        logger.info(f"Found {len(recordings)} changed SuperWhisper recordings ({len(seen)} total)")
+        return recordings
 
-            # Apply limit
-            if limit and len(recordings) >= limit:
-                break
+    def _load_recording(
+        self,
+        recording_id: str,
+        stat: os.stat_result,
+        incremental: bool,
+    ) -> Tuple[Optional[str], Optional[Dict[str, Any]]]:
+        """
+        Read, hash and chunk one recording's meta.json (runs in a worker thread).
 
-        logger.info(f"Found {len(recordings)} SuperWhisper recordings")
-        return recordings
+        Returns:
+            (content digest or None if unreadable, recording dict or None
+            if unchanged since the last run)
+        """
+        meta_path = self.recordings_path / recording_id / "meta.json"
+        try:
+            data = meta_path.read_bytes()
+            digest = content_digest(data)
+            previous = self.manifest.get(recording_id)
+            if incremental and previous and previous.get("sha1") == digest:
+                return digest, None
+            meta = json.loads(data)
+        except (json.JSONDecodeError, UnicodeDecodeError, IOError, OSError) as e:
+            logger.warning(f"Failed to read {meta_path}: {e}")
+            return None, None
+
+        # Parse datetime for filtering
+        recording_dt = None
+        if meta.get("datetime"):
+            try:
+                recording_dt = datetime.fromisoformat(meta["datetime"])
+            except ValueError:
+                pass
+
+        recording = {
+            "id": recording_id,
+            "meta": meta,
+            "datetime": recording_dt,
+        }
+        # Skip empty transcriptions (chunk stays None)
+        recording["chunk"] = self._recording_to_chunk(recording) if meta.get("result") else None
+        return digest, recording
 
     def chunk_data(self, recordings: List[Dict[str, Any]]) -> List[UnifiedChunk]:
         """
@@ -143,7 +208,8 @@ class SuperWhisperIndexer(BaseSourceIndexer):
         chunks = []
 
         for recording in recordings:
-            chunk = self._recording_to_chunk(recording)
+            # fetch_data() already chunked in its worker threads
+            chunk = recording["chunk"] if "chunk" in recording else self._recording_to_chunk(recording)
             if chunk:
                 chunks.append(chunk)
 
@@ -200,7 +266,7 @@ class SuperWhisperIndexer(BaseSourceIndexer):
         Returns:
             Dict with oldest and newest recording dates
         """
-        recordings = self.fetch_data(limit=None)
+        recordings = self.fetch_data(limit=None, incremental=False)
         if not recordings:
             return {"oldest": None, "newest": None}
 
@@ -0,0 +1,367 @@
+"""
+Incrementally maintained per-chat and per-handle rollups of chat.db.
+
+Listing commands (recent conversations, groups, handles, unknown senders)
+used to GROUP BY over the whole message table on every call, so their cost
+grew with total history. This module keeps the aggregates in the sidecar
+database (see chat_db.open_sidecar), folding in only messages with a ROWID
+above the stored high-water mark, so each listing becomes an indexed read.
+
+- chat_rollup: one row per chat - last message (ROWID, date, direction,
+  sender, text), sent/received/unread counts and the participant list.
+- handle_day: messages per (handle, UTC day), so "handles active in the
+  last N days" sums at most N rows per handle.
+
+Unread counts are the one aggregate that changes without a new ROWID
+(messages get marked read in place); chats with unread > 0 are recounted
+on each sync, which only ever touches a handful of chats.
+
+CS Concept: **Materialized view with incremental maintenance** - the
+rollups are a cached query result, kept current by applying deltas
+(new rows) rather than recomputing from scratch.
+"""
+
+import json
+import logging
+import sqlite3
+from pathlib import Path
+from typing import Any, Callable, Dict, Iterable, List, Optional, Tuple
+
+from .chat_db import open_sidecar
+
+logger = logging.getLogger(__name__)
+
+# ROWID range folded in per transaction during sync
+SYNC_BATCH_SIZE = 5000
+
+NS_PER_DAY = 86400 * 1_000_000_000
+
+_SCHEMA = """
+    CREATE TABLE IF NOT EXISTS rollup_meta (
+        key TEXT PRIMARY KEY,
+        value TEXT
+    );
+    CREATE TABLE IF NOT EXISTS chat_rollup (
+        chat_id INTEGER PRIMARY KEY,    -- chat.db chat.ROWID
+        chat_identifier TEXT,
+        display_name TEXT,
+        participants TEXT NOT NULL DEFAULT '[]',   -- JSON list of handles
+        participant_count INTEGER NOT NULL DEFAULT 0,
+        last_rowid INTEGER,
+        last_date INTEGER,              -- Cocoa nanoseconds
+        last_is_from_me INTEGER,
+        last_handle TEXT,
+        last_text TEXT,
+        sent_count INTEGER NOT NULL DEFAULT 0,
+        received_count INTEGER NOT NULL DEFAULT 0,
+        unread_count INTEGER NOT NULL DEFAULT 0
+    );
+    CREATE INDEX IF NOT EXISTS idx_chat_rollup_last_date ON chat_rollup(last_date);
+    CREATE TABLE IF NOT EXISTS handle_day (
+        handle TEXT NOT NULL,
+        day INTEGER NOT NULL,           -- Cocoa date // NS_PER_DAY (UTC days since 2001)
+        sent_count INTEGER NOT NULL,
+        received_count INTEGER NOT NULL,
+        last_date INTEGER NOT NULL,
+        PRIMARY KEY (handle, day)
+    ) WITHOUT ROWID;
+    CREATE INDEX IF NOT EXISTS idx_handle_day_day ON handle_day(day);
+"""
+
+_CHAT_COLUMNS = (
+    "chat_id, chat_identifier, display_name, participants, participant_count, "
+    "last_rowid, last_date, last_is_from_me, last_handle, last_text, "
+    "sent_count, received_count, unread_count"
+)
+
+
+class ConversationRollups:
+    """
+    Sidecar rollups maintained from the chat.db ROWID high-water mark.
+
+    Args:
+        index_path: Sidecar database path (default: ~/.imessage_rag/chat_index.db)
+        source_db: chat.db path the rollups are built from; a different
+            source triggers a rebuild so rollups never mix databases
+    """
+
+    def __init__(self, index_path: Optional[Path] = None, source_db: Optional[Path] = None):
+        self.conn = open_sidecar(index_path)
+        self.conn.executescript(_SCHEMA)
+        self.source_db = str(source_db) if source_db else ""
+
+        if self.source_db and self._get_meta("source_db") not in (None, self.source_db):
+            logger.info("Rollups built from a different chat.db - rebuilding")
+            self.clear()
+        self._set_meta("source_db", self.source_db)
+        self.conn.commit()
+
+    # ----- metadata -----
+
+    def _get_meta(self, key: str) -> Optional[str]:
+        row = self.conn.execute("SELECT value FROM rollup_meta WHERE key = ?", (key,)).fetchone()
+        return row[0] if row else None
+
+    def _set_meta(self, key: str, value: Any):
+        self.conn.execute(
+            "INSERT OR REPLACE INTO rollup_meta (key, value) VALUES (?, ?)", (key, str(value))
+        )
+
+    @property
+    def max_rowid(self) -> int:
+        """Highest chat.db ROWID already folded in."""
+        value = self._get_meta("max_rowid")
+        return int(value) if value else 0
+
+    def clear(self):
+        """Drop all rollups (next sync rebuilds from ROWID 0)."""
+        self.conn.execute("DELETE FROM chat_rollup")
+        self.conn.execute("DELETE FROM handle_day")
+        self.conn.execute("DELETE FROM rollup_meta WHERE key = 'max_rowid'")
+        self.conn.commit()
+
+    # ----- maintenance -----
+
+    def sync(
+        self,
+        chat_conn: sqlite3.Connection,
+        decode_many: Callable[[Iterable[Tuple]], Dict[int, Optional[str]]],
+        batch_size: int = SYNC_BATCH_SIZE,
+    ) -> int:
+        """
+        Fold messages added since the last sync into the rollups.
+
+        Args:
+            chat_conn: Read-only connection to chat.db
+            decode_many: Batch decoder taking (text, attributedBody, ROWID)
+                rows and returning ROWID -> text (MessagesInterface._decode_bodies)
+            batch_size: ROWID range per transaction
+
+        Returns:
+            Number of messages folded in
+        """
+        last_rowid = self.max_rowid
+
+        # chat.db was reset/restored: ROWIDs are no longer comparable
+        chat_max = chat_conn.execute("SELECT COALESCE(MAX(ROWID), 0) FROM message").fetchone()[0]
+        if chat_max < last_rowid:
+            logger.info("chat.db ROWIDs went backwards - rebuilding rollups")
+            self.clear()
+            last_rowid = 0
+
+        self._refresh_unread(chat_conn)
+
+        if chat_max == last_rowid:
+            return 0
+
+        if last_rowid == 0:
+            logger.info("Building conversation rollups (first run, may take a moment)...")
+
+        added = 0
+        while last_rowid < chat_max:
+            upper = min(last_rowid + batch_size, chat_max)
+            rows = chat_conn.execute("""
+                SELECT
+                    message.ROWID,
+                    message.date,
+                    message.is_from_me,
+                    message.is_read,
+                    handle.id,
+                    message.text,
+                    message.attributedBody,
+                    chat_message_join.chat_id
+                FROM message
+                LEFT JOIN handle ON message.handle_id = handle.ROWID
+                LEFT JOIN chat_message_join ON chat_message_join.message_id = message.ROWID
+                WHERE message.ROWID > ? AND message.ROWID <= ?
+                ORDER BY message.ROWID
+            """, (last_rowid, upper)).fetchall()
+
+            added += self._apply(chat_conn, rows, decode_many)
+            last_rowid = upper
+            with self.conn:
+                self._set_meta("max_rowid", last_rowid)
+
+        logger.info(f"Rollups: folded in {added} messages (max ROWID {last_rowid})")
+        return added
+
+    def _apply(self, chat_conn, rows: List[Tuple], decode_many) -> int:
+        """Fold one ROWID range into chat_rollup and handle_day."""
+        chats: Dict[int, Dict[str, Any]] = {}
+        handle_days: Dict[Tuple[str, int], List[int]] = {}
+        seen = set()
+
+        for rowid, date, is_from_me, is_read, handle, text, body, chat_id in rows:
+            date = date or 0
+            if rowid not in seen:
+                seen.add(rowid)
+                if handle:
+                    counts = handle_days.setdefault((handle, date // NS_PER_DAY), [0, 0, 0])
+                    counts[0 if is_from_me else 1] += 1
+                    counts[2] = max(counts[2], date)
+
+            if chat_id is None:
+                continue
+            chat = chats.setdefault(chat_id, {"sent": 0, "received": 0, "unread": 0, "last": None})
+            chat["sent" if is_from_me else "received"] += 1
+            if not is_from_me and not is_read:
+                chat["unread"] += 1
+            if chat["last"] is None or date >= chat["last"][1]:
+                chat["last"] = (rowid, date, is_from_me, handle, text, body)
+
+        if not seen:
+            return 0
+
+        lasts = [chat["last"] for chat in chats.values()]
+        texts = decode_many((last[4], last[5], last[0]) for last in lasts)
+
+        chat_rows = []
+        for chat_id, chat in chats.items():
+            rowid, date, is_from_me, handle, text, _ = chat["last"]
+            chat_rows.append((
+                chat_id, rowid, date, 1 if is_from_me else 0, handle,
+                text or texts.get(rowid), chat["sent"], chat["received"], chat["unread"],
+            ))
+
+        details = self._chat_details(chat_conn, list(chats))
+
+        with self.conn:
+            self.conn.executemany("""
+                INSERT INTO chat_rollup (
+                    chat_id, last_rowid, last_date, last_is_from_me, last_handle, last_text,
+                    sent_count, received_count, unread_count
+                ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
+                ON CONFLICT(chat_id) DO UPDATE SET
+                    sent_count = sent_count + excluded.sent_count,
+                    received_count = received_count + excluded.received_count,
+                    unread_count = unread_count + excluded.unread_count,
+                    last_rowid = CASE WHEN excluded.last_date >= COALESCE(last_date, 0)
+                        THEN excluded.last_rowid ELSE last_rowid END,
+                    last_is_from_me = CASE WHEN excluded.last_date >= COALESCE(last_date, 0)
+                        THEN excluded.last_is_from_me ELSE last_is_from_me END,
+                    last_handle = CASE WHEN excluded.last_date >= COALESCE(last_date, 0)
+                        THEN excluded.last_handle ELSE last_handle END,
+                    last_text = CASE WHEN excluded.last_date >= COALESCE(last_date, 0)
+                        THEN excluded.last_text ELSE last_text END,
+                    last_date = MAX(COALESCE(last_date, 0), excluded.last_date)
+            """, chat_rows)
+            self.conn.executemany(
+                "UPDATE chat_rollup SET chat_identifier = ?, display_name = ?, "
+                "participants = ?, participant_count = ? WHERE chat_id = ?",
+                [
+                    (identifier, display_name, json.dumps(participants), len(participants), chat_id)
+                    for chat_id, (identifier, display_name, participants) in details.items()
+                ],
+            )
+            self.conn.executemany("""
+                INSERT INTO handle_day (handle, day, sent_count, received_count, last_date)
+                VALUES (?, ?, ?, ?, ?)
+                ON CONFLICT(handle, day) DO UPDATE SET
+                    sent_count = sent_count + excluded.sent_count,
+                    received_count = received_count + excluded.received_count,
+                    last_date = MAX(last_date, excluded.last_date)
+            """, [(h, day, c[0], c[1], c[2]) for (h, day), c in handle_days.items()])
+
+        return len(seen)
+
+    @staticmethod
+    def _chat_details(chat_conn, chat_ids: List[int]) -> Dict[int, Tuple]:
+        """chat_id -> (chat_identifier, display_name, participant handles)."""
+        details: Dict[int, Tuple] = {}
+        for i in range(0, len(chat_ids), 500):
+            batch = chat_ids[i:i + 500]
+            placeholders = ",".join("?" * len(batch))
+            for chat_id, identifier, display_name in chat_conn.execute(
+                f"SELECT ROWID, chat_identifier, display_name FROM chat WHERE ROWID IN ({placeholders})",
+                batch,
+            ):
+                details[chat_id] = (identifier, display_name, [])
+            for chat_id, handle in chat_conn.execute(
+                f"SELECT chj.chat_id, h.id FROM chat_handle_join chj "
+                f"JOIN handle h ON h.ROWID = chj.handle_id WHERE chj.chat_id IN ({placeholders})",
+                batch,
+            ):
+                if chat_id in details:
+                    details[chat_id][2].append(handle)
+        return details
+
+    def _refresh_unread(self, chat_conn):
+        """Recount unread messages for chats that had any (reads happen in place)."""
+        chat_ids = [row[0] for row in self.conn.execute(
+            "SELECT chat_id FROM chat_rollup WHERE unread_count > 0"
+        )]
+        if not chat_ids:
+            return
+
+        counts = {chat_id: 0 for chat_id in chat_ids}
+        max_rowid = self.max_rowid
+        for i in range(0, len(chat_ids), 500):
+            batch = chat_ids[i:i + 500]
+            for chat_id, unread in chat_conn.execute(f"""
+                SELECT cmj.chat_id, COUNT(*)
+                FROM chat_message_join cmj
+                JOIN message m ON m.ROWID = cmj.message_id
+                WHERE cmj.chat_id IN ({','.join('?' * len(batch))})
+                    AND m.ROWID <= ? AND m.is_from_me = 0 AND m.is_read = 0
+                GROUP BY cmj.chat_id
+            """, [*batch, max_rowid]):
+                counts[chat_id] = unread
+
+        with self.conn:
+            self.conn.executemany(
+                "UPDATE chat_rollup SET unread_count = ? WHERE chat_id = ?",
+                [(unread, chat_id) for chat_id, unread in counts.items()],
+            )
+
+    # ----- querying -----
+
+    def _chats(self, where: str, params: List[Any], limit: Optional[int]) -> List[Dict[str, Any]]:
+        sql = f"SELECT {_CHAT_COLUMNS} FROM chat_rollup {where} ORDER BY last_date DESC"
+        if limit is not None:
+            sql += " LIMIT ?"
+            params = [*params, limit]
+        rows = self.conn.execute(sql, params).fetchall()
+        names = [c.strip() for c in _CHAT_COLUMNS.split(",")]
+        chats = []
+        for row in rows:
+            chat = dict(zip(names, row))
+            chat["participants"] = json.loads(chat["participants"])
+            chats.append(chat)
+        return chats
+
+    def conversations(self, limit: int = 20) -> List[Dict[str, Any]]:
+        """Chats ordered by most recent message (rollup column dicts)."""
+        return self._chats("", [], limit)
+
+    def group_chats(self, limit: int = 50) -> List[Dict[str, Any]]:
+        """Group chats (2+ participants) ordered by most recent message."""
+        return self._chats(
+            "WHERE participant_count >= 2 AND (chat_identifier LIKE 'chat%' "
+            "OR (display_name IS NOT NULL AND display_name != ''))",
+            [],
+            limit,
+        )
+
+    def handles(self, since_cocoa: float, limit: Optional[int] = None) -> List[Tuple]:
+        """
+        Handles active since a Cocoa timestamp, most recent first.
+
+        Counts are per whole UTC day, so the window starts at midnight UTC
+        of the day containing `since_cocoa`.
+
+        Returns:
+            (handle, message_count, last_date, sent_count, received_count) tuples
+        """
+        sql = """
+            SELECT handle, SUM(sent_count + received_count), MAX(last_date),
+                   SUM(sent_count), SUM(received_count)
+            FROM handle_day
+            WHERE day >= ?
+            GROUP BY handle
+            ORDER BY MAX(last_date) DESC
+        """
+        params: List[Any] = [int(since_cocoa) // NS_PER_DAY]
+        if limit is not None:
+            sql += " LIMIT ?"
+            params.append(limit)
+        return self.conn.execute(sql, params).fetchall()
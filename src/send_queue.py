@@ -0,0 +1,249 @@
+"""
+Batched iMessage sending through a precompiled AppleScript runner.
+
+send_message() used to build an AppleScript source string per message and
+run it with `osascript -e`, paying process startup, script compilation and
+the Messages.app account lookup for every recipient. SendQueue compiles one
+batch script once (osacompile, cached on disk), hands it many
+(handle, text) pairs per osascript process, and runs a few of those
+processes concurrently.
+
+CS Concept: Amortization and bounded parallelism. Fixed per-process costs
+are paid once per chunk instead of once per message, and a small worker
+pool overlaps chunk startup without flooding Messages.app, which handles
+Apple Events serially anyway.
+
+Handles and texts are passed as argv items rather than spliced into script
+source, so no AppleScript escaping is involved.
+
+The script also logs each message's status to stderr as soon as it is
+known. When a chunk times out or osascript dies partway, those lines say
+which messages went out; the one in flight is reported as possibly sent
+and the rest as not attempted, so a caller retrying failures doesn't send
+anything twice.
+"""
+
+import hashlib
+import logging
+import re
+import subprocess
+import threading
+from concurrent.futures import ThreadPoolExecutor, as_completed
+from pathlib import Path
+from typing import Callable, Dict, Iterable, List, Optional, Sequence, Tuple
+
+logger = logging.getLogger(__name__)
+
+# Results are joined with ASCII record separator so error text may contain newlines
+RESULT_SEPARATOR = "\x1e"
+
+# Per-message progress lines on stderr: RS, status, US
+PROGRESS_RE = re.compile("\x1e(.*?)\x1f", re.DOTALL)
+
+SEND_BATCH_SCRIPT = '''
+on run argv
+    set results to {}
+    tell application "Messages"
+        set targetService to 1st account whose service type = iMessage
+        repeat with i from 1 to (count of argv) by 2
+            try
+                set targetBuddy to participant (item i of argv) of targetService
+                send (item (i + 1) of argv) to targetBuddy
+                set status to "ok"
+            on error errMsg
+                set status to "error: " & errMsg
+            end try
+            log (character id 30) & status & (character id 31)
+            set end of results to status
+        end repeat
+    end tell
+    set AppleScript's text item delimiters to (character id 30)
+    return results as text
+end run
+'''
+
+DEFAULT_CHUNK_SIZE = 20        # Messages per osascript process
+DEFAULT_CONCURRENCY = 2        # osascript processes in flight
+BASE_TIMEOUT = 10.0            # Seconds per chunk, plus...
+PER_MESSAGE_TIMEOUT = 5.0      # ...this much per message in it
+
+DEFAULT_SCRIPT_DIR = Path.home() / ".imessage_rag"
+
+# (argv, timeout) -> (returncode, stdout, stderr)
+Runner = Callable[[List[str], float], Tuple[int, str, str]]
+
+
+def _run_process(argv: List[str], timeout: float) -> Tuple[int, str, str]:
+    result = subprocess.run(argv, capture_output=True, text=True, timeout=timeout)
+    return result.returncode, result.stdout, result.stderr
+
+
+class SendQueue:
+    """
+    Sends batches of iMessages with per-message results.
+
+    Args:
+        script_dir: Where the compiled batch script is cached
+        chunk_size: Messages handed to one osascript process
+        concurrency: osascript processes run at once
+        runner: Process runner (injectable for tests)
+
+    Example:
+        queue = SendQueue()
+        results = queue.send_batch([("+14155551234", "Running late"), ...])
+        failed = [r for r in results if not r["success"]]
+    """
+
+    def __init__(
+        self,
+        script_dir: Optional[Path] = None,
+        chunk_size: int = DEFAULT_CHUNK_SIZE,
+        concurrency: int = DEFAULT_CONCURRENCY,
+        runner: Optional[Runner] = None,
+    ):
+        self.script_dir = Path(script_dir) if script_dir else DEFAULT_SCRIPT_DIR
+        self.chunk_size = max(1, chunk_size)
+        self.concurrency = max(1, concurrency)
+        self._run = runner or _run_process
+        self._compiled: Optional[Path] = None
+        self._compile_failed = False
+        self._compile_lock = threading.Lock()
+
+    def _compiled_script(self) -> Optional[Path]:
+        """Compile SEND_BATCH_SCRIPT once; None means fall back to `osascript -e`."""
+        with self._compile_lock:
+            if self._compiled is not None or self._compile_failed:
+                return self._compiled
+
+            digest = hashlib.sha1(SEND_BATCH_SCRIPT.encode()).hexdigest()[:12]
+            path = self.script_dir / f"send_batch-{digest}.scpt"
+            if not path.exists():
+                try:
+                    self.script_dir.mkdir(parents=True, exist_ok=True)
+                    code, _, stderr = self._run(
+                        ["osacompile", "-o", str(path), "-e", SEND_BATCH_SCRIPT], BASE_TIMEOUT
+                    )
+                    if code != 0:
+                        raise RuntimeError(stderr.strip())
+                except Exception as e:
+                    logger.warning(f"Could not compile send script, using osascript -e: {e}")
+                    self._compile_failed = True
+                    return None
+
+            self._compiled = path
+            return path
+
+    def _command(self, args: List[str]) -> List[str]:
+        script = self._compiled_script()
+        if script is not None:
+            return ["osascript", str(script), *args]
+        return ["osascript", "-e", SEND_BATCH_SCRIPT, *args]
+
+    def _send_chunk(self, chunk: Sequence[Tuple[str, str]]) -> List[Dict]:
+        """Send one chunk through a single osascript process."""
+        args = [value for handle, text in chunk for value in (handle, text)]
+        timeout = BASE_TIMEOUT + PER_MESSAGE_TIMEOUT * len(chunk)
+
+        try:
+            code, stdout, stderr = self._run(self._command(args), timeout)
+        except subprocess.TimeoutExpired as e:
+            logger.error("AppleScript timeout - Messages.app may not be running")
+            return self._interrupted(chunk, e.stderr, "Timeout - ensure Messages.app is running")
+        except Exception as e:
+            logger.error(f"Exception sending messages: {e}")
+            return self._interrupted(chunk, None, str(e))
+
+        if code != 0:
+            error = PROGRESS_RE.sub("", stderr).strip() or f"osascript exited with {code}"
+            logger.error(f"Failed to send messages: {error}")
+            return self._interrupted(chunk, stderr, error)
+
+        statuses = stdout.rstrip("\n").split(RESULT_SEPARATOR)
+        return [
+            _status_result(handle, statuses[i] if i < len(statuses) else "error: no result reported")
+            for i, (handle, _) in enumerate(chunk)
+        ]
+
+    @staticmethod
+    def _interrupted(chunk: Sequence[Tuple[str, str]], stderr, error: str) -> List[Dict]:
+        """
+        Results for a chunk whose process failed before reporting them all.
+
+        Messages with a progress line keep their status. The first one
+        without was in flight when the process stopped and may have gone
+        out; the ones after it were never attempted and are safe to retry.
+        """
+        if isinstance(stderr, bytes):
+            stderr = stderr.decode("utf-8", errors="replace")
+        statuses = PROGRESS_RE.findall(stderr or "")
+        results = []
+        for i, (handle, _) in enumerate(chunk):
+            if i < len(statuses):
+                results.append(_status_result(handle, statuses[i]))
+            elif i == len(statuses):
+                results.append({"handle": handle, "success": False, "possibly_sent": True,
+                                "error": f"{error} (may have been sent)"})
+            else:
+                results.append({"handle": handle, "success": False, "error": f"Not attempted: {error}"})
+        return results
+
+    def send_batch(
+        self,
+        messages: Iterable[Tuple[str, str]],
+        on_result: Optional[Callable[[int, Dict], None]] = None,
+        concurrency: Optional[int] = None,
+    ) -> List[Dict]:
+        """
+        Send (handle, text) pairs with bounded concurrency.
+
+        Args:
+            messages: (phone or email handle, text) pairs
+            on_result: Called with (input index, result) as each chunk
+                finishes, for progress reporting
+            concurrency: osascript processes in flight for this batch
+                (default: the queue's)
+
+        Returns:
+            One {"handle", "success", "error"} dict per message, in input
+            order; "possibly_sent" is set on a failure that may still have
+            been delivered (its process died mid-send), so don't resend it
+            blindly
+        """
+        messages = list(messages)
+        concurrency = max(1, concurrency) if concurrency is not None else self.concurrency
+        chunks = [
+            (start, messages[start:start + self.chunk_size])
+            for start in range(0, len(messages), self.chunk_size)
+        ]
+        results: List[Optional[Dict]] = [None] * len(messages)
+
+        def record(start: int, chunk_results: List[Dict]):
+            for offset, result in enumerate(chunk_results):
+                results[start + offset] = result
+                if on_result is not None:
+                    on_result(start + offset, result)
+
+        if len(chunks) <= 1 or concurrency == 1:
+            for start, chunk in chunks:
+                record(start, self._send_chunk(chunk))
+        else:
+            with ThreadPoolExecutor(max_workers=min(concurrency, len(chunks))) as executor:
+                futures = {executor.submit(self._send_chunk, chunk): start for start, chunk in chunks}
+                for future in as_completed(futures):
+                    record(futures[future], future.result())
+
+        sent = sum(1 for r in results if r["success"])
+        logger.info(f"Sent {sent}/{len(results)} messages")
+        return results
+
+    def send(self, handle: str, text: str) -> Dict:
+        """Send one message; same result shape as send_batch() entries."""
+        return self.send_batch([(handle, text)])[0]
+
+
+def _status_result(handle: str, status: str) -> Dict:
+    """Result dict for one "ok" / "error: ..." status from the batch script."""
+    if status == "ok":
+        return {"handle": handle, "success": True, "error": None}
+    return {"handle": handle, "success": False,
+            "error": status[len("error: "):] if status.startswith("error: ") else status}
@@ -0,0 +1,333 @@
+"""
+Lightweight span tracing for gateway commands and indexing runs.
+
+A trace collects named spans (connect, query, decode, contacts, format
+for gateway commands; fetch, decode, enrich, chunk, embed, store for
+indexing) and reports how much wall time each stage took, so a slow
+`search` or `followup` shows whether SQL, blob decoding, contact
+resolution, embedding or Chroma was responsible.
+
+    with trace("search", root_stage="format") as t:
+        with span("embed"):
+            ...
+    print(t.format_report())
+
+Spans nest; each records its *exclusive* time (its duration minus that of
+the spans inside it), so stage times add up to the trace's elapsed time
+and an outer "fetch" doesn't also count the "decode" it triggered. Time
+not covered by any span is reported under the trace's root_stage.
+
+With no trace active, span() returns a shared no-op context manager and
+traced_iter()/traced() return their argument unchanged, so instrumented
+code costs one ContextVar lookup when nobody is profiling.
+
+The active trace lives in a ContextVar, so a trace started for one
+command is never seen outside it: the daemon runs requests one at a time,
+and each request's trace is reset when its command returns. Threads
+started with asyncio.to_thread copy the context and so record into the
+caller's trace; plain pool workers don't, and their time falls to the
+caller's enclosing span. Each thread keeps its own span stack; spans
+recorded on helper threads overlap the caller's time and are added to the
+totals as-is.
+
+CS Concept: **Exclusive (self) time** - attributing each interval to the
+innermost span open at the time, the same accounting sampling profilers
+use, turns a tree of nested timers into a flat breakdown that sums to
+the total.
+"""
+
+import functools
+import json
+import sys
+import threading
+import time
+import types
+from contextvars import ContextVar
+from datetime import datetime
+from pathlib import Path
+from typing import Any, Dict, Iterable, List, Optional
+
+_clock = time.perf_counter
+
+_current: ContextVar[Optional["Trace"]] = ContextVar("imessage_trace", default=None)
+
+
+def _peak_rss_mb() -> float:
+    """Peak resident set size of this process, 0.0 where unavailable."""
+    try:
+        import resource
+    except ImportError:
+        return 0.0
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # ru_maxrss is bytes on macOS, KiB on Linux
+    return peak / (1024 * 1024) if sys.platform == "darwin" else peak / 1024
+
+
+class Trace:
+    """
+    Per-stage timings for one command or indexing run.
+
+    Args:
+        name: What was traced ("search", "index_imessage", ...)
+        root_stage: Stage that time outside every span is reported under
+    """
+
+    def __init__(self, name: str, root_stage: str = "other"):
+        self.name = name
+        self.root_stage = root_stage
+        self.elapsed_seconds: Optional[float] = None
+        self.memory_used_mb = 0.0
+        self._stages: Dict[str, List[float]] = {}   # stage -> [seconds, calls]
+        self._lock = threading.Lock()
+        self._local = threading.local()
+        self._owner = threading.get_ident()
+        self._covered = 0.0                          # Top-level span time on the owner thread
+        self._rss_start = _peak_rss_mb()
+        self._start = _clock()
+
+    # ----- recording -----
+
+    def _stack(self) -> List[List[Any]]:
+        stack = getattr(self._local, "stack", None)
+        if stack is None:
+            stack = self._local.stack = []
+        return stack
+
+    def _record(self, stage: str, seconds: float, calls: int = 1):
+        with self._lock:
+            entry = self._stages.setdefault(stage, [0.0, 0])
+            entry[0] += seconds
+            entry[1] += calls
+
+    def _enter(self, stage: str):
+        self._stack().append([stage, _clock(), 0.0])
+
+    def _exit(self):
+        stack = self._stack()
+        stage, started, children = stack.pop()
+        elapsed = _clock() - started
+        self._record(stage, elapsed - children)
+        self._add_child_time(elapsed)
+
+    def _add_child_time(self, elapsed: float):
+        """Credit elapsed time to the innermost open span (or the trace root)."""
+        stack = self._stack()
+        if stack:
+            stack[-1][2] += elapsed
+        elif threading.get_ident() == self._owner:
+            self._covered += elapsed
+
+    def _in_span(self) -> bool:
+        return bool(self._stack())
+
+    def _absorb(self, child: "Trace"):
+        """Fold a finished nested trace into this one (same thread)."""
+        for stage, (seconds, calls) in child._stages.items():
+            self._record(stage, seconds, calls)
+        self._add_child_time(child.elapsed_seconds or 0.0)
+
+    def finish(self):
+        """Stop the clock; time outside all spans goes to root_stage."""
+        if self.elapsed_seconds is not None:
+            return
+        self.elapsed_seconds = _clock() - self._start
+        unattributed = self.elapsed_seconds - self._covered
+        if unattributed > 0:
+            self._record(self.root_stage, unattributed, 0)
+        self.memory_used_mb = max(0.0, _peak_rss_mb() - self._rss_start)
+
+    # ----- reporting -----
+
+    @property
+    def stages(self) -> Dict[str, Dict[str, float]]:
+        """Stage -> {"seconds", "calls"}, slowest first."""
+        with self._lock:
+            items = sorted(self._stages.items(), key=lambda item: -item[1][0])
+        return {stage: {"seconds": round(seconds, 6), "calls": calls} for stage, (seconds, calls) in items}
+
+    def stage_seconds(self) -> Dict[str, float]:
+        """Stage -> seconds, slowest first (for stats dicts)."""
+        return {stage: round(info["seconds"], 4) for stage, info in self.stages.items()}
+
+    def format_report(self) -> str:
+        """Human-readable breakdown, one stage per line."""
+        total = self.elapsed_seconds if self.elapsed_seconds is not None else _clock() - self._start
+        lines = [f"Profile: {self.name} ({total * 1000:.1f} ms)"]
+        for stage, info in self.stages.items():
+            share = info["seconds"] / total * 100 if total else 0.0
+            calls = f"{info['calls']} call{'s' if info['calls'] != 1 else ''}" if info["calls"] else ""
+            lines.append(f"  {stage:<10} {info['seconds'] * 1000:>10.1f} ms {share:>6.1f}%  {calls}".rstrip())
+        return "\n".join(lines)
+
+    def to_benchmark_record(self, name: Optional[str] = None, **metrics) -> Dict[str, Any]:
+        """
+        This trace as a benchmarks BenchmarkResult dict.
+
+        Per-stage numbers are flattened into metrics as <stage>_seconds and
+        <stage>_calls so regression comparisons can diff them by key.
+        """
+        flat: Dict[str, Any] = {}
+        for stage, info in self.stages.items():
+            flat[f"{stage}_seconds"] = info["seconds"]
+            flat[f"{stage}_calls"] = info["calls"]
+        flat.update(metrics)
+        return {
+            "name": name or self.name,
+            "elapsed_seconds": self.elapsed_seconds or 0.0,
+            "memory_used_mb": round(self.memory_used_mb, 3),
+            "timestamp": datetime.now().isoformat(),
+            "metrics": flat,
+        }
+
+
+class _Span:
+    __slots__ = ("trace", "stage")
+
+    def __init__(self, trace_: Trace, stage: str):
+        self.trace = trace_
+        self.stage = stage
+
+    def __enter__(self):
+        self.trace._enter(self.stage)
+        return self
+
+    def __exit__(self, *exc):
+        self.trace._exit()
+        return False
+
+
+class _NullSpan:
+    __slots__ = ()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        return False
+
+
+_NULL_SPAN = _NullSpan()
+
+
+def current_trace() -> Optional[Trace]:
+    return _current.get()
+
+
+def active() -> bool:
+    """True when spans are being recorded in this context."""
+    return _current.get() is not None
+
+
+def span(stage: str, outermost: bool = False):
+    """
+    Context manager timing a block as `stage`.
+
+    Args:
+        stage: Stage name
+        outermost: Only record when no other span is open, so wrappers
+            around whole API calls don't split time that inner
+            instrumentation already attributes
+    """
+    t = _current.get()
+    if t is None or (outermost and t._in_span()):
+        return _NULL_SPAN
+    return _Span(t, stage)
+
+
+class trace:
+    """
+    Context manager that activates a new Trace for its block.
+
+    Nested inside another trace, the inner trace's stages are folded into
+    the outer one when it ends, so an index run inside a profiled `index`
+    command shows up in both.
+    """
+
+    def __init__(self, name: str, root_stage: str = "other"):
+        self.trace = Trace(name, root_stage)
+        self._parent: Optional[Trace] = None
+        self._token = None
+
+    def __enter__(self) -> Trace:
+        self._parent = _current.get()
+        self._token = _current.set(self.trace)
+        return self.trace
+
+    def __exit__(self, *exc):
+        _current.reset(self._token)
+        self.trace.finish()
+        if self._parent is not None:
+            self._parent._absorb(self.trace)
+        return False
+
+
+def traced_iter(iterable: Iterable, stage: str, outermost: bool = False) -> Iterable:
+    """
+    Time each step of an iterator as `stage`.
+
+    For lazy pipelines (generators feeding generators), where the work
+    happens when the consumer asks for the next item rather than when the
+    call is made. Returns the iterable itself when no trace is active.
+    """
+    if _current.get() is None:
+        return iterable
+    return _traced_steps(iter(iterable), stage, outermost)
+
+
+def _traced_steps(iterator, stage, outermost):
+    while True:
+        with span(stage, outermost):
+            try:
+                item = next(iterator)
+            except StopIteration:
+                return
+        yield item
+
+
+class _TracedProxy:
+    """Forwards to `target`, timing public method calls as one stage."""
+
+    __slots__ = ("_target", "_stage")
+
+    def __init__(self, target, stage: str):
+        object.__setattr__(self, "_target", target)
+        object.__setattr__(self, "_stage", stage)
+
+    def __getattr__(self, name):
+        value = getattr(self._target, name)
+        if name.startswith("_") or not callable(value):
+            return value
+        stage = self._stage
+
+        @functools.wraps(value)
+        def call(*args, **kwargs):
+            with span(stage, outermost=True):
+                result = value(*args, **kwargs)
+            if isinstance(result, types.GeneratorType):
+                return traced_iter(result, stage, outermost=True)
+            return result
+
+        return call
+
+    def __setattr__(self, name, value):
+        setattr(self._target, name, value)
+
+
+def traced(target, stage: str):
+    """
+    Wrap an object so each public method call is timed as `stage`.
+
+    Calls made while another span is open are left to that span. Returns
+    target unchanged when no trace is active.
+    """
+    if _current.get() is None or target is None:
+        return target
+    return _TracedProxy(target, stage)
+
+
+def append_metrics(path, record: Dict[str, Any]):
+    """Append one record as a JSON line (benchmark_runner.load_benchmark_results reads these)."""
+    path = Path(path).expanduser()
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, "a") as f:
+        f.write(json.dumps(record, default=str) + "\n")
@@ -0,0 +1,69 @@
+"""
+Shared builders for tests that need a hand-made chat.db.
+
+Test modules import these directly (from tests.conftest import ...) so
+every fixture database uses one schema - the subset of the real chat.db
+tables and columns the gateway reads - and one attributedBody encoder.
+"""
+
+import sqlite3
+from pathlib import Path
+from typing import Iterable
+
+CHAT_DB_SCHEMA = """
+    CREATE TABLE handle (ROWID INTEGER PRIMARY KEY, id TEXT);
+    CREATE TABLE chat (ROWID INTEGER PRIMARY KEY, chat_identifier TEXT, display_name TEXT);
+    CREATE TABLE chat_handle_join (chat_id INTEGER, handle_id INTEGER);
+    CREATE TABLE chat_message_join (chat_id INTEGER, message_id INTEGER);
+    CREATE TABLE message (
+        ROWID INTEGER PRIMARY KEY, guid TEXT, text TEXT, attributedBody BLOB, date INTEGER,
+        is_from_me INTEGER, is_read INTEGER DEFAULT 1, handle_id INTEGER, cache_roomnames TEXT,
+        associated_message_type INTEGER DEFAULT 0, associated_message_guid TEXT,
+        associated_message_emoji TEXT, item_type INTEGER DEFAULT 0,
+        is_audio_message INTEGER DEFAULT 0, is_played INTEGER DEFAULT 0,
+        was_data_detected INTEGER DEFAULT 1
+    );
+    CREATE TABLE attachment (
+        ROWID INTEGER PRIMARY KEY, filename TEXT, mime_type TEXT, uti TEXT, total_bytes INTEGER,
+        is_outgoing INTEGER DEFAULT 0, transfer_name TEXT, created_date INTEGER, is_sticker INTEGER DEFAULT 0
+    );
+    CREATE TABLE message_attachment_join (message_id INTEGER, attachment_id INTEGER);
+"""
+
+
+def make_chat_db(path: Path, handles: Iterable[str] = ("+14155551234",), wal: bool = False) -> sqlite3.Connection:
+    """
+    Create an empty chat.db with CHAT_DB_SCHEMA; handles get ROWIDs 1, 2, ...
+
+    Returns the open, writable connection (callers close it).
+    """
+    conn = sqlite3.connect(path)
+    if wal:
+        conn.execute("PRAGMA journal_mode = WAL")
+    conn.executescript(CHAT_DB_SCHEMA)
+    conn.executemany("INSERT INTO handle (ROWID, id) VALUES (?, ?)", enumerate(handles, 1))
+    conn.commit()
+    return conn
+
+
+def encode_length(n: int) -> bytes:
+    """typedstream integer encoding used for string lengths."""
+    if n < 0x80:
+        return bytes([n])
+    if n < 0x10000:
+        return b"\x81" + n.to_bytes(2, "little")
+    return b"\x82" + n.to_bytes(4, "little")
+
+
+def streamtyped_blob(text: str, class_name: bytes = b"NSString") -> bytes:
+    """Build an attributedBody blob the way Messages writes it."""
+    encoded = text.encode("utf-8")
+    return (
+        b"\x04\x0bstreamtyped\x81\xe8\x03\x84\x01@\x84\x84\x84\x12NSAttributedString\x00"
+        b"\x84\x84\x08NSObject\x00\x85\x92\x84\x84\x84"
+        + bytes([len(class_name)]) + class_name
+        + b"\x01\x94\x84\x01+" + encode_length(len(encoded)) + encoded
+        + b"\x86\x84\x02iI\x01\x05\x92\x84\x84\x84\x0cNSDictionary\x00\x94\x84\x01i\x01"
+        b"\x92\x84\x96\x96\x1d__kIMMessagePartAttributeName\x86\x92\x84\x84\x84\x08NSNumber"
+        b"\x00\x84\x84\x07NSValue\x00\x94\x84\x01*\x84\x99\x99\x00\x86\x86\x86"
+    )
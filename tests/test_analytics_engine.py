@@ -0,0 +1,146 @@
+"""
+Unit tests for the single-pass analytics engine and the MessagesInterface
+methods backed by it (analytics, reaction summary, follow-ups).
+"""
+
+import sqlite3
+import sys
+from datetime import datetime, timedelta
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.analytics_engine import AnalyticsEngine, MessageWindow, to_cocoa
+from src.messages_interface import MessagesInterface
+from tests.conftest import make_chat_db
+
+NOW = datetime.now().replace(microsecond=0)
+
+
+def cocoa(hours_ago):
+    return to_cocoa(NOW - timedelta(hours=hours_ago))
+
+
+@pytest.fixture
+def chat_db(tmp_path):
+    path = tmp_path / "chat.db"
+    conn = make_chat_db(path, handles=["+14155551234", "+14155559999"])
+    rows = [
+        # (text, hours_ago, is_from_me, handle, assoc_type)
+        ("Can you send the report?", 100, 0, 1, 0),     # Unanswered question (stale)
+        ("sounds good", 80, 0, 2, 0),
+        ("I'll call you tomorrow", 79, 1, 2, 0),        # Promise + time reference
+        ("let me know when you land", 78, 1, 2, 0),     # Waiting, answered below
+        ("landed!", 77, 0, 2, 0),
+        ("old message", 24 * 60, 0, 1, 0),              # Outside every window
+        (None, 76, 0, 2, 2000),                         # They loved something
+        (None, 75, 1, 2, 2003),                         # I laughed
+        (None, 74, 1, 2, 3003),                         # ...and took it back
+    ]
+    conn.executemany(
+        "INSERT INTO message (text, date, is_from_me, handle_id, associated_message_type) "
+        "VALUES (?, ?, ?, ?, ?)",
+        [(text, cocoa(hours), me, handle, assoc) for text, hours, me, handle, assoc in rows],
+    )
+    conn.executemany("INSERT INTO message_attachment_join VALUES (?, ?)", [(2, 10), (2, 11)])
+    conn.commit()
+    conn.close()
+    return path
+
+
+@pytest.fixture
+def interface(chat_db, tmp_path):
+    mi = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+    yield mi
+    mi.close()
+
+
+def test_window_loads_columns_once(chat_db):
+    conn = sqlite3.connect(chat_db)
+    window = MessageWindow.load(conn, since=NOW - timedelta(days=30))
+    conn.close()
+
+    assert len(window) == 8
+    assert list(window.dates) == sorted(window.dates)
+    assert list(window.attachments).count(2) == 1
+    assert list(window.has_text).count(1) == 5  # Texts themselves are not loaded
+
+
+def test_conversation_analytics(interface):
+    analytics = interface.get_conversation_analytics(days=30)
+
+    assert analytics["total_messages"] == 5
+    assert analytics["sent_count"] == 2
+    assert analytics["received_count"] == 3
+    assert analytics["reaction_count"] == 3
+    assert analytics["attachment_count"] == 2
+    assert sum(analytics["messages_by_hour"]) == 5
+    assert sum(analytics["messages_by_day"].values()) == 5
+    assert analytics["top_contacts"][0] == {"phone": "+14155559999", "message_count": 4}
+
+    response = analytics["response_stats"]
+    assert response["my_reply_count"] == 1 and response["my_median_minutes"] == 60.0
+    assert response["their_reply_count"] == 1 and response["their_avg_minutes"] == 60.0
+
+    single = interface.get_conversation_analytics(phone="5551234", days=30)
+    assert single["total_messages"] == 1
+    assert single["top_contacts"] == []
+
+
+def test_reaction_summary_nets_removals(interface):
+    summary = interface.get_reaction_summary(days=30)
+
+    assert summary["by_type"] == {"love": 1}
+    assert summary["given"] == 0
+    assert summary["received"] == 1
+    assert summary["removals"] == 1
+    assert summary["top_reactors"] == [{"handle": "+14155559999", "reaction_count": 1}]
+
+
+def test_follow_ups(interface):
+    results = interface.detect_follow_up_needed(days=7, min_stale_days=2)
+
+    assert [q["text"] for q in results["unanswered_questions"]] == ["Can you send the report?"]
+    # "let me know" also reads as a promise ("let me ...")
+    assert [p["text"] for p in results["pending_promises"]] == [
+        "let me know when you land", "I'll call you tomorrow",
+    ]
+    assert results["waiting_on_them"] == []  # They replied "landed!"
+    assert [c["phone"] for c in results["stale_conversations"]] == ["+14155551234", "+14155559999"]
+    assert [t["text"] for t in results["time_sensitive"]] == ["I'll call you tomorrow"]
+    assert results["summary"]["total_action_items"] == 5
+
+
+def test_follow_up_reads_text_only_for_recent_candidates():
+    """Only each contact's newest per_contact messages are read and decoded."""
+    window = MessageWindow()
+    for i in range(30):
+        window.rowids.append(i)
+        window.dates.append(to_cocoa(NOW - timedelta(minutes=30 - i)))
+        window.from_me.append(0)
+        window.handles.append("+1")
+        window.assoc_types.append(0)
+        window.attachments.append(0)
+        window.item_types.append(0)
+        window.has_text.append(1)
+
+    fetched_rowids, decoded_rowids = [], []
+
+    def fetch_texts(rowids):
+        fetched_rowids.extend(rowids)
+        return {rowid: (None, b"blob") for rowid in rowids}
+
+    def decode_many(rows):
+        rows = list(rows)
+        decoded_rowids.extend(r[2] for r in rows)
+        return {r[2]: "what time?" for r in rows}
+
+    results = AnalyticsEngine(window, now=NOW).follow_ups(
+        MessagesInterface.FOLLOW_UP_PATTERNS, fetch_texts, decode_many,
+        stale_before=NOW - timedelta(days=2), days=1, per_contact=5,
+    )
+
+    assert sorted(fetched_rowids) == sorted(decoded_rowids) == [25, 26, 27, 28, 29]
+    assert len(results["unanswered_questions"]) == 5
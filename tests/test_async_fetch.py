@@ -0,0 +1,238 @@
+"""
+Unit tests for async paged fetching: backoff, bounded concurrency,
+multi-stream paging and per-stream cursors in index_async().
+"""
+
+import asyncio
+import sys
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.rag.unified.async_fetch import (
+    FetchStream,
+    Page,
+    RetryableError,
+    call_with_backoff,
+    fetch_pages,
+)
+from src.rag.unified.gmail_indexer import GmailIndexer
+from src.rag.unified.slack_indexer import SlackIndexer
+
+
+class FakeStore:
+    def __init__(self):
+        self.ids = {}
+
+    def add_chunks(self, chunks, batch_size=100):
+        new = [c for c in chunks if c.chunk_id not in self.ids]
+        for chunk in new:
+            self.ids[chunk.chunk_id] = chunk
+        return {chunks[0].source: len(new)} if chunks else {}
+
+
+def run(coro):
+    return asyncio.run(coro)
+
+
+async def collect(streams, **kwargs):
+    return [event async for event in fetch_pages(streams, **kwargs)]
+
+
+def test_backoff_retries_transient_errors():
+    delays = []
+    calls = []
+
+    async def fake_sleep(delay):
+        delays.append(delay)
+
+    async def flaky():
+        calls.append(1)
+        if len(calls) < 3:
+            raise RetryableError("429", retry_after=5.0 if len(calls) == 2 else None)
+        return "ok"
+
+    assert run(call_with_backoff(flaky, base_delay=1.0, sleep=fake_sleep)) == "ok"
+    assert len(calls) == 3
+    assert 1.0 <= delays[0] <= 1.25      # base delay, jittered
+    assert delays[1] >= 5.0              # server's Retry-After wins
+
+    async def always_down():
+        raise ConnectionError("down")
+
+    with pytest.raises(ConnectionError):
+        run(call_with_backoff(always_down, retries=2, sleep=fake_sleep))
+
+    async def bad_request():
+        calls.append(1)
+        raise ValueError("400")
+
+    calls.clear()
+    with pytest.raises(ValueError):
+        run(call_with_backoff(bad_request, sleep=fake_sleep))
+    assert len(calls) == 1               # Not retried
+
+
+def make_fetcher(pages_by_key, in_flight=None, peak=None):
+    """Fetcher over {key: [[items], [items], ...]} with numeric page tokens."""
+
+    async def fetch(page_token=None, key=None):
+        if in_flight is not None:
+            in_flight.append(1)
+            peak.append(len(in_flight))
+        await asyncio.sleep(0.001)
+        if in_flight is not None:
+            in_flight.pop()
+        pages = pages_by_key[key]
+        index = int(page_token or 0)
+        next_token = str(index + 1) if index + 1 < len(pages) else None
+        return {"items": pages[index], "next_page_token": next_token}
+
+    return fetch
+
+
+def test_streams_page_concurrently_within_limit():
+    pages = {f"s{n}": [[{"n": n, "p": p}] for p in range(3)] for n in range(6)}
+    in_flight, peak = [], []
+    fetch = make_fetcher(pages, in_flight, peak)
+    streams = [FetchStream(key, fetch, {"key": key}) for key in pages]
+
+    events = run(collect(streams, concurrency=2))
+
+    assert max(peak) == 2
+    done = [e.key for e in events if e.done]
+    assert sorted(done) == sorted(pages)
+    for key in pages:
+        got = [e.page.items[0]["p"] for e in events if e.key == key and e.page]
+        assert got == [0, 1, 2]      # Pages of a stream stay in order
+
+
+def test_failed_stream_reports_error_and_others_finish():
+    good = make_fetcher({"good": [[{"x": 1}], [{"x": 2}]]})
+
+    async def broken(page_token=None):
+        raise RetryableError("503")
+
+    streams = [FetchStream("good", good, {"key": "good"}), FetchStream("bad", broken)]
+    events = run(collect(streams, retries=1, base_delay=0))
+
+    errors = {e.key: e.error for e in events if e.error}
+    assert list(errors) == ["bad"]
+    assert sum(len(e.page.items) for e in events if e.page) == 2
+
+
+def test_page_coerce():
+    assert Page.coerce([{"a": 1}]).next_page_token is None
+    assert Page.coerce({"items": [], "nextPageToken": "t"}).next_page_token == "t"
+
+
+def email(message_id, history_id, label):
+    return {
+        "id": message_id,
+        "historyId": str(history_id),
+        "subject": f"Subject {message_id}",
+        "from": "alice@example.com",
+        "to": "me@example.com",
+        "date": "2024-05-01T10:00:00",
+        "body": f"Body of message {message_id} in {label} with enough words to index.",
+    }
+
+
+def test_gmail_index_async_resumes_per_label(tmp_path):
+    mailbox = {
+        "INBOX": [[email("a", 10, "INBOX"), email("b", 11, "INBOX")], [email("c", 12, "INBOX")]],
+        "SENT": [[email("d", 20, "SENT")]],
+    }
+    calls = []
+
+    async def fetch(page_token=None, label=None, query=None, start_history_id=None):
+        calls.append((label, start_history_id))
+        pages = mailbox[label]
+        index = int(page_token or 0)
+        return {"items": pages[index], "next_page_token": str(index + 1) if index + 1 < len(pages) else None}
+
+    store = FakeStore()
+    indexer = GmailIndexer(gmail_fetcher=fetch, labels=["INBOX", "SENT"],
+                           state_file=tmp_path / "state.json", store=store)
+
+    first = run(indexer.index_async())
+    assert first["success"] and first["items_fetched"] == 4
+    assert len(store.ids) == 4
+    assert indexer.state.get_cursor("gmail")["streams"] == {"INBOX": 12, "SENT": 20}
+
+    # Second run resumes each label from its own watermark; old items are skipped
+    mailbox["INBOX"].append([email("e", 13, "INBOX")])
+    calls.clear()
+    second = run(indexer.index_async())
+    assert ("INBOX", 12) in calls and ("SENT", 20) in calls
+    assert second["items_fetched"] == 1
+    assert indexer.state.get_cursor("gmail")["streams"]["INBOX"] == 13
+
+
+def test_days_window_only_applies_to_first_sync(tmp_path):
+    calls = []
+
+    async def fetch(page_token=None, label=None, query=None, start_history_id=None):
+        calls.append((query, start_history_id))
+        return [email("a", 10, label)] if start_history_id is None else [email("b", 11, label)]
+
+    indexer = GmailIndexer(gmail_fetcher=fetch, labels=["INBOX"],
+                           state_file=tmp_path / "state.json", store=FakeStore())
+    run(indexer.index_async(days=30))
+    assert calls[0][0].startswith("after:") and calls[0][1] is None
+    assert indexer.state.get_cursor("gmail")["streams"] == {"INBOX": 10}
+
+    calls.clear()
+    assert run(indexer.index_async(days=30))["items_fetched"] == 1
+    assert calls == [(None, 10)]
+    assert indexer.state.get_cursor("gmail")["streams"] == {"INBOX": 11}
+
+
+def test_failed_stream_keeps_its_cursor(tmp_path):
+    async def fetch(page_token=None, label=None, query=None, start_history_id=None):
+        if label == "SENT":
+            raise RetryableError("503")
+        return [email("a", 10, label)]
+
+    indexer = GmailIndexer(gmail_fetcher=fetch, labels=["INBOX", "SENT"],
+                           state_file=tmp_path / "state.json", store=FakeStore())
+    result = run(indexer.index_async(retries=0))
+
+    assert result["success"] is False and list(result["errors"]) == ["SENT"]
+    assert indexer.state.get_cursor("gmail")["streams"] == {"INBOX": 10}
+
+
+def test_slack_chunks_each_channel_once_read(tmp_path):
+    def msg(ts, text):
+        return {"ts": f"{ts}.000100", "user": "U1", "text": text}
+
+    history = {
+        "C1": [[msg(1714557600, "Planning the offsite for next month")],
+               [msg(1714557660, "I can book the venue and catering today")]],
+        "C2": [[msg(1714557600, "Release notes are drafted"),
+                msg(1714557700, "Shipping the release after lunch")]],
+    }
+
+    async def fetch(page_token=None, channel=None, oldest=None):
+        pages = history[channel]
+        index = int(page_token or 0)
+        return {"items": pages[index], "next_page_token": str(index + 1) if index + 1 < len(pages) else None}
+
+    store = FakeStore()
+    indexer = SlackIndexer(slack_fetcher=fetch, channels=["C1", "C2"], min_messages=2, min_words=5,
+                           state_file=tmp_path / "state.json", store=store)
+    result = run(indexer.index_async())
+
+    # Both C1 pages land in one time-window chunk, tagged with the channel
+    assert result["chunks_indexed"] == 2
+    assert sorted(c.context_id for c in store.ids.values()) == ["C1", "C2"]
+    assert indexer.state.get_cursor("slack")["streams"] == {
+        "C1": "1714557660.000100", "C2": "1714557700.000100",
+    }
+
+
+def test_no_fetcher_configured(tmp_path):
+    indexer = GmailIndexer(state_file=tmp_path / "state.json", store=FakeStore())
+    assert run(indexer.index_async())["success"] is False
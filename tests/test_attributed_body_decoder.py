@@ -0,0 +1,84 @@
+"""
+Correctness corpus for the streamtyped attributedBody decoder.
+
+Each case is checked against the expected text and, where the old
+multi-pass heuristic got it right, against that output too.
+"""
+
+import plistlib
+import sys
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.messages_interface import (
+    _extract_text_legacy,
+    decode_attributed_bodies,
+    extract_text_from_blob,
+    parse_streamtyped_string,
+)
+from tests.conftest import streamtyped_blob
+
+
+def keyed_archiver_blob(text: str) -> bytes:
+    """NSKeyedArchiver (bplist) form seen on some exported/synced messages."""
+    return plistlib.dumps({
+        "$archiver": "NSKeyedArchiver",
+        "$objects": ["$null", {"NS.string": text}, {"$classname": "NSAttributedString"}],
+        "$top": {"root": 1},
+        "$version": 100000,
+    }, fmt=plistlib.FMT_BINARY)
+
+
+# (name, blob, expected text, legacy output matches?)
+CORPUS = [
+    ("short_ascii", streamtyped_blob("Hello"), "Hello", True),
+    ("sentence", streamtyped_blob("Running late, see you at 7?"), "Running late, see you at 7?", True),
+    ("emoji", streamtyped_blob("On my way 😅🚗"), "On my way 😅🚗", True),
+    ("accented", streamtyped_blob("Café à côté"), "Café à côté", True),
+    ("url", streamtyped_blob("https://example.com/a?b=c"), "https://example.com/a?b=c", True),
+    # Legacy NSMutableString path stopped at the first "i" followed by I/N ("Ed")
+    ("mutable_string", streamtyped_blob("Edited text", b"NSMutableString"), "Edited text", False),
+    ("length_127", streamtyped_blob("x" * 127), "x" * 127, True),
+    # Legacy skipped exactly one length byte, so 0x81/0x82 lengths fell to the regex path
+    ("length_0x81", streamtyped_blob("long message " * 20), ("long message " * 20).strip(), False),
+    ("length_0x82", streamtyped_blob("y" * 70_000), "y" * 70_000, False),
+    # UTF-8 continuation bytes 0x84/0x86 used to be treated as terminators
+    ("cyrillic_0x84", streamtyped_blob("фото"), "фото", False),
+    ("ellipsis_0x86", streamtyped_blob("wait… what"), "wait… what", False),
+    ("keyed_archiver", keyed_archiver_blob("From a bplist"), "From a bplist", True),
+]
+
+
+@pytest.mark.parametrize("name, blob, expected, legacy_ok", CORPUS)
+def test_corpus_decodes_expected_text(name, blob, expected, legacy_ok):
+    """New decoder returns the exact message text for every corpus case."""
+    assert extract_text_from_blob(blob) == expected
+    if legacy_ok:
+        assert _extract_text_legacy(blob) == expected
+
+
+def test_batch_api_matches_single_decode():
+    """decode_attributed_bodies preserves order and handles empty entries."""
+    blobs = [case[1] for case in CORPUS] + [None, b""]
+    expected = [extract_text_from_blob(b) for b in blobs[:-2]] + [None, None]
+    assert decode_attributed_bodies(blobs) == expected
+
+
+def test_truncated_length_falls_back():
+    """A length prefix pointing past the blob end isn't trusted."""
+    blob = streamtyped_blob("Hello there")
+    encoded_at = blob.index(b"Hello there")
+    truncated = blob[:encoded_at - 1] + b"\x50" + blob[encoded_at:encoded_at + 11]
+
+    assert parse_streamtyped_string(truncated) is None
+    assert extract_text_from_blob(truncated) == _extract_text_legacy(truncated)
+
+
+def test_non_text_blobs():
+    """Blobs without a string payload decode to None."""
+    assert extract_text_from_blob(b"") is None
+    assert extract_text_from_blob(None) is None
+    assert parse_streamtyped_string(b"\x04\x0bstreamtyped\x81\xe8\x03\x84\x01@") is None
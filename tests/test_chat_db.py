@@ -0,0 +1,149 @@
+"""
+Unit tests for the pooled read-only chat.db connection.
+"""
+
+import os
+import sqlite3
+import sys
+import threading
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.chat_db import ChatDBConnection
+from src.messages_interface import MessagesInterface
+from tests.conftest import make_chat_db
+
+
+def create_chat_db(path: Path, messages=(("hello", 1),), wal: bool = True):
+    """Create a minimal chat.db with the tables MessagesInterface reads."""
+    conn = make_chat_db(path, wal=wal)
+    for i, (text, is_from_me) in enumerate(messages, 1):
+        conn.execute(
+            "INSERT INTO message (text, date, is_from_me, handle_id) VALUES (?, ?, ?, 1)",
+            (text, i * 1_000_000_000, is_from_me),
+        )
+    conn.commit()
+    return conn
+
+
+def test_connection_is_reused(tmp_path):
+    """Repeated calls share one connection instead of reopening."""
+    db_path = tmp_path / "chat.db"
+    writer = create_chat_db(db_path)
+
+    mi = MessagesInterface(str(db_path))
+    for _ in range(5):
+        assert len(mi.get_recent_messages("4155551234")) == 1
+        assert len(mi.get_all_recent_conversations()) == 1
+
+    assert mi._db.open_count == 1
+    mi.close()
+    writer.close()
+
+
+def test_connection_is_read_only(tmp_path):
+    """query_only prevents accidental writes to chat.db."""
+    db_path = tmp_path / "chat.db"
+    create_chat_db(db_path).close()
+
+    conn = ChatDBConnection(db_path).get()
+    assert conn.execute("PRAGMA query_only").fetchone()[0] == 1
+    with pytest.raises(sqlite3.Error):
+        conn.execute("DELETE FROM message")
+
+
+def test_sees_new_writes_without_reopen(tmp_path):
+    """New messages written to the WAL are visible on the same connection."""
+    db_path = tmp_path / "chat.db"
+    writer = create_chat_db(db_path)
+
+    mi = MessagesInterface(str(db_path))
+    assert len(mi.get_all_recent_conversations()) == 1
+
+    writer.execute("INSERT INTO message (text, date, is_from_me, handle_id) VALUES ('new', 9e9, 0, 1)")
+    writer.commit()
+
+    assert len(mi.get_all_recent_conversations()) == 2
+    assert mi._db.open_count == 1
+    writer.close()
+
+
+def test_survives_wal_checkpoint_without_reopen(tmp_path):
+    """A truncating checkpoint resets the WAL; the open connection keeps up."""
+    db_path = tmp_path / "chat.db"
+    writer = create_chat_db(db_path, messages=[(f"m{i}", 0) for i in range(50)])
+
+    db = ChatDBConnection(db_path)
+    conn = db.get()
+    assert os.path.getsize(str(db_path) + "-wal") > 0
+
+    writer.execute("PRAGMA wal_checkpoint(TRUNCATE)")
+    assert os.path.getsize(str(db_path) + "-wal") == 0
+    writer.execute("INSERT INTO message (text, date, is_from_me, handle_id) VALUES ('after', 9e9, 0, 1)")
+    writer.commit()
+
+    assert db.get() is conn and db.open_count == 1
+    assert conn.execute("SELECT COUNT(*) FROM message").fetchone()[0] == 51
+    writer.close()
+
+
+def test_each_thread_gets_its_own_connection(tmp_path):
+    """sqlite3 connections aren't safe to share, so threads never do."""
+    db_path = tmp_path / "chat.db"
+    writer = create_chat_db(db_path, messages=[(f"m{i}", 0) for i in range(200)])
+    db = ChatDBConnection(db_path)
+    main_conn = db.get()
+
+    seen, errors = [], []
+
+    def worker():
+        try:
+            conn = db.get()
+            assert db.get() is conn
+            for _ in range(50):
+                assert conn.execute("SELECT COUNT(*) FROM message").fetchone()[0] == 200
+            seen.append(conn)
+        except Exception as e:  # Surfaced below; a thread can't fail the test itself
+            errors.append(e)
+
+    threads = [threading.Thread(target=worker) for _ in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    assert not errors
+    assert len({id(c) for c in seen} | {id(main_conn)}) == 5
+    assert db.open_count == 5
+
+    db.close()
+    with pytest.raises(sqlite3.ProgrammingError):
+        main_conn.execute("SELECT 1")
+    assert db.get() is not main_conn and db.open_count == 6
+    writer.close()
+
+
+def test_reopens_when_file_replaced(tmp_path):
+    """Replacing chat.db (new inode) is detected and the new file is read."""
+    db_path = tmp_path / "chat.db"
+    create_chat_db(db_path, messages=[("old", 0)], wal=False).close()
+
+    db = ChatDBConnection(db_path)
+    assert db.get().execute("SELECT text FROM message").fetchone()[0] == "old"
+
+    replacement = tmp_path / "replacement.db"
+    create_chat_db(replacement, messages=[("new", 0)], wal=False).close()
+    os.replace(replacement, db_path)
+
+    assert db.get().execute("SELECT text FROM message").fetchone()[0] == "new"
+    assert db.open_count == 2
+
+
+def test_missing_database_returns_empty(tmp_path):
+    """Methods still degrade to empty results when chat.db is absent."""
+    mi = MessagesInterface(str(tmp_path / "missing.db"))
+    assert mi.get_recent_messages("+14155551234") == []
+    mi.close()
@@ -0,0 +1,175 @@
+"""
+Unit tests for the chat.db watcher: debounced change detection and the
+incremental sidecar/RAG sync it drives.
+"""
+
+import os
+import sys
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.chat_watcher import ChatDBWatcher
+from src.messages_interface import MessagesInterface
+from src.rag.unified.imessage_indexer import ImessageIndexer
+from tests.conftest import make_chat_db
+
+
+class FakeClock:
+    def __init__(self):
+        self.now = 0.0
+
+    def __call__(self):
+        return self.now
+
+
+def touch(path: Path, data: bytes = b"x"):
+    """Append to path so size (and mtime) change even within one clock tick."""
+    with open(path, "ab") as f:
+        f.write(data)
+
+
+@pytest.fixture
+def db_files(tmp_path):
+    db = tmp_path / "chat.db"
+    db.write_bytes(b"")
+    return db
+
+
+def test_burst_is_debounced_into_one_run(db_files):
+    clock = FakeClock()
+    runs = []
+    watcher = ChatDBWatcher(db_files, lambda: runs.append(clock.now), debounce=2.0, clock=clock)
+
+    assert watcher.poll() is False  # Nothing changed yet
+
+    wal = db_files.with_name("chat.db-wal")
+    for t in (0.0, 1.0, 1.5, 3.0):
+        clock.now = t
+        touch(wal)
+        assert watcher.poll() is False
+
+    clock.now = 4.9
+    assert watcher.poll() is False  # Still inside the quiet period after t=3.0
+    clock.now = 5.0
+    assert watcher.poll() is True
+    assert runs == [5.0]
+
+    clock.now = 20.0
+    assert watcher.poll() is False  # Idle database costs nothing
+
+
+def test_max_delay_bounds_latency_under_constant_writes(db_files):
+    clock = FakeClock()
+    runs = []
+    watcher = ChatDBWatcher(db_files, lambda: runs.append(clock.now),
+                            debounce=2.0, max_delay=5.0, clock=clock)
+
+    for step in range(12):
+        clock.now = step * 1.0
+        touch(db_files)
+        watcher.poll()
+
+    assert runs == [5.0, 11.0]
+
+
+def test_handler_errors_do_not_stop_watching(db_files):
+    clock = FakeClock()
+    calls = []
+
+    def flaky():
+        calls.append(clock.now)
+        if len(calls) == 1:
+            raise RuntimeError("store locked")
+
+    watcher = ChatDBWatcher(db_files, flaky, debounce=0.0, clock=clock)
+    touch(db_files)
+    assert watcher.poll() is True
+    clock.now = 1.0
+    touch(db_files)
+    assert watcher.poll() is True
+    assert len(calls) == 2
+
+
+class FakeContacts:
+    def get_contact_by_phone(self, phone):
+        return None
+
+    def resolve_handles(self, handles):
+        return {handle: None for handle in handles}
+
+    def get_contact_by_name(self, name):
+        return None
+
+
+class FakeStore:
+    def __init__(self):
+        self.batches = []
+
+    def add_chunks(self, chunks, batch_size=100):
+        self.batches.append(chunks)
+        return {"imessage": len(chunks)}
+
+    def delete_chunks(self, source, chunk_ids):
+        return len(chunk_ids)
+
+
+@pytest.fixture
+def chat_db(tmp_path):
+    path = tmp_path / "chat.db"
+    conn = make_chat_db(path, wal=True)
+    conn.executescript("""
+        INSERT INTO chat VALUES (1, '+14155551234', '');
+        INSERT INTO chat_handle_join VALUES (1, 1);
+    """)
+    conn.commit()
+    yield path, conn
+    conn.close()
+
+
+def add_messages(conn, count, start=0):
+    for i in range(start, start + count):
+        cursor = conn.execute(
+            "INSERT INTO message (text, date, is_from_me, handle_id) VALUES (?, ?, ?, 1)",
+            (f"message {i} about the climbing trip this weekend", i * 1_000_000_000, i % 2),
+        )
+        conn.execute("INSERT INTO chat_message_join VALUES (1, ?)", (cursor.lastrowid,))
+    conn.commit()
+
+
+def test_watcher_indexes_only_new_rows(chat_db, tmp_path):
+    path, writer = chat_db
+    add_messages(writer, 50)
+
+    mi = MessagesInterface(str(path), sidecar_path=str(tmp_path / "sidecar.db"))
+    indexer = ImessageIndexer(
+        messages_interface=mi,
+        contacts_manager=FakeContacts(),
+        state_file=tmp_path / "state.json",
+        store=FakeStore(),
+    )
+    processed = []
+
+    def on_change():
+        mi.sync_sidecars()
+        processed.append(indexer.index(incremental=True)["messages_processed"])
+
+    clock = FakeClock()
+    watcher = ChatDBWatcher(path, on_change, debounce=1.0, clock=clock)
+    watcher._fire()  # Catch-up run, as run() does on start
+    assert processed == [50]
+
+    add_messages(writer, 3, start=50)
+    clock.now = 1.0
+    assert watcher.poll() is False  # WAL grew; waiting for the burst to settle
+    clock.now = 2.0
+    assert watcher.poll() is True
+    assert processed == [50, 3]
+    assert indexer.state.get_cursor("imessage")["rowid"] == 53
+
+    # Sidecars were synced by the watcher, so queries start up to date
+    assert os.path.exists(tmp_path / "sidecar.db")
+    assert mi.list_conversations(limit=5)[0]["last_message"].startswith("message 52")
+    mi.close()
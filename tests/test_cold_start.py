@@ -0,0 +1,60 @@
+"""
+Unit tests for deferred initialization: package imports stay light, and
+stats/clear on a store never start Chroma or an embedding backend they
+don't need.
+"""
+
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+import src.rag.store as rag_store
+import src.rag.unified.store as unified_store
+from src.rag.unified.store import UnifiedVectorStore
+
+REPO_ROOT = Path(__file__).parent.parent
+
+
+def loaded_modules(code: str) -> set:
+    """Modules in sys.modules after running code in a fresh interpreter."""
+    out = subprocess.run(
+        [sys.executable, "-c", f"import sys; {code}; print('\\n'.join(sys.modules))"],
+        capture_output=True, text=True, cwd=str(REPO_ROOT), check=True,
+    ).stdout
+    return set(out.split())
+
+
+def test_package_import_defers_indexers():
+    modules = loaded_modules("from src.rag.unified import UnifiedRetriever")
+    assert "src.rag.unified.retriever" in modules
+    for name in ("src.rag.unified.gmail_indexer", "src.rag.unified.imessage_indexer",
+                 "src.rag.chunker", "asyncio", "chromadb", "openai"):
+        assert name not in modules, name
+
+
+def test_store_defers_client_and_embedder(tmp_path, monkeypatch):
+    def no_chroma():
+        raise AssertionError("chromadb imported")
+
+    class NoEmbedder:
+        def __init__(self, *args, **kwargs):
+            raise AssertionError("embedder created")
+
+    monkeypatch.setattr(unified_store, "_get_chromadb", no_chroma)
+    monkeypatch.setattr(rag_store, "EmbeddingProvider", NoEmbedder)
+
+    store = UnifiedVectorStore(persist_directory=str(tmp_path / "chroma"))
+    stats = store.get_stats()
+    assert stats["total_chunks"] == 0
+    assert set(stats["by_source"]) == set(unified_store.SOURCE_TYPES)
+    assert store.clear() == 0
+    assert store.loaded_embedder is None
+
+    # Once Chroma has data, the client is opened on demand
+    (tmp_path / "chroma" / "chroma.sqlite3").write_bytes(b"")
+    with pytest.raises(AssertionError, match="chromadb imported"):
+        store.get_stats()
@@ -12,7 +12,8 @@ from pathlib import Path
 import sys
 sys.path.insert(0, str(Path(__file__).parent.parent))
 
-from src.contacts_manager import ContactsManager, Contact
+from src.contacts_cache import ContactsCache, default_cache_path
+from src.contacts_manager import ContactIndex, ContactsManager, Contact
 
 
 @pytest.fixture
@@ -42,6 +43,7 @@ def temp_contacts_file():
 
     # Cleanup
     Path(temp_path).unlink()
+    default_cache_path(Path(temp_path)).unlink(missing_ok=True)
 
 
 def test_load_contacts(temp_contacts_file):
@@ -161,3 +163,120 @@ def test_contact_to_dict():
     assert contact_dict["phone"] == "+11234567890"
     assert contact_dict["relationship_type"] == "other"
     assert contact_dict["notes"] == "Test note"
+
+
+@pytest.fixture
+def synced_contacts_file(tmp_path):
+    """Contacts in the shape scripts/sync_contacts.py writes."""
+    path = tmp_path / "contacts.json"
+    path.write_text(json.dumps({
+        "contacts": [
+            {
+                "name": "Sarah Connor",
+                "phone": "14155551111",
+                "macos_contact_id": "ABC",
+                "all_phones": [
+                    {"label": "mobile", "value": "14155551111"},
+                    {"label": "work", "value": "442079460958"}
+                ],
+                "emails": [{"label": "home", "value": "Sarah@Example.com"}]
+            },
+            {"name": "Sarah Lee", "phone": "(415) 555-2222"},
+            {"name": "Pharmacy", "phone": "72345"}
+        ]
+    }))
+    return path
+
+
+def test_resolve_handles_uses_indexes(synced_contacts_file):
+    """Phones in any format, secondary numbers and emails resolve in one call."""
+    manager = ContactsManager(str(synced_contacts_file))
+
+    resolved = manager.resolve_handles([
+        "+14155551111", "4155552222", "+44 20 7946 0958",
+        "sarah@example.com", "72345", "+19995550000", "4155552222",
+    ])
+
+    names = {handle: c.name if c else None for handle, c in resolved.items()}
+    assert names == {
+        "+14155551111": "Sarah Connor",
+        "4155552222": "Sarah Lee",
+        "+44 20 7946 0958": "Sarah Connor",
+        "sarah@example.com": "Sarah Connor",
+        "72345": "Pharmacy",
+        "+19995550000": None,
+    }
+    assert manager.get_contact_by_phone("") is None
+
+
+def test_name_prefix_index(synced_contacts_file):
+    """Name and token prefixes pick the earliest matching contact."""
+    manager = ContactsManager(str(synced_contacts_file))
+
+    assert manager.get_contact_by_name("sarah").name == "Sarah Connor"
+    assert manager.get_contact_by_name("Lee").name == "Sarah Lee"
+    assert manager.get_contact_by_name("sarah l").name == "Sarah Lee"
+    assert manager.get_contact_by_name("harma").name == "Pharmacy"  # Mid-name fallback
+    assert manager.get_contact_by_exact_name(" sarah lee ").name == "Sarah Lee"
+    assert manager.get_contact_by_exact_name("sarah") is None  # No partial fallback
+
+    manager.add_contact("Leena Park", "+14155553333")
+    assert manager.get_contact_by_name("leen").name == "Leena Park"
+    assert manager.resolve_handles(["4155553333"])["4155553333"].name == "Leena Park"
+
+    # A prefix match beats an earlier contact containing the query mid-name
+    manager.add_contact("Armando Diaz", "+14155554444")
+    assert manager.get_contact_by_name("arm").name == "Armando Diaz"
+
+
+def test_save_preserves_synced_fields(synced_contacts_file):
+    manager = ContactsManager(str(synced_contacts_file))
+    manager.add_contact("New Person", "+14155559999")
+
+    saved = json.loads(synced_contacts_file.read_text())["contacts"][0]
+    assert saved["macos_contact_id"] == "ABC"
+    assert len(saved["all_phones"]) == 2
+
+
+def test_compiled_cache_serves_lookups_without_json(synced_contacts_file, monkeypatch):
+    """A second manager answers from the compiled cache with identical results."""
+    first = ContactsManager(str(synced_contacts_file))
+    assert isinstance(first._index, ContactIndex)
+    assert default_cache_path(synced_contacts_file).exists()
+
+    def no_json(*args, **kwargs):
+        raise AssertionError("contacts.json parsed despite a fresh cache")
+
+    monkeypatch.setattr(json, "load", no_json)
+    second = ContactsManager(str(synced_contacts_file))
+    assert isinstance(second._index, ContactsCache)
+
+    handles = ["+14155551111", "4155552222", "+44 20 7946 0958", "SARAH@example.com",
+               "72345", "555", "+19995550000"]
+    as_names = lambda resolved: {h: c.name if c else None for h, c in resolved.items()}
+    assert as_names(second.resolve_handles(handles)) == as_names(first.resolve_handles(handles))
+    for query in ["sarah", "Lee", "sarah l", "harma", "nobody"]:
+        expected = first.get_contact_by_name(query)
+        actual = second.get_contact_by_name(query)
+        assert (actual.name if actual else None) == (expected.name if expected else None)
+
+    assert second.get_contact_by_phone("14155551111").extra["macos_contact_id"] == "ABC"
+    assert [c.name for c in second.contacts] == [c.name for c in first.contacts]
+
+
+def test_cache_recompiled_when_json_changes(synced_contacts_file):
+    ContactsManager(str(synced_contacts_file))
+
+    data = json.loads(synced_contacts_file.read_text())
+    data["contacts"].append({"name": "Zed Zulu", "phone": "+14155554444"})
+    synced_contacts_file.write_text(json.dumps(data))
+
+    manager = ContactsManager(str(synced_contacts_file))
+    assert isinstance(manager._index, ContactIndex)
+    assert manager.get_contact_by_name("zed").phone == "+14155554444"
+
+    # add_contact on a cache-backed manager saves and recompiles
+    cached = ContactsManager(str(synced_contacts_file))
+    assert isinstance(cached._index, ContactsCache)
+    cached.add_contact("Amy Adams", "+14155556666")
+    assert ContactsManager(str(synced_contacts_file)).get_contact_by_phone("4155556666").name == "Amy Adams"
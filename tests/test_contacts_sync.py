@@ -10,6 +10,8 @@ Tests:
 import pytest
 from src.contacts_sync import (
     FuzzyNameMatcher,
+    NameBlocker,
+    match_contacts,
     normalize_phone_number,
     compare_phone_numbers,
     MacOSContact
@@ -251,6 +253,63 @@ class TestMacOSContact:
         assert contact.email_addresses[0]["value"] == "john@example.com"
 
 
+class TestNameBlocker:
+    """Test trigram candidate generation."""
+
+    def test_only_plausible_names_are_candidates(self):
+        blocker = NameBlocker(["John Doe", "Jon Doe", "Doe John", "Zachary Quinn", "Johnny Doe"])
+
+        candidates = blocker.candidates("John Doe")
+        assert candidates[0] in ("John Doe", "Doe John")  # All trigrams shared
+        assert "Jon Doe" in candidates and "Johnny Doe" in candidates
+        assert "Zachary Quinn" not in candidates
+
+    def test_short_query_matches_longer_name(self):
+        """Overlap is measured against the shorter name, so "John" finds "John Doe"."""
+        assert NameBlocker(["John Doe", "Mary Major"]).candidates("John") == ["John Doe"]
+        assert NameBlocker(["John Doe"]).candidates("  ") == []
+
+
+class DifflibMatcher(FuzzyNameMatcher):
+    """Matcher that works without fuzzywuzzy installed."""
+
+    def is_match(self, name1, name2):
+        from difflib import SequenceMatcher
+        return SequenceMatcher(None, name1.lower(), name2.lower()).ratio() >= self.threshold
+
+
+class TestMatchContacts:
+    """Test pairing synced contacts with contacts.json entries."""
+
+    def test_joins_by_id_then_phone_then_name(self):
+        existing = [
+            {"name": "Jonathan Doe", "phone": "14155551234", "macos_contact_id": "A"},
+            {"name": "Sarah Connor", "phone": "(415) 555-2222"},
+            {"name": "Bob Smith", "phone": ""},
+            {"name": "Alice Wong", "phone": "14155559999"},
+            {"name": "Eve Adams", "phone": ""},
+        ]
+        incoming = [
+            {"name": "Jon Doe", "phone": "", "macos_contact_id": "A"},
+            {"name": "S. Connor", "phone": "14155557777",
+             "all_phones": [{"label": "home", "value": "4155552222"}], "macos_contact_id": "B"},
+            {"name": "Bob Smyth", "phone": "", "macos_contact_id": "C"},
+            {"name": "Someone New", "phone": "14155550000", "macos_contact_id": "D"},
+            {"name": "Eve Adams", "phone": "14155553333", "macos_contact_id": "E"},
+        ]
+
+        pairs = match_contacts(incoming, existing, matcher=DifflibMatcher(threshold=0.8))
+        assert pairs == {0: (0, "id"), 1: (1, "phone"), 2: (2, "fuzzy"), 4: (4, "name")}
+
+    def test_each_existing_entry_matched_once(self):
+        existing = [{"name": "Chris Lee", "phone": ""}]
+        incoming = [
+            {"name": "Chris Lee", "phone": "", "macos_contact_id": "A"},
+            {"name": "Chris Lee", "phone": "", "macos_contact_id": "B"},
+        ]
+        assert match_contacts(incoming, existing, matcher=DifflibMatcher()) == {0: (0, "name")}
+
+
 # Integration test (requires macOS and permissions)
 # Skip by default - run with: pytest --run-integration
 class TestMacOSContactsReader:
@@ -0,0 +1,92 @@
+"""
+Unit tests for the persistent attributedBody decoded-text cache.
+"""
+
+import sys
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+import src.messages_interface as messages_interface
+from src.decoded_text_cache import DecodedTextCache
+from src.messages_interface import MessagesInterface
+from tests.conftest import make_chat_db
+
+
+def fake_decode(blobs):
+    return [blob.decode("utf-8").upper() if blob != b"empty" else None for blob in blobs]
+
+
+def test_decode_many_only_decodes_misses(tmp_path):
+    """Second lookup of the same blobs is served from the cache."""
+    cache = DecodedTextCache(tmp_path / "sidecar.db")
+    calls = []
+
+    def counting_decode(blobs):
+        calls.extend(blobs)
+        return fake_decode(blobs)
+
+    items = [(1, b"hello"), (2, b"world"), (3, b"empty")]
+    assert cache.decode_many(items, counting_decode) == {1: "HELLO", 2: "WORLD", 3: None}
+    assert len(calls) == 3
+
+    assert cache.decode_many(items, counting_decode) == {1: "HELLO", 2: "WORLD", 3: None}
+    assert len(calls) == 3
+    assert cache.stats() == {"hits": 3, "misses": 3, "cached_rows": 3}
+
+
+def test_changed_blob_is_a_miss(tmp_path):
+    """An edited message (new blob, same ROWID) is decoded again."""
+    cache = DecodedTextCache(tmp_path / "sidecar.db")
+    cache.decode_many([(1, b"before")], fake_decode)
+
+    assert cache.get_many([(1, b"after")]) == {}
+    assert cache.decode_many([(1, b"after")], fake_decode) == {1: "AFTER"}
+
+
+def test_cache_persists_and_resets_on_decoder_change(tmp_path):
+    """Cached text survives restarts but not a decoder version bump."""
+    path = tmp_path / "sidecar.db"
+    DecodedTextCache(path, decoder_version=1).decode_many([(1, b"hi")], fake_decode)
+
+    assert DecodedTextCache(path, decoder_version=1).get_many([(1, b"hi")]) == {1: "HI"}
+    assert DecodedTextCache(path, decoder_version=2).get_many([(1, b"hi")]) == {}
+
+
+def test_messages_interface_reuses_cached_text(tmp_path, monkeypatch):
+    """Repeated reads decode each attributedBody blob only once."""
+    db_path = tmp_path / "chat.db"
+    conn = make_chat_db(db_path)
+    for i in range(20):
+        conn.execute(
+            "INSERT INTO message (text, attributedBody, date, is_from_me, handle_id) VALUES (?, ?, ?, 0, 1)",
+            (None if i % 2 else f"plain {i}", f"blob {i}".encode(), i),
+        )
+    conn.commit()
+    conn.close()
+
+    calls = []
+    monkeypatch.setattr(messages_interface, "decode_attributed_bodies",
+                        lambda blobs: [calls.append(b) or b.decode() for b in blobs])
+
+    mi = MessagesInterface(str(db_path), sidecar_path=str(tmp_path / "sidecar.db"))
+    first = mi.get_recent_messages("4155551234", limit=20)
+    assert len(calls) == 10  # Only rows without plain text are decoded
+
+    second = mi.get_all_recent_conversations(limit=20)
+    assert len(calls) == 10
+    assert sorted(m["text"] for m in first) == sorted(m["text"] for m in second)
+    mi.close()
+
+
+def test_unwritable_sidecar_falls_back_to_direct_decode(tmp_path):
+    """A sidecar that can't be opened never breaks message reads."""
+    blocker = tmp_path / "not_a_dir"
+    blocker.write_text("")
+    mi = MessagesInterface(str(tmp_path / "chat.db"), sidecar_path=str(blocker / "sidecar.db"))
+
+    texts = mi._decode_bodies([(None, b"\x04\x0bstreamtyped NSString\x01\x94\x84\x01+\x05hello\x86", 7)])
+    assert texts == {7: "hello"}
+    assert mi._text_cache_failed is True
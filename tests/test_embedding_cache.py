@@ -0,0 +1,159 @@
+"""
+Unit tests for the content-addressed embedding cache.
+"""
+
+import sys
+import threading
+import types
+from collections import OrderedDict
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.rag.embedding_cache import EmbeddingCache, pack_vector, unpack_vector
+from src.rag.store import EmbeddingProvider
+
+
+class CountingProvider(EmbeddingProvider):
+    """EmbeddingProvider with a fake backend that counts computed texts."""
+
+    def __init__(self, cache):
+        self.use_local = True
+        self.model = "fake-model"
+        self.max_retries = 0
+        self._pause_until = 0.0
+        self._pause_lock = threading.Lock()
+        self._cache = cache
+        self._cache_enabled = cache is not None
+        self._query_cache = OrderedDict()
+        self._query_lock = threading.Lock()
+        self.computed = []
+
+    def _compute(self, texts):
+        self.computed.extend(texts)
+        return [[float(len(t)), 0.5] for t in texts]
+
+
+def test_vectors_roundtrip_compactly():
+    vector = [0.1, -0.25, 3.0]
+    assert unpack_vector(pack_vector(vector)) == pytest.approx(vector)
+    assert len(pack_vector(vector, "float16")) == 6
+    assert unpack_vector(pack_vector(vector, "float16"), "float16") == pytest.approx(vector, abs=1e-3)
+
+
+def test_repeated_texts_are_computed_once(tmp_path):
+    """Cache hits skip the backend, across calls and across provider instances."""
+    cache = EmbeddingCache(tmp_path / "cache.db")
+    provider = CountingProvider(cache)
+
+    assert provider.embed(["a", "bb", "a"]) == [[1.0, 0.5], [2.0, 0.5], [1.0, 0.5]]
+    assert provider.computed == ["a", "bb"]
+
+    assert provider.embed_single("bb") == [2.0, 0.5]
+    assert provider.computed == ["a", "bb"]
+
+    other = CountingProvider(EmbeddingCache(tmp_path / "cache.db"))
+    other.embed(["a", "ccc"])
+    assert other.computed == ["ccc"]
+
+
+def test_cache_is_keyed_by_model(tmp_path):
+    cache = EmbeddingCache(tmp_path / "cache.db")
+    cache.put_many("openai:m1", {"hello": [1.0]})
+
+    assert cache.get_many("openai:m1", ["hello"]) == {"hello": [1.0]}
+    assert cache.get_many("local:m2", ["hello"]) == {}
+
+
+def test_stats_report_hit_rates(tmp_path):
+    path = tmp_path / "cache.db"
+    provider = CountingProvider(EmbeddingCache(path))
+    provider.embed(["a", "b"])
+    provider.embed(["a", "b"])
+
+    stats = provider.cache_stats()
+    assert stats["entries"] == 2
+    assert stats["hits"] == 2 and stats["misses"] == 2
+    assert stats["hit_rate"] == 0.5
+
+    # Lifetime counters survive into a new process/instance
+    assert EmbeddingCache(path).stats()["lifetime_hit_rate"] == 0.5
+
+
+def test_lookups_do_not_write(tmp_path):
+    """Hit/miss counts are buffered, so the search path never opens a write transaction."""
+    path = tmp_path / "cache.db"
+    cache = EmbeddingCache(path)
+    cache.put_many("m", {"a": [1.0]})
+    writes = cache.conn.total_changes
+
+    for _ in range(10):
+        assert cache.get_many("m", ["a", "b"]).keys() == {"a"}
+    assert cache.conn.total_changes == writes
+
+    cache.close()
+    assert EmbeddingCache(path).stats()["lifetime_hits"] == 10
+
+
+def test_disabled_cache_always_computes():
+    provider = CountingProvider(None)
+    provider.embed(["a"])
+    provider.embed(["a"])
+    assert provider.computed == ["a", "a"]
+    assert provider.cache_stats() is None
+
+
+def test_query_embeddings_are_normalized_and_kept_in_lru(tmp_path, monkeypatch):
+    """Equivalent queries share an LRU entry; the model sees the query as typed."""
+    cache = EmbeddingCache(tmp_path / "cache.db")
+    provider = CountingProvider(cache)
+    monkeypatch.setattr(EmbeddingProvider, "QUERY_CACHE_SIZE", 2)
+
+    first = provider.embed_query("Dinner  plans ")
+    assert provider.embed_query("dinner plans") == first
+    assert provider.computed == ["Dinner  plans "]
+    assert cache.stats()["hits"] == 0  # Second lookup never reached SQLite
+
+    provider.embed_query("a")
+    provider.embed_query("b")  # Evicts "dinner plans" from the LRU
+    assert list(provider._query_cache) == ["a", "b"]
+
+    provider.embed_query("b ")
+    provider.embed_query("a")  # LRU hit
+    provider.embed_query("Dinner  plans ")
+    assert provider.computed == ["Dinner  plans ", "a", "b"]  # Served from disk
+    assert cache.stats()["hits"] == 1
+
+
+def test_local_model_loads_lazily(tmp_path, monkeypatch):
+    """Constructing a local provider, or a cached query, never loads the model."""
+    loads = []
+
+    class FakeModel:
+        def __init__(self, name):
+            loads.append(name)
+
+        def get_sentence_embedding_dimension(self):
+            return 2
+
+        def encode(self, texts, batch_size, convert_to_numpy):
+            return types.SimpleNamespace(tolist=lambda: [[1.0, 0.0] for _ in texts])
+
+    monkeypatch.setitem(sys.modules, "sentence_transformers",
+                        types.SimpleNamespace(SentenceTransformer=FakeModel))
+    monkeypatch.setattr("importlib.util.find_spec", lambda name: object())
+    monkeypatch.setattr("src.rag.store._sentence_transformers", None)
+
+    cache = EmbeddingCache(tmp_path / "cache.db")
+    cache.put_many("local:all-MiniLM-L6-v2", {"cached query": [0.0, 1.0]})
+    provider = EmbeddingProvider(use_local=True, cache=cache)
+
+    assert provider.embed_query("cached query") == [0.0, 1.0]
+    assert loads == []
+
+    assert provider.embed_query("new query") == [1.0, 0.0]
+    provider.warm_up()
+    assert loads == ["all-MiniLM-L6-v2"]
+    assert provider.dimensions == 2
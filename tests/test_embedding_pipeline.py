@@ -0,0 +1,160 @@
+"""
+Unit tests for pipelined embedding (embed_and_add_pipelined) and the
+OpenAI retry/backoff path in EmbeddingProvider.
+"""
+
+import sys
+import threading
+import time
+from pathlib import Path
+from types import SimpleNamespace
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.rag.store import EmbeddingProvider, embed_and_add_pipelined
+
+
+class Chunk:
+    def __init__(self, i):
+        self.chunk_id = f"c{i}"
+
+    def to_embedding_text(self):
+        return self.chunk_id
+
+    def to_dict(self):
+        return {"i": int(self.chunk_id[1:])}
+
+
+class SlowEmbedder:
+    """Fake embedder: fixed latency per call, tracks peak concurrency."""
+
+    max_concurrency = 4
+
+    def __init__(self, delay=0.05, fail_on=None):
+        self.delay = delay
+        self.fail_on = fail_on
+        self.active = 0
+        self.peak = 0
+        self.lock = threading.Lock()
+
+    def preferred_batch_size(self, requested):
+        return requested
+
+    def embed(self, texts):
+        with self.lock:
+            self.active += 1
+            self.peak = max(self.peak, self.active)
+        try:
+            time.sleep(self.delay)
+            if self.fail_on in texts:
+                raise RuntimeError("embedding failed")
+            return [[float(t[1:])] for t in texts]
+        finally:
+            with self.lock:
+                self.active -= 1
+
+
+class RecordingCollection:
+    def __init__(self):
+        self.added = []
+        self.threads = set()
+
+    def add(self, ids, embeddings, documents, metadatas):
+        self.threads.add(threading.get_ident())
+        assert [[float(i[1:])] for i in ids] == embeddings
+        self.added.extend(ids)
+
+
+def test_batches_embed_concurrently_and_write_in_order():
+    """Embedding overlaps across batches; writes stay ordered on the caller thread."""
+    embedder = SlowEmbedder(delay=0.05)
+    collection = RecordingCollection()
+    chunks = [Chunk(i) for i in range(80)]
+
+    start = time.perf_counter()
+    added = embed_and_add_pipelined(collection, embedder, chunks, batch_size=10, max_in_flight=4)
+    elapsed = time.perf_counter() - start
+
+    assert added == 80
+    assert collection.added == [c.chunk_id for c in chunks]
+    assert collection.threads == {threading.get_ident()}
+    assert 1 < embedder.peak <= 4
+    assert elapsed < 8 * 0.05 * 0.75  # Well under the serial time
+
+
+def test_failure_propagates_after_writing_earlier_batches():
+    embedder = SlowEmbedder(delay=0.01, fail_on="c35")
+    collection = RecordingCollection()
+
+    with pytest.raises(RuntimeError):
+        embed_and_add_pipelined(collection, embedder, [Chunk(i) for i in range(60)],
+                                batch_size=10, max_in_flight=2)
+
+    assert collection.added == [f"c{i}" for i in range(30)]
+
+
+class RateLimitError(Exception):
+    """Stand-in for openai.RateLimitError (matched by class name)."""
+
+    def __init__(self):
+        super().__init__("rate limited")
+        self.status_code = 429
+        self.response = SimpleNamespace(status_code=429, headers={"retry-after": "0.01"})
+
+
+class BadRequestError(Exception):
+    status_code = 400
+
+
+def make_openai_provider(create):
+    provider = EmbeddingProvider.__new__(EmbeddingProvider)
+    provider.use_local = False
+    provider.model = "text-embedding-3-small"
+    provider.max_retries = 3
+    provider._pause_until = 0.0
+    provider._pause_lock = threading.Lock()
+    provider._cache = None
+    provider._cache_enabled = False
+    provider.client = SimpleNamespace(embeddings=SimpleNamespace(create=create))
+    return provider
+
+
+def test_openai_rate_limit_is_retried(monkeypatch):
+    calls = []
+
+    def create(model, input):
+        calls.append(input)
+        if len(calls) < 3:
+            raise RateLimitError()
+        return SimpleNamespace(data=[SimpleNamespace(embedding=[1.0]) for _ in input])
+
+    provider = make_openai_provider(create)
+    assert provider.embed(["a", "b"]) == [[1.0], [1.0]]
+    assert len(calls) == 3
+
+
+def test_openai_client_errors_are_not_retried():
+    calls = []
+
+    def create(model, input):
+        calls.append(input)
+        raise BadRequestError("bad input")
+
+    provider = make_openai_provider(create)
+    with pytest.raises(BadRequestError):
+        provider.embed(["a"])
+    assert len(calls) == 1
+
+
+def test_backend_concurrency_defaults(monkeypatch):
+    provider = make_openai_provider(None)
+    monkeypatch.delenv("IMESSAGE_RAG_EMBED_CONCURRENCY", raising=False)
+    assert provider.max_concurrency == EmbeddingProvider.DEFAULT_OPENAI_CONCURRENCY
+    monkeypatch.setenv("IMESSAGE_RAG_EMBED_CONCURRENCY", "8")
+    assert provider.max_concurrency == 8
+
+    provider.use_local = True
+    assert provider.max_concurrency == 1
+    assert provider.preferred_batch_size(100) == EmbeddingProvider.LOCAL_CALL_BATCH
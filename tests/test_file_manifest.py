@@ -0,0 +1,169 @@
+"""
+Unit tests for the file manifest and the manifest-driven Notes and
+SuperWhisper indexers (changed-only reads, chunk replacement, deletions).
+"""
+
+import json
+import os
+import sys
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.rag.unified.file_manifest import FileManifest, scan_tree
+from src.rag.unified.notes_indexer import NotesIndexer
+from src.rag.unified.superwhisper_indexer import SuperWhisperIndexer
+
+
+class FakeStore:
+    def __init__(self):
+        self.ids = {}
+        self.deleted = []
+
+    def add_chunks(self, chunks, batch_size=100):
+        new = [c for c in chunks if c.chunk_id not in self.ids]
+        for chunk in new:
+            self.ids[chunk.chunk_id] = chunk
+        return {chunks[0].source: len(new)} if chunks else {}
+
+    def delete_chunks(self, source, chunk_ids):
+        self.deleted.extend(chunk_ids)
+        for chunk_id in chunk_ids:
+            self.ids.pop(chunk_id, None)
+        return len(chunk_ids)
+
+
+def bump_mtime(path: Path, seconds: int = 10):
+    stat = path.stat()
+    os.utime(path, ns=(stat.st_atime_ns, stat.st_mtime_ns + seconds * 1_000_000_000))
+
+
+def note(text: str) -> str:
+    return f"# Heading\n\n{text} " + "More words to pass the minimum chunk size. " * 4
+
+
+@pytest.fixture
+def vault(tmp_path):
+    root = tmp_path / "notes"
+    (root / "journals").mkdir(parents=True)
+    (root / "meetings" / "2024").mkdir(parents=True)
+    (root / "journals" / "day1.md").write_text(note("Walked to the park."))
+    (root / "journals" / "day2.md").write_text(note("Cooked dinner."))
+    (root / "meetings" / "2024" / "standup.md").write_text(note("Discussed the launch."))
+    (root / "journals" / "ignore.txt").write_text("not markdown")
+    return root
+
+
+def test_scan_tree_walks_recursively(vault):
+    found = dict(scan_tree(vault, lambda e: e.name.endswith(".md")))
+    assert sorted(found) == [
+        os.path.join("journals", "day1.md"),
+        os.path.join("journals", "day2.md"),
+        os.path.join("meetings", "2024", "standup.md"),
+    ]
+    assert found[os.path.join("journals", "day1.md")].st_size > 0
+
+
+def test_notes_reindex_touches_only_changed_files(vault, tmp_path):
+    store = FakeStore()
+    indexer = NotesIndexer(notes_path=vault, state_file=tmp_path / "state.json", store=store)
+
+    first = indexer.index()
+    assert first["chunks_indexed"] == 3
+    day1_ids = FileManifest(tmp_path / "notes_manifest.json").get(os.path.join("journals", "day1.md"))["chunk_ids"]
+    assert len(day1_ids) == 1
+
+    # Nothing changed: nothing is read
+    read = []
+    original = indexer._load_document
+    indexer._load_document = lambda *args: read.append(args[0]) or original(*args)
+    assert indexer.index()["chunks_found"] == 0
+    assert read == []
+
+    # Touched without edits: read and hashed, but no new chunks or deletions
+    bump_mtime(vault / "journals" / "day2.md")
+    assert indexer.index()["chunks_found"] == 0
+    assert read == [os.path.join("journals", "day2.md")]
+    assert store.deleted == []
+
+    # Edited: its old chunk is replaced; deleted: its chunk is removed
+    edited = vault / "journals" / "day1.md"
+    edited.write_text(note("Walked to the beach instead."))
+    bump_mtime(edited)
+    (vault / "meetings" / "2024" / "standup.md").unlink()
+    result = indexer.index()
+
+    assert result["chunks_indexed"] == 1
+    assert len(store.deleted) == 2 and day1_ids[0] in store.deleted
+    assert sorted(c.metadata["filename"] for c in store.ids.values()) == ["day1", "day2"]
+    assert "beach" in next(c.text for c in store.ids.values() if c.metadata["filename"] == "day1")
+
+    manifest = FileManifest(tmp_path / "notes_manifest.json")
+    assert len(manifest) == 2
+    assert indexer.state.get_cursor("notes") == {"files": 2}
+
+
+def test_edit_past_first_100_chars_is_reindexed(vault, tmp_path):
+    """A date-named note edited near the end of a section gets a new chunk."""
+    store = FakeStore()
+    indexer = NotesIndexer(notes_path=vault, state_file=tmp_path / "state.json", store=store)
+    dated = vault / "journals" / "2024-05-01.md"
+    dated.write_text(note("Long day.") + "Ended at the lake.")
+    indexer.index()
+
+    dated.write_text(note("Long day.") + "Ended at the river.")
+    bump_mtime(dated)
+    assert indexer.index()["chunks_indexed"] == 1
+
+    texts = [c.text for c in store.ids.values() if c.metadata["filename"] == "2024-05-01"]
+    assert len(texts) == 1 and texts[0].endswith("river.")
+
+
+def test_failed_deletion_keeps_manifest_for_retry(vault, tmp_path):
+    store = FakeStore()
+    indexer = NotesIndexer(notes_path=vault, state_file=tmp_path / "state.json", store=store)
+    indexer.index()
+
+    def broken_delete(source, chunk_ids):
+        raise RuntimeError("store unavailable")
+
+    store.delete_chunks = broken_delete
+    (vault / "journals" / "day1.md").unlink()
+    indexer.index()
+    assert len(FileManifest(tmp_path / "notes_manifest.json")) == 3
+
+    del store.delete_chunks
+    indexer.index()
+    assert len(FileManifest(tmp_path / "notes_manifest.json")) == 2
+    assert len(store.deleted) == 1
+
+
+def test_superwhisper_manifest(tmp_path):
+    recordings = tmp_path / "recordings"
+
+    def record(recording_id, text):
+        folder = recordings / recording_id
+        folder.mkdir(parents=True, exist_ok=True)
+        (folder / "meta.json").write_text(json.dumps({
+            "result": text, "datetime": "2024-05-01T10:00:00", "modeName": "Default",
+        }))
+
+    record("1714557600", "Remember to book the dentist appointment")
+    record("1714557700", "Idea for the blog post about indexing")
+    record("1714557800", "")  # Empty transcription, tracked but never chunked
+
+    store = FakeStore()
+    indexer = SuperWhisperIndexer(recordings_path=recordings, state_file=tmp_path / "state.json", store=store)
+    assert indexer.index()["chunks_indexed"] == 2
+    assert indexer.fetch_data() == []
+    assert len(FileManifest(tmp_path / "superwhisper_manifest.json")) == 3
+
+    record("1714557700", "Idea for the blog post about incremental indexing")
+    bump_mtime(recordings / "1714557700" / "meta.json")
+    (recordings / "1714557600" / "meta.json").unlink()
+    assert indexer.index()["chunks_indexed"] == 1
+
+    assert len(store.deleted) == 2
+    assert [c.text for c in store.ids.values()] == ["Idea for the blog post about incremental indexing"]
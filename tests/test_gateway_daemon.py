@@ -0,0 +1,138 @@
+"""
+Unit tests for the resident gateway daemon (gateway/daemon.py).
+"""
+
+import socket
+import sys
+import threading
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from gateway import daemon
+
+
+def fake_runner(argv):
+    """Stand-in for imessage_client.run_command."""
+    if argv and argv[0] == "fail":
+        print("boom", file=sys.stderr)
+        return 3
+    if argv and argv[0] == "usage":
+        raise SystemExit(2)
+    print("ran:" + " ".join(argv))
+    return 0
+
+
+@pytest.fixture
+def running_daemon(tmp_path):
+    """Serve the fake runner on a temporary socket in a background thread."""
+    socket_path = tmp_path / "gw.sock"
+    warmed = []
+    server = daemon.GatewayDaemon(socket_path, fake_runner, warmup=lambda: warmed.append(True))
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+    yield socket_path, server, warmed
+    server.shutdown()
+    server.server_close()
+    thread.join(timeout=5)
+
+
+def test_run_via_daemon_returns_output_and_exit_code(running_daemon):
+    """Commands execute inside the daemon and report their exit code."""
+    socket_path, server, _ = running_daemon
+
+    response = daemon._request({"op": "run", "argv": ["recent", "--limit", "5"]}, socket_path)
+    assert response["exit_code"] == 0
+    assert response["stdout"] == "ran:recent --limit 5\n"
+    assert response["stderr"] == ""
+
+    response = daemon._request({"op": "run", "argv": ["fail"]}, socket_path)
+    assert response["exit_code"] == 3
+    assert response["stderr"] == "boom\n"
+
+
+def test_system_exit_becomes_exit_code(running_daemon):
+    """argparse-style SystemExit does not kill the daemon."""
+    socket_path, server, _ = running_daemon
+
+    response = daemon._request({"op": "run", "argv": ["usage"]}, socket_path)
+    assert response["exit_code"] == 2
+
+    # Daemon still serving afterwards
+    assert daemon.ping(socket_path)["ok"] is True
+
+
+def test_ping_reports_status_and_warmup_runs(running_daemon):
+    """Ping returns pid/command counters; warm-up ran once at startup."""
+    socket_path, server, warmed = running_daemon
+
+    daemon._request({"op": "run", "argv": ["x"]}, socket_path)
+    info = daemon.ping(socket_path)
+
+    assert info["commands"] == 1
+    assert info["socket"] == str(socket_path)
+    assert warmed == [True]
+
+
+def test_socket_is_owner_only(running_daemon):
+    """Socket permissions prevent other users from sending messages."""
+    socket_path, _, _ = running_daemon
+    assert socket_path.stat().st_mode & 0o777 == 0o600
+
+
+def test_fallback_when_no_daemon(tmp_path):
+    """run_via_daemon returns None so the CLI runs in-process."""
+    assert daemon.run_via_daemon(["recent"], socket_path=tmp_path / "missing.sock") is None
+
+
+def test_no_fallback_after_request_is_sent(tmp_path, capsys):
+    """A daemon that dies after reading the request may have run it - never re-run."""
+    socket_path = tmp_path / "gw.sock"
+    listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    listener.bind(str(socket_path))
+    listener.listen(1)
+    received = []
+
+    def accept_and_close():
+        conn, _ = listener.accept()
+        received.append(conn.makefile("rb").readline())
+        conn.close()
+
+    thread = threading.Thread(target=accept_and_close, daemon=True)
+    thread.start()
+    try:
+        assert daemon.run_via_daemon(["send", "Sarah", "hi"], socket_path=socket_path) == 1
+    finally:
+        thread.join(timeout=5)
+        listener.close()
+
+    assert b'"send"' in received[0]
+    assert "failed mid-command" in capsys.readouterr().err
+
+
+def test_stale_socket_is_replaced(tmp_path):
+    """A leftover socket file from a crashed daemon doesn't block startup."""
+    socket_path = tmp_path / "gw.sock"
+    stale = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    stale.bind(str(socket_path))
+    stale.close()  # File remains, nobody listening
+
+    assert daemon.run_via_daemon(["recent"], socket_path=socket_path) is None
+
+    server = daemon.GatewayDaemon(socket_path, fake_runner)
+    try:
+        assert socket_path.exists()
+    finally:
+        server.server_close()
+    assert not socket_path.exists()
+
+
+def test_env_overrides(monkeypatch, tmp_path):
+    """Socket path and opt-out are configurable via environment."""
+    monkeypatch.setenv("IMESSAGE_GATEWAY_SOCKET", str(tmp_path / "custom.sock"))
+    assert daemon.get_socket_path() == tmp_path / "custom.sock"
+
+    monkeypatch.setenv("IMESSAGE_GATEWAY_NO_DAEMON", "1")
+    assert daemon.daemon_disabled() is True
@@ -0,0 +1,175 @@
+"""
+Unit tests for the BM25 chunk keyword index and hybrid (RRF) retrieval.
+"""
+
+import sys
+import threading
+from datetime import datetime
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.rag.unified.chunk import UnifiedChunk
+from src.rag.unified.keyword_index import ChunkKeywordIndex, build_keyword_query
+from src.rag.unified.retriever import UnifiedRetriever, reciprocal_rank_fusion
+from src.rag.unified.store import UnifiedVectorStore
+
+
+def make_chunk(text, source="gmail", day=1, participants=(), tags=(), title=None):
+    return UnifiedChunk(
+        source=source,
+        text=text,
+        title=title,
+        context_id=text[:10],
+        context_type="thread",
+        timestamp=datetime(2024, 3, day),
+        participants=list(participants),
+        tags=list(tags),
+    )
+
+
+@pytest.fixture
+def index(tmp_path):
+    index = ChunkKeywordIndex(tmp_path / "keyword_index.db")
+    index.add_chunks([
+        make_chunk("Your flight UA 837 to Tokyo departs at 11:05", day=2, tags=["travel"]),
+        make_chunk("Flight options for the Tokyo trip next spring", day=3),
+        make_chunk("Dinner at the new ramen place with Sarah", source="imessage", day=4,
+                   participants=["Sarah Smith"]),
+        make_chunk("See https://example.com/itinerary for details", day=5),
+    ])
+    return index
+
+
+def test_build_keyword_query_is_safe():
+    assert build_keyword_query("UA 837") == '"UA" OR "837"'
+    assert build_keyword_query("example.com NEAR(x)") == '"example com" OR "NEAR x"'
+    assert build_keyword_query("  *** ") is None
+
+
+def test_exact_tokens_rank_first(index):
+    hits = index.search("UA 837")
+    assert hits[0][0]["text"].startswith("Your flight UA 837")
+    assert hits[0][1] > 0
+
+    assert index.search("example.com")[0][0]["text"].startswith("See https://example.com")
+
+
+def test_filters_and_idempotent_inserts(index):
+    assert [m["source"] for m, _ in index.search("ramen Sarah", sources=["imessage"])] == ["imessage"]
+    assert index.search("ramen", participants=["Sarah Smith"])
+    assert index.search("ramen", participants=["Sarah"]) == []
+    assert len(index.search("Tokyo", tags=["travel"])) == 1
+    assert len(index.search("Tokyo", min_date=datetime(2024, 3, 3))) == 1
+    undated = make_chunk("Tokyo packing list", source="notes")
+    undated.timestamp = None
+    index.add_chunks([undated])
+    assert len(index.search("Tokyo", min_date=datetime(2024, 3, 3))) == 2  # Undated kept
+    assert len(index.search("Tokyo", max_date=datetime(2024, 3, 2))) == 2
+
+    assert index.add_chunks([make_chunk("Flight options for the Tokyo trip next spring", day=3)]) == 0
+    assert index.count("gmail") == 3
+    index.clear("gmail")
+    assert index.count("gmail") == 0
+    assert index.count("imessage") == 1
+
+
+def test_delete_drops_superseded_chunks(index):
+    stale = make_chunk("Flight options for the Tokyo trip next spring", day=3)
+    assert index.delete([stale.chunk_id, "missing"]) == 1
+    assert [m["text"] for m, _ in index.search("Tokyo")] == ["Your flight UA 837 to Tokyo departs at 11:05"]
+    assert index.count("gmail") == 2
+
+
+def test_reciprocal_rank_fusion_rewards_agreement():
+    semantic = [{"chunk_id": c, "score": 0.9} for c in ["a", "b", "c"]]
+    keyword = [{"chunk_id": c, "score": 0.5} for c in ["c", "d", "a"]]
+
+    fused = reciprocal_rank_fusion({"semantic": semantic, "keyword": keyword}, limit=3)
+
+    assert [r["chunk_id"] for r in fused] == ["a", "c", "b"]
+    assert fused[0]["match"] == "semantic+keyword"
+    assert fused[0]["semantic_rank"] == 1 and fused[0]["keyword_rank"] == 3
+    assert fused[2]["match"] == "semantic"
+    assert 0 < fused[0]["score"] <= 1
+
+
+class FakeCollection:
+    def __init__(self, metadatas):
+        self.metadatas = metadatas
+
+    def count(self):
+        return len(self.metadatas)
+
+    def get(self, include, limit, offset):
+        page = self.metadatas[offset:offset + limit]
+        return {"ids": [m["chunk_id"] for m in page], "metadatas": page}
+
+
+def make_store(tmp_path, collections):
+    store = UnifiedVectorStore.__new__(UnifiedVectorStore)
+    store._collections = collections
+    store._counts = {}
+    store._keyword_path = tmp_path / "keyword_index.db"
+    store._keywords = None
+    store._keywords_failed = False
+    return store
+
+
+def test_keyword_search_backfills_from_chroma(tmp_path):
+    """Chunks indexed before the keyword index existed are searchable."""
+    metas = [make_chunk(f"note {i} about invoices", source="notes").to_dict() for i in range(3)]
+    metas.append(make_chunk("Invoice PR-1234 is overdue", source="notes").to_dict())
+    store = make_store(tmp_path, {"notes": FakeCollection(metas), "gmail": FakeCollection([])})
+
+    results = store.keyword_search("PR-1234", sources=["notes", "gmail"])
+
+    assert results[0]["text"] == "Invoice PR-1234 is overdue"
+    assert results[0]["source"] == "notes"
+    assert 0 < results[0]["score"] < 1
+    assert store._get_keyword_index().count("notes") == 4
+
+
+class FakeStore:
+    def __init__(self, semantic, keyword):
+        self.semantic = semantic
+        self.keyword = keyword
+        self.calls = []
+
+    def search(self, query, limit, **filters):
+        self.calls.append(("semantic", limit, filters))
+        return self.semantic[:limit]
+
+    def keyword_search(self, query, limit, **filters):
+        self.calls.append(("keyword", limit, filters))
+        return self.keyword[:limit]
+
+
+def make_retriever(store):
+    retriever = UnifiedRetriever.__new__(UnifiedRetriever)
+    retriever.store = store
+    return retriever
+
+
+def test_hybrid_mode_fuses_both_rankings():
+    semantic = [{"chunk_id": f"s{i}", "score": 0.8} for i in range(40)]
+    keyword = [{"chunk_id": "k0", "score": 0.9}, {"chunk_id": "s5", "score": 0.7}]
+    store = FakeStore(semantic, keyword)
+
+    results = make_retriever(store).search("UA 837", limit=3, days=7)
+
+    assert [r["chunk_id"] for r in results] == ["s5", "s0", "k0"]
+    assert [c[:2] for c in store.calls] == [("semantic", 30), ("keyword", 30)]
+    assert store.calls[0][2]["min_date"] is not None
+
+    assert make_retriever(store).search("q", limit=2, mode="semantic") == semantic[:2]
+    with pytest.raises(ValueError):
+        make_retriever(store).search("q", mode="fuzzy")
+
+
+def test_hybrid_falls_back_to_semantic_without_keyword_hits():
+    semantic = [{"chunk_id": f"s{i}", "score": 0.8} for i in range(5)]
+    results = make_retriever(FakeStore(semantic, [])).search("q", limit=3)
+    assert results == semantic[:3]
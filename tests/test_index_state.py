@@ -101,3 +101,73 @@ def test_index_state_get_all_states(tmp_path):
     assert "imessage" in all_states
     assert "gmail" in all_states
     assert len(all_states) == 2
+
+
+def test_cursor_roundtrip_and_reserved_key(tmp_path):
+    """Cursors persist alongside timestamps but aren't reported as sources."""
+    state_file = tmp_path / "state.json"
+    state = IndexState(state_file)
+    state.update_cursor("imessage", {"rowid": 482113, "db": "/tmp/chat.db"})
+
+    reloaded = IndexState(state_file)
+    assert reloaded.get_cursor("imessage") == {"rowid": 482113, "db": "/tmp/chat.db"}
+    assert reloaded.get_last_indexed("imessage") is not None
+    assert reloaded.get_cursor("gmail") == {}
+    assert list(reloaded.get_all_states()) == ["imessage"]
+
+    reloaded.reset("imessage")
+    assert IndexState(state_file).get_cursor("imessage") == {}
+
+
+def test_instances_sharing_a_file_keep_each_others_updates(tmp_path):
+    """Saving one source doesn't discard a source saved by another instance."""
+    state_file = tmp_path / "state.json"
+    notes_state = IndexState(state_file)
+    imessage_state = IndexState(state_file)
+
+    imessage_state.update_cursor("imessage", {"rowid": 10})
+    notes_state.update_cursor("notes", {"change_stamp": 5})
+
+    final = IndexState(state_file)
+    assert final.get_cursor("imessage") == {"rowid": 10}
+    assert final.get_cursor("notes") == {"change_stamp": 5}
+
+
+def test_save_is_atomic(tmp_path):
+    """Writes go through a temp file; no partial or leftover files remain."""
+    state_file = tmp_path / "state.json"
+    state = IndexState(state_file)
+    for rowid in range(5):
+        state.update_cursor("imessage", {"rowid": rowid})
+
+    assert [p.name for p in tmp_path.iterdir()] == ["state.json"]
+
+
+class FakeStore:
+    def add_chunks(self, chunks, batch_size=100):
+        return {chunks[0].source: len(chunks)} if chunks else {}
+
+
+def test_notes_cursor_skips_unchanged_files(tmp_path):
+    """Second incremental notes run reads nothing; a touched file is picked up."""
+    import os
+    from src.rag.unified.notes_indexer import NotesIndexer
+
+    notes = tmp_path / "notes" / "journals"
+    notes.mkdir(parents=True)
+    for i in range(3):
+        (notes / f"day{i}.md").write_text(f"# Day {i}\n\n" + "Walked to the park and back again. " * 5)
+
+    indexer = NotesIndexer(
+        notes_path=tmp_path / "notes", state_file=tmp_path / "state.json", store=FakeStore()
+    )
+    assert len(indexer.fetch_data()) == 3
+    indexer.index()
+    assert indexer.fetch_data() == []
+
+    changed = notes / "day1.md"
+    changed.write_text(changed.read_text() + "\nAdded a line.")
+    stat = changed.stat()
+    os.utime(changed, ns=(stat.st_atime_ns, stat.st_mtime_ns + 10_000_000_000))
+    assert [d["filename"] for d in indexer.fetch_data()] == ["day1"]
+    assert len(indexer.fetch_data(incremental=False)) == 3
@@ -0,0 +1,170 @@
+"""
+Unit tests for the sidecar link index and the shared attachment query
+behind extract_links, get_attachments and get_voice_messages.
+"""
+
+import sqlite3
+import sys
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.media_index import MediaIndex, extract_urls
+from src.messages_interface import MessagesInterface
+from tests.conftest import make_chat_db, streamtyped_blob
+
+
+def add_message(conn, text=None, blob=None, date=0, is_from_me=0, handle_id=1, is_audio=0):
+    cur = conn.execute(
+        "INSERT INTO message (text, attributedBody, date, is_from_me, handle_id, is_audio_message) "
+        "VALUES (?, ?, ?, ?, ?, ?)",
+        (text, blob, date, is_from_me, handle_id, is_audio),
+    )
+    conn.commit()
+    return cur.lastrowid
+
+
+def add_attachment(conn, message_id, filename, mime_type, uti="public.data"):
+    cur = conn.execute(
+        "INSERT INTO attachment (filename, mime_type, uti, total_bytes, transfer_name) VALUES (?, ?, ?, ?, ?)",
+        (filename, mime_type, uti, 1024, Path(filename).name),
+    )
+    conn.execute("INSERT INTO message_attachment_join VALUES (?, ?)", (message_id, cur.lastrowid))
+    conn.commit()
+
+
+@pytest.fixture
+def chat_db(tmp_path):
+    """Links in plain text and in blobs, plus image and audio attachments."""
+    path = tmp_path / "chat.db"
+    conn = make_chat_db(path, handles=["+14155551234", "+14155559999"])
+    add_message(conn, text="Read this: https://example.com/a.", date=1_000)
+    add_message(conn, blob=streamtyped_blob("both https://example.com/b and http://example.org/c"), date=2_000)
+    for i in range(20):
+        add_message(conn, blob=streamtyped_blob(f"no links here {i}"), date=3_000 + i)
+    add_message(conn, text="https://example.net/d", date=4_000, handle_id=2, is_from_me=1)
+
+    photo = add_message(conn, date=5_000)
+    add_attachment(conn, photo, "~/Library/Messages/Attachments/photo.jpg", "image/jpeg")
+    memo = add_message(conn, date=6_000, handle_id=2, is_audio=1)
+    add_attachment(conn, memo, "~/Library/Messages/Attachments/memo.caf", None, uti="com.apple.coreaudio-format")
+    song = add_message(conn, date=7_000)
+    add_attachment(conn, song, "~/Library/Messages/Attachments/song.m4a", "audio/mp4")
+    conn.close()
+    return path
+
+
+class CountingDecoder:
+    """decode_many stand-in that records which ROWIDs it was asked to decode."""
+
+    def __init__(self, interface):
+        self.interface = interface
+        self.rowids = []
+
+    def __call__(self, rows):
+        rows = list(rows)
+        self.rowids.extend(row[-1] for row in rows if not row[0])
+        return self.interface._decode_bodies(rows)
+
+
+def test_extract_urls():
+    assert extract_urls("see https://example.com/x). and http://a.b/c?d=1,") == [
+        "https://example.com/x", "http://a.b/c?d=1",
+    ]
+    assert extract_urls("no links") == []
+    assert extract_urls(None) == []
+
+
+def test_sync_decodes_only_blobs_that_mention_http(chat_db, tmp_path):
+    mi = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+    decoder = CountingDecoder(mi)
+    index = MediaIndex(tmp_path / "sidecar.db", source_db=chat_db)
+    conn = sqlite3.connect(chat_db)
+
+    assert index.sync(conn, decode_many=decoder, batch_size=5) == 4
+    assert decoder.rowids == [2]          # The 20 link-free blobs were never decoded
+    assert [link["url"] for link in index.links()] == [
+        "https://example.net/d", "https://example.com/b", "http://example.org/c", "https://example.com/a",
+    ]
+
+    new = add_message(conn, text="late https://example.com/e", date=9_000)
+    assert index.sync(conn, decode_many=decoder) == 1
+    assert index.sync(conn, decode_many=decoder) == 0
+    assert index.links(limit=1)[0]["rowid"] == new
+    conn.close()
+
+
+def test_extract_links_pages_by_rowid(chat_db, tmp_path):
+    mi = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+
+    # limit=2 lands inside message 2; its second link stays on this page
+    first = mi.extract_links(limit=2)
+    assert [link["url"] for link in first] == [
+        "https://example.net/d", "https://example.com/b", "http://example.org/c",
+    ]
+    assert first[0]["is_from_me"] is True and first[0]["sender_handle"] == "+14155559999"
+
+    rest = mi.extract_links(before_rowid=first[-1]["rowid"])
+    assert [link["url"] for link in rest] == ["https://example.com/a"]
+    assert rest[0]["message_text"] == "Read this: https://example.com/a."
+
+    assert [link["url"] for link in mi.extract_links(phone="+14155559999")] == ["https://example.net/d"]
+    assert mi.sync_sidecars()["links"] is True
+
+
+def test_extract_links_scan_fallback_matches_index(chat_db, tmp_path):
+    fast = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+    slow = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "unused.db"))
+    slow._media_index_failed = True
+
+    assert fast.extract_links() == slow.extract_links()
+    assert fast.extract_links(before_rowid=2) == slow.extract_links(before_rowid=2)
+    assert fast.extract_links(limit=2) == slow.extract_links(limit=2)
+
+
+def walk_pages(fetch, rowid_key, limit):
+    """Follow before_rowid cursors until a short page, as the CLI hint does."""
+    items, cursor = [], None
+    while True:
+        page = fetch(before_rowid=cursor, limit=limit)
+        items += page
+        if len(page) < limit:
+            return items
+        cursor = min(item[rowid_key] for item in page)
+
+
+def test_pages_never_split_a_message(chat_db, tmp_path):
+    conn = sqlite3.connect(chat_db)
+    album = add_message(conn, date=8_000)
+    for i in range(3):
+        add_attachment(conn, album, f"~/Library/Messages/Attachments/album{i}.jpg", "image/jpeg")
+    add_message(conn, text="https://example.com/x https://example.com/y https://example.com/z", date=8_500)
+    conn.close()
+
+    fast = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+    slow = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "unused.db"))
+    slow._media_index_failed = True
+
+    for limit in (1, 2, 4):
+        names = [a["transfer_name"] for a in walk_pages(fast.get_attachments, "message_rowid", limit)]
+        assert names == ["album0.jpg", "album1.jpg", "album2.jpg", "song.m4a", "memo.caf", "photo.jpg"]
+        for mi in (fast, slow):
+            urls = [link["url"] for link in walk_pages(mi.extract_links, "rowid", limit)]
+            assert len(urls) == len(set(urls)) == 7, (limit, urls)
+
+
+def test_attachments_and_voice_share_paged_query(chat_db, tmp_path):
+    mi = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+
+    names = [a["transfer_name"] for a in mi.get_attachments()]
+    assert names == ["song.m4a", "memo.caf", "photo.jpg"]
+    assert [a["transfer_name"] for a in mi.get_attachments(mime_type_filter="image/")] == ["photo.jpg"]
+
+    voice = mi.get_voice_messages(limit=1)
+    assert [v["attachment_path"].rsplit("/", 1)[-1] for v in voice] == ["song.m4a"]
+    older = mi.get_voice_messages(before_rowid=voice[0]["message_rowid"])
+    assert [v["attachment_path"].rsplit("/", 1)[-1] for v in older] == ["memo.caf"]
+    assert older[0]["sender_handle"] == "+14155559999"
+    assert mi.get_voice_messages(phone="+14155551234", before_rowid=voice[0]["message_rowid"]) == []
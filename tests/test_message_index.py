@@ -0,0 +1,141 @@
+"""
+Unit tests for the FTS5 keyword index behind MessagesInterface.search_messages.
+"""
+
+import sys
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.message_index import MessageSearchIndex, build_fts_query
+from src.messages_interface import MessagesInterface, extract_text_from_blob
+from tests.conftest import make_chat_db, streamtyped_blob
+
+
+def add_message(conn, text=None, blob=None, date=0, is_from_me=0, handle_id=1, room=None):
+    cur = conn.execute(
+        "INSERT INTO message (text, attributedBody, date, is_from_me, handle_id, cache_roomnames) "
+        "VALUES (?, ?, ?, ?, ?, ?)",
+        (text, blob, date, is_from_me, handle_id, room),
+    )
+    conn.commit()
+    return cur.lastrowid
+
+
+@pytest.fixture
+def chat_db(tmp_path):
+    """chat.db where most text lives only in attributedBody (Ventura+)."""
+    path = tmp_path / "chat.db"
+    conn = make_chat_db(path, handles=["+14155551234", "+14155559999"])
+    # Many recent non-matching blob messages push the match past any SQL LIMIT
+    add_message(conn, blob=streamtyped_blob("Dinner plans at Nopa tonight?"), date=1_000)
+    for i in range(60):
+        add_message(conn, blob=streamtyped_blob(f"unrelated chatter {i}"), date=2_000 + i)
+    add_message(conn, text="dinner was great", date=5_000, handle_id=2)
+    yield path, conn
+    conn.close()
+
+
+@pytest.fixture
+def interface(chat_db, tmp_path):
+    path, _ = chat_db
+    mi = MessagesInterface(str(path), sidecar_path=str(tmp_path / "sidecar.db"))
+    yield mi
+    mi.close()
+
+
+def test_build_fts_query_is_safe():
+    """User input never reaches FTS5 as operator syntax."""
+    assert build_fts_query("dinner plans") == '"dinner plans"*'
+    assert build_fts_query('NEAR("x") OR -y') == '"NEAR x OR y"*'
+    assert build_fts_query("?!") is None
+
+
+def test_finds_attributed_body_matches_beyond_limit(interface):
+    """Blob-only messages are found even when many newer rows don't match."""
+    results = interface.search_messages("dinner plans", limit=5)
+
+    assert len(results) == 1
+    assert results[0]["text"] == "Dinner plans at Nopa tonight?"
+    assert "Dinner plans" in results[0]["match_snippet"]
+
+
+def test_prefix_and_phone_filter(interface):
+    """Last token matches as prefix; phone filter narrows to one handle."""
+    assert len(interface.search_messages("dinn")) == 2
+
+    results = interface.search_messages("dinner", phone="4155559999")
+    assert [r["text"] for r in results] == ["dinner was great"]
+    assert results[0]["phone"] == "+14155559999"
+
+    # LIKE wildcards in the filter are literal, not "any handle"
+    assert interface.search_messages("dinner", phone="%") == []
+    assert interface.search_messages("dinner", phone="415555_999") == []
+
+
+def test_sort_orders(interface):
+    """recent = newest first; relevance = BM25 rank."""
+    recent = interface.search_messages("dinner", sort="recent")
+    assert recent[0]["text"] == "dinner was great"
+
+    relevance = interface.search_messages("dinner", sort="relevance")
+    assert len(relevance) == 2
+
+
+def test_incremental_sync_picks_up_new_messages(chat_db, interface):
+    """New chat.db rows are indexed from the max ROWID watermark."""
+    _, conn = chat_db
+    assert interface.search_messages("sushi") == []
+
+    add_message(conn, blob=streamtyped_blob("sushi on friday"), date=9_000)
+    results = interface.search_messages("sushi")
+
+    assert len(results) == 1
+    assert interface._search_index.max_rowid == conn.execute("SELECT MAX(ROWID) FROM message").fetchone()[0]
+
+
+def test_deleted_messages_are_pruned(chat_db, interface):
+    """Messages deleted from chat.db stop appearing in results."""
+    _, conn = chat_db
+    assert len(interface.search_messages("dinner")) == 2
+
+    conn.execute("DELETE FROM message WHERE text = 'dinner was great'")
+    conn.commit()
+
+    assert [r["text"] for r in interface.search_messages("dinner")] == ["Dinner plans at Nopa tonight?"]
+
+
+def test_index_rebuilds_for_different_source(chat_db, tmp_path):
+    """Pointing the sidecar at another chat.db discards the old index."""
+    path, conn = chat_db
+    sidecar = tmp_path / "shared.db"
+
+    index = MessageSearchIndex(sidecar, source_db=path)
+    index.sync(conn, decode_many=lambda rows: {
+        row[-1]: extract_text_from_blob(row[1]) for row in rows if not row[0] and row[1]
+    })
+    assert index.max_rowid > 0
+
+    other = MessageSearchIndex(sidecar, source_db=tmp_path / "other.db")
+    assert other.max_rowid == 0
+
+
+def test_scan_fallback_applies_limit_after_filter(chat_db, tmp_path):
+    """Without the index, the full scan still returns matches past the SQL LIMIT."""
+    path, _ = chat_db
+    mi = MessagesInterface(str(path), sidecar_path=str(tmp_path / "sidecar.db"))
+    mi._search_index_failed = True
+
+    results = mi.search_messages("Nopa", limit=5)
+    assert len(results) == 1
+    assert "Nopa" in results[0]["match_snippet"]
+    assert mi.search_messages("Nopa", phone="%") == []  # Wildcards escaped here too
+    mi.close()
+
+
+def test_punctuation_only_query_uses_scan(interface):
+    """Queries without word characters can't use FTS5 and fall back to scanning."""
+    results = interface.search_messages("?", limit=5)
+    assert [r["text"] for r in results] == ["Dinner plans at Nopa tonight?"]
@@ -0,0 +1,273 @@
+"""
+Unit tests for the streaming (iter_*) message APIs and the streamed
+iMessage indexing pipeline.
+"""
+
+import sqlite3
+import sys
+from datetime import datetime, timedelta
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.messages_interface import MessageRecord, MessagesInterface
+from src.rag.chunker import ConversationChunker
+from src.rag.unified.imessage_indexer import ImessageIndexer
+from tests.conftest import make_chat_db
+
+NS_PER_HOUR = 3600 * 1_000_000_000
+
+
+@pytest.fixture
+def chat_db(tmp_path):
+    """2,500 messages across two contacts, a few hours apart per burst."""
+    path = tmp_path / "chat.db"
+    conn = make_chat_db(path, handles=["+14155551234", "+14155559999"])
+    # 10 messages per burst, one burst per contact every 12 hours
+    conn.executemany(
+        "INSERT INTO message (text, date, is_from_me, handle_id) VALUES (?, ?, ?, ?)",
+        [
+            (f"message number {i} about the weekend plans", (i // 10) * 12 * NS_PER_HOUR + i,
+             i % 2, 1 + (i // 10) % 2)
+            for i in range(2500)
+        ],
+    )
+    conn.commit()
+    conn.close()
+    return path
+
+
+@pytest.fixture
+def interface(chat_db, tmp_path):
+    mi = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+    yield mi
+    mi.close()
+
+
+def test_iter_messages_pages_by_rowid(interface):
+    """All rows come back once, in ROWID order, across many small pages."""
+    records = list(interface.iter_messages(batch_size=100))
+
+    assert len(records) == 2500
+    assert [r.rowid for r in records] == list(range(1, 2501))
+    assert records[0].get("text") == "message number 0 about the weekend plans"
+    assert records[0]["phone"] == "+14155551234"
+
+
+def test_limit_latest_and_filters(interface):
+    """limit/latest pick the newest rows; since and phone narrow the range."""
+    latest = list(interface.iter_all_recent_conversations(limit=250, batch_size=100))
+    assert [r.rowid for r in latest] == list(range(2251, 2501))
+
+    oldest = list(interface.iter_messages(limit=5, batch_size=2))
+    assert [r.rowid for r in oldest] == [1, 2, 3, 4, 5]
+
+    since = datetime(2001, 1, 1) + timedelta(hours=12 * 240)
+    assert [r.rowid for r in interface.iter_messages_since(since)] == list(range(2401, 2501))
+
+    phone = list(interface.iter_recent_messages("4155559999", limit=15))
+    assert len(phone) == 15
+    assert {r.phone for r in phone} == {"+14155559999"}
+
+
+def test_iterator_matches_list_api(interface):
+    """Streaming records carry the same fields as get_messages_since()."""
+    since = datetime(2001, 1, 1)
+    listed = interface.get_messages_since(since)
+    streamed = [r.to_dict() for r in interface.iter_messages_since(since, batch_size=333)]
+
+    assert len(listed) == len(streamed)
+    for a, b in zip(listed, streamed):
+        b.pop("rowid")
+        assert a == b
+
+
+def test_message_record_dict_access():
+    record = MessageRecord(1, "hi", None, False, "+1", False, None, "+1")
+    assert "_contact_name" not in record
+    record["_contact_name"] = "Alice"
+    assert record.get("_contact_name") == "Alice"
+    assert record.get("display_name") is None
+    with pytest.raises(KeyError):
+        record["unknown"] = 1
+
+
+def test_split_open_windows_carries_recent_windows():
+    """Only a conversation's trailing window near the stream head stays open."""
+    chunker = ConversationChunker(window_hours=4)
+
+    def msg(phone, hour):
+        return {"phone": phone, "date": datetime(2024, 1, 1, hour).isoformat()}
+
+    messages = [msg("a", 0), msg("a", 1), msg("b", 2), msg("a", 9), msg("a", 10), msg("b", 11)]
+    closed, still_open = chunker.split_open_windows(messages)
+
+    # a@9,10 and b@11 may still grow; a@0,1 and b@2 are followed by >4h gaps
+    assert closed == messages[:3]
+    assert still_open == messages[3:]
+    assert chunker.split_open_windows(messages, max_open=3) == (messages, [])
+
+
+class FakeContacts:
+    def get_contact_by_phone(self, phone):
+        return None
+
+    def resolve_handles(self, handles):
+        return {handle: None for handle in handles}
+
+    def get_contact_by_name(self, name):
+        return None
+
+
+class FakeStore:
+    def __init__(self):
+        self.batches = []
+        self.ids = set()
+        self.deleted = []
+
+    def add_chunks(self, chunks, batch_size=100):
+        self.batches.append(chunks)
+        new = {c.chunk_id for c in chunks} - self.ids
+        self.ids |= new
+        return {"imessage": len(new)}
+
+    def delete_chunks(self, source, chunk_ids):
+        self.deleted.extend(chunk_ids)
+        self.ids -= set(chunk_ids)
+        return len(chunk_ids)
+
+
+def test_streamed_index_matches_one_shot_chunking(interface, tmp_path):
+    """Batch-wise chunking with carried-over windows builds the same chunks."""
+    store = FakeStore()
+    indexer = ImessageIndexer(
+        messages_interface=interface,
+        contacts_manager=FakeContacts(),
+        state_file=tmp_path / "state.json",
+        store=store,
+    )
+
+    result = indexer.index(incremental=False, stream_batch_size=97)
+
+    assert result["success"] is True
+    assert result["messages_processed"] == 2500
+    assert len(store.batches) > 1
+
+    streamed_ids = sorted(c.chunk_id for batch in store.batches for c in batch)
+    one_shot = indexer.chunk_data([r.to_dict() for r in interface.iter_messages()])
+    assert streamed_ids == sorted(c.chunk_id for c in one_shot)
+    assert result["chunks_indexed"] == len(one_shot)
+
+
+def test_rowid_cursor_fetches_only_new_rows(chat_db, interface, tmp_path):
+    """Incremental runs resume after the stored ROWID and no-op when idle."""
+    indexer = ImessageIndexer(
+        messages_interface=interface,
+        contacts_manager=FakeContacts(),
+        state_file=tmp_path / "state.json",
+        store=FakeStore(),
+    )
+    assert indexer.index()["messages_processed"] == 2500
+    assert indexer.state.get_cursor("imessage")["rowid"] == 2500
+
+    assert indexer.index()["messages_processed"] == 0
+
+    conn = sqlite3.connect(chat_db)
+    conn.execute("INSERT INTO message (text, date, is_from_me, handle_id) VALUES ('new one', 0, 0, 1)")
+    conn.commit()
+    conn.close()
+
+    assert indexer.index()["messages_processed"] == 1
+    assert indexer.state.get_cursor("imessage")["rowid"] == 2501
+
+
+def test_rowid_cursor_ignored_when_rowids_go_backwards(interface, tmp_path):
+    """A cursor past chat.db's max ROWID (restored database) triggers a full run."""
+    indexer = ImessageIndexer(
+        messages_interface=interface,
+        contacts_manager=FakeContacts(),
+        state_file=tmp_path / "state.json",
+        store=FakeStore(),
+    )
+    indexer.state.update_cursor("imessage", {"rowid": 999_999, "db": str(interface.messages_db_path)})
+
+    assert indexer.index()["messages_processed"] == 2500
+    assert indexer.state.get_cursor("imessage")["rowid"] == 2500
+
+
+def add_rows(chat_db, rows):
+    conn = sqlite3.connect(chat_db)
+    conn.executemany("INSERT INTO message (text, date, is_from_me, handle_id) VALUES (?, ?, ?, ?)", rows)
+    conn.commit()
+    conn.close()
+
+
+def one_shot_ids(indexer, interface):
+    return {c.chunk_id for c in indexer.chunk_data([r.to_dict() for r in interface.iter_messages()])}
+
+
+def test_incremental_run_replaces_only_the_open_window(chat_db, interface, tmp_path):
+    """New messages extend the stored tail window instead of starting a new chunk."""
+    store = FakeStore()
+    indexer = ImessageIndexer(
+        messages_interface=interface,
+        contacts_manager=FakeContacts(),
+        state_file=tmp_path / "state.json",
+        store=store,
+    )
+    indexer.index()
+    windows = indexer.state.get_cursor("imessage")["open_windows"]
+    assert list(windows) == ["+14155559999"]  # Only the newest burst can still grow
+    assert windows["+14155559999"]["rowids"] == list(range(2491, 2501))
+    old_chunk_ids = windows["+14155559999"]["chunk_ids"]
+    assert len(old_chunk_ids) == 1
+
+    # An idle run keeps the window state
+    assert indexer.index()["messages_processed"] == 0
+    assert indexer.state.get_cursor("imessage")["open_windows"] == windows
+
+    last_burst = 249 * 12 * NS_PER_HOUR
+    add_rows(chat_db, [
+        (f"follow up {i} about where to meet for the weekend", last_burst + NS_PER_HOUR + i, 0, 2)
+        for i in range(3)
+    ])
+    result = indexer.index()
+
+    assert result["messages_processed"] == 3
+    assert result["chunks_indexed"] == 1
+    assert store.deleted == old_chunk_ids
+    assert store.batches[-1][0].metadata["message_count"] == 13
+    assert indexer.state.get_cursor("imessage")["open_windows"]["+14155559999"]["rowids"] == \
+        list(range(2491, 2504))
+    assert store.ids == one_shot_ids(indexer, interface)
+
+
+def test_windows_past_the_gap_are_not_reopened(chat_db, interface, tmp_path):
+    """A message days later closes the old window without re-reading it."""
+    store = FakeStore()
+    indexer = ImessageIndexer(
+        messages_interface=interface,
+        contacts_manager=FakeContacts(),
+        state_file=tmp_path / "state.json",
+        store=store,
+    )
+    indexer.index()
+
+    reread = []
+    original = interface.iter_messages
+
+    def spy(*args, **kwargs):
+        if kwargs.get("rowids") is not None:
+            reread.append(kwargs["rowids"])
+        return original(*args, **kwargs)
+
+    interface.iter_messages = spy
+    add_rows(chat_db, [("much later", 260 * 12 * NS_PER_HOUR, 0, 2)])
+
+    assert indexer.index()["messages_processed"] == 1
+    assert reread == []
+    assert store.deleted == []
+    assert store.ids == one_shot_ids(indexer, interface)
+    assert indexer.state.get_cursor("imessage")["open_windows"]["+14155559999"]["rowids"] == [2501]
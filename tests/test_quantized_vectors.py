@@ -0,0 +1,209 @@
+"""
+Unit tests for reduced-dimension collections: quantization codecs, the
+re-rank sidecar, and two-stage search through UnifiedVectorStore.
+"""
+
+import math
+import random
+import sys
+from datetime import datetime
+from pathlib import Path
+from types import SimpleNamespace
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+import src.rag.store as rag_store
+import src.rag.unified.store as unified_store
+from src.rag.unified.chunk import UnifiedChunk
+from src.rag.unified.quantized_vectors import (
+    RerankVectorStore,
+    VectorConfig,
+    cosine,
+    dequantize,
+    quantize,
+    truncate,
+)
+from src.rag.unified.store import UnifiedVectorStore
+
+
+def unit(vector):
+    norm = math.sqrt(sum(x * x for x in vector))
+    return [x / norm for x in vector]
+
+
+@pytest.mark.parametrize("storage, size, tolerance", [
+    ("float32", 64 * 4, 1e-6),
+    ("float16", 64 * 2, 1e-3),
+    ("int8", 64 + 4, 1e-2),
+])
+def test_quantize_round_trip(storage, size, tolerance):
+    rng = random.Random(7)
+    vector = unit([rng.gauss(0, 1) for _ in range(64)])
+    blob = quantize(vector, storage)
+    assert len(blob) == size
+    decoded = dequantize(blob, storage)
+    assert max(abs(a - b) for a, b in zip(vector, decoded)) < tolerance
+    assert cosine(vector, decoded) > 0.999
+
+
+def test_truncate_renormalizes():
+    assert truncate([3.0, 4.0, 12.0], 2) == [0.6, 0.8]
+    assert truncate([0.0, 0.0, 1.0], 2) == [0.0, 0.0]
+
+
+def test_vector_config_metadata():
+    config = VectorConfig(dimensions=256, rerank_storage="int8")
+    assert VectorConfig.from_metadata({"hnsw:space": "cosine", **config.to_metadata()}) == config
+    assert VectorConfig.from_metadata({"hnsw:space": "cosine"}) == VectorConfig()
+    assert not VectorConfig().reduced
+    with pytest.raises(ValueError):
+        VectorConfig(dimensions=64, rerank_storage="int4")
+
+
+def test_rerank_store(tmp_path):
+    store = RerankVectorStore(tmp_path / "rerank.db")
+    store.put_many("notes", "int8", {"a": [1.0, 0.0], "b": [0.0, 1.0]})
+    store.put_many("gmail", "float16", {"a": [0.5, 0.5]})
+
+    assert sorted(store.get_many("notes", ["a", "b", "missing"])) == ["a", "b"]
+    assert store.get_many("gmail", ["a"])["a"] == [0.5, 0.5]
+    store.delete("notes", ["a"])
+    assert store.stats("notes") == {"vectors": 1, "bytes": 2 + 4}
+    store.clear("gmail")
+    assert store.get_many("gmail", ["a"]) == {}
+
+
+# Hand-made 4-dim embeddings: the first two dimensions alone rank "beta"
+# above "alpha" for the query, the full vectors rank "alpha" first
+VECTORS = {
+    "query": unit([1.0, 0.0, 1.0, 0.0]),
+    "alpha": unit([0.9, 0.3, 1.0, 0.0]),
+    "beta": unit([1.0, 0.0, -0.2, 0.0]),
+    "gamma": unit([0.0, 1.0, 0.0, 1.0]),
+}
+
+
+class FakeEmbedder:
+    max_concurrency = 1
+
+    def __init__(self, use_local=False):
+        pass
+
+    def preferred_batch_size(self, requested):
+        return requested
+
+    def embed(self, texts):
+        return [VECTORS[text.split()[-1]] for text in texts]
+
+    def embed_query(self, query):
+        return VECTORS[query]
+
+
+class FakeCollection:
+    """Exact cosine ranking over whatever vectors were written."""
+
+    def __init__(self, metadata):
+        self.metadata = metadata
+        self.rows = {}
+
+    def count(self):
+        return len(self.rows)
+
+    def get(self, ids=None, include=None, **kwargs):
+        ids = [i for i in ids or self.rows if i in self.rows]
+        return {"ids": ids, "metadatas": [self.rows[i][2] for i in ids]}
+
+    def add(self, ids, embeddings, documents, metadatas):
+        for row in zip(ids, embeddings, documents, metadatas):
+            self.rows[row[0]] = row[1:]
+
+    def delete(self, ids):
+        for chunk_id in ids:
+            self.rows.pop(chunk_id, None)
+
+    def query(self, query_embeddings, n_results, include, where=None):
+        ranked = sorted(self.rows.items(), key=lambda kv: -cosine(query_embeddings[0], kv[1][0]))[:n_results]
+        return {
+            "ids": [[cid for cid, _ in ranked]],
+            "documents": [[row[1] for _, row in ranked]],
+            "metadatas": [[row[2] for _, row in ranked]],
+            "distances": [[1 - cosine(query_embeddings[0], row[0]) for _, row in ranked]],
+        }
+
+
+class FakeClient:
+    def __init__(self, path):
+        self.collections = {}
+
+    def get_collection(self, name):
+        if name not in self.collections:
+            raise ValueError(f"Collection {name} does not exist")
+        return self.collections[name]
+
+    def get_or_create_collection(self, name, metadata):
+        return self.collections.setdefault(name, FakeCollection(metadata))
+
+    def delete_collection(self, name):
+        del self.collections[name]
+
+
+@pytest.fixture
+def make_store(tmp_path, monkeypatch):
+    client = FakeClient(tmp_path)
+    monkeypatch.setattr(unified_store, "_get_chromadb", lambda: SimpleNamespace(PersistentClient=lambda path: client))
+    monkeypatch.setattr(rag_store, "EmbeddingProvider", FakeEmbedder)
+
+    def make(**kwargs):
+        store = UnifiedVectorStore(persist_directory=str(tmp_path / "chroma"), **kwargs)
+        store._keywords_failed = True  # Vector search only
+        return store
+
+    return make
+
+
+def chunks(*names):
+    return [
+        UnifiedChunk(source="notes", text=f"note about {name}", context_id=name,
+                     context_type="document", timestamp=datetime(2024, 1, 1))
+        for name in names
+    ]
+
+
+def test_reduced_collection_reranks_with_full_vectors(make_store):
+    store = make_store(vector_config={"notes": VectorConfig(dimensions=2, rerank_storage="int8")})
+    assert store.add_chunks(chunks("alpha", "beta", "gamma")) == {"notes": 3}
+
+    collection = store._collections["notes"]
+    assert {len(row[0]) for row in collection.rows.values()} == {2}   # Chroma got truncated vectors
+
+    # Truncated space alone would put beta first
+    first_stage = collection.query([truncate(VECTORS["query"], 2)], 1, include=[])
+    assert first_stage["documents"][0][0].endswith("note about beta")
+
+    results = store.search("query", sources=["notes"], limit=2)
+    assert [r["context_id"] for r in results] == ["alpha", "beta"]
+    assert results[0]["score"] == pytest.approx(cosine(VECTORS["query"], VECTORS["alpha"]), abs=0.01)
+
+    stats = store.get_stats("notes")["by_source"]["notes"]["vectors"]
+    assert stats["dimensions"] == 2 and stats["vectors"] == 3
+
+    store.delete_chunks("notes", [chunks("alpha")[0].chunk_id])
+    assert [r["context_id"] for r in store.search("query", sources=["notes"], limit=1)] == ["beta"]
+    assert store._get_rerank_store().stats("notes")["vectors"] == 2
+
+
+def test_existing_collection_keeps_its_layout(make_store):
+    full = make_store()
+    full.add_chunks(chunks("alpha"))
+
+    reopened = make_store(vector_config=VectorConfig(dimensions=2))
+    reopened.add_chunks(chunks("beta"))
+    assert {len(row[0]) for row in reopened._collections["notes"].rows.values()} == {4}
+    assert not reopened._configs["notes"].reduced
+
+    # Clearing the source lets it be rebuilt with the requested layout
+    reopened.clear("notes")
+    reopened.add_chunks(chunks("gamma"))
+    assert {len(row[0]) for row in reopened._collections["notes"].rows.values()} == {2}
@@ -0,0 +1,148 @@
+"""
+Unit tests for the sidecar conversation rollups and the listing methods
+served from them (conversations, groups, handles, unknown senders).
+"""
+
+import sqlite3
+import sys
+from datetime import datetime
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.messages_interface import MessagesInterface
+from src.rollup_store import ConversationRollups
+from tests.conftest import make_chat_db
+
+NS_PER_HOUR = 3600 * 1_000_000_000
+NOW_COCOA = int((datetime.now() - datetime(2001, 1, 1)).total_seconds()) * 1_000_000_000
+
+
+@pytest.fixture
+def chat_db(tmp_path):
+    """Two 1:1 chats and one group; messages over the last 10 days."""
+    path = tmp_path / "chat.db"
+    conn = make_chat_db(path, handles=["+14155551234", "+14155559999", "promo@example.com"])
+    conn.executescript("""
+        INSERT INTO chat VALUES
+            (1, '+14155551234', ''), (2, 'promo@example.com', ''), (3, 'chat123456', 'Climbing');
+        INSERT INTO chat_handle_join VALUES (1, 1), (2, 3), (3, 1), (3, 2);
+    """)
+    conn.commit()
+    conn.close()
+    return path
+
+
+def add_message(path, chat_id, handle_id, hours_ago, text, is_from_me=0, is_read=1):
+    conn = sqlite3.connect(path)
+    cursor = conn.execute(
+        "INSERT INTO message (text, date, is_from_me, is_read, handle_id) VALUES (?, ?, ?, ?, ?)",
+        (text, NOW_COCOA - hours_ago * NS_PER_HOUR, is_from_me, is_read, handle_id),
+    )
+    conn.execute("INSERT INTO chat_message_join VALUES (?, ?)", (chat_id, cursor.lastrowid))
+    conn.commit()
+    conn.close()
+    return cursor.lastrowid
+
+
+@pytest.fixture
+def populated(chat_db):
+    add_message(chat_db, 1, 1, 200, "old hello")
+    add_message(chat_db, 1, 1, 5, "see you soon", is_from_me=1)
+    add_message(chat_db, 2, 3, 30, "50% off today", is_read=0)
+    add_message(chat_db, 3, 2, 3, "who's in for saturday?", is_read=0)
+    add_message(chat_db, 3, 1, 2, "me!", is_read=0)
+    return chat_db
+
+
+def make_interface(path, tmp_path, name="sidecar.db"):
+    return MessagesInterface(str(path), sidecar_path=str(tmp_path / name))
+
+
+def test_rollups_build_and_fold_in_new_rows(populated, tmp_path):
+    conn = sqlite3.connect(populated)
+    rollups = ConversationRollups(tmp_path / "sidecar.db", source_db=populated)
+    assert rollups.sync(conn, decode_many=lambda rows: {}, batch_size=2) == 5
+
+    chats = {c["chat_id"]: c for c in rollups.conversations()}
+    assert [c["chat_id"] for c in rollups.conversations()] == [3, 1, 2]
+    assert chats[1]["last_text"] == "see you soon"
+    assert (chats[1]["sent_count"], chats[1]["received_count"]) == (1, 1)
+    assert chats[3]["participants"] == ["+14155551234", "+14155559999"]
+    assert chats[3]["unread_count"] == 2
+
+    add_message(populated, 2, 3, 0, "last chance!", is_read=0)
+    assert rollups.sync(conn, decode_many=lambda rows: {}) == 1
+    assert rollups.sync(conn, decode_many=lambda rows: {}) == 0
+    assert rollups.conversations(limit=1)[0]["last_text"] == "last chance!"
+    assert rollups.conversations(limit=1)[0]["unread_count"] == 2
+    conn.close()
+
+
+def test_unread_counts_follow_in_place_reads(populated, tmp_path):
+    conn = sqlite3.connect(populated)
+    rollups = ConversationRollups(tmp_path / "sidecar.db", source_db=populated)
+    rollups.sync(conn, decode_many=lambda rows: {})
+
+    writer = sqlite3.connect(populated)
+    writer.execute("UPDATE message SET is_read = 1 WHERE text = 'me!'")
+    writer.commit()
+    writer.close()
+
+    rollups.sync(conn, decode_many=lambda rows: {})
+    chats = {c["chat_id"]: c for c in rollups.conversations()}
+    assert chats[3]["unread_count"] == 1
+    conn.close()
+
+
+def test_listing_methods_match_full_scans(populated, tmp_path):
+    """Rollup-served results equal the GROUP BY fallback."""
+    fast = make_interface(populated, tmp_path)
+    slow = make_interface(populated, tmp_path, name="unused.db")
+    slow._rollups_failed = True
+
+    try:
+        assert fast.list_group_chats() == slow.list_group_chats()
+        assert fast.list_group_chats()[0]["display_name"] == "Climbing"
+        assert fast.list_conversations() == slow.list_conversations()
+        assert fast.list_recent_handles(days=3) == slow.list_recent_handles(days=3)
+        assert [h["handle"] for h in fast.list_recent_handles(days=30)] == [
+            "+14155551234", "+14155559999", "promo@example.com",
+        ]
+        unknown = fast.search_unknown_senders(known_phones=["+1 (415) 555-1234"], days=30)
+        assert [u["handle"] for u in unknown] == ["+14155559999", "promo@example.com"]
+    finally:
+        fast.close()
+        slow.close()
+
+    assert fast._rollups is not None
+
+
+def test_conversation_listing_shape(populated, tmp_path):
+    mi = make_interface(populated, tmp_path)
+    try:
+        conversations = mi.list_conversations(limit=2)
+    finally:
+        mi.close()
+
+    group, direct = conversations
+    assert group["is_group_chat"] is True
+    assert group["display_name"] == "Climbing"
+    assert group["last_message"] == "me!"
+    assert direct["handle_id"] == "+14155551234"
+    assert direct["last_is_from_me"] is True
+    assert direct["message_count"] == 2
+
+
+def test_restored_database_triggers_rebuild(populated, tmp_path):
+    conn = sqlite3.connect(populated)
+    rollups = ConversationRollups(tmp_path / "sidecar.db", source_db=populated)
+    rollups.sync(conn, decode_many=lambda rows: {})
+    conn.execute("DELETE FROM message WHERE ROWID > 2")
+    conn.commit()
+
+    rollups.sync(conn, decode_many=lambda rows: {})
+    assert [c["chat_id"] for c in rollups.conversations()] == [1]
+    conn.close()
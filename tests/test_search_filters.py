@@ -0,0 +1,220 @@
+"""
+Unit tests for UnifiedVectorStore.search: where-clause pushdown and
+concurrent fan-out across source collections.
+"""
+
+import sys
+import threading
+import time
+from datetime import datetime
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.rag.unified.chunk import UNDATED_EPOCH, UnifiedChunk
+from src.rag.unified.store import UnifiedVectorStore, build_where
+
+
+def matches(meta, where):
+    """Minimal evaluator for the subset of Chroma's where syntax we emit."""
+    if "$and" in where:
+        return all(matches(meta, w) for w in where["$and"])
+    if "$or" in where:
+        return any(matches(meta, w) for w in where["$or"])
+    (key, cond), = where.items()
+    if isinstance(cond, dict):
+        (op, bound), = cond.items()
+        if key not in meta:
+            return False
+        if op == "$eq":
+            return meta[key] == bound
+        return meta[key] >= bound if op == "$gte" else meta[key] <= bound
+    return meta.get(key) == cond
+
+
+class FakeCollection:
+    """Ranks by insertion order; applies where before truncating, like Chroma."""
+
+    def __init__(self, metadatas, delay=0.0, distance=0.1, prefix="c"):
+        self.items = {f"{prefix}{i}": meta for i, meta in enumerate(metadatas)}
+        self.queries = []
+        self.counts = 0
+        self.delay = delay
+        self.distance = distance
+
+    def count(self):
+        self.counts += 1
+        return len(self.items)
+
+    def query(self, query_embeddings, n_results, include, where=None):
+        self.queries.append({"n_results": n_results, "where": where})
+        time.sleep(self.delay)
+        hits = [(cid, m) for cid, m in self.items.items() if where is None or matches(m, where)]
+        hits = hits[:n_results]
+        return {
+            "ids": [[cid for cid, _ in hits]],
+            "documents": [[m.get("text", "") for _, m in hits]],
+            "metadatas": [[m for _, m in hits]],
+            "distances": [[self.distance + i / 1000 for i in range(len(hits))]],
+        }
+
+    def get(self, include, limit, offset):
+        ids = list(self.items)[offset:offset + limit]
+        return {"ids": ids, "metadatas": [self.items[i] for i in ids]}
+
+    def update(self, ids, metadatas):
+        for cid, meta in zip(ids, metadatas):
+            self.items[cid] = meta
+
+
+class FakeEmbedder:
+    def embed_query(self, text):
+        return [0.0]
+
+
+def make_store(tmp_path, collection=None, collections=None):
+    store = UnifiedVectorStore.__new__(UnifiedVectorStore)
+    store.embedder = FakeEmbedder()
+    store._collections = collections or {"imessage": collection}
+    store._configs = {}
+    store._schema_path = tmp_path / "filter_schema.json"
+    store._filter_ready = None
+    store._schema_lock = threading.Lock()
+    store._counts = {}
+    store._executor = None
+    return store
+
+
+def make_chunk(i, day, participants, tags=()):
+    return UnifiedChunk(
+        source="imessage",
+        text=f"chunk {i}",
+        context_id=f"ctx{i}",
+        context_type="conversation",
+        timestamp=datetime(2024, 1, day),
+        participants=list(participants),
+        tags=list(tags),
+    ).to_dict()
+
+
+def test_to_dict_emits_filterable_fields():
+    meta = make_chunk(0, 5, ["Alice", "Bob"], ["work"])
+    assert meta["timestamp_epoch"] == datetime(2024, 1, 5).timestamp()
+    assert meta["participant:Alice"] is True
+    assert meta["participant:Bob"] is True
+    assert meta["tag:work"] is True
+    assert UnifiedChunk.from_dict(meta).participants == ["Alice", "Bob"]
+
+
+def test_build_where_compiles_all_filters():
+    assert build_where() is None
+    assert build_where(participants=["Alice"]) == {"participant:Alice": True}
+
+    where = build_where(
+        min_date=datetime(2024, 1, 1),
+        max_date=datetime(2024, 1, 31),
+        participants=["Alice", "Bob"],
+        tags=["work"],
+    )
+    assert where == {"$and": [
+        {"$or": [
+            {"timestamp_epoch": {"$gte": datetime(2024, 1, 1).timestamp()}},
+            {"timestamp_epoch": {"$eq": UNDATED_EPOCH}},
+        ]},
+        {"timestamp_epoch": {"$lte": datetime(2024, 1, 31).timestamp()}},
+        {"$or": [{"participant:Alice": True}, {"participant:Bob": True}]},
+        {"tag:work": True},
+    ]}
+
+
+def test_selective_filter_still_returns_full_result_set(tmp_path):
+    """Matching chunks ranked below the top-N unfiltered hits are still found."""
+    metas = [make_chunk(i, 1 + i % 28, ["Bob"]) for i in range(200)]
+    metas += [make_chunk(200 + i, 20, ["Alice"]) for i in range(10)]
+    collection = FakeCollection(metas)
+    store = make_store(tmp_path, collection)
+
+    results = store.search("q", sources=["imessage"], limit=10, participants=["Alice"])
+
+    assert len(results) == 10
+    assert all(r["participants"] == ["Alice"] for r in results)
+    assert collection.queries[-1]["where"] == {"participant:Alice": True}
+
+    recent = store.search("q", sources=["imessage"], limit=10, min_date=datetime(2024, 1, 20))
+    assert len(recent) == 10
+    assert all(r["timestamp"] >= "2024-01-20" for r in recent)
+
+
+def test_legacy_chunks_are_backfilled_once(tmp_path):
+    """Chunks stored without epoch/flag fields get them before filtering."""
+    legacy = []
+    for i in range(5):
+        meta = make_chunk(i, 10 + i, ["Alice"], ["family"])
+        legacy.append({k: v for k, v in meta.items()
+                       if k != "timestamp_epoch" and ":" not in k})
+    collection = FakeCollection(legacy)
+    store = make_store(tmp_path, collection)
+
+    results = store.search("q", sources=["imessage"], min_date=datetime(2024, 1, 12), tags=["family"])
+
+    assert sorted(r["chunk_id"] for r in results) == ["c2", "c3", "c4"]
+    assert collection.items["c0"]["participant:Alice"] is True
+    assert (tmp_path / "filter_schema.json").exists()
+
+    # Second store instance trusts the recorded schema version
+    collection.items["c0"].pop("tag:family")
+    make_store(tmp_path, collection).search("q", sources=["imessage"], tags=["family"])
+    assert "tag:family" not in collection.items["c0"]
+
+
+def test_undated_chunks_pass_date_filters(tmp_path):
+    """Chunks without a timestamp are kept by date filters, as before pushdown."""
+    undated = {k: v for k, v in make_chunk(0, 1, []).items()
+               if k not in ("timestamp", "timestamp_epoch")}
+    collection = FakeCollection([undated, make_chunk(1, 5, []), make_chunk(2, 25, [])])
+    store = make_store(tmp_path, collection)
+
+    results = store.search("q", sources=["imessage"], min_date=datetime(2024, 1, 10))
+    assert sorted(r["chunk_id"] for r in results) == ["c0", "c2"]
+    assert collection.items["c0"]["timestamp_epoch"] == UNDATED_EPOCH  # Backfilled
+
+    results = store.search("q", sources=["imessage"], max_date=datetime(2024, 1, 10))
+    assert sorted(r["chunk_id"] for r in results) == ["c0", "c1"]
+
+
+def test_fan_out_queries_sources_concurrently_and_merges_top_k(tmp_path):
+    """Latency tracks the slowest collection; results interleave by score."""
+    notes = FakeCollection([make_chunk(i, 1, []) for i in range(20)], delay=0.1, distance=0.05, prefix="n")
+    gmail = FakeCollection([make_chunk(i, 1, []) for i in range(20)], delay=0.1, distance=0.3, prefix="g")
+    imessage = FakeCollection([make_chunk(i, 1, []) for i in range(20)], delay=0.1, distance=0.2, prefix="i")
+    empty = FakeCollection([])
+    store = make_store(tmp_path, collections={
+        "notes": notes, "gmail": gmail, "imessage": imessage, "slack": empty,
+    })
+
+    start = time.perf_counter()
+    results = store.search("q", sources=["notes", "gmail", "imessage", "slack"], limit=25)
+    elapsed = time.perf_counter() - start
+
+    assert elapsed < 0.25  # Serial would be >= 0.3s
+    assert len(results) == 25
+    assert [r["source"] for r in results] == ["notes"] * 20 + ["imessage"] * 5
+    assert [r["score"] for r in results] == sorted((r["score"] for r in results), reverse=True)
+    assert empty.queries == []
+
+
+def test_counts_are_cached_and_invalidated(tmp_path, monkeypatch):
+    collection = FakeCollection([make_chunk(i, 1, []) for i in range(3)])
+    store = make_store(tmp_path, collection)
+
+    store.search("q", sources=["imessage"])
+    store.search("q", sources=["imessage"])
+    assert collection.counts == 1
+
+    store._counts.pop("imessage")  # What add_chunks/clear do after writing
+    store.search("q", sources=["imessage"])
+    assert collection.counts == 2
+
+    monkeypatch.setattr("src.rag.unified.store.COUNT_CACHE_TTL", 0.0)
+    store.search("q", sources=["imessage"])
+    assert collection.counts == 3
@@ -0,0 +1,204 @@
+"""
+Unit tests for the batched send queue and the send-batch gateway command.
+"""
+
+import json
+import subprocess
+import sys
+import threading
+import time
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from gateway import imessage_client
+from src.send_queue import RESULT_SEPARATOR, SendQueue
+
+
+class FakeOsascript:
+    """Records invocations and replies like the batch script would."""
+
+    def __init__(self, fail_handles=(), compile_code=0, delay=0.0):
+        self.fail_handles = set(fail_handles)
+        self.compile_code = compile_code
+        self.delay = delay
+        self.calls = []
+        self.active = 0
+        self.peak = 0
+        self.lock = threading.Lock()
+
+    def __call__(self, argv, timeout):
+        self.calls.append(argv)
+        if argv[0] == "osacompile":
+            if self.compile_code == 0:
+                Path(argv[2]).write_text("compiled")
+            return self.compile_code, "", "osacompile: not available"
+
+        with self.lock:
+            self.active += 1
+            self.peak = max(self.peak, self.active)
+        time.sleep(self.delay)
+        with self.lock:
+            self.active -= 1
+
+        args = argv[2:] if argv[1] != "-e" else argv[3:]
+        statuses = [
+            "error: Can't get participant\n(-1728)" if handle in self.fail_handles else "ok"
+            for handle in args[::2]
+        ]
+        return 0, RESULT_SEPARATOR.join(statuses) + "\n", ""
+
+
+def test_batch_results_in_input_order(tmp_path):
+    runner = FakeOsascript(fail_handles={"+15550000003"}, delay=0.01)
+    queue = SendQueue(script_dir=tmp_path, chunk_size=2, concurrency=2, runner=runner)
+    messages = [(f"+1555000000{i}", f"hello {i}") for i in range(7)]
+
+    progress = []
+    results = queue.send_batch(messages, on_result=lambda i, r: progress.append(i))
+
+    assert [r["handle"] for r in results] == [h for h, _ in messages]
+    assert [r["success"] for r in results] == [True, True, True, False, True, True, True]
+    assert results[3]["error"] == "Can't get participant\n(-1728)"
+    assert sorted(progress) == list(range(7))
+
+    sends = [c for c in runner.calls if c[0] == "osascript"]
+    assert len(sends) == 4  # ceil(7 / 2) processes, not 7
+    assert runner.peak <= 2
+    assert sends[0][1] == str(tmp_path / next(p.name for p in tmp_path.glob("*.scpt")))
+    assert sends[0][2:] == ["+15550000000", "hello 0", "+15550000001", "hello 1"]
+
+
+def test_script_compiled_once_and_fallback(tmp_path):
+    runner = FakeOsascript()
+    queue = SendQueue(script_dir=tmp_path, runner=runner)
+    queue.send("+15550000000", "a")
+    queue.send("+15550000001", "b")
+    assert sum(1 for c in runner.calls if c[0] == "osacompile") == 1
+
+    broken = FakeOsascript(compile_code=1)
+    queue = SendQueue(script_dir=tmp_path / "fresh", runner=broken)
+    assert queue.send("+15550000000", 'say "hi" \\ bye')["success"] is True
+    assert broken.calls[-1][1] == "-e"
+    assert broken.calls[-1][-1] == 'say "hi" \\ bye'  # Passed verbatim, never spliced
+
+
+def test_failures_reported_per_message(tmp_path):
+    def timing_out(argv, timeout):
+        if argv[0] == "osacompile":
+            return 1, "", "no osacompile"
+        raise subprocess.TimeoutExpired(argv, timeout)
+
+    results = SendQueue(script_dir=tmp_path, runner=timing_out).send_batch([("a@b.c", "x"), ("+1", "y")])
+    assert [r["success"] for r in results] == [False, False]
+    assert "Timeout" in results[0]["error"]
+    assert results[0]["possibly_sent"] is True and "possibly_sent" not in results[1]
+
+    def short_output(argv, timeout):
+        return (1, "", "") if argv[0] == "osacompile" else (0, "ok\n", "")
+
+    results = SendQueue(script_dir=tmp_path, runner=short_output).send_batch([("a", "x"), ("b", "y")])
+    assert results[1] == {"handle": "b", "success": False, "error": "no result reported"}
+
+
+def test_interrupted_chunk_keeps_progress(tmp_path):
+    """Messages the script reported before dying are not marked failed."""
+    progress = "\x1eok\x1f\n\x1eerror: Can't get participant\n(-1728)\x1f\n"
+
+    def timing_out(argv, timeout):
+        if argv[0] == "osacompile":
+            return 1, "", "no osacompile"
+        raise subprocess.TimeoutExpired(argv, timeout, stderr=progress.encode())
+
+    def crashing(argv, timeout):
+        if argv[0] == "osacompile":
+            return 1, "", "no osacompile"
+        return 1, "", progress + "execution error: Messages got an error (-609)"
+
+    messages = [("a", "1"), ("b", "2"), ("c", "3"), ("d", "4")]
+    for runner in (timing_out, crashing):
+        results = SendQueue(script_dir=tmp_path, runner=runner).send_batch(messages)
+        assert results[0] == {"handle": "a", "success": True, "error": None}
+        assert results[1]["error"] == "Can't get participant\n(-1728)"
+        assert results[2]["possibly_sent"] is True
+        assert results[3]["error"].startswith("Not attempted") and "possibly_sent" not in results[3]
+    assert results[3]["error"] == "Not attempted: execution error: Messages got an error (-609)"
+
+
+def test_concurrency_is_per_batch(tmp_path):
+    runner = FakeOsascript(delay=0.01)
+    queue = SendQueue(script_dir=tmp_path, chunk_size=1, concurrency=1, runner=runner)
+    queue.send_batch([(f"+1555000000{i}", "x") for i in range(4)], concurrency=3)
+    assert runner.peak > 1 and queue.concurrency == 1
+
+
+class FakeContact:
+    def __init__(self, name, phone):
+        self.name = name
+        self.phone = phone
+
+
+class FakeContacts:
+    sarah = FakeContact("Sarah Smith", "+14155551111")
+
+    def get_contact_by_name(self, name):
+        return self.sarah if name.lower().startswith("sarah") else None
+
+    def get_contact_by_exact_name(self, name):
+        return self.sarah if name.lower() == "sarah smith" else None
+
+    def resolve_handles(self, handles):
+        return {h: self.sarah if h.endswith("4155551111") else None for h in handles}
+
+
+class FakeMessages:
+    def __init__(self):
+        self.batches = []
+
+    def send_messages(self, messages, concurrency=None, on_result=None):
+        self.batches.append((list(messages), concurrency))
+        results = [{"handle": h, "success": True, "error": None} for h, _ in messages]
+        for i, r in enumerate(results):
+            on_result(i, r)
+        return results
+
+
+def test_send_batch_command(tmp_path, monkeypatch, capsys):
+    mi = FakeMessages()
+    monkeypatch.setattr(imessage_client, "get_interfaces", lambda: (mi, FakeContacts()))
+    batch = tmp_path / "batch.jsonl"
+    batch.write_text("\n".join(json.dumps(e) for e in [
+        {"to": "Sarah Smith", "text": "dinner at 7?"},
+        {"to": "(415) 555-2222", "text": "on my way"},
+        {"to": "Nobody Known", "text": "hi"},
+        {"to": "x@example.com"},
+        {"to": "Sarah", "text": "partial name"},
+    ]))
+
+    code = imessage_client.run_command(["send-batch", str(batch), "--json", "--concurrency", "3"])
+    output = json.loads(capsys.readouterr().out)
+
+    assert code == 1
+    assert mi.batches == [([("+14155551111", "dinner at 7?"), ("4155552222", "on my way")], 3)]
+    assert [r["success"] for r in output["results"]] == [True, True, False, False, False]
+    assert output["results"][0]["contact"] == "Sarah Smith"
+    assert output["results"][1]["contact"] is None
+    assert output["results"][2]["error"] == "Contact not found"
+    assert "closest: Sarah Smith" in output["results"][4]["error"]  # Never guessed
+    assert output["failed"] == 3
+
+    capsys.readouterr()
+    imessage_client.run_command(["send-batch", str(batch)])
+    assert "[1/5] Sarah Smith (+14155551111): sent" in capsys.readouterr().err
+
+    code = imessage_client.run_command(["send-batch", str(batch), "--dry-run", "--json"])
+    assert code == 1
+    assert len(mi.batches) == 2  # Nothing sent
+
+    capsys.readouterr()
+    batch.write_text(json.dumps([{"to": "Sarah Smith", "text": "hi"}, "Sarah: hi"]))
+    assert imessage_client.run_command(["send-batch", str(batch)]) == 1
+    assert "entry 2 is str" in capsys.readouterr().err
+    assert len(mi.batches) == 2
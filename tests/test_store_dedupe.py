@@ -0,0 +1,47 @@
+"""
+Unit tests for the targeted "already indexed?" check used by add_chunks.
+"""
+
+import sys
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.rag.store import filter_new_chunks, find_existing_ids
+
+
+class FakeCollection:
+    """Records get() calls; mimics Chroma's get(ids=..., include=[])."""
+
+    def __init__(self, ids):
+        self.ids = set(ids)
+        self.calls = []
+
+    def get(self, ids=None, include=None):
+        self.calls.append((list(ids) if ids is not None else None, include))
+        if ids is None:
+            return {"ids": list(self.ids)}
+        return {"ids": [i for i in ids if i in self.ids]}
+
+
+class Chunk:
+    def __init__(self, chunk_id):
+        self.chunk_id = chunk_id
+
+
+def test_only_candidate_ids_are_queried():
+    """Lookups never fetch the whole collection or its payloads."""
+    collection = FakeCollection(f"id{i}" for i in range(10_000))
+
+    existing = find_existing_ids(collection, ["id5", "id9999", "new1"], batch_size=2)
+
+    assert existing == {"id5", "id9999"}
+    assert collection.calls == [(["id5", "id9999"], []), (["new1"], [])]
+
+
+def test_filter_new_chunks_drops_existing_and_repeated_ids():
+    collection = FakeCollection(["a", "b"])
+    chunks = [Chunk("a"), Chunk("c"), Chunk("c"), Chunk("d"), Chunk("b")]
+
+    assert [c.chunk_id for c in filter_new_chunks(collection, chunks)] == ["c", "d"]
+    assert all(ids is not None for ids, _ in collection.calls)
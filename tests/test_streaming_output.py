@@ -0,0 +1,123 @@
+"""
+Unit tests for streamed output: token-budgeted conversation summaries,
+NDJSON writing, and stdout relayed in chunks by the gateway daemon.
+"""
+
+import json
+import sys
+import threading
+from datetime import datetime
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from gateway import daemon
+from gateway.imessage_client import write_ndjson
+from src.messages_interface import MessagesInterface, estimate_tokens
+from tests.conftest import make_chat_db
+
+NS_PER_MINUTE = 60 * 1_000_000_000
+START_COCOA = int((datetime(2024, 5, 1, 9, 0) - datetime(2001, 1, 1)).total_seconds()) * 1_000_000_000
+
+
+@pytest.fixture
+def chat_db(tmp_path):
+    """One conversation of 50 messages, a minute apart."""
+    path = tmp_path / "chat.db"
+    conn = make_chat_db(path)
+    conn.executemany(
+        "INSERT INTO message (text, date, is_from_me, handle_id) VALUES (?, ?, ?, 1)",
+        [(f"message number {i} about the climbing trip", START_COCOA + i * NS_PER_MINUTE, i % 2)
+         for i in range(50)],
+    )
+    conn.commit()
+    conn.close()
+    return path
+
+
+def test_summary_format_and_stats(chat_db, tmp_path):
+    mi = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+    summary = mi.get_conversation_for_summary("+14155551234", limit=3)
+
+    assert summary["conversation_text"] == (
+        "\n=== 2024-05-01 ===\n\n"
+        "[09:00] Them: message number 0 about the climbing trip\n"
+        "[09:01] You: message number 1 about the climbing trip\n"
+        "[09:02] Them: message number 2 about the climbing trip"
+    )
+    assert summary["message_count"] == 3 and summary["truncated"] is False
+    assert summary["key_stats"] == {"sent": 1, "received": 2, "avg_message_length": 40}
+    assert "climbing" in summary["recent_topics"]
+    assert summary["estimated_tokens"] >= estimate_tokens(summary["conversation_text"])
+
+    assert mi.get_conversation_for_summary("+19999999999")["error"] == "No messages found"
+
+
+def test_token_budget_stops_fetching(chat_db, tmp_path):
+    mi = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+    batches = []
+    decode = mi._decode_bodies
+    mi._decode_bodies = lambda rows: (batches.append(len(rows)), decode(rows))[1]
+
+    summary = mi.get_conversation_for_summary("+14155551234", limit=500, max_tokens=120)
+
+    assert summary["truncated"] is True
+    assert 0 < summary["message_count"] < 10
+    assert summary["estimated_tokens"] <= 120
+    assert estimate_tokens(summary["conversation_text"]) <= 120
+
+    # The budget drops the oldest messages; the rest stay in order
+    lines = summary["conversation_text"].strip().splitlines()[2:]
+    assert lines[-1].endswith("number 49 about the climbing trip")
+    assert lines == sorted(lines)
+
+    # Stopping at the budget means later pages are never fetched
+    batches.clear()
+    records = list(mi.iter_conversation_for_summary("+14155551234", limit=500, max_tokens=120, batch_size=5))
+    assert len(batches) == 2
+    assert [r["type"] for r in records][-1] == "summary"
+    assert sum(r["type"] == "message" for r in records) == summary["message_count"]
+    assert set(records[0]) == {"type", "date", "sender", "line"}
+
+
+def test_write_ndjson_is_compact_and_line_delimited(capsys):
+    write_ndjson(iter([{"a": 1, "b": [1, 2]}, {"when": datetime(2024, 5, 1)}]))
+    lines = capsys.readouterr().out.splitlines()
+    assert lines[0] == '{"a":1,"b":[1,2]}'
+    assert json.loads(lines[1]) == {"when": "2024-05-01 00:00:00"}
+
+
+def test_daemon_relays_output_before_command_finishes(tmp_path):
+    first_chunk_seen = threading.Event()
+
+    def runner(argv):
+        print("first", flush=True)
+        # Blocks until the client has the first line: proves it was streamed
+        assert first_chunk_seen.wait(timeout=5)
+        print("last")
+        return 0
+
+    server = daemon.GatewayDaemon(tmp_path / "gw.sock", runner)
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+    try:
+        chunks = []
+
+        def on_chunk(text):
+            chunks.append(text)
+            first_chunk_seen.set()
+
+        response = daemon._request({"op": "run", "argv": [], "stream": True},
+                                   tmp_path / "gw.sock", on_chunk=on_chunk)
+        assert chunks == ["first\n"]
+        assert response == {"exit_code": 0, "stdout": "last\n", "stderr": ""}
+
+        # Non-streaming requests still get everything in one reply
+        first_chunk_seen.set()
+        assert daemon._request({"op": "run", "argv": []}, tmp_path / "gw.sock")["stdout"] == "first\nlast\n"
+    finally:
+        server.shutdown()
+        server.server_close()
+        thread.join(timeout=5)
@@ -0,0 +1,110 @@
+"""
+Unit tests for the synthetic benchmark datasets and the scaling suite's
+percentile and regression comparison.
+"""
+
+import sqlite3
+import sys
+from datetime import datetime
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from benchmarks.bench_scaling import compare_scaling, percentile
+from benchmarks.synthetic_data import (
+    generate_chat_db,
+    generate_notes,
+    generate_superwhisper,
+    synthetic_dataset,
+)
+from src.messages_interface import MessagesInterface
+from src.rag.unified.notes_indexer import NotesIndexer
+from src.rag.unified.store import UnifiedVectorStore
+from src.rag.unified.superwhisper_indexer import SuperWhisperIndexer
+
+END = datetime(2026, 1, 1)
+
+
+def message_rows(path):
+    conn = sqlite3.connect(path)
+    rows = conn.execute("SELECT guid, text, attributedBody, date, handle_id FROM message ORDER BY ROWID").fetchall()
+    conn.close()
+    return rows
+
+
+@pytest.fixture
+def dataset(tmp_path):
+    return synthetic_dataset("3000", seed=7, root=tmp_path / "data")
+
+
+def test_same_seed_same_rows(tmp_path):
+    first = generate_chat_db(tmp_path / "a.db", 500, seed=3, end=END)
+    again = generate_chat_db(tmp_path / "b.db", 500, seed=3, end=END)
+    generate_chat_db(tmp_path / "c.db", 500, seed=4, end=END)
+
+    assert first == again and first["messages"] == 500
+    assert message_rows(tmp_path / "a.db") == message_rows(tmp_path / "b.db")
+    assert message_rows(tmp_path / "a.db") != message_rows(tmp_path / "c.db")
+
+
+def test_dataset_has_realistic_mix(dataset):
+    counts = dataset.counts
+    assert counts["messages"] == 3000
+    for kind in ("reactions", "attachments", "voice", "links", "group_messages", "replies"):
+        assert counts[kind] > 0, kind
+    assert 0.6 < counts["blob_only"] / counts["messages"] < 0.8
+
+    # Cached: a second call reuses the files instead of regenerating
+    mtime = dataset.chat_db.stat().st_mtime_ns
+    assert synthetic_dataset("3000", seed=7, root=dataset.root.parent).chat_db.stat().st_mtime_ns == mtime
+
+
+def test_gateway_queries_find_synthetic_data(dataset, tmp_path):
+    mi = MessagesInterface(str(dataset.chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+
+    groups = mi.list_group_chats(limit=100)
+    assert 0 < len(groups) <= 25          # Quiet groups may have no messages yet
+    assert mi.get_group_messages(group_id=groups[0]["group_id"], limit=10)
+    assert mi.get_unread_messages(limit=100)
+    assert mi.get_voice_messages(limit=5)
+    assert all(link["url"].startswith("https://") for link in mi.extract_links(limit=20))
+    assert mi.get_attachments(mime_type_filter="image/", limit=5)
+
+    reactions = mi.get_reactions(limit=20)
+    assert reactions and any(r.get("original_message_preview") for r in reactions)
+
+    # Most bodies live only in attributedBody; search has to decode them
+    assert mi.search_messages("dinner", limit=10)
+
+
+def test_notes_and_superwhisper_corpora_load(tmp_path):
+    store = UnifiedVectorStore(persist_directory=str(tmp_path / "chroma"))
+    assert generate_notes(tmp_path / "notes", 20, seed=1) == 20
+    assert generate_superwhisper(tmp_path / "sw", 15, seed=1, end=END) == 15
+
+    notes = NotesIndexer(notes_path=tmp_path / "notes", state_file=tmp_path / "n.json", store=store)
+    recordings = SuperWhisperIndexer(recordings_path=tmp_path / "sw", state_file=tmp_path / "s.json", store=store)
+    assert len(notes.fetch_data(incremental=False)) == 20
+    assert len(recordings.chunk_data(recordings.fetch_data(incremental=False))) == 15
+
+
+def test_percentile_and_regression_comparison():
+    samples = [float(i) for i in range(1, 101)]
+    assert (percentile(samples, 50), percentile(samples, 95), percentile(samples, 99)) == (50.0, 95.0, 99.0)
+    assert percentile([], 50) == 0.0
+
+    baseline = [
+        {"name": "cmd_recent_10k", "elapsed_seconds": 1.0, "metrics": {"p50_ms": 10.0, "p95_ms": 12.0}},
+        {"name": "imessage_chunk_10k", "elapsed_seconds": 2.0, "metrics": {}},
+    ]
+    current = [
+        {"name": "cmd_recent_10k", "elapsed_seconds": 1.05, "metrics": {"p50_ms": 15.0, "p95_ms": 12.5}},
+        {"name": "imessage_chunk_10k", "elapsed_seconds": 1.0, "metrics": {}},
+        {"name": "cmd_new_10k", "elapsed_seconds": 9.0, "metrics": {}},
+    ]
+    changes = {(c["name"], c["metric"]): c for c in compare_scaling(baseline, current)}
+    assert set(changes) == {("cmd_recent_10k", "p50_ms"), ("imessage_chunk_10k", "elapsed_seconds")}
+    assert changes[("cmd_recent_10k", "p50_ms")]["regressed"] is True
+    assert changes[("imessage_chunk_10k", "elapsed_seconds")]["regressed"] is False
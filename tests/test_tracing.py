@@ -0,0 +1,168 @@
+"""
+Unit tests for span tracing: exclusive-time accounting, the no-trace fast
+path, per-stage indexing stats, and the gateway's --profile/--metrics-file.
+"""
+
+import itertools
+import sys
+from datetime import datetime
+from pathlib import Path
+
+import pytest
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+import src.tracing as tracing
+from benchmarks.benchmark_runner import load_benchmark_results
+from benchmarks.synthetic_data import generate_chat_db, generate_contacts
+from gateway import imessage_client
+from src.contacts_manager import ContactsManager
+from src.messages_interface import MessagesInterface
+from src.rag.unified.imessage_indexer import ImessageIndexer
+from src.tracing import span, trace, traced, traced_iter
+
+
+@pytest.fixture
+def clock(monkeypatch):
+    """Deterministic clock: every reading advances one second."""
+    ticks = itertools.count()
+    monkeypatch.setattr(tracing, "_clock", lambda: float(next(ticks)))
+
+
+class FakeStore:
+    """add_chunks/delete_chunks stand-in that records a store span."""
+
+    def add_chunks(self, chunks, batch_size=100):
+        with span("store"):
+            return {"imessage": len(chunks)}
+
+    def delete_chunks(self, source, chunk_ids):
+        return len(chunk_ids)
+
+
+class Recorder:
+    def lookup(self, value):
+        with span("decode"):
+            return value
+
+    def rows(self):
+        yield from range(3)
+
+
+def test_nested_spans_record_exclusive_time(clock):
+    with trace("cmd", root_stage="format") as t:      # start: 0
+        with span("query"):                          # 1
+            with span("decode"):                     # 2
+                pass                                 # 3
+            with span("decode"):                     # 4
+                pass                                 # 5
+        # query ends at 6: 5s long, 2s of it decode
+
+    assert t.elapsed_seconds == 7
+    assert t.stages == {
+        "query": {"seconds": 3.0, "calls": 1},
+        "decode": {"seconds": 2.0, "calls": 2},
+        "format": {"seconds": 2.0, "calls": 0},
+    }
+    assert sum(info["seconds"] for info in t.stages.values()) == t.elapsed_seconds
+
+
+def test_nested_trace_folds_into_parent(clock):
+    with trace("cmd", root_stage="format") as outer:
+        with trace("index") as inner:
+            with span("chunk"):
+                pass
+    assert set(inner.stage_seconds()) == {"chunk", "other"}
+    assert set(outer.stage_seconds()) == {"chunk", "other", "format"}
+    assert sum(outer.stage_seconds().values()) == outer.elapsed_seconds
+
+
+def test_no_trace_is_a_no_op():
+    recorder = Recorder()
+    rows = recorder.rows()
+    assert traced(recorder, "query") is recorder
+    assert traced_iter(rows, "fetch") is rows
+    assert span("query") is span("decode")            # Shared null context
+
+
+def test_proxy_times_calls_and_generators_once():
+    with trace("cmd") as t:
+        proxy = traced(Recorder(), "query")
+        assert proxy.lookup(5) == 5
+        assert list(proxy.rows()) == [0, 1, 2]
+        # Inside another span the proxy leaves attribution to that span
+        with span("fetch"):
+            proxy.lookup(1)
+
+    stages = t.stages
+    assert stages["query"]["calls"] == 1 + 1 + 4       # lookup, rows(), 3 items + exhaustion
+    assert stages["decode"]["calls"] == 2
+    assert stages["fetch"]["calls"] == 1
+
+
+@pytest.fixture
+def chat_db(tmp_path):
+    path = tmp_path / "chat.db"
+    generate_chat_db(path, 400, seed=5, end=datetime(2026, 1, 1))
+    generate_contacts(tmp_path / "contacts.json", path, count=10)
+    return path
+
+
+def test_index_reports_stage_breakdown(chat_db, tmp_path):
+    mi = MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db"))
+    indexer = ImessageIndexer(
+        messages_interface=mi,
+        contacts_manager=ContactsManager(str(tmp_path / "contacts.json")),
+        state_file=tmp_path / "state.json",
+        store=FakeStore(),
+        min_words=1,
+    )
+    result = indexer.index(incremental=False)
+
+    assert result["success"] and result["messages_processed"] == 400
+    assert {"fetch", "decode", "enrich", "chunk", "store"} <= set(result["stages"])
+    assert sum(result["stages"].values()) == pytest.approx(result["duration_seconds"], rel=0.05, abs=0.01)
+
+
+def test_gateway_profile_and_metrics_file(chat_db, tmp_path, monkeypatch, capsys):
+    contacts = tmp_path / "contacts.json"
+    monkeypatch.setattr(imessage_client, "CONTACTS_CONFIG", contacts)
+    monkeypatch.setattr(imessage_client, "_interfaces", (
+        MessagesInterface(str(chat_db), sidecar_path=str(tmp_path / "sidecar.db")),
+        ContactsManager(str(contacts)),
+    ))
+    monkeypatch.setattr(imessage_client, "_contacts_mtime", contacts.stat().st_mtime_ns)
+    metrics = tmp_path / "metrics.jsonl"
+
+    assert imessage_client.run_command(["unread", "--json", "--profile", "--metrics-file", str(metrics)]) == 0
+    assert imessage_client.run_command(["find", "Contact 001", "--query", "dinner", "--json",
+                                        "--metrics-file", str(metrics)]) == 0
+    captured = capsys.readouterr()
+    assert captured.err.startswith("Profile: unread")
+    assert "query" in captured.err and "format" in captured.err
+    assert captured.out.lstrip().startswith("[")       # stdout stays clean JSON
+
+    unread, find = load_benchmark_results(metrics)
+    assert (unread.name, find.name) == ("cmd_unread", "cmd_find")
+    assert find.metrics["decode_calls"] >= 1 and find.metrics["exit_code"] == 0
+    assert "argv" not in find.metrics                  # May hold names or message text
+    assert find.elapsed_seconds == pytest.approx(
+        sum(v for k, v in find.metrics.items() if k.endswith("_seconds")), rel=0.01)
+
+    # Without the flags, handlers get the plain interfaces
+    assert type(imessage_client.get_interfaces()[0]) is MessagesInterface
+
+
+def test_relative_metrics_file_forwarded_as_absolute(tmp_path, monkeypatch):
+    """The daemon runs in its own cwd, so the client resolves the path first."""
+    forwarded = []
+    monkeypatch.setattr(imessage_client, "daemon_disabled", lambda: False)
+    monkeypatch.setattr(imessage_client, "run_via_daemon", lambda argv: forwarded.append(argv) or 0)
+    monkeypatch.chdir(tmp_path)
+
+    assert imessage_client.main(["unread", "--metrics-file", "m.jsonl"]) == 0
+    assert imessage_client.main(["unread", "--metrics-file=out/m.jsonl", "--profile"]) == 0
+    assert forwarded == [
+        ["unread", "--metrics-file", str(tmp_path / "m.jsonl")],
+        ["unread", f"--metrics-file={tmp_path / 'out' / 'm.jsonl'}", "--profile"],
+    ]